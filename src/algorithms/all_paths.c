@@ -7,6 +7,7 @@
 #include "all_paths.h"
 #include "RG.h"
 #include "../util/arr.h"
+#include "../query_ctx.h"
 #include "../util/rmalloc.h"
 
 // Make sure context levels array have atleast 'level' entries,
@@ -119,6 +120,10 @@ Path *AllPathsCtx_NextPath(AllPathsCtx *ctx) {
 
 	// As long as path is not empty OR there are neighbors to traverse.
 	while(Path_NodeCount(ctx->path) || _AllPathsCtx_LevelNotEmpty(ctx, 0)) {
+		// a long DFS might not produce a path for a while
+		// stop traversing once the query is cancelled
+		if(QueryCtx_Cancelled()) return NULL;
+
 		uint32_t depth = Path_NodeCount(ctx->path);
 
 		// Can we advance?
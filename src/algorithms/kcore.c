@@ -0,0 +1,84 @@
+/*
+* Copyright 2018-2021 Redis Labs Ltd. and Contributors
+*
+* This file is available under the Redis Labs Source Available License Agreement
+*/
+
+#include "RG.h"
+#include "kcore.h"
+#include "undirected.h"
+
+GrB_Info KCore
+(
+	GrB_Vector *core,
+	const GrB_Matrix A,
+	const GrB_Vector V,
+	int64_t k
+) {
+	ASSERT(A    != NULL);
+	ASSERT(V    != NULL);
+	ASSERT(core != NULL);
+
+	GrB_Info    info;
+	GrB_Index   n;
+	GrB_Index   alive_count;
+	GrB_Index   deg_count;
+	GrB_Scalar  thunk  =  NULL;
+	GrB_Matrix  S      =  NULL;  // undirected structure of A
+	GrB_Vector  deg    =  NULL;  // degree of remaining nodes
+	GrB_Vector  alive  =  NULL;  // remaining nodes
+
+	info = Undirected(&S, A, V);
+	ASSERT(info == GrB_SUCCESS);
+
+	info = GrB_Matrix_nrows(&n, S);
+	ASSERT(info == GrB_SUCCESS);
+
+	info = GrB_Vector_dup(&alive, V);
+	ASSERT(info == GrB_SUCCESS);
+	info = GrB_Vector_nvals(&alive_count, alive);
+	ASSERT(info == GrB_SUCCESS);
+
+	info = GrB_Vector_new(&deg, GrB_INT64, n);
+	ASSERT(info == GrB_SUCCESS);
+
+	info = GrB_Scalar_new(&thunk, GrB_INT64);
+	ASSERT(info == GrB_SUCCESS);
+	info = GrB_Scalar_setElement_INT64(thunk, k);
+	ASSERT(info == GrB_SUCCESS);
+
+	// repeatedly peel nodes with less than k remaining neighbors
+	while(true) {
+		// deg(i) = number of remaining neighbors of i
+		info = GrB_Vector_assign_INT64(deg, alive, NULL, 0, GrB_ALL, n,
+				GrB_DESC_RS);
+		ASSERT(info == GrB_SUCCESS);
+		info = GrB_mxv(deg, alive, GrB_PLUS_INT64, GxB_PLUS_PAIR_INT64, S,
+				alive, GrB_DESC_S);
+		ASSERT(info == GrB_SUCCESS);
+
+		// keep nodes with at least k remaining neighbors
+		info = GxB_Vector_select(deg, NULL, NULL, GxB_GE_THUNK, deg, thunk,
+				NULL);
+		ASSERT(info == GrB_SUCCESS);
+
+		info = GrB_Vector_nvals(&deg_count, deg);
+		ASSERT(info == GrB_SUCCESS);
+
+		// no node was peeled, k-core reached
+		if(deg_count == alive_count) break;
+
+		info = GrB_Vector_assign_BOOL(alive, deg, NULL, true, GrB_ALL, n,
+				GrB_DESC_RS);
+		ASSERT(info == GrB_SUCCESS);
+		alive_count = deg_count;
+	}
+
+	GrB_free(&S);
+	GrB_free(&alive);
+	GrB_free(&thunk);
+
+	*core = deg;
+	return info;
+}
+
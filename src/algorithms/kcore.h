@@ -0,0 +1,21 @@
+/*
+* Copyright 2018-2021 Redis Labs Ltd. and Contributors
+*
+* This file is available under the Redis Labs Source Available License Agreement
+*/
+
+#pragma once
+
+#include "../../deps/GraphBLAS/Include/GraphBLAS.h"
+
+// computes the k-core of the graph, the maximal subgraph in which
+// every node has at least k neighbors within the subgraph
+// edge direction is ignored and only edges connecting nodes in V are considered
+GrB_Info KCore
+(
+	GrB_Vector *core,    // [output] degree of each node in the k-core, INT64
+	const GrB_Matrix A,  // input graph, n x n, values are ignored
+	const GrB_Vector V,  // nodes to consider
+	int64_t k            // minimum degree
+);
+
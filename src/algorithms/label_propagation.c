@@ -0,0 +1,152 @@
+/*
+* Copyright 2018-2021 Redis Labs Ltd. and Contributors
+*
+* This file is available under the Redis Labs Source Available License Agreement
+*/
+
+#include "RG.h"
+#include "undirected.h"
+#include "label_propagation.h"
+#include "../util/rmalloc.h"
+#include <stdlib.h>
+
+static int _compare_labels
+(
+	const void *a,
+	const void *b
+) {
+	uint64_t x = *(const uint64_t *)a;
+	uint64_t y = *(const uint64_t *)b;
+	return (x > y) - (x < y);
+}
+
+// returns the label most common among 'count' neighbor labels
+// ties are resolved in favor of the smallest label
+static uint64_t _dominant_label
+(
+	uint64_t *labels,  // neighbor labels, reordered
+	GrB_Index count    // number of neighbor labels
+) {
+	qsort(labels, count, sizeof(uint64_t), _compare_labels);
+
+	uint64_t  best        =  labels[0];
+	GrB_Index best_freq   =  0;
+	GrB_Index i           =  0;
+
+	while(i < count) {
+		GrB_Index j = i;
+		while(j < count && labels[j] == labels[i]) j++;
+
+		// labels are visited in ascending order, keep first most common
+		GrB_Index freq = j - i;
+		if(freq > best_freq) {
+			best       =  labels[i];
+			best_freq  =  freq;
+		}
+		i = j;
+	}
+
+	return best;
+}
+
+// labels are updated synchronously, each iteration computes new labels
+// from the labels of the previous iteration, making the result independent
+// of the order in which nodes are processed
+// synchronous updates may oscillate, e.g. two adjacent nodes swapping labels
+// indefinitely, in which case iteration stops after 'max_iter' iterations
+GrB_Info LabelPropagation
+(
+	GrB_Vector *communities,
+	const GrB_Matrix A,
+	const GrB_Vector V,
+	int max_iter
+) {
+	ASSERT(A           != NULL);
+	ASSERT(V           != NULL);
+	ASSERT(communities != NULL);
+
+	GrB_Info    info;
+	GrB_Type    type;
+	GrB_Index   n;
+	GrB_Index   ncols;
+	GrB_Index   nv;
+	GrB_Index   Ap_size;
+	GrB_Index   Aj_size;
+	GrB_Index   Ax_size;
+	bool        iso;
+	GrB_Index   *Ap  =  NULL;  // row pointers
+	GrB_Index   *Aj  =  NULL;  // column indices
+	void        *Ax  =  NULL;  // values
+	GrB_Matrix  S    =  NULL;  // undirected structure of A
+	GrB_Vector  c    =  NULL;  // communities
+
+	info = Undirected(&S, A, V);
+	ASSERT(info == GrB_SUCCESS);
+
+	info = GrB_Matrix_nrows(&n, S);
+	ASSERT(info == GrB_SUCCESS);
+	info = GrB_Vector_nvals(&nv, V);
+	ASSERT(info == GrB_SUCCESS);
+
+	// access S's rows directly, S is consumed by the export
+	info = GxB_Matrix_export_CSR(&S, &type, &n, &ncols, &Ap, &Aj, &Ax,
+			&Ap_size, &Aj_size, &Ax_size, &iso, NULL, NULL);
+	ASSERT(info == GrB_SUCCESS);
+
+	GrB_Index *I      = rm_malloc(sizeof(GrB_Index) * nv);  // nodes considered
+	uint64_t  *labels = rm_malloc(sizeof(uint64_t) * n);    // label per node
+	uint64_t  *next   = rm_malloc(sizeof(uint64_t) * n);    // updated labels
+	uint64_t  *buf    = NULL;                               // neighbor labels
+	GrB_Index buf_cap = 0;
+
+	info = GrB_Vector_extractTuples_BOOL(I, NULL, &nv, V);
+	ASSERT(info == GrB_SUCCESS);
+
+	// each node starts in its own community
+	for(GrB_Index k = 0; k < nv; k++) labels[I[k]] = next[I[k]] = I[k];
+
+	bool changed = true;
+	for(int iter = 0; iter < max_iter && changed; iter++) {
+		changed = false;
+		for(GrB_Index k = 0; k < nv; k++) {
+			GrB_Index i   = I[k];
+			GrB_Index deg = Ap[i + 1] - Ap[i];
+			next[i] = labels[i];
+			if(deg == 0) continue;
+
+			if(deg > buf_cap) {
+				buf_cap = deg;
+				buf = rm_realloc(buf, sizeof(uint64_t) * buf_cap);
+			}
+
+			for(GrB_Index p = 0; p < deg; p++) buf[p] = labels[Aj[Ap[i] + p]];
+
+			next[i] = _dominant_label(buf, deg);
+			if(next[i] != labels[i]) changed = true;
+		}
+
+		uint64_t *tmp = labels;
+		labels = next;
+		next = tmp;
+	}
+
+	info = GrB_Vector_new(&c, GrB_UINT64, n);
+	ASSERT(info == GrB_SUCCESS);
+	// compact labels in place, I is sorted and I[k] >= k
+	for(GrB_Index k = 0; k < nv; k++) labels[k] = labels[I[k]];
+	info = GrB_Vector_build_UINT64(c, I, labels, nv, GrB_FIRST_UINT64);
+	ASSERT(info == GrB_SUCCESS);
+
+	*communities = c;
+
+	rm_free(I);
+	rm_free(Ap);
+	rm_free(Aj);
+	rm_free(Ax);
+	rm_free(buf);
+	rm_free(next);
+	rm_free(labels);
+
+	return info;
+}
+
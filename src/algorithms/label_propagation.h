@@ -0,0 +1,23 @@
+/*
+* Copyright 2018-2021 Redis Labs Ltd. and Contributors
+*
+* This file is available under the Redis Labs Source Available License Agreement
+*/
+
+#pragma once
+
+#include "../../deps/GraphBLAS/Include/GraphBLAS.h"
+
+// detects communities using label propagation
+// each node starts with its own ID as its label and repeatedly adopts the
+// label most common among its neighbors, until labels no longer change
+// or 'max_iter' iterations were performed
+// edge direction is ignored and only edges connecting nodes in V are considered
+GrB_Info LabelPropagation
+(
+	GrB_Vector *communities,  // [output] community of each node in V, UINT64
+	const GrB_Matrix A,       // input graph, n x n, values are ignored
+	const GrB_Vector V,       // nodes to consider
+	int max_iter              // maximum number of iterations
+);
+
@@ -57,6 +57,41 @@ int compar(const void *x, const void *y) {
 	}
 }
 
+//------------------------------------------------------------------------------
+// select the k highest ranked pages
+//------------------------------------------------------------------------------
+
+// partially order P such that its first k entries are the k highest ranked
+// pages, in no particular order, P [k-1] being the kth highest ranked page
+static void _select_top(LAGraph_PageRank *P, int64_t n, int64_t k) {
+	int64_t lo = 0 ;
+	int64_t hi = n - 1 ;
+
+	while(lo < hi) {
+		double pivot = P [lo + (hi - lo) / 2].pagerank ;
+		int64_t i = lo ;
+		int64_t j = hi ;
+
+		// partition, [lo, j] ranked >= pivot, [i, hi] ranked <= pivot
+		while(i <= j) {
+			while(P [i].pagerank > pivot) i++ ;
+			while(P [j].pagerank < pivot) j-- ;
+			if(i <= j) {
+				LAGraph_PageRank tmp = P [i] ;
+				P [i] = P [j] ;
+				P [j] = tmp ;
+				i++ ;
+				j-- ;
+			}
+		}
+
+		// continue with the partition holding the kth page
+		if(k - 1 <= j) hi = j ;
+		else if(k - 1 >= i) lo = i ;
+		else break ;
+	}
+}
+
 //------------------------------------------------------------------------------
 // LAGraph_pagerank: compute the pagerank of all nodes in a graph
 //------------------------------------------------------------------------------
@@ -65,6 +100,7 @@ GrB_Info Pagerank               // GrB_SUCCESS or error condition
 (
 	LAGraph_PageRank **Phandle, // output: array of LAGraph_PageRank structs
 	GrB_Matrix A,               // binary input graph, not modified
+	GrB_Index top,              // number of top ranked pages to return
 	int itermax,                // max number of iterations
 	double tol,                 // stop when norm (r-rnew,2) < tol
 	int *iters                  // number of iterations taken
@@ -231,6 +267,13 @@ GrB_Info Pagerank               // GrB_SUCCESS or error condition
 		P [k].page = k ;
 	}
 
+	// only the top ranked pages are required, avoid sorting all pages
+	if(top < n) {
+		_select_top(P, n, top) ;
+		P = rm_realloc(P, top * sizeof(LAGraph_PageRank)) ;
+		n = top ;
+	}
+
 	// qsort (P) in descending order
 	qsort(P, n, sizeof(LAGraph_PageRank), compar) ;
 
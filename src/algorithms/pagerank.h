@@ -34,6 +34,7 @@ GrB_Info Pagerank               // GrB_SUCCESS or error condition
 (
 	LAGraph_PageRank **Phandle, // output: array of LAGraph_PageRank structs
 	GrB_Matrix A,               // binary input graph, not modified
+	GrB_Index top,              // number of top ranked pages to return, top > 0
 	int itermax,                // max number of iterations
 	double tol,                 // stop when norm (r-rnew,2) < tol
 	int *iters                  // number of iterations taken
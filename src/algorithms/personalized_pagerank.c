@@ -0,0 +1,143 @@
+/*
+* Copyright 2018-2021 Redis Labs Ltd. and Contributors
+*
+* This file is available under the Redis Labs Source Available License Agreement
+*/
+
+#include "RG.h"
+#include "personalized_pagerank.h"
+
+// the rank of a node is the probability of a random walk to reside at it
+// at each step a walk either follows one of its node's outgoing edges
+// with probability 'damping' or restarts from a random source
+// walks reaching a node without outgoing edges restart as well
+//
+// r = damping * A' * (r ./ d) + (1 - damping + damping * dangling) * p
+//
+// where d is the out degree of each node, p is uniform over the sources
+// and 'dangling' is the rank held by nodes without outgoing edges
+//
+// all vectors are kept sparse, populated only by nodes reachable from
+// the sources, as such a small neighborhood is ranked quickly
+GrB_Info PersonalizedPageRank
+(
+	GrB_Vector *ranks,
+	const GrB_Matrix A,
+	const GrB_Vector V,
+	const GrB_Index *sources,
+	GrB_Index source_count,
+	double damping,
+	double tol,
+	int max_iter
+) {
+	ASSERT(A       != NULL);
+	ASSERT(V       != NULL);
+	ASSERT(ranks   != NULL);
+	ASSERT(sources != NULL || source_count == 0);
+
+	GrB_Info    info;
+	GrB_Index   n;
+	GrB_Index   p_count;
+	GrB_Vector  p  =  NULL;  // restart distribution
+	GrB_Vector  d  =  NULL;  // out degree
+	GrB_Vector  r  =  NULL;  // ranks
+	GrB_Vector  t  =  NULL;  // next ranks
+	GrB_Vector  w  =  NULL;  // workspace
+
+	info = GrB_Matrix_nrows(&n, A);
+	ASSERT(info == GrB_SUCCESS);
+
+	info = GrB_Vector_new(&p, GrB_FP64, n);
+	ASSERT(info == GrB_SUCCESS);
+	info = GrB_Vector_new(&d, GrB_FP64, n);
+	ASSERT(info == GrB_SUCCESS);
+	info = GrB_Vector_new(&t, GrB_FP64, n);
+	ASSERT(info == GrB_SUCCESS);
+	info = GrB_Vector_new(&w, GrB_FP64, n);
+	ASSERT(info == GrB_SUCCESS);
+
+	// p = uniform distribution over distinct sources
+	for(GrB_Index i = 0; i < source_count; i++) {
+		info = GrB_Vector_setElement_FP64(p, 1, sources[i]);
+		ASSERT(info == GrB_SUCCESS);
+	}
+	info = GrB_Vector_nvals(&p_count, p);
+	ASSERT(info == GrB_SUCCESS);
+	if(p_count > 0) {
+		info = GrB_Vector_assign_FP64(p, p, NULL, 1.0 / p_count, GrB_ALL, n,
+				GrB_DESC_S);
+		ASSERT(info == GrB_SUCCESS);
+	}
+
+	// d(i) = number of outgoing edges of i reaching nodes in V
+	info = GrB_mxv(d, V, NULL, GxB_PLUS_PAIR_FP64, A, V, GrB_DESC_S);
+	ASSERT(info == GrB_SUCCESS);
+
+	// walks start at the sources
+	info = GrB_Vector_dup(&r, p);
+	ASSERT(info == GrB_SUCCESS);
+
+	for(int iter = 0; iter < max_iter && p_count > 0; iter++) {
+		double rsum;
+		double linked;
+		double diff;
+
+		info = GrB_Vector_reduce_FP64(&rsum, NULL, GrB_PLUS_MONOID_FP64, r,
+				NULL);
+		ASSERT(info == GrB_SUCCESS);
+
+		// w = r ./ d, for nodes with outgoing edges
+		info = GrB_Vector_eWiseMult_BinaryOp(w, NULL, NULL, GrB_FIRST_FP64, r,
+				d, GrB_DESC_R);
+		ASSERT(info == GrB_SUCCESS);
+		info = GrB_Vector_reduce_FP64(&linked, NULL, GrB_PLUS_MONOID_FP64, w,
+				NULL);
+		ASSERT(info == GrB_SUCCESS);
+		info = GrB_Vector_eWiseMult_BinaryOp(w, NULL, NULL, GrB_DIV_FP64, w, d,
+				NULL);
+		ASSERT(info == GrB_SUCCESS);
+
+		// t = damping * A' * w
+		info = GrB_vxm(t, V, NULL, GxB_PLUS_FIRST_FP64, w, A, GrB_DESC_RS);
+		ASSERT(info == GrB_SUCCESS);
+		info = GrB_Vector_apply_BinaryOp2nd_FP64(t, NULL, NULL, GrB_TIMES_FP64,
+				t, damping, NULL);
+		ASSERT(info == GrB_SUCCESS);
+
+		// t += restart * p
+		// restarting walks and walks reaching dead ends return to the sources
+		double restart = (1 - damping) * rsum + damping * (rsum - linked);
+		info = GrB_Vector_apply_BinaryOp2nd_FP64(w, NULL, NULL, GrB_TIMES_FP64,
+				p, restart, GrB_DESC_R);
+		ASSERT(info == GrB_SUCCESS);
+		info = GrB_Vector_eWiseAdd_BinaryOp(t, NULL, NULL, GrB_PLUS_FP64, t, w,
+				NULL);
+		ASSERT(info == GrB_SUCCESS);
+
+		// diff = sum(abs(t - r))
+		info = GrB_Vector_eWiseAdd_BinaryOp(w, NULL, NULL, GrB_MINUS_FP64, t, r,
+				GrB_DESC_R);
+		ASSERT(info == GrB_SUCCESS);
+		info = GrB_Vector_apply(w, NULL, NULL, GrB_ABS_FP64, w, NULL);
+		ASSERT(info == GrB_SUCCESS);
+		info = GrB_Vector_reduce_FP64(&diff, NULL, GrB_PLUS_MONOID_FP64, w,
+				NULL);
+		ASSERT(info == GrB_SUCCESS);
+
+		// swap r and t
+		GrB_Vector tmp = r;
+		r = t;
+		t = tmp;
+
+		if(diff < tol) break;
+	}
+
+	GrB_free(&p);
+	GrB_free(&d);
+	GrB_free(&t);
+	GrB_free(&w);
+
+	*ranks = r;
+	return info;
+}
+
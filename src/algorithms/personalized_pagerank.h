@@ -0,0 +1,25 @@
+/*
+* Copyright 2018-2021 Redis Labs Ltd. and Contributors
+*
+* This file is available under the Redis Labs Source Available License Agreement
+*/
+
+#pragma once
+
+#include "../../deps/GraphBLAS/Include/GraphBLAS.h"
+
+// computes personalized pagerank, where random walks restart from
+// the source nodes rather than from any node in the graph
+// only edges connecting nodes in V are considered
+GrB_Info PersonalizedPageRank
+(
+	GrB_Vector *ranks,         // [output] rank of nodes reachable from sources, FP64
+	const GrB_Matrix A,        // input graph, n x n, values are ignored
+	const GrB_Vector V,        // nodes to consider
+	const GrB_Index *sources,  // nodes walks restart from, expected to be in V
+	GrB_Index source_count,    // number of source nodes
+	double damping,            // probability of following an edge
+	double tol,                // stop when sum(abs(r - r_prev)) < tol
+	int max_iter               // maximum number of iterations
+);
+
@@ -0,0 +1,63 @@
+/*
+* Copyright 2018-2021 Redis Labs Ltd. and Contributors
+*
+* This file is available under the Redis Labs Source Available License Agreement
+*/
+
+#include "RG.h"
+#include "undirected.h"
+#include "triangle_count.h"
+
+GrB_Info TriangleCount
+(
+	GrB_Vector *triangles,
+	const GrB_Matrix A,
+	const GrB_Vector V
+) {
+	ASSERT(A         != NULL);
+	ASSERT(V         != NULL);
+	ASSERT(triangles != NULL);
+
+	GrB_Info    info;
+	GrB_Index   n;
+	GrB_Matrix  S  =  NULL;  // undirected structure of A
+	GrB_Matrix  C  =  NULL;  // common neighbors of adjacent nodes
+	GrB_Vector  t  =  NULL;  // triangles per node
+
+	info = Undirected(&S, A, V);
+	ASSERT(info == GrB_SUCCESS);
+
+	info = GrB_Matrix_nrows(&n, S);
+	ASSERT(info == GrB_SUCCESS);
+
+	// C<S> = S * S
+	// C(i,j) is the number of common neighbors of adjacent nodes i and j
+	// each of which closes a triangle
+	info = GrB_Matrix_new(&C, GrB_INT64, n, n);
+	ASSERT(info == GrB_SUCCESS);
+	info = GrB_mxm(C, S, NULL, GxB_PLUS_PAIR_INT64, S, S, GrB_DESC_S);
+	ASSERT(info == GrB_SUCCESS);
+
+	GrB_free(&S);
+
+	// nodes participating in no triangle report 0
+	info = GrB_Vector_new(&t, GrB_INT64, n);
+	ASSERT(info == GrB_SUCCESS);
+	info = GrB_Vector_assign_INT64(t, V, NULL, 0, GrB_ALL, n, GrB_DESC_S);
+	ASSERT(info == GrB_SUCCESS);
+
+	// t(i) = sum(C(i,:)) / 2
+	// as each triangle is counted once for each of i's two edges closing it
+	info = GrB_Matrix_reduce_Monoid(t, NULL, GrB_PLUS_INT64,
+			GrB_PLUS_MONOID_INT64, C, NULL);
+	ASSERT(info == GrB_SUCCESS);
+	info = GrB_Vector_apply_BinaryOp2nd_INT64(t, NULL, NULL, GrB_DIV_INT64, t,
+			2, NULL);
+	ASSERT(info == GrB_SUCCESS);
+
+	GrB_free(&C);
+
+	*triangles = t;
+	return info;
+}
+
@@ -0,0 +1,19 @@
+/*
+* Copyright 2018-2021 Redis Labs Ltd. and Contributors
+*
+* This file is available under the Redis Labs Source Available License Agreement
+*/
+
+#pragma once
+
+#include "../../deps/GraphBLAS/Include/GraphBLAS.h"
+
+// counts the number of triangles each node in V participates in
+// edge direction is ignored and only edges connecting nodes in V are considered
+GrB_Info TriangleCount
+(
+	GrB_Vector *triangles,  // [output] triangles per node in V, INT64
+	const GrB_Matrix A,     // input graph, n x n, values are ignored
+	const GrB_Vector V      // nodes to consider
+);
+
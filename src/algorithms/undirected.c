@@ -0,0 +1,63 @@
+/*
+* Copyright 2018-2021 Redis Labs Ltd. and Contributors
+*
+* This file is available under the Redis Labs Source Available License Agreement
+*/
+
+#include "RG.h"
+#include "undirected.h"
+
+GrB_Info Undirected
+(
+	GrB_Matrix *S,
+	const GrB_Matrix A,
+	const GrB_Vector V
+) {
+	ASSERT(S != NULL);
+	ASSERT(A != NULL);
+	ASSERT(V != NULL);
+
+	GrB_Info    info;
+	GrB_Index   n;
+	GrB_Matrix  _S  =  NULL;
+	GrB_Matrix  D   =  NULL;
+
+	info = GrB_Matrix_nrows(&n, A);
+	ASSERT(info == GrB_SUCCESS);
+
+	info = GrB_Matrix_new(&_S, GrB_BOOL, n, n);
+	ASSERT(info == GrB_SUCCESS);
+
+	// S = A + A'
+	info = GrB_Matrix_eWiseAdd_BinaryOp(_S, NULL, NULL, GxB_PAIR_BOOL, A, A,
+			GrB_DESC_T1);
+	ASSERT(info == GrB_SUCCESS);
+
+	// entries copied from A might have been cast to false
+	info = GrB_Matrix_apply(_S, NULL, NULL, GxB_ONE_BOOL, _S, NULL);
+	ASSERT(info == GrB_SUCCESS);
+
+	// discard self loops
+	info = GxB_Matrix_select(_S, NULL, NULL, GxB_OFFDIAG, _S, NULL, NULL);
+	ASSERT(info == GrB_SUCCESS);
+
+	// S = D * S * D, where D = diag(V)
+	// discarding rows and columns of nodes not in V
+	info = GrB_Matrix_new(&D, GrB_BOOL, n, n);
+	ASSERT(info == GrB_SUCCESS);
+
+	info = GxB_Matrix_diag(D, V, 0, NULL);
+	ASSERT(info == GrB_SUCCESS);
+
+	info = GrB_mxm(_S, NULL, NULL, GxB_ANY_PAIR_BOOL, D, _S, NULL);
+	ASSERT(info == GrB_SUCCESS);
+
+	info = GrB_mxm(_S, NULL, NULL, GxB_ANY_PAIR_BOOL, _S, D, NULL);
+	ASSERT(info == GrB_SUCCESS);
+
+	GrB_free(&D);
+
+	*S = _S;
+	return info;
+}
+
@@ -0,0 +1,20 @@
+/*
+* Copyright 2018-2021 Redis Labs Ltd. and Contributors
+*
+* This file is available under the Redis Labs Source Available License Agreement
+*/
+
+#pragma once
+
+#include "../../deps/GraphBLAS/Include/GraphBLAS.h"
+
+// builds S, the undirected structure of A restricted to the nodes in V
+// S(i,j) = S(j,i) = true if either A(i,j) or A(j,i) exist
+// and both i and j are in V, self loops are discarded
+GrB_Info Undirected
+(
+	GrB_Matrix *S,       // [output] undirected structure, n x n boolean
+	const GrB_Matrix A,  // input graph, n x n, values are ignored
+	const GrB_Vector V   // nodes to consider
+);
+
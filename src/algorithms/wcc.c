@@ -0,0 +1,130 @@
+/*
+* Copyright 2018-2021 Redis Labs Ltd. and Contributors
+*
+* This file is available under the Redis Labs Source Available License Agreement
+*/
+
+#include "RG.h"
+#include "wcc.h"
+#include "../util/rmalloc.h"
+
+// FastSV connected components
+// Zhang, Azad, Hu. "FastSV: A Distributed-Memory Connected Component
+// Algorithm with Fast Convergence", SIAM PP 2020
+//
+// each node maintains a parent pointer f, initially pointing to itself
+// every iteration:
+// 1. mngf(i) = min over neighbors j of i of gf(j), the grandparent of j
+// 2. stochastic hooking:  f(f(i)) = min(f(f(i)), mngf(i))
+// 3. aggressive hooking:  f(i) = min(f(i), mngf(i))
+// 4. shortcutting:        f(i) = min(f(i), gf(i))
+// 5. gf(i) = f(f(i))
+// until gf no longer changes
+//
+// the neighbor reduction is carried out by GraphBLAS
+// while the pointer updates operate on dense arrays
+GrB_Info WCC
+(
+	GrB_Vector *components,
+	const GrB_Matrix A,
+	const GrB_Vector V
+) {
+	ASSERT(A          != NULL);
+	ASSERT(V          != NULL);
+	ASSERT(components != NULL);
+
+	GrB_Info   info;
+	GrB_Index  n;          // matrix dimension
+	GrB_Index  nv;         // number of nodes considered
+	GrB_Vector gfv  = NULL;
+	GrB_Vector mngf = NULL;
+
+	info = GrB_Matrix_nrows(&n, A);
+	ASSERT(info == GrB_SUCCESS);
+	info = GrB_Vector_nvals(&nv, V);
+	ASSERT(info == GrB_SUCCESS);
+
+	GrB_Index *I  = rm_malloc(sizeof(GrB_Index) * nv);  // nodes considered
+	GrB_Index *J  = rm_malloc(sizeof(GrB_Index) * nv);  // mngf indices
+	uint64_t  *X  = rm_malloc(sizeof(uint64_t) * nv);   // mngf values
+	uint64_t  *gf = rm_malloc(sizeof(uint64_t) * nv);   // grandparents, aligned with I
+	uint64_t  *f  = rm_malloc(sizeof(uint64_t) * n);    // parents, indexed by node ID
+
+	info = GrB_Vector_extractTuples_BOOL(I, NULL, &nv, V);
+	ASSERT(info == GrB_SUCCESS);
+
+	// each node is its own parent
+	for(GrB_Index k = 0; k < nv; k++) {
+		f[I[k]] = I[k];
+		gf[k]   = I[k];
+	}
+
+	info = GrB_Vector_new(&gfv, GrB_UINT64, n);
+	ASSERT(info == GrB_SUCCESS);
+	info = GrB_Vector_new(&mngf, GrB_UINT64, n);
+	ASSERT(info == GrB_SUCCESS);
+
+	bool changed = (nv > 0);
+	while(changed) {
+		info = GrB_Vector_clear(gfv);
+		ASSERT(info == GrB_SUCCESS);
+		info = GrB_Vector_build_UINT64(gfv, I, gf, nv, GrB_FIRST_UINT64);
+		ASSERT(info == GrB_SUCCESS);
+
+		// mngf = min over both outgoing and incoming neighbors
+		// gfv is only populated for nodes in V, as such
+		// edges reaching nodes outside of V are ignored
+		info = GrB_mxv(mngf, V, NULL, GrB_MIN_SECOND_SEMIRING_UINT64, A, gfv,
+				GrB_DESC_RS);
+		ASSERT(info == GrB_SUCCESS);
+		info = GrB_mxv(mngf, V, GrB_MIN_UINT64, GrB_MIN_SECOND_SEMIRING_UINT64,
+				A, gfv, GrB_DESC_ST0);
+		ASSERT(info == GrB_SUCCESS);
+
+		GrB_Index m = nv;
+		info = GrB_Vector_extractTuples_UINT64(J, X, &m, mngf);
+		ASSERT(info == GrB_SUCCESS);
+
+		// stochastic and aggressive hooking
+		for(GrB_Index k = 0; k < m; k++) {
+			GrB_Index i = J[k];
+			uint64_t  p = f[i];
+			if(X[k] < f[p]) f[p] = X[k];
+			if(X[k] < f[i]) f[i] = X[k];
+		}
+
+		// shortcutting
+		for(GrB_Index k = 0; k < nv; k++) {
+			GrB_Index i = I[k];
+			if(gf[k] < f[i]) f[i] = gf[k];
+		}
+
+		// compute grandparents
+		changed = false;
+		for(GrB_Index k = 0; k < nv; k++) {
+			uint64_t g = f[f[I[k]]];
+			if(g != gf[k]) {
+				gf[k]   = g;
+				changed = true;
+			}
+		}
+	}
+
+	// once converged, each node's grandparent is its component's root
+	info = GrB_Vector_clear(gfv);
+	ASSERT(info == GrB_SUCCESS);
+	info = GrB_Vector_build_UINT64(gfv, I, gf, nv, GrB_FIRST_UINT64);
+	ASSERT(info == GrB_SUCCESS);
+
+	*components = gfv;
+
+	GrB_free(&mngf);
+	rm_free(I);
+	rm_free(J);
+	rm_free(X);
+	rm_free(f);
+	rm_free(gf);
+
+	return info;
+}
+
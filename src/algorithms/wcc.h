@@ -0,0 +1,20 @@
+/*
+* Copyright 2018-2021 Redis Labs Ltd. and Contributors
+*
+* This file is available under the Redis Labs Source Available License Agreement
+*/
+
+#pragma once
+
+#include "../../deps/GraphBLAS/Include/GraphBLAS.h"
+
+// computes the weakly connected components of the graph
+// edge direction is ignored and only edges connecting nodes in V are considered
+// each node in V is assigned the smallest node ID in its component
+GrB_Info WCC
+(
+	GrB_Vector *components,  // [output] component of each node in V, UINT64
+	const GrB_Matrix A,      // input graph, n x n, values are ignored
+	const GrB_Vector V       // nodes to consider
+);
+
@@ -193,6 +193,12 @@ AggregateResult AGG_COUNT(SIValue *argv, int argc) {
 	return AGGREGATE_OK;
 }
 
+void Aggregate_CountN(AggregateCtx *ctx, int64_t n) {
+	ASSERT(ctx->hashSet == NULL);
+	if(SI_TYPE(ctx->result) == T_NULL) ctx->result = SI_LongVal(0);
+	ctx->result.longval += n;
+}
+
 //------------------------------------------------------------------------------
 // Precentile
 //------------------------------------------------------------------------------
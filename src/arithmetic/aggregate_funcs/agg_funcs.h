@@ -22,3 +22,6 @@ bool Aggregate_PerformsDistinct(AggregateCtx *ctx);
 
 SIValue Aggregate_GetResult(AggregateCtx *ctx);
 
+// increase a non distinct count aggregation by n
+void Aggregate_CountN(AggregateCtx *ctx, int64_t n);
+
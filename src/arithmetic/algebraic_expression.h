@@ -226,6 +226,16 @@ RG_Matrix AlgebraicExpression_Eval
 	RG_Matrix res                   // Result output
 );
 
+// Evaluate expression tree, computing only the entries present in mask
+// entries outside of mask might still be present in the result
+// e.g. when the expression isn't a multiplication
+RG_Matrix AlgebraicExpression_EvalMasked
+(
+	const AlgebraicExpression *exp, // Root node
+	const GrB_Matrix mask,          // Structural mask of result
+	RG_Matrix res                   // Result output
+);
+
 // locates operand based on row,column domain and edge or label
 // sets 'operand' if found otherwise set it to NULL
 // sets 'parent' if requested, parent can still be set to NULL
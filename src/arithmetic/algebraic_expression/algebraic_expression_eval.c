@@ -18,6 +18,7 @@ RG_Matrix _AlgebraicExpression_Eval
 RG_Matrix _Eval_Mul
 (
 	const AlgebraicExpression *exp,
+	const GrB_Matrix mask,
 	RG_Matrix res
 );
 
@@ -39,7 +40,7 @@ RG_Matrix _AlgebraicExpression_Eval
 	case AL_OPERATION:
 		switch(exp->operation.op) {
 		case AL_EXP_MUL:
-			res = _Eval_Mul(exp, res);
+			res = _Eval_Mul(exp, NULL, res);
 			break;
 
 		case AL_EXP_ADD:
@@ -73,3 +74,19 @@ RG_Matrix AlgebraicExpression_Eval
 	return _AlgebraicExpression_Eval(exp, res);
 }
 
+RG_Matrix AlgebraicExpression_EvalMasked
+(
+	const AlgebraicExpression *exp,
+	const GrB_Matrix mask,
+	RG_Matrix res
+) {
+	ASSERT(exp  != NULL);
+	ASSERT(mask != NULL);
+
+	// mask is applied to the expression's final multiplication
+	if(exp->type == AL_OPERATION && exp->operation.op == AL_EXP_MUL) {
+		return _Eval_Mul(exp, mask, res);
+	}
+
+	return _AlgebraicExpression_Eval(exp, res);
+}
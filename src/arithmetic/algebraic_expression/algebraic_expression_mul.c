@@ -11,6 +11,7 @@
 RG_Matrix _Eval_Mul
 (
 	const AlgebraicExpression *exp,
+	const GrB_Matrix mask,
 	RG_Matrix res
 ) {
 	//--------------------------------------------------------------------------
@@ -33,6 +34,12 @@ RG_Matrix _Eval_Mul
 	GrB_Semiring  semiring      =  GxB_ANY_PAIR_BOOL                    ;
 	uint          child_count   =  AlgebraicExpression_ChildCount(exp)  ;
 
+	// locate last multiplied operand, its multiplication is masked
+	uint last = child_count - 1 ;
+	while(last > 0 && CHILD_AT(exp, last)->operand.matrix == IDENTITY_MATRIX) {
+		last-- ;
+	}
+
 	for(uint i = 0; i < child_count; i++) {
 		c = CHILD_AT(exp, i) ;
 		ASSERT(c->type == AL_OPERAND) ;
@@ -49,7 +56,11 @@ RG_Matrix _Eval_Mul
 		}
 
 		// both A and M are valid matrices, perform multiplication
-		info = RG_mxm(res, semiring, A, M) ;
+		if(mask != NULL && i == last) {
+			info = RG_mxm_masked(res, mask, semiring, A, M) ;
+		} else {
+			info = RG_mxm(res, semiring, A, M) ;
+		}
 		res_modified = true ;
 		// setup for next iteration
 		A = res ;
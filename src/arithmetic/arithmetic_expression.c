@@ -76,9 +76,10 @@ bool AR_EXP_IsAttribute(const AR_ExpNode *exp, char **attr) {
 	if(attr != NULL) {
 		AR_ExpNode *r = exp->op.children[1];
 		ASSERT(AR_EXP_IsConstant(r));
-		SIValue v = r->operand.constant;
-		ASSERT(SI_TYPE(v) == T_STRING);
-		*attr = v.stringval;
+		ASSERT(SI_TYPE(r->operand.constant) == T_STRING);
+		// reference the constant held by the node rather than a local copy
+		// as short strings are stored within the SIValue itself
+		*attr = SI_STRINGVAL(r->operand.constant);
 	}
 
 	return true;
@@ -615,7 +616,7 @@ void AR_EXP_CollectAttributes(AR_ExpNode *root, rax *attributes) {
 			ASSERT(AR_EXP_IsConstant(arg));
 			ASSERT(SI_TYPE(arg->operand.constant) == T_STRING);
 
-			const char *attr = arg->operand.constant.stringval;
+			const char *attr = SI_STRINGVAL(arg->operand.constant);
 			raxInsert(attributes, (unsigned char *)attr, strlen(attr), NULL, NULL);
 		}
 
@@ -64,7 +64,7 @@ SIValue AR_HAS_LABELS(SIValue *argv, int argc) {
 			Error_SITypeMismatch(label_value, T_STRING);
 			return SI_NullVal();
 		}
-		char *label = label_value.stringval;
+		char *label = SI_STRINGVAL(label_value);
 		Schema *s = GraphContext_GetSchema(gc, label, SCHEMA_NODE);
 
 		// validate schema exists
@@ -149,7 +149,7 @@ SIValue _AR_NodeDegree(SIValue *argv, int argc, GRAPH_EDGE_DIR dir) {
 	if(argc > 1) {
 		// We're interested in specific relationship type(s).
 		for(int i = 1; i < argc; i++) {
-			const char *label = argv[i].stringval;
+			const char *label = SI_STRINGVAL(argv[i]);
 
 			// Make sure relationship exists.
 			Schema *s = GraphContext_GetSchema(gc, label, SCHEMA_EDGE);
@@ -207,7 +207,7 @@ SIValue AR_PROPERTY(SIValue *argv, int argc) {
 	if(SI_TYPE(obj) & SI_GRAPHENTITY) {
 		// retrieve entity property
 		GraphEntity *graph_entity = (GraphEntity *)obj.ptrval;
-		const char *prop_name     = argv[1].stringval;
+		const char *prop_name     = SI_STRINGVAL(argv[1]);
 		Attribute_ID prop_idx     = argv[2].longval;
 
 		// We have the property string, attempt to look up the index now.
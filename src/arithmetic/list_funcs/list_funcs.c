@@ -272,7 +272,7 @@ SIValue AR_SIZE(SIValue *argv, int argc) {
 	case T_ARRAY:
 		return SI_LongVal(SIArray_Length(value));
 	case T_STRING:
-		return SI_LongVal(strlen(value.stringval));
+		return SI_LongVal(strlen(SI_STRINGVAL(value)));
 	case T_NULL:
 		return SI_NullVal();
 	default:
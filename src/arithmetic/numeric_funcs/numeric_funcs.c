@@ -116,7 +116,7 @@ SIValue AR_TOINTEGER(SIValue *argv, int argc) {
 		return SI_LongVal(floor(arg.doubleval));
 	case T_STRING:
 		errno = 0;
-		double parsedval = strtod(arg.stringval, &sEnd);
+		double parsedval = strtod(SI_STRINGVAL(arg), &sEnd);
 		/* The input was not a complete number or represented a number that
 		 * cannot be represented as a double. */
 		if(sEnd[0] != '\0' || errno == ERANGE) return SI_NullVal();
@@ -18,12 +18,12 @@ SIValue AR_LEFT(SIValue *argv, int argc) {
 	if(SIValue_IsNull(argv[0])) return SI_NullVal();
 
 	int64_t newlen = argv[1].longval;
-	if(strlen(argv[0].stringval) <= newlen) {
+	if(strlen(SI_STRINGVAL(argv[0])) <= newlen) {
 		// No need to truncate this string based on the requested length
-		return SI_DuplicateStringVal(argv[0].stringval);
+		return SI_DuplicateStringVal(SI_STRINGVAL(argv[0]));
 	}
 	char *left_str = rm_malloc((newlen + 1) * sizeof(char));
-	strncpy(left_str, argv[0].stringval, newlen * sizeof(char));
+	strncpy(left_str, SI_STRINGVAL(argv[0]), newlen * sizeof(char));
 	left_str[newlen] = '\0';
 	return SI_TransferStringVal(left_str);
 }
@@ -32,7 +32,7 @@ SIValue AR_LEFT(SIValue *argv, int argc) {
 SIValue AR_LTRIM(SIValue *argv, int argc) {
 	if(SIValue_IsNull(argv[0])) return SI_NullVal();
 
-	char *trimmed = argv[0].stringval;
+	char *trimmed = SI_STRINGVAL(argv[0]);
 
 	while(*trimmed == ' ') {
 		trimmed ++;
@@ -46,20 +46,20 @@ SIValue AR_RIGHT(SIValue *argv, int argc) {
 	if(SIValue_IsNull(argv[0])) return SI_NullVal();
 
 	int64_t newlen = argv[1].longval;
-	int64_t start = strlen(argv[0].stringval) - newlen;
+	int64_t start = strlen(SI_STRINGVAL(argv[0])) - newlen;
 
 	if(start <= 0) {
 		// No need to truncate this string based on the requested length
-		return SI_DuplicateStringVal(argv[0].stringval);
+		return SI_DuplicateStringVal(SI_STRINGVAL(argv[0]));
 	}
-	return SI_DuplicateStringVal(argv[0].stringval + start);
+	return SI_DuplicateStringVal(SI_STRINGVAL(argv[0]) + start);
 }
 
 // returns the original string with trailing whitespace removed.
 SIValue AR_RTRIM(SIValue *argv, int argc) {
 	if(SIValue_IsNull(argv[0])) return SI_NullVal();
 
-	char *str = argv[0].stringval;
+	char *str = SI_STRINGVAL(argv[0]);
 
 	size_t i = strlen(str);
 	while(i > 0 && str[i - 1] == ' ') {
@@ -82,7 +82,7 @@ SIValue AR_REVERSE(SIValue *argv, int argc) {
 	SIValue value = argv[0];
 	if(SI_TYPE(value) == T_STRING) {
 		// string reverse
-		char *str = value.stringval;
+		char *str = SI_STRINGVAL(value);
 		size_t str_len = strlen(str);
 		char *reverse = rm_malloc((str_len + 1) * sizeof(char));
 
@@ -113,7 +113,7 @@ SIValue AR_SUBSTRING(SIValue *argv, int argc) {
 	*/
 	if(SIValue_IsNull(argv[0])) return SI_NullVal();
 
-	char *original = argv[0].stringval;
+	char *original = SI_STRINGVAL(argv[0]);
 	int64_t original_len = strlen(original);
 	int64_t start = argv[1].longval;
 	int64_t length;
@@ -143,7 +143,7 @@ SIValue AR_SUBSTRING(SIValue *argv, int argc) {
 // returns the original string in lowercase.
 SIValue AR_TOLOWER(SIValue *argv, int argc) {
 	if(SIValue_IsNull(argv[0])) return SI_NullVal();
-	char *original = argv[0].stringval;
+	char *original = SI_STRINGVAL(argv[0]);
 	size_t lower_len = strlen(original);
 	char *lower = rm_malloc((lower_len + 1) * sizeof(char));
 	str_tolower(original, lower, &lower_len);
@@ -153,7 +153,7 @@ SIValue AR_TOLOWER(SIValue *argv, int argc) {
 // returns the original string in uppercase.
 SIValue AR_TOUPPER(SIValue *argv, int argc) {
 	if(SIValue_IsNull(argv[0])) return SI_NullVal();
-	char *original = argv[0].stringval;
+	char *original = SI_STRINGVAL(argv[0]);
 	size_t upper_len = strlen(original);
 	char *upper = rm_malloc((upper_len + 1) * sizeof(char));
 	str_toupper(original, upper, &upper_len);
@@ -190,8 +190,8 @@ SIValue AR_CONTAINS(SIValue *argv, int argc) {
 	// No string contains null.
 	if(SIValue_IsNull(argv[0]) || SIValue_IsNull(argv[1])) return SI_NullVal();
 
-	const char *hay = argv[0].stringval;
-	const char *needle = argv[1].stringval;
+	const char *hay = SI_STRINGVAL(argv[0]);
+	const char *needle = SI_STRINGVAL(argv[1]);
 
 	// See if needle is in hay.
 	bool found = (strstr(hay, needle) != NULL);
@@ -203,8 +203,8 @@ SIValue AR_STARTSWITH(SIValue *argv, int argc) {
 	// No string contains null.
 	if(SIValue_IsNull(argv[0]) || SIValue_IsNull(argv[1])) return SI_NullVal();
 
-	const char *str = argv[0].stringval;
-	const char *sub_string = argv[1].stringval;
+	const char *str = SI_STRINGVAL(argv[0]);
+	const char *sub_string = SI_STRINGVAL(argv[1]);
 	size_t str_len = strlen(str);
 	size_t sub_string_len = strlen(sub_string);
 
@@ -224,8 +224,8 @@ SIValue AR_ENDSWITH(SIValue *argv, int argc) {
 	// No string contains null.
 	if(SIValue_IsNull(argv[0]) || SIValue_IsNull(argv[1])) return SI_NullVal();
 
-	const char *str = argv[0].stringval;
-	const char *sub_string = argv[1].stringval;
+	const char *str = SI_STRINGVAL(argv[0]);
+	const char *sub_string = SI_STRINGVAL(argv[1]);
 	size_t str_len = strlen(str);
 	size_t sub_string_len = strlen(sub_string);
 
@@ -254,9 +254,9 @@ SIValue AR_REPLACE(SIValue *argv, int argc) {
 	// argv[0] is the original string to be manipulated
 	// argv[1] is the search sub string to be replaced
 	// argv[2] is the string to be replaced with
-	const char *str            =  argv[0].stringval;
-	const char *old_string     =  argv[1].stringval;
-	const char *new_string     =  argv[2].stringval;
+	const char *str            =  SI_STRINGVAL(argv[0]);
+	const char *old_string     =  SI_STRINGVAL(argv[1]);
+	const char *new_string     =  SI_STRINGVAL(argv[2]);
 	size_t      str_len        =  strlen(str);
 	size_t      old_string_len =  strlen(old_string);
 	size_t      new_string_len =  strlen(new_string);
@@ -78,7 +78,14 @@ static void _AST_Extract_Params(const cypher_parse_result_t *parse_result) {
 	const cypher_astnode_t *statement = _AST_parse_result_root(parse_result);
 	uint noptions = cypher_ast_statement_noptions(statement);
 	if(noptions == 0) return;
-	rax *params = raxNew();
+
+	// binary parameters may have been decoded already
+	rax *params = QueryCtx_GetParams();
+	if(params == NULL) {
+		params = raxNew();
+		QueryCtx_SetParams(params);
+	}
+
 	for(uint i = 0; i < noptions; i++) {
 		const cypher_astnode_t *option = cypher_ast_statement_get_option(statement, i);
 		uint nparams = cypher_ast_cypher_option_nparams(option);
@@ -87,11 +94,12 @@ static void _AST_Extract_Params(const cypher_parse_result_t *parse_result) {
 			const char *paramName = cypher_ast_string_get_value(cypher_ast_cypher_option_param_get_name(param));
 			const cypher_astnode_t *paramValue = cypher_ast_cypher_option_param_get_value(param);
 			AR_ExpNode *exp = AR_EXP_FromASTNode(paramValue);
-			raxInsert(params, (unsigned char *) paramName, strlen(paramName), (void *)exp, NULL);
+			AR_ExpNode *replaced = NULL;
+			raxInsert(params, (unsigned char *) paramName, strlen(paramName), (void *)exp,
+					  (void **)&replaced);
+			if(replaced != NULL) AR_EXP_Free(replaced);
 		}
 	}
-	// Add the parameters map to the QueryCtx.
-	QueryCtx_SetParams(params);
 }
 
 static void AST_IncreaseRefCount(AST *ast) {
@@ -224,10 +224,14 @@ static int _BulkInsert_ProcessNodeFile
     // load nodes
     //--------------------------------------------------------------------------
 
+	// IDs of created nodes, labeled in bulk once all nodes are loaded
+	NodeID* ids = array_new(NodeID, 0);
+
 	while (data_idx < data_len) {
 		Node n;
 		GraphEntity* ge;
-		Graph_CreateNode(gc->g, &n, label_ids, label_count);
+		Graph_CreateNode(gc->g, &n, NULL, 0);
+		array_append(ids, ENTITY_GET_ID(&n));
 		ge = (GraphEntity*)&n;
 		// process entity attributes
 		for (uint i = 0; i < prop_count; i++) {
@@ -235,10 +239,13 @@ static int _BulkInsert_ProcessNodeFile
 			// skip invalid attribute values
 			if (!(SI_TYPE(value) & SI_VALID_PROPERTY_VALUE))
 				continue;
-			GraphEntity_AddProperty(ge, prop_indices[i], value);
+			GraphEntity_AddProperty(ge, prop_indices[i], value, gc->g->string_pool);
 		}
 	}
 
+	Graph_LabelNodes(gc->g, ids, array_len(ids), label_ids, label_count);
+	array_free(ids);
+
     Graph_SetMatrixPolicy(gc->g, SYNC_POLICY_RESIZE);
     if (prop_indices) rm_free(prop_indices);
     array_free(label_ids);
@@ -300,7 +307,7 @@ static int _BulkInsert_ProcessEdgeFile
 				continue;
 			}
 
-			GraphEntity_AddProperty(ge, prop_indices[i], value);
+			GraphEntity_AddProperty(ge, prop_indices[i], value, gc->g->string_pool);
 		}
 	}
 
@@ -0,0 +1,216 @@
+/*
+* Copyright 2018-2021 Redis Labs Ltd. and Contributors
+*
+* This file is available under the Redis Labs Source Available License Agreement
+*/
+
+#include "RG.h"
+#include <endian.h>
+#include "binary_params.h"
+#include "../errors.h"
+#include "../query_ctx.h"
+#include "../util/arr.h"
+#include "../datatypes/map.h"
+#include "../datatypes/array.h"
+#include "../arithmetic/arithmetic_expression.h"
+
+// max nesting depth of arrays and maps
+#define BINARY_PARAMS_MAX_DEPTH 64
+
+typedef struct {
+	const char *data;  // binary parameters
+	size_t len;        // length of data
+	size_t pos;        // current read position
+} BinaryParamsReader;
+
+static inline bool _ReadBytes
+(
+	BinaryParamsReader *reader,
+	void *dest,
+	size_t n
+) {
+	if(reader->len - reader->pos < n) return false;
+	memcpy(dest, reader->data + reader->pos, n);
+	reader->pos += n;
+	return true;
+}
+
+// read a 4-byte little-endian unsigned integer
+static inline bool _ReadUInt32
+(
+	BinaryParamsReader *reader,
+	uint32_t *n
+) {
+	uint32_t le;
+	if(!_ReadBytes(reader, &le, sizeof(le))) return false;
+	*n = le32toh(le);
+	return true;
+}
+
+// read an 8-byte little-endian unsigned integer
+static inline bool _ReadUInt64
+(
+	BinaryParamsReader *reader,
+	uint64_t *n
+) {
+	uint64_t le;
+	if(!_ReadBytes(reader, &le, sizeof(le))) return false;
+	*n = le64toh(le);
+	return true;
+}
+
+// read a null-terminated string, the returned string references 'data'
+static const char *_ReadString
+(
+	BinaryParamsReader *reader
+) {
+	const char *s = reader->data + reader->pos;
+	const char *end = memchr(s, '\0', reader->len - reader->pos);
+	if(end == NULL) return NULL;
+
+	reader->pos += (end - s) + 1;
+	return s;
+}
+
+// read a container's length, each of its elements is encoded in
+// at least one byte, which bounds the length by the remaining data
+static bool _ReadLength
+(
+	BinaryParamsReader *reader,
+	uint32_t *len
+) {
+	uint64_t u;
+	if(!_ReadUInt64(reader, &u)) return false;
+	int64_t n = (int64_t)u;
+	if(n < 0 || (uint64_t)n > reader->len - reader->pos) return false;
+	if(n > UINT32_MAX) return false;
+
+	*len = n;
+	return true;
+}
+
+// read an SIValue from 'reader'
+// the returned value owns its allocations
+static bool _ReadValue
+(
+	BinaryParamsReader *reader,
+	SIValue *v,
+	uint depth
+) {
+	uint8_t b;
+	double d;
+	uint64_t u;
+	uint32_t len;
+	const char *s;
+	uint8_t t;
+
+	if(depth > BINARY_PARAMS_MAX_DEPTH) return false;
+	if(!_ReadBytes(reader, &t, sizeof(t))) return false;
+
+	switch(t) {
+		case BINARY_PARAM_NULL:
+			*v = SI_NullVal();
+			return true;
+
+		case BINARY_PARAM_BOOL:
+			if(!_ReadBytes(reader, &b, sizeof(b))) return false;
+			*v = SI_BoolVal(b != 0);
+			return true;
+
+		case BINARY_PARAM_DOUBLE:
+			// IEEE 754 bit pattern, byte swapped as an integer
+			if(!_ReadUInt64(reader, &u)) return false;
+			memcpy(&d, &u, sizeof(d));
+			*v = SI_DoubleVal(d);
+			return true;
+
+		case BINARY_PARAM_LONG:
+			if(!_ReadUInt64(reader, &u)) return false;
+			*v = SI_LongVal((int64_t)u);
+			return true;
+
+		case BINARY_PARAM_STRING:
+			s = _ReadString(reader);
+			if(s == NULL) return false;
+			*v = SI_DuplicateStringVal(s);
+			return true;
+
+		case BINARY_PARAM_ARRAY:
+			if(!_ReadLength(reader, &len)) return false;
+			*v = SIArray_New(len);
+			for(uint32_t j = 0; j < len; j++) {
+				SIValue elem;
+				if(!_ReadValue(reader, &elem, depth + 1)) {
+					SIValue_Free(*v);
+					return false;
+				}
+				// hand element over to the array, sparing SIArray_Append's clone
+				array_append(v->array, elem);
+			}
+			return true;
+
+		case BINARY_PARAM_MAP:
+			if(!_ReadLength(reader, &len)) return false;
+			*v = Map_New(len);
+			for(uint32_t j = 0; j < len; j++) {
+				SIValue val;
+				s = _ReadString(reader);
+				if(s == NULL || !_ReadValue(reader, &val, depth + 1)) {
+					SIValue_Free(*v);
+					return false;
+				}
+				// hand value over to the map, sparing Map_Add's clone
+				SIValue key = SI_ConstStringVal(s);
+				Map_Remove(*v, key);
+				Pair pair = {.key = SI_DuplicateStringVal(s), .val = val};
+				array_append(v->map, pair);
+			}
+			return true;
+
+		default:
+			return false;
+	}
+}
+
+bool BinaryParams_Decode
+(
+	const char *data,
+	size_t len
+) {
+	ASSERT(data != NULL);
+
+	uint32_t count;
+	BinaryParamsReader reader = {.data = data, .len = len, .pos = 0};
+
+	if(!_ReadUInt32(&reader, &count)) goto error;
+
+	rax *params = QueryCtx_GetParams();
+	if(params == NULL) {
+		params = raxNew();
+		QueryCtx_SetParams(params);
+	}
+
+	for(uint32_t i = 0; i < count; i++) {
+		SIValue v;
+		const char *name = _ReadString(&reader);
+		if(name == NULL || !_ReadValue(&reader, &v, 0)) goto error;
+
+		// a parameter specified more than once takes its last value
+		AR_ExpNode *exp = AR_EXP_NewConstOperandNode(v);
+		AR_ExpNode *replaced = NULL;
+		raxInsert(params, (unsigned char *)name, strlen(name), exp,
+				(void **)&replaced);
+		if(replaced != NULL) AR_EXP_Free(replaced);
+	}
+
+	// trailing data
+	if(reader.pos != reader.len) goto error;
+
+	return true;
+
+error:
+	ErrorCtx_SetError("Error: malformed binary parameters at offset %zu",
+			reader.pos);
+	return false;
+}
+
@@ -0,0 +1,55 @@
+/*
+* Copyright 2018-2021 Redis Labs Ltd. and Contributors
+*
+* This file is available under the Redis Labs Source Available License Agreement
+*/
+
+#pragma once
+
+#include <stddef.h>
+#include <stdbool.h>
+
+// query parameters may be passed to GRAPH.QUERY in binary form
+// following the PARAMS keyword, sparing the parsing of a textual
+// CYPHER p1=... p2=... prefix
+//
+// GRAPH.QUERY <graph> <query> PARAMS <binary parameters>
+//
+// binary parameters format:
+// - parameter count : 4-byte unsigned integer
+// [0..parameter_count]
+//   - parameter name  : null-terminated C string
+//   - parameter value : encoded value
+//
+// encoded value format:
+// - value type : 1-byte integer corresponding to the BinaryParamType enum
+// - nothing if type is null
+// - 1-byte true/false if type is boolean
+// - 8-byte double if type is double
+// - 8-byte integer if type is integer
+// - null-terminated C string if type is string
+// - 8-byte array length followed by N values if type is array
+// - 8-byte key count followed by N key/value pairs if type is map
+//   where each key is a null-terminated C string
+//
+// numbers are encoded in little-endian byte order regardless of the host,
+// doubles as their IEEE 754 bit pattern; this format is also what gets
+// replicated, byte for byte, alongside the query
+typedef enum {
+	BINARY_PARAM_NULL   = 0,
+	BINARY_PARAM_BOOL   = 1,
+	BINARY_PARAM_DOUBLE = 2,
+	BINARY_PARAM_STRING = 3,
+	BINARY_PARAM_LONG   = 4,
+	BINARY_PARAM_ARRAY  = 5,
+	BINARY_PARAM_MAP    = 6,
+} BinaryParamType;
+
+// decode binary parameters into the query context's parameters map
+// returns false and sets a query error if 'data' is malformed
+bool BinaryParams_Decode
+(
+	const char *data,  // binary parameters
+	size_t len         // length of data in bytes
+);
+
@@ -22,19 +22,24 @@ CommandCtx *CommandCtx_New
 	RedisModuleBlockedClient *bc,
 	RedisModuleString *cmd_name,
 	RedisModuleString *query,
+	RedisModuleString *params,
 	GraphContext *graph_ctx,
 	ExecutorThread thread,
 	bool replicated_command,
 	bool compact,
-	long long timeout
+	long long timeout,
+	thpool_priority priority
 ) {
 	CommandCtx *context = rm_malloc(sizeof(CommandCtx));
 	context->bc = bc;
 	context->ctx = ctx;
 	context->query = NULL;
+	context->binary_params = NULL;
+	context->binary_params_len = 0;
 	context->thread = thread;
 	context->compact = compact;
 	context->timeout = timeout;
+	context->priority = priority;
 	context->command_name = NULL;
 	context->graph_ctx = graph_ctx;
 	context->replicated_command = replicated_command;
@@ -51,6 +56,15 @@ CommandCtx *CommandCtx_New
 		context->query = rm_strdup(q);
 	}
 
+	if(params) {
+		// Make a copy of binary parameters.
+		size_t len;
+		const char *p = RedisModule_StringPtrLen(params, &len);
+		context->binary_params = rm_malloc(len);
+		context->binary_params_len = len;
+		memcpy(context->binary_params, p, len);
+	}
+
 	return context;
 }
 
@@ -115,6 +129,12 @@ const char *CommandCtx_GetQuery(const CommandCtx *command_ctx) {
 	return command_ctx->query;
 }
 
+const char *CommandCtx_GetBinaryParams(const CommandCtx *command_ctx, size_t *len) {
+	ASSERT(command_ctx != NULL);
+	if(len) *len = command_ctx->binary_params_len;
+	return command_ctx->binary_params;
+}
+
 void CommandCtx_ThreadSafeContextLock(const CommandCtx *command_ctx) {
 	/* Acquire lock only when working with a blocked client
 	 * otherwise we're running on Redis main thread,
@@ -142,6 +162,7 @@ void CommandCtx_Free(CommandCtx *command_ctx) {
 	CommandCtx_UntrackCtx(command_ctx);
 
 	if(command_ctx->query) rm_free(command_ctx->query);
+	if(command_ctx->binary_params) rm_free(command_ctx->binary_params);
 	rm_free(command_ctx->command_name);
 	rm_free(command_ctx);
 }
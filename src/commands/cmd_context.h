@@ -9,6 +9,7 @@
 #include "cypher-parser.h"
 #include "../redismodule.h"
 #include "../graph/graphcontext.h"
+#include "../util/thpool/pools.h"
 
 // ExecutorThread lists the diffrent types of threads in the system
 typedef enum {
@@ -20,6 +21,8 @@ typedef enum {
 /* Query context, used for concurent query processing. */
 typedef struct {
 	char *query;                    // Query string.
+	char *binary_params;            // Binary query parameters, if specified.
+	size_t binary_params_len;       // Length of binary query parameters.
 	RedisModuleCtx *ctx;            // Redis module context.
 	char *command_name;             // Command to execute.
 	GraphContext *graph_ctx;        // Graph context.
@@ -28,6 +31,7 @@ typedef struct {
 	bool compact;                   // Whether this query was issued with the compact flag.
 	ExecutorThread thread;          // Which thread executes this command
 	long long timeout;              // The query timeout, if specified.
+	thpool_priority priority;       // The query scheduling priority.
 } CommandCtx;
 
 // Create a new command context.
@@ -37,11 +41,13 @@ CommandCtx *CommandCtx_New
 	RedisModuleBlockedClient *bc,   // Blocked client.
 	RedisModuleString *cmd_name,    // Command to execute.
 	RedisModuleString *query,       // Query string.
+	RedisModuleString *params,      // Binary query parameters, optional.
 	GraphContext *graph_ctx,        // Graph context.
 	ExecutorThread thread,          // Which thread executes this command
 	bool replicated_command,        // Whether this instance was spawned by a replication command.
 	bool compact,                   // Whether this query was issued with the compact flag.
-	long long timeout               // The query timeout, if specified.
+	long long timeout,              // The query timeout, if specified.
+	thpool_priority priority        // The query scheduling priority.
 );
 
 // Tracks given 'ctx' such that in case of a crash we will be able to report
@@ -80,6 +86,13 @@ const char *CommandCtx_GetQuery
 	const CommandCtx *command_ctx
 );
 
+// Get binary query parameters, NULL if none were specified.
+const char *CommandCtx_GetBinaryParams
+(
+	const CommandCtx *command_ctx,
+	size_t *len
+);
+
 // Acquire Redis global lock.
 void CommandCtx_ThreadSafeContextLock
 (
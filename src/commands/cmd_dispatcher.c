@@ -15,15 +15,35 @@
 // Command handler function pointer.
 typedef void(*Command_Handler)(void *args);
 
+// Parse query priority, returning false if 'arg' isn't a known priority.
+static bool _parse_priority(const char *arg, thpool_priority *priority) {
+	if(!strcasecmp(arg, "high")) {
+		*priority = THPOOL_PRIORITY_HIGH;
+	} else if(!strcasecmp(arg, "normal")) {
+		*priority = THPOOL_PRIORITY_NORMAL;
+	} else if(!strcasecmp(arg, "low")) {
+		*priority = THPOOL_PRIORITY_LOW;
+	} else {
+		return false;
+	}
+	return true;
+}
+
 // Read configuration flags, returning REDIS_MODULE_ERR if flag parsing failed.
 static int _read_flags(RedisModuleString **argv, int argc, bool *compact,
-					   long long *timeout, uint *graph_version, char **errmsg) {
+					   long long *timeout, uint *graph_version,
+					   thpool_priority *priority, RedisModuleString **params,
+					   char **errmsg) {
 
 	ASSERT(compact);
 	ASSERT(timeout);
+	ASSERT(priority);
+	ASSERT(params);
 
 	// set defaults
 	*compact = false;  // verbose
+	*params = NULL;
+	*priority = THPOOL_PRIORITY_NORMAL;
 	*graph_version = GRAPH_VERSION_MISSING;
 	Config_Option_get(Config_TIMEOUT, timeout);
 
@@ -72,6 +92,35 @@ static int _read_flags(RedisModuleString **argv, int argc, bool *compact,
 				asprintf(errmsg, "Failed to parse query timeout value");
 				return REDISMODULE_ERR;
 			}
+
+			continue;
+		}
+
+		// binary query parameters
+		if(!strcasecmp(arg, "params")) {
+			if(i == argc - 1) {
+				asprintf(errmsg, "Failed to parse query parameters, missing value");
+				return REDISMODULE_ERR;
+			}
+			i++; // Set the current argument to the parameters value.
+			*params = argv[i];
+			continue;
+		}
+
+		// query priority
+		if(!strcasecmp(arg, "priority")) {
+			bool parsed = false;
+			if(i < argc - 1) {
+				i++; // Set the current argument to the priority value.
+				const char *value = RedisModule_StringPtrLen(argv[i], NULL);
+				parsed = _parse_priority(value, priority);
+			}
+
+			// Emit error on missing or unknown priority values.
+			if(!parsed) {
+				asprintf(errmsg, "Failed to parse query priority value, expecting HIGH, NORMAL or LOW");
+				return REDISMODULE_ERR;
+			}
 		}
 	}
 	return REDISMODULE_OK;
@@ -99,7 +148,7 @@ static inline bool _validate_command_arity(GRAPH_Commands cmd, int arity) {
 		case CMD_EXPLAIN:
 		case CMD_PROFILE:
 			// Expect a command, graph name, a query, and optional config flags.
-			return arity >= 3 && arity <= 8;
+			return arity >= 3 && arity <= 12;
 		case CMD_SLOWLOG:
 			// Expect just a command and graph name.
 			return arity == 2;
@@ -160,6 +209,8 @@ int CommandDispatch(RedisModuleCtx *ctx, RedisModuleString **argv, int argc) {
 	bool compact;
 	uint version;
 	long long timeout;
+	thpool_priority priority;
+	RedisModuleString *params;
 	CommandCtx *context = NULL;
 
 	RedisModuleString *graph_name = argv[1];
@@ -170,7 +221,8 @@ int CommandDispatch(RedisModuleCtx *ctx, RedisModuleString **argv, int argc) {
 	if(_validate_command_arity(cmd, argc) == false) return RedisModule_WrongArity(ctx);
 
 	// parse additional arguments
-	int res = _read_flags(argv, argc, &compact, &timeout, &version, &errmsg);
+	int res = _read_flags(argv, argc, &compact, &timeout, &version, &priority,
+			&params, &errmsg);
 	if(res == REDISMODULE_ERR) {
 		// emit error and exit if argument parsing failed
 		RedisModule_ReplyWithError(ctx, errmsg);
@@ -208,16 +260,19 @@ int CommandDispatch(RedisModuleCtx *ctx, RedisModuleString **argv, int argc) {
 	Command_Handler handler = get_command_handler(cmd);
 	if(exec_thread == EXEC_THREAD_MAIN) {
 		// run query on Redis main thread
-		context = CommandCtx_New(ctx, NULL, argv[0], query, gc, exec_thread,
-								 is_replicated, compact, timeout);
+		context = CommandCtx_New(ctx, NULL, argv[0], query, params, gc, exec_thread,
+								 is_replicated, compact, timeout, priority);
 		handler(context);
 	} else {
 		// run query on a dedicated thread
 		RedisModuleBlockedClient *bc = RedisModule_BlockClient(ctx, NULL, NULL, NULL, 0);
-		context = CommandCtx_New(NULL, bc, argv[0], query, gc, exec_thread,
-								 is_replicated, compact, timeout);
+		context = CommandCtx_New(NULL, bc, argv[0], query, params, gc, exec_thread,
+								 is_replicated, compact, timeout, priority);
 
-		if(ThreadPools_AddWorkReader(handler, context) == THPOOL_QUEUE_FULL) {
+		// queries are queued per graph, such that a burst of queries against
+		// one graph won't delay queries issued against other graphs
+		if(ThreadPools_AddWorkReader(handler, context, priority, gc) ==
+		   THPOOL_QUEUE_FULL) {
 			// Report an error once our workers thread pool internal queue
 			// is full, this error usually happens when the server is
 			// under heavy load and is unable to catch up
@@ -6,6 +6,7 @@
 
 #include "../errors.h"
 #include "cmd_context.h"
+#include "binary_params.h"
 #include "../query_ctx.h"
 #include "execution_ctx.h"
 #include "../index/index.h"
@@ -39,6 +40,12 @@ void Graph_Explain(void *args) {
 	 * 2. Whether these items were cached or not */
 	bool           cached     =  false;
 	ExecutionPlan  *plan      =  NULL;
+
+	// decode binary query parameters
+	size_t params_len;
+	const char *params = CommandCtx_GetBinaryParams(command_ctx, &params_len);
+	if(params != NULL && !BinaryParams_Decode(params, params_len)) goto cleanup;
+
 	exec_ctx  =  ExecutionCtx_FromQuery(command_ctx->query);
 	if(exec_ctx == NULL) goto cleanup;
 
@@ -7,17 +7,32 @@
 #include "RG.h"
 #include "../errors.h"
 #include "cmd_context.h"
+#include "binary_params.h"
 #include "../ast/ast.h"
 #include "../util/arr.h"
 #include "../util/cron.h"
 #include "../query_ctx.h"
 #include "../graph/graph.h"
 #include "../util/rmalloc.h"
+#include "../util/simple_timer.h"
 #include "../util/cache/cache.h"
 #include "../util/thpool/pools.h"
+#include "../configuration/config.h"
 #include "../execution_plan/execution_plan.h"
 #include "execution_ctx.h"
 
+// estimated number of processed records above which a read query is
+// considered expensive and is scheduled behind other queries
+#define EXPENSIVE_QUERY_COST 1000000
+
+// max number of write queries committed as a single group
+#define GROUP_COMMIT_MAX_QUERIES 256
+
+// max duration in milliseconds a group holds its locks
+// once elapsed, the locks are released and reacquired for the rest of
+// the group, letting the main thread and readers through
+#define GROUP_COMMIT_MAX_HOLD_MS 10
+
 // GraphQueryCtx stores the allocations required to execute a query.
 typedef struct {
 	GraphContext *graph_ctx;  // graph context
@@ -27,7 +42,7 @@ typedef struct {
 	CommandCtx *command_ctx;  // command context
 	bool readonly_query;      // read only query
 	bool profile;             // profile query
-	CronTaskHandle timeout;   // timeout cron task
+	bool migrated;            // query migrated to a different thread
 } GraphQueryCtx;
 
 static GraphQueryCtx *GraphQueryCtx_New
@@ -37,8 +52,7 @@ static GraphQueryCtx *GraphQueryCtx_New
 	ExecutionCtx *exec_ctx,
 	CommandCtx *command_ctx,
 	bool readonly_query,
-	bool profile,
-	CronTaskHandle timeout
+	bool profile
 ) {
 	GraphQueryCtx *ctx = rm_malloc(sizeof(GraphQueryCtx));
 
@@ -49,7 +63,7 @@ static GraphQueryCtx *GraphQueryCtx_New
 	ctx->command_ctx     =  command_ctx;
 	ctx->readonly_query  =  readonly_query;
 	ctx->profile         =  profile;
-	ctx->timeout         =  timeout;
+	ctx->migrated        =  false;
 
 	return ctx;
 }
@@ -130,23 +144,6 @@ static void _index_operation(RedisModuleCtx *ctx, GraphContext *gc, AST *ast,
 	}
 }
 
-//------------------------------------------------------------------------------
-// Query timeout
-//------------------------------------------------------------------------------
-
-// timeout handler
-void QueryTimedOut(void *pdata) {
-	ASSERT(pdata != NULL);
-	ExecutionPlan *plan = (ExecutionPlan *)pdata;
-	ExecutionPlan_Drain(plan);
-}
-
-// set timeout for query execution
-CronTaskHandle Query_SetTimeOut(uint timeout, ExecutionPlan *plan) {
-	// increase execution plan ref count
-	return Cron_AddTask(timeout, QueryTimedOut, plan);
-}
-
 inline static bool _readonly_cmd_mode(CommandCtx *ctx) {
 	return strcasecmp(CommandCtx_GetCommandName(ctx), "graph.RO_QUERY") == 0;
 }
@@ -169,9 +166,9 @@ static void _ExecuteQuery(void *args) {
 	ExecutionPlan   *plan         =  exec_ctx->plan;
 	ExecutionType   exec_type     =  exec_ctx->exec_type;
 
-	// if we have migrated to a writer thread,
+	// if we have migrated to a different thread,
 	// update thread-local storage and track the CommandCtx
-	if(command_ctx->thread == EXEC_THREAD_WRITER) {
+	if(gq_ctx->migrated) {
 		QueryCtx_SetTLS(query_ctx);
 		CommandCtx_TrackCtx(command_ctx);
 	}
@@ -195,11 +192,16 @@ static void _ExecuteQuery(void *args) {
 		/* if this is a writer query `we need to re-open the graph key with write flag
 		 * this notifies Redis that the key is "dirty" any watcher on that key will
 		 * be notified */
-		CommandCtx_ThreadSafeContextLock(command_ctx);
-		{
+		if(QueryCtx_InGroupCommit()) {
+			// GIL is already held by the group commit
 			GraphContext_MarkWriter(rm_ctx, gc);
+		} else {
+			CommandCtx_ThreadSafeContextLock(command_ctx);
+			{
+				GraphContext_MarkWriter(rm_ctx, gc);
+			}
+			CommandCtx_ThreadSafeContextUnlock(command_ctx);
 		}
-		CommandCtx_ThreadSafeContextUnlock(command_ctx);
 	}
 
 	if(exec_type == EXECUTION_TYPE_QUERY) {  // query operation
@@ -216,11 +218,9 @@ static void _ExecuteQuery(void *args) {
 			result_set = ExecutionPlan_Execute(plan);
 		}
 
-		// abort timeout if set
-		if(gq_ctx->timeout != 0) Cron_AbortTask(gq_ctx->timeout);
-
 		// emit error if query timed out
-		if(ExecutionPlan_Drained(plan)) ErrorCtx_SetError("Query timed out");
+		// pending changes of a cancelled write query are discarded
+		if(!QueryCtx_Complete()) ErrorCtx_SetError("Query timed out");
 
 		ExecutionPlan_Free(plan);
 		exec_ctx->plan = NULL;
@@ -256,6 +256,145 @@ static void _ExecuteQuery(void *args) {
 	GraphQueryCtx_Free(gq_ctx);
 }
 
+//------------------------------------------------------------------------------
+// Group commit
+//------------------------------------------------------------------------------
+
+// write queries to the same graph awaiting to be committed as a group
+typedef struct {
+	uint64_t id;               // unique group ID
+	int db;                    // database holding the graph key
+	GraphContext *gc;          // graph written to
+	GraphQueryCtx **queries;   // queued write queries
+	thpool_priority priority;  // priority of the group's first query
+} WriteGroup;
+
+static WriteGroup **_write_groups = NULL;  // open groups, at most one per graph
+static uint64_t _write_group_id = 0;       // ID of the next opened group
+static pthread_mutex_t _write_groups_lock = PTHREAD_MUTEX_INITIALIZER;
+
+// executes a group of write queries back to back on the writer thread
+// under a single acquisition of the GIL, graph key and graph write lock
+// queries execute in full while the locks are held, as each query must
+// observe the changes committed by its predecessors
+// the locks are held for at most GROUP_COMMIT_MAX_HOLD_MS at a time
+static void _ExecuteWriteGroup(void *args) {
+	ASSERT(args != NULL);
+
+	double     timer[2];
+	bool       grouped      =  false;
+	WriteGroup *group       =  args;
+	uint       query_count  =  array_len(group->queries);
+
+	// each query replies individually
+	for(uint i = 0; i < query_count; i++) {
+		// a single query gains nothing from grouping
+		if(!grouped && query_count - i > 1) {
+			grouped = QueryCtx_BeginGroupCommit(group->gc, group->db);
+			simple_tic(timer);
+		}
+
+		_ExecuteQuery(group->queries[i]);
+
+		// yield the locks once held for too long
+		if(grouped && simple_toc(timer) * 1000 >= GROUP_COMMIT_MAX_HOLD_MS) {
+			QueryCtx_EndGroupCommit();
+			grouped = false;
+		}
+	}
+
+	if(grouped) QueryCtx_EndGroupCommit();
+
+	array_free(group->queries);
+	rm_free(group);
+}
+
+// removes the group identified by 'id' from the open groups
+// returns NULL if the group is no longer open
+// expects _write_groups_lock to be held
+static WriteGroup *_DetachWriteGroup(uint64_t id) {
+	uint group_count = array_len(_write_groups);
+	for(uint i = 0; i < group_count; i++) {
+		WriteGroup *g = _write_groups[i];
+		if(g->id == id) {
+			array_del_fast(_write_groups, i);
+			return g;
+		}
+	}
+	return NULL;
+}
+
+static void _DispatchWriteGroup(WriteGroup *group) {
+	int res = ThreadPools_AddWorkWriter(_ExecuteWriteGroup, group,
+			group->priority, group->gc);
+	ASSERT(res == 0);
+}
+
+// group commit window elapsed, invoked on the cron thread
+// 'pdata' holds the group's ID rather than the group itself
+// as a dispatched group is freed and its address might be reused
+static void _WriteGroupWindowElapsed(void *pdata) {
+	pthread_mutex_lock(&_write_groups_lock);
+	WriteGroup *group = _DetachWriteGroup((uint64_t)(uintptr_t)pdata);
+	pthread_mutex_unlock(&_write_groups_lock);
+
+	// group might have been dispatched once it filled up
+	if(group != NULL) _DispatchWriteGroup(group);
+}
+
+// queue write query to be committed along with all other writes
+// to the same graph arriving within the group commit window
+static void _GroupWriter(GraphQueryCtx *gq_ctx, uint64_t window) {
+	ASSERT(gq_ctx != NULL);
+
+	GraphContext  *gc       =  gq_ctx->graph_ctx;
+	WriteGroup    *group    =  NULL;
+	WriteGroup    *full     =  NULL;
+	bool          created   =  false;
+	uint64_t      id        =  0;
+
+	pthread_mutex_lock(&_write_groups_lock);
+
+	if(_write_groups == NULL) _write_groups = array_new(WriteGroup *, 1);
+
+	// look for the graph's open group
+	uint group_count = array_len(_write_groups);
+	for(uint i = 0; i < group_count; i++) {
+		if(_write_groups[i]->gc == gc) {
+			group = _write_groups[i];
+			break;
+		}
+	}
+
+	// open a new group
+	if(group == NULL) {
+		RedisModuleCtx *ctx = CommandCtx_GetRedisCtx(gq_ctx->command_ctx);
+		group = rm_malloc(sizeof(WriteGroup));
+		group->id        =  _write_group_id++;
+		group->db        =  RedisModule_GetSelectedDb(ctx);
+		group->gc        =  gc;
+		group->queries   =  array_new(GraphQueryCtx *, 1);
+		group->priority  =  gq_ctx->command_ctx->priority;
+		array_append(_write_groups, group);
+		created = true;
+	}
+
+	id = group->id;
+	array_append(group->queries, gq_ctx);
+
+	// dispatch group without waiting for the window to elapse once it's full
+	if(array_len(group->queries) == GROUP_COMMIT_MAX_QUERIES) {
+		full = _DetachWriteGroup(id);
+	}
+
+	pthread_mutex_unlock(&_write_groups_lock);
+
+	if(created) {
+		Cron_AddTask(window, _WriteGroupWindowElapsed, (void *)(uintptr_t)id);
+	}
+	if(full != NULL) _DispatchWriteGroup(full);
+}
+
 static void _DelegateWriter(GraphQueryCtx *gq_ctx) {
 	ASSERT(gq_ctx != NULL);
 
@@ -272,13 +411,71 @@ static void _DelegateWriter(GraphQueryCtx *gq_ctx) {
 	CommandCtx_UntrackCtx(gq_ctx->command_ctx);
 
 	// update execution thread to writer
+	gq_ctx->migrated = true;
 	gq_ctx->command_ctx->thread = EXEC_THREAD_WRITER;
 
+	// group writes to the same graph if group commit is enabled
+	uint64_t window;
+	Config_Option_get(Config_GROUP_COMMIT_WINDOW, &window);
+	if(window != GROUP_COMMIT_DISABLED) {
+		_GroupWriter(gq_ctx, window);
+		return;
+	}
+
 	// dispatch work to the writer thread
-	int res = ThreadPools_AddWorkWriter(_ExecuteQuery, gq_ctx);
+	int res = ThreadPools_AddWorkWriter(_ExecuteQuery, gq_ctx,
+			gq_ctx->command_ctx->priority, gq_ctx->graph_ctx);
 	ASSERT(res == 0);
 }
 
+// returns true if read query should be rescheduled with a lower priority
+// queries are ordered by cost only when the caller didn't prioritize them
+static bool _ShouldDemoteReader(GraphQueryCtx *gq_ctx) {
+	ASSERT(gq_ctx != NULL);
+
+	CommandCtx    *command_ctx  =  gq_ctx->command_ctx;
+	ExecutionCtx  *exec_ctx     =  gq_ctx->exec_ctx;
+	Graph         *g            =  gq_ctx->graph_ctx->g;
+
+	if(!gq_ctx->readonly_query                         ||
+	   command_ctx->thread != EXEC_THREAD_READER       ||
+	   command_ctx->priority != THPOOL_PRIORITY_NORMAL ||
+	   exec_ctx->exec_type != EXECUTION_TYPE_QUERY) return false;
+
+	Graph_AcquireReadLock(g);
+	uint64_t cost = ExecutionPlan_EstimateCost(exec_ctx->plan, g);
+	Graph_ReleaseLock(g);
+
+	return (cost > EXPENSIVE_QUERY_COST);
+}
+
+// reschedule read query with a lower priority
+// letting cheaper queries which are already queued run ahead of it
+// returns false if the query couldn't be rescheduled
+static bool _DemoteReader(GraphQueryCtx *gq_ctx) {
+	ASSERT(gq_ctx != NULL);
+
+	CommandCtx *command_ctx = gq_ctx->command_ctx;
+
+	// clear this thread data
+	ErrorCtx_Clear();
+	QueryCtx_RemoveFromTLS();
+	CommandCtx_UntrackCtx(command_ctx);
+
+	gq_ctx->migrated = true;
+	command_ctx->priority = THPOOL_PRIORITY_LOW;
+
+	int res = ThreadPools_AddWorkReader(_ExecuteQuery, gq_ctx,
+			THPOOL_PRIORITY_LOW, gq_ctx->graph_ctx);
+	if(res == 0) return true;
+
+	// queue is full, execute on this thread
+	gq_ctx->migrated = false;
+	QueryCtx_SetTLS(gq_ctx->query_ctx);
+	CommandCtx_TrackCtx(command_ctx);
+	return false;
+}
+
 void _query(bool profile, void *args) {
 	CommandCtx     *command_ctx = (CommandCtx *)args;
 	RedisModuleCtx *ctx         = CommandCtx_GetRedisCtx(command_ctx);
@@ -295,6 +492,11 @@ void _query(bool profile, void *args) {
 
 	QueryCtx_BeginTimer(); // Start query timing.
 
+	// decode binary query parameters
+	size_t params_len;
+	const char *params = CommandCtx_GetBinaryParams(command_ctx, &params_len);
+	if(params != NULL && !BinaryParams_Decode(params, params_len)) goto cleanup;
+
 	// parse query parameters and build an execution plan or retrieve it from the cache
 	exec_ctx = ExecutionCtx_FromQuery(command_ctx->query);
 	if(exec_ctx == NULL) goto cleanup;
@@ -316,20 +518,19 @@ void _query(bool profile, void *args) {
 		goto cleanup;
 	}
 
-	CronTaskHandle timeout_task = 0;
-
 	// set the query timeout if one was specified
-	if(command_ctx->timeout != 0) {
-		// disallow timeouts on write operations to avoid leaving the graph in an inconsistent state
-		if(readonly) {
-			timeout_task = Query_SetTimeOut(command_ctx->timeout,
-					exec_ctx->plan);
-		}
+	// write queries which time out before committing discard their changes
+	// index operations are not subject to timeouts
+	if(command_ctx->timeout != 0 && exec_type == EXECUTION_TYPE_QUERY) {
+		QueryCtx_SetTimeout(command_ctx->timeout);
 	}
 
 	// populate the container struct for invoking _ExecuteQuery.
 	GraphQueryCtx *gq_ctx = GraphQueryCtx_New(gc, ctx, exec_ctx, command_ctx,
-											  readonly, profile, timeout_task);
+											  readonly, profile);
+
+	// expensive read queries are rescheduled behind cheaper ones
+	if(_ShouldDemoteReader(gq_ctx) && _DemoteReader(gq_ctx)) return;
 
 	// if 'thread' is redis main thread, continue running
 	// if readonly is true we're executing on a worker thread from
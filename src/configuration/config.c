@@ -46,6 +46,12 @@
 // number of pending changed befor RG_Matrix flushed
 #define DELTA_MAX_PENDING_CHANGES "DELTA_MAX_PENDING_CHANGES"
 
+// config param, ms during which write queries are grouped
+#define GROUP_COMMIT_WINDOW "GROUP_COMMIT_WINDOW"
+
+// config param, save and load relationship matrix snapshots
+#define MATRIX_SNAPSHOT "MATRIX_SNAPSHOT"
+
 //------------------------------------------------------------------------------
 // Configuration defaults
 //------------------------------------------------------------------------------
@@ -66,6 +72,8 @@ typedef struct {
 	uint64_t max_queued_queries;       // max number of queued queries
 	int64_t query_mem_capacity;        // Max mem(bytes) that query/thread can utilize at any given time
 	int64_t delta_max_pending_changes; // number of pending changed befor RG_Matrix flushed
+	uint64_t group_commit_window;      // ms during which write queries are grouped, 0 disabled
+	bool matrix_snapshot;              // if true, relationship matrices are snapshotted alongside the RDB
 	Config_on_change cb;               // callback function which being called when config param changed
 } RG_Config;
 
@@ -255,6 +263,30 @@ uint64_t Config_delta_max_pending_changes_get(void)
 	return config.delta_max_pending_changes;
 }
 
+//------------------------------------------------------------------------------
+// group commit window
+//------------------------------------------------------------------------------
+
+void Config_group_commit_window_set(uint64_t window) {
+	config.group_commit_window = window;
+}
+
+uint64_t Config_group_commit_window_get(void) {
+	return config.group_commit_window;
+}
+
+//------------------------------------------------------------------------------
+// matrix snapshot
+//------------------------------------------------------------------------------
+
+void Config_matrix_snapshot_set(bool matrix_snapshot) {
+	config.matrix_snapshot = matrix_snapshot;
+}
+
+bool Config_matrix_snapshot_get(void) {
+	return config.matrix_snapshot;
+}
+
 bool Config_Contains_field(const char *field_str, Config_Option_Field *field)
 {
 	ASSERT(field_str != NULL);
@@ -279,6 +311,10 @@ bool Config_Contains_field(const char *field_str, Config_Option_Field *field)
 		f = Config_QUERY_MEM_CAPACITY;
 	} else if (!(strcasecmp(field_str, DELTA_MAX_PENDING_CHANGES))) {
 		f = Config_DELTA_MAX_PENDING_CHANGES;
+	} else if (!(strcasecmp(field_str, GROUP_COMMIT_WINDOW))) {
+		f = Config_GROUP_COMMIT_WINDOW;
+	} else if (!(strcasecmp(field_str, MATRIX_SNAPSHOT))) {
+		f = Config_MATRIX_SNAPSHOT;
 	} else {
 		return false;
 	}
@@ -331,6 +367,14 @@ const char *Config_Field_name(Config_Option_Field field) {
 			name = DELTA_MAX_PENDING_CHANGES;
 			break;
 
+		case Config_GROUP_COMMIT_WINDOW:
+			name = GROUP_COMMIT_WINDOW;
+			break;
+
+		case Config_MATRIX_SNAPSHOT:
+			name = MATRIX_SNAPSHOT;
+			break;
+
         //----------------------------------------------------------------------
         // invalid option
         //----------------------------------------------------------------------
@@ -380,6 +424,12 @@ void _Config_SetToDefaults(void) {
 
 	// number of pending changed befor RG_Matrix flushed
 	config.delta_max_pending_changes = DELTA_MAX_PENDING_CHANGES_DEFAULT;
+
+	// write queries are committed individually by default
+	config.group_commit_window = GROUP_COMMIT_DISABLED;
+
+	// graphs are decoded solely from the RDB by default
+	config.matrix_snapshot = false;
 }
 
 int Config_Init(RedisModuleCtx *ctx, RedisModuleString **argv, int argc) {
@@ -583,6 +633,36 @@ bool Config_Option_get(Config_Option_Field field, ...) {
 			}
 			break;
 
+		//----------------------------------------------------------------------
+		// group commit window
+		//----------------------------------------------------------------------
+
+		case Config_GROUP_COMMIT_WINDOW:
+			{
+				va_start(ap, field);
+				uint64_t *group_commit_window = va_arg(ap, uint64_t *);
+				va_end(ap);
+
+				ASSERT(group_commit_window != NULL);
+				(*group_commit_window) = Config_group_commit_window_get();
+			}
+			break;
+
+		//----------------------------------------------------------------------
+		// matrix snapshot
+		//----------------------------------------------------------------------
+
+		case Config_MATRIX_SNAPSHOT:
+			{
+				va_start(ap, field);
+				bool *matrix_snapshot = va_arg(ap, bool *);
+				va_end(ap);
+
+				ASSERT(matrix_snapshot != NULL);
+				(*matrix_snapshot) = Config_matrix_snapshot_get();
+			}
+			break;
+
         //----------------------------------------------------------------------
         // invalid option
         //----------------------------------------------------------------------
@@ -731,6 +811,32 @@ bool Config_Option_set(Config_Option_Field field, const char *val) {
 			}
 			break;
 
+		//----------------------------------------------------------------------
+		// group commit window
+		//----------------------------------------------------------------------
+
+		case Config_GROUP_COMMIT_WINDOW:
+			{
+				long long group_commit_window;
+				if (!_Config_ParseNonNegativeInteger(val, &group_commit_window)) return false;
+
+				Config_group_commit_window_set(group_commit_window);
+			}
+			break;
+
+		//----------------------------------------------------------------------
+		// matrix snapshot
+		//----------------------------------------------------------------------
+
+		case Config_MATRIX_SNAPSHOT:
+			{
+				bool matrix_snapshot;
+				if(!_Config_ParseYesNo(val, &matrix_snapshot)) return false;
+
+				Config_matrix_snapshot_set(matrix_snapshot);
+			}
+			break;
+
 	//----------------------------------------------------------------------
 	// invalid option
 	//----------------------------------------------------------------------
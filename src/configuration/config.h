@@ -14,6 +14,7 @@
 #define CONFIG_TIMEOUT_NO_TIMEOUT          0
 #define VKEY_ENTITY_COUNT_UNLIMITED        UINT64_MAX
 #define DELTA_MAX_PENDING_CHANGES_DEFAULT  10000
+#define GROUP_COMMIT_DISABLED              0
 
 typedef enum {
 	Config_TIMEOUT                   = 0,     // timeout value for queries
@@ -26,7 +27,9 @@ typedef enum {
 	Config_MAX_QUEUED_QUERIES        = 7,     // max number of queued queries
 	Config_QUERY_MEM_CAPACITY        = 8,     // max mem(bytes) that query/thread can utilize at any given time
 	Config_DELTA_MAX_PENDING_CHANGES = 9,    // number of pending changed befor RG_Matrix flushed
-	Config_END_MARKER                = 10
+	Config_GROUP_COMMIT_WINDOW       = 10,    // ms during which write queries are grouped
+	Config_MATRIX_SNAPSHOT           = 11,    // save and load relationship matrix snapshots
+	Config_END_MARKER                = 12
 } Config_Option_Field;
 
 // callback function, invoked once configuration changes as a result of
@@ -34,7 +37,7 @@ typedef enum {
 typedef void (*Config_on_change)(Config_Option_Field type);
 
 // Run-time configurable fields
-#define RUNTIME_CONFIG_COUNT 6
+#define RUNTIME_CONFIG_COUNT 8
 static const Config_Option_Field RUNTIME_CONFIGS[] =
 {
 	Config_RESULTSET_MAX_SIZE,
@@ -42,7 +45,9 @@ static const Config_Option_Field RUNTIME_CONFIGS[] =
 	Config_MAX_QUEUED_QUERIES,
 	Config_QUERY_MEM_CAPACITY,
 	Config_DELTA_MAX_PENDING_CHANGES,
-	Config_VKEY_MAX_ENTITY_COUNT
+	Config_VKEY_MAX_ENTITY_COUNT,
+	Config_GROUP_COMMIT_WINDOW,
+	Config_MATRIX_SNAPSHOT
 };
 
 // Set module-level configurations to defaults or to user arguments where provided.
@@ -44,7 +44,7 @@ static int Map_KeyIdx
 	// search for key in map
 	for(uint i = 0; i < n; i++) {
 		Pair pair = m[i];
-		if(RG_STRCMP(pair.key.stringval, key.stringval) == 0) {
+		if(RG_STRCMP(SI_STRINGVAL(pair.key), SI_STRINGVAL(key)) == 0) {
 			return i;
 		}
 	}
@@ -204,7 +204,7 @@ SIValue *Map_Keys
 	return keys;
 }
 
-#define KEY_ISLT(a,b) (strcmp(a->key.stringval, b->key.stringval) < 0)
+#define KEY_ISLT(a,b) (strcmp(SI_STRINGVAL(a->key), SI_STRINGVAL(b->key)) < 0)
 int Map_Compare
 (
 	SIValue mapA,
@@ -18,6 +18,18 @@
 
 #include <setjmp.h>
 
+// initial number of records a record pool can hold
+#define RECORD_POOL_CAP 256
+
+// max number of record pools kept for reuse by each thread
+#define SPARE_RECORD_POOLS_CAP 8
+
+// record pools of freed execution plans, kept for reuse by plans executed
+// later on by the same thread, such that executions of a cached query
+// don't allocate a new record pool each time
+static __thread ObjectPool *_spare_record_pools[SPARE_RECORD_POOLS_CAP];
+static __thread uint _spare_record_pool_count = 0;
+
 // Allocate a new ExecutionPlan segment.
 inline ExecutionPlan *ExecutionPlan_NewEmptyExecutionPlan(void) {
 	return rm_calloc(1, sizeof(ExecutionPlan));
@@ -351,6 +363,35 @@ void ExecutionPlan_ReturnRecord(ExecutionPlan *plan, Record r) {
 // Execution plan initialization
 //------------------------------------------------------------------------------
 
+// retrieves a spare record pool of records of size 'rec_size'
+// returns NULL if there's no such pool
+static ObjectPool *_ExecutionPlan_TakeSpareRecordPool(uint rec_size) {
+	for(uint i = 0; i < _spare_record_pool_count; i++) {
+		ObjectPool *pool = _spare_record_pools[i];
+		if(ObjectPool_ItemSize(pool) != rec_size) continue;
+
+		// fill the gap with the last spare pool
+		_spare_record_pool_count--;
+		_spare_record_pools[i] = _spare_record_pools[_spare_record_pool_count];
+		return pool;
+	}
+
+	return NULL;
+}
+
+// keeps a freed plan's record pool for reuse, or frees it
+static void _ExecutionPlan_RecycleRecordPool(ObjectPool *pool) {
+	// only pools at their initial capacity which hold no records are kept
+	// pools grown by large queries are released
+	bool reusable = (pool->itemCount == 0 && pool->itemCap <= RECORD_POOL_CAP);
+
+	if(reusable && _spare_record_pool_count < SPARE_RECORD_POOLS_CAP) {
+		_spare_record_pools[_spare_record_pool_count++] = pool;
+	} else {
+		ObjectPool_Free(pool);
+	}
+}
+
 static inline void _ExecutionPlan_InitRecordPool(ExecutionPlan *plan) {
 	if(plan->record_pool) return;
 	/* Initialize record pool.
@@ -358,14 +399,22 @@ static inline void _ExecutionPlan_InitRecordPool(ExecutionPlan *plan) {
 	uint entries_count = raxSize(plan->record_map);
 	uint rec_size = sizeof(_Record) + (sizeof(Entry) * entries_count);
 
+	// reuse a record pool of a previously executed plan
+	plan->record_pool = _ExecutionPlan_TakeSpareRecordPool(rec_size);
+	if(plan->record_pool) return;
+
 	// Create a data block with initial capacity of 256 records.
-	plan->record_pool = ObjectPool_New(256, rec_size, (fpDestructor)Record_FreeEntries);
+	plan->record_pool = ObjectPool_New(RECORD_POOL_CAP, rec_size,
+			(fpDestructor)Record_FreeEntries);
 }
 
 static void _ExecutionPlanInit(OpBase *root) {
 	// If the ExecutionPlan associated with this op hasn't built a record pool yet, do so now.
 	_ExecutionPlan_InitRecordPool((ExecutionPlan *)root->plan);
 
+	// cache the query's state, checked for cancellation on every consume
+	root->query_state = QueryCtx_GetState();
+
 	// Initialize the operation if necessary.
 	if(root->init) root->init(root);
 
@@ -399,34 +448,133 @@ ResultSet *ExecutionPlan_Execute(ExecutionPlan *plan) {
 }
 
 //------------------------------------------------------------------------------
-// Execution plan draining
+// Execution plan cost estimation
 //------------------------------------------------------------------------------
 
-// NOP operation consume routine for immediately terminating execution.
-static Record deplete_consume(struct OpBase *op) {
-	return NULL;
+// number of hops assumed for variable length traversals
+#define VAR_LEN_ESTIMATED_HOPS 3
+
+// a filter is assumed to pass 1 out of every N records
+// equality predicates are assumed to be more selective than other filters
+#define EQUALITY_FILTER_SELECTIVITY 10
+#define FILTER_SELECTIVITY 3
+
+// saturating multiplication
+static inline uint64_t _CostMul(uint64_t a, uint64_t b) {
+	if(a != 0 && b > UINT64_MAX / a) return UINT64_MAX;
+	return a * b;
 }
 
-// return true if execution plan been drained
-// false otherwise
-bool ExecutionPlan_Drained(ExecutionPlan *plan) {
-	ASSERT(plan != NULL);
-	ASSERT(plan->root != NULL);
-	return (plan->root->consume == deplete_consume);
+// saturating addition
+static inline uint64_t _CostAdd(uint64_t a, uint64_t b) {
+	return (a > UINT64_MAX - b) ? UINT64_MAX : a + b;
 }
 
-static void _ExecutionPlan_Drain(OpBase *root) {
-	root->consume = deplete_consume;
-	for(int i = 0; i < root->childCount; i++) {
-		_ExecutionPlan_Drain(root->children[i]);
+// returns N, where filter tree is assumed to pass 1 out of every N records
+static uint64_t _FilterSelectivity
+(
+	const FT_FilterNode *ft
+) {
+	if(ft->t == FT_N_PRED && ft->pred.op == OP_EQUAL) {
+		return EQUALITY_FILTER_SELECTIVITY;
 	}
+	return FILTER_SELECTIVITY;
+}
+
+// estimates the number of records produced by 'op'
+// 'fanout' is the graph's average node degree
+// filters reduce the estimate only if 'selective' is set
+static uint64_t _ExecutionPlan_EstimateRecords
+(
+	const OpBase *op,
+	const Graph *g,
+	uint64_t fanout,
+	bool selective
+) {
+	uint64_t scanned = 1;      // number of records produced per input record
+	uint64_t selectivity = 1;  // 1 out of 'selectivity' records is produced
+	int label_id;
+
+	switch(op->type) {
+		case OPType_ALL_NODE_SCAN:
+			scanned = Graph_NodeCount(g);
+			break;
+		case OPType_NODE_BY_LABEL_SCAN:
+		case OPType_NODE_BY_LABEL_AND_ID_SCAN:
+			label_id = ((const NodeByLabelScan *)op)->n.label_id;
+			scanned = (label_id < 0) ? 0 : Graph_LabeledNodeCount(g, label_id);
+			break;
+		case OPType_CONDITIONAL_TRAVERSE:
+		case OPType_INTERSECT_TRAVERSE:
+			scanned = fanout;
+			break;
+		case OPType_CONDITIONAL_VAR_LEN_TRAVERSE: {
+			uint hops = ((const CondVarLenTraverse *)op)->maxHops;
+			if(hops > VAR_LEN_ESTIMATED_HOPS) hops = VAR_LEN_ESTIMATED_HOPS;
+			for(uint i = 0; i < hops; i++) scanned = _CostMul(scanned, fanout);
+			break;
+		}
+		case OPType_FILTER:
+			if(selective) {
+				selectivity = _FilterSelectivity(((const OpFilter *)op)->filterTree);
+			}
+			break;
+		default:
+			break;
+	}
+
+	if(op->childCount == 0) return scanned;
+
+	uint64_t records = (op->type == OPType_CARTESIAN_PRODUCT) ? 1 : 0;
+	for(int i = 0; i < op->childCount; i++) {
+		uint64_t child = _ExecutionPlan_EstimateRecords(op->children[i], g,
+				fanout, selective);
+		// cartesian product combines every record of its children
+		if(op->type == OPType_CARTESIAN_PRODUCT) {
+			records = _CostMul(records, child);
+		} else {
+			records = _CostAdd(records, child);
+		}
+	}
+
+	records = _CostMul(records, scanned);
+
+	// round up, a filtered stream isn't assumed to be empty
+	return records / selectivity + (records % selectivity != 0);
+}
+
+static uint64_t _ExecutionPlan_Estimate
+(
+	const OpBase *op,
+	const Graph *g,
+	bool selective
+) {
+	ASSERT(g != NULL);
+	ASSERT(op != NULL);
+
+	uint64_t node_count = Graph_NodeCount(g);
+	uint64_t fanout = (node_count == 0) ? 1 : Graph_EdgeCount(g) / node_count;
+	if(fanout == 0) fanout = 1;
+
+	return _ExecutionPlan_EstimateRecords(op, g, fanout, selective);
+}
+
+uint64_t ExecutionPlan_EstimateRecords
+(
+	const OpBase *op,
+	const Graph *g
+) {
+	return _ExecutionPlan_Estimate(op, g, true);
 }
 
-// Resets each operation consume function to simply return NULL
-// this will cause the execution-plan to quickly deplete
-void ExecutionPlan_Drain(ExecutionPlan *plan) {
-	ASSERT(plan && plan->root);
-	_ExecutionPlan_Drain(plan->root);
+uint64_t ExecutionPlan_EstimateCost
+(
+	const ExecutionPlan *plan,
+	const Graph *g
+) {
+	ASSERT(plan != NULL && plan->root != NULL);
+	// filtered records are processed nonetheless
+	return _ExecutionPlan_Estimate(plan->root, g, false);
 }
 
 //------------------------------------------------------------------------------
@@ -483,7 +631,7 @@ static void _ExecutionPlan_FreeInternals(ExecutionPlan *plan) {
 
 	QueryGraph_Free(plan->query_graph);
 	if(plan->record_map) raxFree(plan->record_map);
-	if(plan->record_pool) ObjectPool_Free(plan->record_pool);
+	if(plan->record_pool) _ExecutionPlan_RecycleRecordPool(plan->record_pool);
 	if(plan->ast_segment) AST_Free(plan->ast_segment);
 	rm_free(plan);
 }
@@ -58,11 +58,13 @@ void ExecutionPlan_Init(ExecutionPlan *plan);
 /* Executes plan */
 ResultSet *ExecutionPlan_Execute(ExecutionPlan *plan);
 
-/* Checks if execution plan been drained */
-bool ExecutionPlan_Drained(ExecutionPlan *plan);
+/* Estimates the number of records processed by the plan
+ * used as a rough execution cost when scheduling queries */
+uint64_t ExecutionPlan_EstimateCost(const ExecutionPlan *plan, const Graph *g);
 
-/* Drains execution plan */
-void ExecutionPlan_Drain(ExecutionPlan *plan);
+/* Estimates the number of records produced by the op tree rooted at 'op'
+ * each filter is assumed to pass a fixed fraction of its input */
+uint64_t ExecutionPlan_EstimateRecords(const OpBase *op, const Graph *g);
 
 /* Profile executes plan */
 ResultSet *ExecutionPlan_Profile(ExecutionPlan *plan);
@@ -39,9 +39,19 @@ void OpBase_Init(OpBase *op, OPType type, const char *name, fpInit init, fpConsu
 	op->clone = clone;
 	op->free = free;
 	op->profile = NULL;
+	op->query_state = NULL;
+}
+
+inline bool OpBase_Cancelled(const OpBase *op) {
+	// an operation which wasn't initialized by a query can't be cancelled
+	if(op->query_state == NULL) return false;
+	return (__atomic_load_n(op->query_state, __ATOMIC_RELAXED) ==
+			QUERY_CANCELLED);
 }
 
 inline Record OpBase_Consume(OpBase *op) {
+	// a cancelled query stops producing data
+	if(OpBase_Cancelled(op)) return NULL;
 	return op->consume(op);
 }
 
@@ -7,6 +7,7 @@
 #pragma once
 
 #include "../record.h"
+#include "../../query_state.h"
 #include "../../util/arr.h"
 #include "../../redismodule.h"
 #include "../../schema/schema.h"
@@ -52,6 +53,8 @@ typedef enum {
 	OPType_OR_APPLY_MULTIPLEXER,
 	OPType_AND_APPLY_MULTIPLEXER,
 	OPType_OPTIONAL,
+	OPType_DEGREE_COUNT,
+	OPType_INTERSECT_TRAVERSE,
 } OPType;
 
 typedef enum {
@@ -135,6 +138,7 @@ struct OpBase {
 	struct OpBase *parent;      // Parent operations.
 	const struct ExecutionPlan *plan; // ExecutionPlan this operation is part of.
 	bool writer;             // Indicates this is a writer operation.
+	const QueryState *query_state;  // Execution state of the query, set on init.
 };
 typedef struct OpBase OpBase;
 
@@ -144,6 +148,7 @@ void OpBase_Init(OpBase *op, OPType type, const char *name, fpInit init, fpConsu
 				 const struct ExecutionPlan *plan);
 void OpBase_Free(OpBase *op);       // Free op.
 Record OpBase_Consume(OpBase *op);  // Consume op.
+bool OpBase_Cancelled(const OpBase *op);  // Query has been cancelled.
 Record OpBase_Profile(OpBase *op);  // Profile op.
 
 void OpBase_ToString(const OpBase *op, sds *buff);
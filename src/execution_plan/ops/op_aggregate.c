@@ -11,6 +11,7 @@
 #include "../../query_ctx.h"
 #include "../../util/rmalloc.h"
 #include "../../grouping/group.h"
+#include "../../arithmetic/aggregate_funcs/agg_funcs.h"
 
 /* Forward declarations. */
 static Record AggregateConsume(OpBase *opBase);
@@ -154,6 +155,18 @@ static void _aggregateRecord(OpAggregate *op, Record r) {
 	Group *group = _GetGroup(op, r);
 	ASSERT(group != NULL);
 
+	// record represents a group of records, count the entire group at once
+	if(op->multiplicityRecIdx != -1) {
+		SIValue n = Record_Get(r, op->multiplicityRecIdx);
+		ASSERT(SI_TYPE(n) == T_INT64);
+		for(uint i = 0; i < op->aggregate_count; i++) {
+			AR_ExpNode *exp = group->aggregationFunctions[i];
+			Aggregate_CountN(exp->op.f->privdata, n.longval);
+		}
+		OpBase_DeleteRecord(r);
+		return;
+	}
+
 	// aggregate group exps
 	for(uint i = 0; i < op->aggregate_count; i++) {
 		AR_ExpNode *exp = group->aggregationFunctions[i];
@@ -200,6 +213,8 @@ OpBase *NewAggregateOp(const ExecutionPlan *plan, AR_ExpNode **exps, bool should
 	op->group_keys = NULL;
 	op->groups = CacheGroupNew();
 	op->should_cache_records = should_cache_records;
+	op->multiplicity = NULL;
+	op->multiplicityRecIdx = -1;
 
 	// Migrate each expression to the keys array or the aggregations array as appropriate.
 	_migrate_expressions(op, exps);
@@ -228,6 +243,15 @@ OpBase *NewAggregateOp(const ExecutionPlan *plan, AR_ExpNode **exps, bool should
 	return (OpBase *)op;
 }
 
+void AggregateOp_SetMultiplicity(OpAggregate *op, const char *alias) {
+	ASSERT(alias != NULL);
+
+	op->multiplicity = alias;
+	bool aware = OpBase_Aware((OpBase *)op, alias, &op->multiplicityRecIdx);
+	UNUSED(aware);
+	ASSERT(aware);
+}
+
 static Record AggregateConsume(OpBase *opBase) {
 	OpAggregate *op = (OpAggregate *)opBase;
 	if(op->group_iter) return _handoff(op);
@@ -273,7 +297,9 @@ static OpBase *AggregateClone(const ExecutionPlan *plan, const OpBase *opBase) {
 	for(uint i = 0; i < key_count; i++) array_append(exps, AR_EXP_Clone(op->key_exps[i]));
 	for(uint i = 0; i < aggregate_count; i++)
 		array_append(exps, AR_EXP_Clone(op->aggregate_exps[i]));
-	return NewAggregateOp(plan, exps, op->should_cache_records);
+	OpBase *clone = NewAggregateOp(plan, exps, op->should_cache_records);
+	if(op->multiplicity) AggregateOp_SetMultiplicity((OpAggregate *)clone, op->multiplicity);
+	return clone;
 }
 
 static void AggregateFree(OpBase *opBase) {
@@ -23,7 +23,15 @@ typedef struct {
 	uint key_count;                     /* Number of key expressions. */
 	uint aggregate_count;               /* Number of aggregating expressions. */
 	bool should_cache_records;          /* Records should be cached if we're sorting after aggregation. */
+	const char *multiplicity;           /* Alias holding the number of records each record represents. */
+	int multiplicityRecIdx;             /* Multiplicity position within record, -1 if not set. */
 } OpAggregate;
 
 OpBase *NewAggregateOp(const ExecutionPlan *plan, AR_ExpNode **exps, bool should_cache_records);
 
+/* Treat each consumed record as a group of records, the size of which
+ * is the integer stored under 'alias'.
+ * Only supported when all aggregations are non distinct counts
+ * of values which are never NULL. */
+void AggregateOp_SetMultiplicity(OpAggregate *op, const char *alias);
+
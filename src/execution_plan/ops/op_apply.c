@@ -5,11 +5,13 @@
  */
 
 #include "op_apply.h"
+#include "../../util/arr.h"
 #include "../execution_plan_build/execution_plan_modify.h"
 
 /* Forward declarations. */
 static OpResult ApplyInit(OpBase *opBase);
 static Record ApplyConsume(OpBase *opBase);
+static Record ApplyCachedConsume(OpBase *opBase);
 static OpResult ApplyReset(OpBase *opBase);
 static OpBase *ApplyClone(const ExecutionPlan *plan, const OpBase *opBase);
 static void ApplyFree(OpBase *opBase);
@@ -20,6 +22,9 @@ OpBase *NewApplyOp(const ExecutionPlan *plan) {
 	op->op_arg = NULL;
 	op->bound_branch = NULL;
 	op->rhs_branch = NULL;
+	op->uncorrelated = false;
+	op->cache = NULL;
+	op->cache_idx = 0;
 
 	// Set our Op operations
 	OpBase_Init((OpBase *)op, OPType_APPLY, "Apply", ApplyInit, ApplyConsume, ApplyReset, NULL,
@@ -28,6 +33,39 @@ OpBase *NewApplyOp(const ExecutionPlan *plan) {
 	return (OpBase *)op;
 }
 
+void ApplyOp_SetUncorrelated(Apply *op) {
+	ASSERT(op != NULL);
+	op->uncorrelated = true;
+	OpBase_UpdateConsume((OpBase *)op, ApplyCachedConsume);
+}
+
+static void _ApplyFreeCache(Apply *op) {
+	if(op->cache == NULL) return;
+
+	uint cache_count = array_len(op->cache);
+	for(uint i = 0; i < cache_count; i++) OpBase_DeleteRecord(op->cache[i]);
+	array_free(op->cache);
+	op->cache = NULL;
+	op->cache_idx = 0;
+}
+
+/* Execute the right-hand branch once and retain all of its Records.
+ * The branch doesn't refer to any bound variable, as such it is fed
+ * an empty Record rather than a clone of the bound Record. */
+static void _ApplyPopulateCache(Apply *op) {
+	ASSERT(op->cache == NULL);
+
+	op->cache = array_new(Record, 1);
+	Argument_AddRecord(op->op_arg, OpBase_CreateRecord((OpBase *)op));
+
+	Record r;
+	while((r = OpBase_Consume(op->rhs_branch)) != NULL) {
+		// Cached Records outlive the branch, make sure they own their scalars.
+		Record_PersistScalars(r);
+		array_append(op->cache, r);
+	}
+}
+
 static OpResult ApplyInit(OpBase *opBase) {
 	ASSERT(opBase->childCount == 2);
 
@@ -82,17 +120,58 @@ static Record ApplyConsume(OpBase *opBase) {
 	return NULL;
 }
 
+static Record ApplyCachedConsume(OpBase *opBase) {
+	Apply *op = (Apply *)opBase;
+
+	while(true) {
+		if(op->r == NULL) {
+			// Retrieve a Record from the bound branch if we're not currently holding one.
+			op->r = OpBase_Consume(op->bound_branch);
+			if(!op->r) return NULL; // Bound branch and this op are depleted.
+
+			/* Execute the RHS branch only once a bound Record is available,
+			 * such that it observes any modification made by the bound branch. */
+			if(op->cache == NULL) _ApplyPopulateCache(op);
+			op->cache_idx = 0;
+		}
+
+		if(op->cache_idx == array_len(op->cache)) {
+			// All cached Records were merged with the current bound Record.
+			OpBase_DeleteRecord(op->r);
+			op->r = NULL;
+			continue;
+		}
+
+		/* Clone the bound Record and merge a copy of the cached Record into it,
+		 * the cached Record retains ownership of its own scalars. */
+		Record r = OpBase_CloneRecord(op->r);
+		Record rhs_record = OpBase_CloneRecord(op->cache[op->cache_idx++]);
+		Record_PersistScalars(rhs_record);
+		Record_Merge(r, rhs_record);
+		OpBase_DeleteRecord(rhs_record);
+
+		return r;
+	}
+
+	return NULL;
+}
+
 static OpResult ApplyReset(OpBase *opBase) {
 	Apply *op = (Apply *)opBase;
 	if(op->r) {
 		OpBase_DeleteRecord(op->r);
 		op->r = NULL;
 	}
+	// The RHS branch is reset as well, recompute it on the next bound Record.
+	_ApplyFreeCache(op);
 	return OP_OK;
 }
 
 static OpBase *ApplyClone(const ExecutionPlan *plan, const OpBase *opBase) {
-	return NewApplyOp(plan);
+	Apply *op = (Apply *)opBase;
+	OpBase *clone = NewApplyOp(plan);
+	if(op->uncorrelated) ApplyOp_SetUncorrelated((Apply *)clone);
+	return clone;
 }
 
 static void ApplyFree(OpBase *opBase) {
@@ -101,5 +180,6 @@ static void ApplyFree(OpBase *opBase) {
 		OpBase_DeleteRecord(op->r);
 		op->r = NULL;
 	}
+	_ApplyFreeCache(op);
 }
 
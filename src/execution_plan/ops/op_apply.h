@@ -16,7 +16,15 @@ typedef struct {
 	OpBase *bound_branch;           // Bound branch.
 	OpBase *rhs_branch;             // Right-hand branch.
 	Argument *op_arg;               // Right-hand branch tap.
+	bool uncorrelated;              // Right-hand branch doesn't depend on bound records.
+	Record *cache;                  // Materialized right-hand branch, NULL if not computed.
+	uint cache_idx;                 // Next cached Record to merge with the bound Record.
 } Apply;
 
 OpBase *NewApplyOp(const ExecutionPlan *plan);
 
+/* Mark the right-hand branch as independent of the bound branch.
+ * The right-hand branch is then executed once, its Records are cached
+ * and merged with every bound Record instead of re-executing the branch. */
+void ApplyOp_SetUncorrelated(Apply *op);
+
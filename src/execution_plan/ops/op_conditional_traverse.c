@@ -15,6 +15,7 @@
 /* Forward declarations. */
 static OpResult CondTraverseInit(OpBase *opBase);
 static Record CondTraverseConsume(OpBase *opBase);
+static Record CondTraverseFactorizedConsume(OpBase *opBase);
 static OpResult CondTraverseReset(OpBase *opBase);
 static OpBase *CondTraverseClone(const ExecutionPlan *plan, const OpBase *opBase);
 static void CondTraverseFree(OpBase *opBase);
@@ -85,6 +86,12 @@ OpBase *NewCondTraverseOp(const ExecutionPlan *plan, Graph *g, AlgebraicExpressi
 	op->record_count = 0;
 	op->edge_ctx = NULL;
 	op->record_cap = BATCH_SIZE;
+	op->factorized = false;
+	op->counts = NULL;
+	op->rows = NULL;
+	op->row_counts = NULL;
+	op->row_count = 0;
+	op->row_pos = 0;
 
 	// Set our Op operations
 	OpBase_Init((OpBase *)op, OPType_CONDITIONAL_TRAVERSE, "Conditional Traverse", CondTraverseInit,
@@ -110,6 +117,14 @@ OpBase *NewCondTraverseOp(const ExecutionPlan *plan, Graph *g, AlgebraicExpressi
 	return (OpBase *)op;
 }
 
+void CondTraverseOp_Factorize(OpCondTraverse *op) {
+	ASSERT(op->edge_ctx == NULL);
+
+	op->factorized = true;
+	op->op.name = "Conditional Traverse (Factorized)";
+	OpBase_UpdateConsume((OpBase *)op, CondTraverseFactorizedConsume);
+}
+
 static OpResult CondTraverseInit(OpBase *opBase) {
 	OpCondTraverse *op = (OpCondTraverse *)opBase;
 	// Create 'records' with this Init function as 'record_cap'
@@ -119,15 +134,57 @@ static OpResult CondTraverseInit(OpBase *opBase) {
 	if(op->record_cap > BATCH_SIZE) op->record_cap = BATCH_SIZE;
 	op->records = rm_calloc(op->record_cap, sizeof(Record));
 
+	if(op->factorized) {
+		GrB_Vector_new(&op->counts, GrB_UINT64, op->record_cap);
+		op->rows = rm_malloc(op->record_cap * sizeof(GrB_Index));
+		op->row_counts = rm_malloc(op->record_cap * sizeof(uint64_t));
+	}
+
 	return OP_OK;
 }
 
+/* Free held records, records handed off by the factorized
+ * consume function are set to NULL. */
+static void _free_records(OpCondTraverse *op) {
+	for(uint i = 0; i < op->record_count; i++) {
+		if(op->records[i]) OpBase_DeleteRecord(op->records[i]);
+	}
+	op->record_count = 0;
+}
+
+/* Replace held records with a new batch of records from child.
+ * Returns the number of records pulled. */
+static uint _pull_records(OpCondTraverse *op) {
+	OpBase *child = op->op.children[0];
+
+	_free_records(op);
+
+	// Ask child operations for data.
+	for(op->record_count = 0; op->record_count < op->record_cap; op->record_count++) {
+		Record childRecord = OpBase_Consume(child);
+		// If the Record is NULL, the child has been depleted.
+		if(!childRecord) break;
+		if(!Record_GetNode(childRecord, op->srcNodeIdx)) {
+			/* The child Record may not contain the source node in scenarios like
+			 * a failed OPTIONAL MATCH. In this case, delete the Record and try again. */
+			OpBase_DeleteRecord(childRecord);
+			op->record_count--;
+			continue;
+		}
+
+		// Store received record.
+		Record_PersistScalars(childRecord);
+		op->records[op->record_count] = childRecord;
+	}
+
+	return op->record_count;
+}
+
 /* Each call to CondTraverseConsume emits a Record containing the
  * traversal's endpoints and, if required, an edge.
  * Returns NULL once all traversals have been performed. */
 static Record CondTraverseConsume(OpBase *opBase) {
 	OpCondTraverse *op = (OpCondTraverse *)opBase;
-	OpBase *child = op->op.children[0];
 
 	/* If we're required to update an edge and have one queued, we can return early.
 	 * Otherwise, try to get a new pair of source and destination nodes. */
@@ -151,29 +208,14 @@ static Record CondTraverseConsume(OpBase *opBase) {
 		/* Run out of tuples, try to get new data.
 		 * Free old records. */
 		op->r = NULL;
-		for(uint i = 0; i < op->record_count; i++) OpBase_DeleteRecord(op->records[i]);
-
-		// Ask child operations for data.
-		for(op->record_count = 0; op->record_count < op->record_cap; op->record_count++) {
-			Record childRecord = OpBase_Consume(child);
-			// If the Record is NULL, the child has been depleted.
-			if(!childRecord) break;
-			if(!Record_GetNode(childRecord, op->srcNodeIdx)) {
-				/* The child Record may not contain the source node in scenarios like
-				 * a failed OPTIONAL MATCH. In this case, delete the Record and try again. */
-				OpBase_DeleteRecord(childRecord);
-				op->record_count--;
-				continue;
-			}
-
-			// Store received record.
-			Record_PersistScalars(childRecord);
-			op->records[op->record_count] = childRecord;
-		}
+		_pull_records(op);
 
 		// No data.
 		if(op->record_count == 0) return NULL;
 
+		// check for cancellation before evaluating the traversal
+		if(OpBase_Cancelled(opBase)) return NULL;
+
 		_traverse(op);
 	}
 
@@ -195,14 +237,53 @@ static Record CondTraverseConsume(OpBase *opBase) {
 	return OpBase_CloneRecord(op->r);
 }
 
+/* Each call to CondTraverseFactorizedConsume emits a source Record
+ * holding the number of destinations it reaches at the destination's position.
+ * Returns NULL once all traversals have been performed. */
+static Record CondTraverseFactorizedConsume(OpBase *opBase) {
+	OpCondTraverse *op = (OpCondTraverse *)opBase;
+
+	while(op->row_pos == op->row_count) {
+		op->row_pos = 0;
+		op->row_count = 0;
+
+		// No data.
+		if(_pull_records(op) == 0) return NULL;
+
+		// check for cancellation before evaluating the traversal
+		if(OpBase_Cancelled(opBase)) return NULL;
+
+		_traverse(op);
+
+		// Count the number of destinations reached by each record.
+		GrB_Vector_clear(op->counts);
+		GrB_Matrix_reduce_Monoid(op->counts, NULL, NULL, GrB_PLUS_MONOID_UINT64,
+				RG_MATRIX_M(op->M), NULL);
+
+		op->row_count = op->record_cap;
+		GrB_Vector_extractTuples_UINT64(op->rows, op->row_counts,
+				&op->row_count, op->counts);
+	}
+
+	// Hand off record, the record slot no longer owns it.
+	GrB_Index row = op->rows[op->row_pos];
+	Record r = op->records[row];
+	op->records[row] = NULL;
+	Record_AddScalar(r, op->destNodeIdx, SI_LongVal(op->row_counts[op->row_pos]));
+	op->row_pos++;
+
+	return r;
+}
+
 static OpResult CondTraverseReset(OpBase *ctx) {
 	OpCondTraverse *op = (OpCondTraverse *)ctx;
 
 	// Do not explicitly free op->r, as the same pointer is also held
 	// in the op->records array and as such will be freed there.
 	op->r = NULL;
-	for(uint i = 0; i < op->record_count; i++) OpBase_DeleteRecord(op->records[i]);
-	op->record_count = 0;
+	_free_records(op);
+	op->row_pos = 0;
+	op->row_count = 0;
 
 	if(op->edge_ctx) EdgeTraverseCtx_Reset(op->edge_ctx);
 
@@ -216,7 +297,9 @@ static OpResult CondTraverseReset(OpBase *ctx) {
 static inline OpBase *CondTraverseClone(const ExecutionPlan *plan, const OpBase *opBase) {
 	ASSERT(opBase->type == OPType_CONDITIONAL_TRAVERSE);
 	OpCondTraverse *op = (OpCondTraverse *)opBase;
-	return NewCondTraverseOp(plan, QueryCtx_GetGraph(), AlgebraicExpression_Clone(op->ae));
+	OpBase *clone = NewCondTraverseOp(plan, QueryCtx_GetGraph(), AlgebraicExpression_Clone(op->ae));
+	if(op->factorized) CondTraverseOp_Factorize((OpCondTraverse *)clone);
+	return clone;
 }
 
 /* Frees CondTraverse */
@@ -248,9 +331,24 @@ static void CondTraverseFree(OpBase *ctx) {
 	}
 
 	if(op->records) {
-		for(uint i = 0; i < op->record_count; i++) OpBase_DeleteRecord(op->records[i]);
+		_free_records(op);
 		rm_free(op->records);
 		op->records = NULL;
 	}
+
+	if(op->counts) {
+		GrB_free(&op->counts);
+		op->counts = NULL;
+	}
+
+	if(op->rows) {
+		rm_free(op->rows);
+		op->rows = NULL;
+	}
+
+	if(op->row_counts) {
+		rm_free(op->row_counts);
+		op->row_counts = NULL;
+	}
 }
 
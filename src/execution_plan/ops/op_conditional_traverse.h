@@ -28,8 +28,19 @@ typedef struct {
 	uint record_cap;            // Max number of records to process.
 	Record *records;            // Array of records.
 	Record r;                   // Currently selected record.
+	bool factorized;            // Emit a single record per source, see CondTraverseOp_Factorize.
+	GrB_Vector counts;          // Number of destinations reached by each record.
+	GrB_Index *rows;            // Records reaching at least one destination.
+	uint64_t *row_counts;       // Number of destinations reached by rows[i].
+	GrB_Index row_count;        // Number of entries in rows.
+	GrB_Index row_pos;          // Next entry in rows to emit.
 } OpCondTraverse;
 
 /* Creates a new Traverse operation */
 OpBase *NewCondTraverseOp(const ExecutionPlan *plan, Graph *g, AlgebraicExpression *ae);
 
+/* Factorize traversal output, rather than emitting a record for each
+ * reached destination, each source record is emitted once, holding
+ * the number of reached destinations in place of the destination node. */
+void CondTraverseOp_Factorize(OpCondTraverse *op);
+
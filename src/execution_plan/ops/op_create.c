@@ -90,10 +90,7 @@ static void _CreateEdges(OpCreate *op, Record r) {
 		}
 
 		// create the actual edge
-		Edge newEdge = {0};
-		newEdge.relationship = e->relation;
-		Edge_SetSrcNode(&newEdge, src_node);
-		Edge_SetDestNode(&newEdge, dest_node);
+		Edge newEdge = GE_NEW_EDGE();
 		Edge *edge_ref = Record_AddEdge(r, e->edge_idx, newEdge);
 
 		// convert query-level properties
@@ -102,7 +99,9 @@ static void _CreateEdges(OpCreate *op, Record r) {
 		if(map) converted_properties = ConvertPropertyMap(r, map, false);
 
 		// save edge for later insertion
+		PendingEdge pending_edge = { src_node, dest_node, e->relation };
 		array_append(op->pending.created_edges, edge_ref);
+		array_append(op->pending.pending_edges, pending_edge);
 
 		// save properties to insert with node
 		array_append(op->pending.edge_properties, converted_properties);
@@ -0,0 +1,615 @@
+/*
+* Copyright 2018-2021 Redis Labs Ltd. and Contributors
+*
+* This file is available under the Redis Labs Source Available License Agreement
+*/
+
+#include "op_degree_count.h"
+#include "RG.h"
+#include "shared/print_functions.h"
+#include "../../errors.h"
+#include "../../query_ctx.h"
+#include "../../util/arr.h"
+#include "../../util/rmalloc.h"
+
+// forward declarations
+static Record DegreeCountConsume(OpBase *opBase);
+static OpResult DegreeCountReset(OpBase *opBase);
+static OpBase *DegreeCountClone(const ExecutionPlan *plan, const OpBase *opBase);
+static void DegreeCountFree(OpBase *opBase);
+
+// index unary operator mapping a relation matrix entry to the number of
+// edges it represents, multi-edge entries refer to an edge list held by the
+// relation's multi-edge store, which is passed as the operator's scalar
+// created once at module load, shared by all threads
+static GrB_IndexUnaryOp _edge_count_op = NULL;
+
+// vectors involved in reducing relation matrices
+typedef struct {
+	GrB_Vector mask;     // [optional] source nodes possessing all labels
+	GrB_Vector ones;     // vector of ones
+	GrB_Vector counts;   // per source node number of connections
+	GrB_Vector dests;    // [sum] destination nodes reached by the sources
+	GrB_Vector values;   // [sum] per node numeric attribute value
+	GrB_Vector sums;     // [sum] per source node sum of attribute values
+	GrB_Vector invalid;  // [sum] ID of each node holding a none numeric value
+	GrB_Vector reached;  // [sum] sources connected to an invalid node
+} _Reduction;
+
+// relation matrix prepared for reduction
+typedef struct {
+	GrB_Matrix A;    // synced relation matrix
+	bool free;       // 'A' was allocated and should be freed
+	bool weighted;   // entries hold the number of edges they represent
+} _Relation;
+
+static void _edge_count(void *_z, const void *_x, GrB_Index i, GrB_Index j,
+		const void *_y) {
+	uint64_t       *z  =  (uint64_t *)_z;
+	const uint64_t *x  =  (const uint64_t *)_x;
+
+	if(SINGLE_EDGE(*x)) {
+		*z = 1;
+	} else {
+		uint32_t n;
+		const MultiEdgeStore *store =
+			(const MultiEdgeStore *)(*(const uint64_t *)_y);
+		MultiEdgeStore_GetEdges(store, CLEAR_MSB(*x), &n);
+		*z = n;
+	}
+}
+
+static void DegreeCountToString(const OpBase *ctx, sds *buf) {
+	TraversalToString(ctx, buf, ((const OpDegreeCount *)ctx)->ae);
+}
+
+// sets 'A' to the fully synced content of 'C' (M + DP - DM)
+// returns true if 'A' was allocated and should be freed by the caller
+static bool _SyncedMatrix
+(
+	RG_Matrix C,
+	GrB_Matrix *A
+) {
+	GrB_Index dp_nvals;
+	GrB_Index dm_nvals;
+	GrB_Matrix_nvals(&dp_nvals, RG_MATRIX_DELTA_PLUS(C));
+	GrB_Matrix_nvals(&dm_nvals, RG_MATRIX_DELTA_MINUS(C));
+
+	if(dp_nvals == 0 && dm_nvals == 0) {
+		*A = RG_MATRIX_M(C);
+		return false;
+	}
+
+	GrB_Info info = RG_Matrix_export(A, C);
+	ASSERT(info == GrB_SUCCESS);
+	return true;
+}
+
+// builds a mask vector holding every node possessing all source labels
+// returns false if one of the labels doesn't exist
+static bool _BuildLabelMask
+(
+	OpDegreeCount *op,
+	GrB_Index dim,
+	GrB_Vector *mask
+) {
+	GrB_Info      info;
+	GraphContext  *gc           =  QueryCtx_GetGraphCtx();
+	uint          label_count   =  array_len(op->labels);
+
+	*mask = NULL;
+
+	for(uint i = 0; i < label_count; i++) {
+		Schema *s = GraphContext_GetSchema(gc, op->labels[i], SCHEMA_NODE);
+		if(s == NULL) {
+			// missing label, no node can satisfy the mask
+			if(*mask != NULL) GrB_free(mask);
+			return false;
+		}
+
+		GrB_Matrix  L;
+		GrB_Vector  d;
+		bool        free_L  =  _SyncedMatrix(Graph_GetLabelMatrix(op->g, s->id), &L);
+
+		info = GrB_Vector_new(&d, GrB_BOOL, dim);
+		ASSERT(info == GrB_SUCCESS);
+		info = GxB_Vector_diag(d, L, 0, NULL);
+		ASSERT(info == GrB_SUCCESS);
+		if(free_L) GrB_free(&L);
+
+		if(*mask == NULL) {
+			*mask = d;
+		} else {
+			// intersect with previous labels
+			info = GrB_Vector_eWiseMult_BinaryOp(*mask, NULL, NULL, GrB_LAND,
+					*mask, d, NULL);
+			ASSERT(info == GrB_SUCCESS);
+			GrB_free(&d);
+		}
+	}
+
+	return true;
+}
+
+// syncs relation matrix 'R' for reduction
+// when counting edges, multi-edge entries are replaced by their edge count
+static _Relation _PrepareRelation
+(
+	OpDegreeCount *op,
+	RG_Matrix R,            // relation matrix
+	bool multi_edge         // R contains multi-edge entries
+) {
+	_Relation rel = {.weighted = false};
+	rel.free = _SyncedMatrix(R, &rel.A);
+
+	if(op->count_edges && multi_edge) {
+		// replace each entry with the number of edges it represents
+		GrB_Info    info;
+		GrB_Index   nrows;
+		GrB_Index   ncols;
+		GrB_Matrix  E;
+		GrB_Matrix_nrows(&nrows, rel.A);
+		GrB_Matrix_ncols(&ncols, rel.A);
+
+		ASSERT(_edge_count_op != NULL);
+		info = GrB_Matrix_new(&E, GrB_UINT64, nrows, ncols);
+		ASSERT(info == GrB_SUCCESS);
+		info = GrB_Matrix_apply_IndexOp_UINT64(E, NULL, NULL, _edge_count_op,
+				rel.A, (uint64_t)RG_MATRIX_MULTI_EDGE_STORE(R), NULL);
+		ASSERT(info == GrB_SUCCESS);
+
+		if(rel.free) GrB_free(&rel.A);
+		rel.A         =  E;
+		rel.free      =  true;
+		rel.weighted  =  true;
+	}
+
+	return rel;
+}
+
+// dests |= R' * sources or dests |= R * sources when transposed
+static void _ReachDestinations
+(
+	OpDegreeCount *op,
+	const _Relation *rel,
+	_Reduction *red
+) {
+	GrB_Vector      sources  =  (red->mask) ? red->mask : red->ones;
+	GrB_Descriptor  desc     =  (op->transpose) ? NULL : GrB_DESC_T0;
+
+	GrB_Info info = GrB_mxv(red->dests, NULL, GrB_LOR, GxB_ANY_PAIR_BOOL,
+			rel->A, sources, desc);
+	ASSERT(info == GrB_SUCCESS);
+}
+
+// counts<mask> += R * 1 or counts<mask> += R' * 1 when transposed
+// when summing an attribute, sums<mask> += R * values
+static void _ReduceRelation
+(
+	OpDegreeCount *op,
+	const _Relation *rel,
+	_Reduction *red
+) {
+	GrB_Info      info;
+	GrB_Semiring  semiring;
+
+	GrB_Descriptor desc;
+	if(red->mask) desc = (op->transpose) ? GrB_DESC_ST0 : GrB_DESC_S;
+	else          desc = (op->transpose) ? GrB_DESC_T0  : NULL;
+
+	semiring = (rel->weighted) ? GrB_PLUS_TIMES_SEMIRING_UINT64 :
+		GxB_PLUS_PAIR_UINT64;
+	info = GrB_mxv(red->counts, red->mask, GrB_PLUS_UINT64, semiring, rel->A,
+			red->ones, desc);
+	ASSERT(info == GrB_SUCCESS);
+
+	if(red->sums != NULL) {
+		// weighted entries hold the number of edges they represent
+		semiring = (rel->weighted) ? GrB_PLUS_TIMES_SEMIRING_FP64 :
+			GxB_PLUS_SECOND_FP64;
+		info = GrB_mxv(red->sums, red->mask, GrB_PLUS_FP64, semiring, rel->A,
+				red->values, desc);
+		ASSERT(info == GrB_SUCCESS);
+
+		info = GrB_mxv(red->reached, red->mask, GrB_MAX_UINT64,
+				GxB_ANY_SECOND_UINT64, rel->A, red->invalid, desc);
+		ASSERT(info == GrB_SUCCESS);
+	}
+}
+
+// sets values[i] to the numeric value of reached node i's summed attribute
+// reached nodes holding a none numeric value are recorded in 'invalid'
+// only nodes reached by the sources are visited
+static void _BuildValues
+(
+	OpDegreeCount *op,
+	_Reduction *red
+) {
+	GraphContext *gc = QueryCtx_GetGraphCtx();
+	Attribute_ID attr_id = GraphContext_GetAttributeID(gc, op->attr);
+	if(attr_id == ATTRIBUTE_NOTFOUND) return;
+
+	GrB_Info   info;
+	GrB_Index  n;
+	info = GrB_Vector_nvals(&n, red->dests);
+	ASSERT(info == GrB_SUCCESS);
+	if(n == 0) return;
+
+	GrB_Index  *ids          =  rm_malloc(sizeof(GrB_Index) * n);
+	GrB_Index  *value_ids    =  rm_malloc(sizeof(GrB_Index) * n);
+	GrB_Index  *invalid_ids  =  rm_malloc(sizeof(GrB_Index) * n);
+	double     *values       =  rm_malloc(sizeof(double) * n);
+	GrB_Index  value_count   =  0;
+	GrB_Index  invalid_count =  0;
+
+	info = GrB_Vector_extractTuples_BOOL(ids, NULL, &n, red->dests);
+	ASSERT(info == GrB_SUCCESS);
+
+	for(GrB_Index i = 0; i < n; i++) {
+		Node node = GE_NEW_NODE();
+		Graph_GetNode(op->g, ids[i], &node);
+		SIValue *v = GraphEntity_GetProperty((GraphEntity *)&node, attr_id);
+		if(v == PROPERTY_NOTFOUND || SI_TYPE(*v) == T_NULL) continue;
+
+		if(SI_TYPE(*v) & SI_NUMERIC) {
+			value_ids[value_count] = ids[i];
+			values[value_count++]  = SI_GET_NUMERIC(*v);
+		} else {
+			invalid_ids[invalid_count++] = ids[i];
+		}
+	}
+
+	info = GrB_Vector_build_FP64(red->values, value_ids, values, value_count,
+			GrB_FIRST_FP64);
+	ASSERT(info == GrB_SUCCESS);
+	// invalid[i] = i
+	info = GrB_Vector_build_UINT64(red->invalid, invalid_ids, invalid_ids,
+			invalid_count, GrB_FIRST_UINT64);
+	ASSERT(info == GrB_SUCCESS);
+
+	rm_free(ids);
+	rm_free(values);
+	rm_free(value_ids);
+	rm_free(invalid_ids);
+}
+
+static void _FreeReduction(_Reduction *red) {
+	if(red->mask)     GrB_free(&red->mask);
+	if(red->ones)     GrB_free(&red->ones);
+	if(red->counts)   GrB_free(&red->counts);
+	if(red->dests)    GrB_free(&red->dests);
+	if(red->values)   GrB_free(&red->values);
+	if(red->sums)     GrB_free(&red->sums);
+	if(red->invalid)  GrB_free(&red->invalid);
+	if(red->reached)  GrB_free(&red->reached);
+}
+
+static void _ComputeCounts(OpDegreeCount *op) {
+	GrB_Info      info;
+	_Reduction    red   =  {0};
+	Graph         *g    =  op->g;
+	GraphContext  *gc   =  QueryCtx_GetGraphCtx();
+	GrB_Index     dim   =  Graph_RequiredMatrixDim(g);
+
+	op->n         =  0;
+	op->pos       =  0;
+	op->computed  =  true;
+
+	if(!_BuildLabelMask(op, dim, &red.mask)) return;
+
+	info = GrB_Vector_new(&red.counts, GrB_UINT64, dim);
+	ASSERT(info == GrB_SUCCESS);
+
+	// ones = [1, 1, ... 1]
+	info = GrB_Vector_new(&red.ones, GrB_UINT64, dim);
+	ASSERT(info == GrB_SUCCESS);
+	info = GrB_Vector_assign_UINT64(red.ones, NULL, NULL, 1, GrB_ALL, dim, NULL);
+	ASSERT(info == GrB_SUCCESS);
+
+	if(op->attr != NULL) {
+		info = GrB_Vector_new(&red.values, GrB_FP64, dim);
+		ASSERT(info == GrB_SUCCESS);
+		info = GrB_Vector_new(&red.sums, GrB_FP64, dim);
+		ASSERT(info == GrB_SUCCESS);
+		info = GrB_Vector_new(&red.invalid, GrB_UINT64, dim);
+		ASSERT(info == GrB_SUCCESS);
+		info = GrB_Vector_new(&red.reached, GrB_UINT64, dim);
+		ASSERT(info == GrB_SUCCESS);
+		info = GrB_Vector_new(&red.dests, GrB_BOOL, dim);
+		ASSERT(info == GrB_SUCCESS);
+	}
+
+	//--------------------------------------------------------------------------
+	// collect relation matrices
+	//--------------------------------------------------------------------------
+
+	_Relation *rels = array_new(_Relation, 1);
+	if(op->relations == NULL) {
+		if(op->count_edges) {
+			// sum edges over every relationship type
+			int relation_count = Graph_RelationTypeCount(g);
+			for(int r = 0; r < relation_count; r++) {
+				RG_Matrix R = Graph_GetRelationMatrix(g, r, false);
+				bool multi_edge = Graph_RelationshipContainsMultiEdge(g, r, false);
+				array_append(rels, _PrepareRelation(op, R, multi_edge));
+			}
+		} else {
+			// count connected nodes using the adjacency matrix
+			RG_Matrix ADJ = Graph_GetAdjacencyMatrix(g, false);
+			array_append(rels, _PrepareRelation(op, ADJ, false));
+		}
+	} else {
+		uint relation_count = array_len(op->relations);
+		for(uint i = 0; i < relation_count; i++) {
+			Schema *s = GraphContext_GetSchema(gc, op->relations[i],
+					SCHEMA_EDGE);
+			// unknown relationship type doesn't contribute to the count
+			if(s == NULL) continue;
+
+			RG_Matrix R = Graph_GetRelationMatrix(g, s->id, false);
+			bool multi_edge = Graph_RelationshipContainsMultiEdge(g, s->id,
+					false);
+			array_append(rels, _PrepareRelation(op, R, multi_edge));
+		}
+	}
+
+	//--------------------------------------------------------------------------
+	// reduce
+	//--------------------------------------------------------------------------
+
+	uint rel_count = array_len(rels);
+
+	if(op->attr != NULL) {
+		// values are required only for the reached destinations
+		for(uint i = 0; i < rel_count; i++) {
+			_ReachDestinations(op, rels + i, &red);
+		}
+		_BuildValues(op, &red);
+	}
+
+	for(uint i = 0; i < rel_count; i++) {
+		_ReduceRelation(op, rels + i, &red);
+		if(rels[i].free) GrB_free(&rels[i].A);
+	}
+	array_free(rels);
+
+	if(red.reached != NULL) {
+		// summing a none numeric value is an error
+		GrB_Index reached;
+		info = GrB_Vector_nvals(&reached, red.reached);
+		ASSERT(info == GrB_SUCCESS);
+		if(reached > 0) {
+			// report the value of one of the reached invalid nodes
+			uint64_t id;
+			info = GrB_Vector_reduce_UINT64(&id, NULL, GrB_MAX_MONOID_UINT64,
+					red.reached, NULL);
+			ASSERT(info == GrB_SUCCESS);
+			_FreeReduction(&red);
+
+			Node node = GE_NEW_NODE();
+			Graph_GetNode(g, id, &node);
+			Attribute_ID attr_id = GraphContext_GetAttributeID(gc, op->attr);
+			SIValue *v = GraphEntity_GetProperty((GraphEntity *)&node, attr_id);
+			Error_SITypeMismatch(*v, T_NULL | T_INT64 | T_DOUBLE);
+			ErrorCtx_RaiseRuntimeException(NULL);
+			return;
+		}
+	}
+
+	info = GrB_Vector_nvals(&op->n, red.counts);
+	ASSERT(info == GrB_SUCCESS);
+
+	if(op->n > 0) {
+		op->ids     =  rm_malloc(sizeof(GrB_Index) * op->n);
+		op->counts  =  rm_malloc(sizeof(uint64_t) * op->n);
+		info = GrB_Vector_extractTuples_UINT64(op->ids, op->counts, &op->n,
+				red.counts);
+		ASSERT(info == GrB_SUCCESS);
+	}
+
+	if(red.sums != NULL && op->n > 0) {
+		// sources connected only to nodes missing the attribute sum to 0
+		// sums<counts> = 0, sums += previously summed values
+		GrB_Vector sums;
+		info = GrB_Vector_new(&sums, GrB_FP64, dim);
+		ASSERT(info == GrB_SUCCESS);
+		info = GrB_Vector_assign_FP64(sums, red.counts, NULL, 0, GrB_ALL, dim,
+				GrB_DESC_S);
+		ASSERT(info == GrB_SUCCESS);
+		info = GrB_Vector_eWiseAdd_BinaryOp(sums, NULL, NULL, GrB_PLUS_FP64,
+				sums, red.sums, NULL);
+		ASSERT(info == GrB_SUCCESS);
+
+		GrB_Index n = op->n;
+		op->sums = rm_malloc(sizeof(double) * n);
+		info = GrB_Vector_extractTuples_FP64(NULL, op->sums, &n, sums);
+		ASSERT(info == GrB_SUCCESS);
+		ASSERT(n == op->n);
+		GrB_free(&sums);
+	}
+
+	_FreeReduction(&red);
+}
+
+OpBase *NewDegreeCountOp
+(
+	const ExecutionPlan *plan,
+	Graph *g,
+	AlgebraicExpression *ae,
+	const char **labels,
+	const char **relations,
+	bool transpose,
+	bool count_edges,
+	const char *node_alias,
+	const char *count_alias
+) {
+	ASSERT(g           != NULL);
+	ASSERT(ae          != NULL);
+	ASSERT(labels      != NULL);
+	ASSERT(node_alias  != NULL);
+	ASSERT(count_alias != NULL);
+
+	OpDegreeCount *op = rm_malloc(sizeof(OpDegreeCount));
+	op->g            =  g;
+	op->ae           =  ae;
+	op->labels       =  labels;
+	op->relations    =  relations;
+	op->transpose    =  transpose;
+	op->count_edges  =  count_edges;
+	op->sum          =  false;
+	op->constant     =  1;
+	op->attr         =  NULL;
+	op->ids          =  NULL;
+	op->counts       =  NULL;
+	op->sums         =  NULL;
+	op->n            =  0;
+	op->pos          =  0;
+	op->computed     =  false;
+
+	OpBase_Init((OpBase *)op, OPType_DEGREE_COUNT, "Degree Count", NULL,
+				DegreeCountConsume, DegreeCountReset, DegreeCountToString,
+				DegreeCountClone, DegreeCountFree, false, plan);
+
+	op->nodeRecIdx = OpBase_Modifies((OpBase *)op, node_alias);
+	op->countRecIdx = OpBase_Modifies((OpBase *)op, count_alias);
+
+	return (OpBase *)op;
+}
+
+void DegreeCountOp_SumConstant
+(
+	OpDegreeCount *op,
+	double constant
+) {
+	ASSERT(op != NULL);
+	ASSERT(!op->sum);
+
+	op->sum       =  true;
+	op->constant  =  constant;
+}
+
+void DegreeCountOp_SumAttribute
+(
+	OpDegreeCount *op,
+	const char *attr
+) {
+	ASSERT(op   != NULL);
+	ASSERT(attr != NULL);
+	ASSERT(!op->sum);
+
+	op->sum   =  true;
+	op->attr  =  rm_strdup(attr);
+}
+
+bool DegreeCountOp_Init(void) {
+	ASSERT(_edge_count_op == NULL);
+
+	GrB_Info info = GrB_IndexUnaryOp_new(&_edge_count_op, _edge_count,
+			GrB_UINT64, GrB_UINT64, GrB_UINT64);
+
+	return (info == GrB_SUCCESS);
+}
+
+void DegreeCountOp_Finalize(void) {
+	if(_edge_count_op != NULL) GrB_free(&_edge_count_op);
+}
+
+static Record DegreeCountConsume(OpBase *opBase) {
+	OpDegreeCount *op = (OpDegreeCount *)opBase;
+
+	// reduce on first call
+	if(!op->computed) _ComputeCounts(op);
+
+	if(op->pos >= op->n) return NULL;
+
+	Record r = OpBase_CreateRecord(opBase);
+
+	Node n = GE_NEW_NODE();
+	Graph_GetNode(op->g, op->ids[op->pos], &n);
+	Record_AddNode(r, op->nodeRecIdx, n);
+
+	SIValue v;
+	if(!op->sum)              v = SI_LongVal(op->counts[op->pos]);
+	else if(op->attr == NULL) v = SI_DoubleVal(op->counts[op->pos] * op->constant);
+	else                      v = SI_DoubleVal(op->sums[op->pos]);
+	Record_AddScalar(r, op->countRecIdx, v);
+
+	op->pos++;
+	return r;
+}
+
+static void _FreeCounts(OpDegreeCount *op) {
+	if(op->ids) {
+		rm_free(op->ids);
+		op->ids = NULL;
+	}
+
+	if(op->counts) {
+		rm_free(op->counts);
+		op->counts = NULL;
+	}
+
+	if(op->sums) {
+		rm_free(op->sums);
+		op->sums = NULL;
+	}
+
+	op->n         =  0;
+	op->pos       =  0;
+	op->computed  =  false;
+}
+
+static OpResult DegreeCountReset(OpBase *opBase) {
+	OpDegreeCount *op = (OpDegreeCount *)opBase;
+	// counts are recomputed as the graph might have changed
+	_FreeCounts(op);
+	return OP_OK;
+}
+
+static OpBase *DegreeCountClone(const ExecutionPlan *plan, const OpBase *opBase) {
+	ASSERT(opBase->type == OPType_DEGREE_COUNT);
+	OpDegreeCount *op = (OpDegreeCount *)opBase;
+
+	const char **labels;
+	const char **relations = NULL;
+	array_clone(labels, op->labels);
+	if(op->relations) array_clone(relations, op->relations);
+
+	OpDegreeCount *clone = (OpDegreeCount *)NewDegreeCountOp(plan,
+			QueryCtx_GetGraph(), AlgebraicExpression_Clone(op->ae), labels,
+			relations, op->transpose, op->count_edges, opBase->modifies[0],
+			opBase->modifies[1]);
+
+	if(op->sum) {
+		if(op->attr) DegreeCountOp_SumAttribute(clone, op->attr);
+		else DegreeCountOp_SumConstant(clone, op->constant);
+	}
+
+	return (OpBase *)clone;
+}
+
+static void DegreeCountFree(OpBase *opBase) {
+	OpDegreeCount *op = (OpDegreeCount *)opBase;
+
+	_FreeCounts(op);
+
+	if(op->ae) {
+		AlgebraicExpression_Free(op->ae);
+		op->ae = NULL;
+	}
+
+	if(op->labels) {
+		array_free(op->labels);
+		op->labels = NULL;
+	}
+
+	if(op->relations) {
+		array_free(op->relations);
+		op->relations = NULL;
+	}
+
+	if(op->attr) {
+		rm_free(op->attr);
+		op->attr = NULL;
+	}
+}
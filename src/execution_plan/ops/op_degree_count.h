@@ -0,0 +1,77 @@
+/*
+* Copyright 2018-2021 Redis Labs Ltd. and Contributors
+*
+* This file is available under the Redis Labs Source Available License Agreement
+*/
+
+#pragma once
+
+#include "op.h"
+#include "../execution_plan.h"
+#include "../../graph/graph.h"
+#include "../../arithmetic/algebraic_expression.h"
+#include "../../../deps/GraphBLAS/Include/GraphBLAS.h"
+
+// DegreeCount computes the number of outgoing (or incoming) connections
+// of every source node in a single GraphBLAS reduction, replacing a
+// Scan -> Conditional Traverse -> Aggregate chain of the form:
+// MATCH (a:L)-[e:R]->(b) RETURN a, count(e)
+// each emitted record holds a source node and its count
+// connections can be summed rather than counted, either by a constant
+// or by an attribute of the connected nodes:
+// MATCH (a:L)-[:R]->(b) RETURN a, sum(b.score)
+
+typedef struct {
+	OpBase op;
+	Graph *g;
+	AlgebraicExpression *ae;    // traversal expression, used for printing
+	const char **labels;        // source node labels, acts as a row mask
+	const char **relations;     // relationship types to reduce, NULL for any
+	bool transpose;             // count incoming connections
+	bool count_edges;           // count edges rather than connected nodes
+	bool sum;                   // sum connections rather than count them
+	double constant;            // summed constant, used if 'attr' is NULL
+	char *attr;                 // summed attribute of connected nodes
+	int nodeRecIdx;             // source node position within record
+	int countRecIdx;            // count position within record
+	GrB_Index *ids;             // source node IDs
+	uint64_t *counts;           // per source node count
+	double *sums;               // per source node sum
+	GrB_Index n;                // number of source nodes
+	GrB_Index pos;              // current position within ids
+	bool computed;              // true if counts have been computed
+} OpDegreeCount;
+
+OpBase *NewDegreeCountOp
+(
+	const ExecutionPlan *plan,  // execution plan
+	Graph *g,                   // graph
+	AlgebraicExpression *ae,    // traversal expression
+	const char **labels,        // source node labels
+	const char **relations,     // relationship types
+	bool transpose,             // count incoming connections
+	bool count_edges,           // count edges rather than connected nodes
+	const char *node_alias,     // alias of emitted source node
+	const char *count_alias     // alias of emitted count
+);
+
+// sum 'constant' for each connection rather than counting connections
+void DegreeCountOp_SumConstant
+(
+	OpDegreeCount *op,          // degree count operation
+	double constant             // summed constant
+);
+
+// sum 'attr' of connected nodes rather than counting connections
+void DegreeCountOp_SumAttribute
+(
+	OpDegreeCount *op,          // degree count operation
+	const char *attr            // summed attribute
+);
+
+// creates the GraphBLAS operator shared by all degree count operations
+// must be called once, after GraphBLAS is initialized
+bool DegreeCountOp_Init(void);
+
+// frees the GraphBLAS operator shared by all degree count operations
+void DegreeCountOp_Finalize(void);
@@ -30,6 +30,11 @@ void _DeleteEntities(OpDelete *op) {
 	// lock everything
 	QueryCtx_LockForCommit();
 
+	// apply buffered index updates before entities are removed from the graph
+	// as entities deleted implicitly, e.g. edges of a deleted node
+	// aren't removed from the buffer
+	QueryCtx_FlushIndexBuffer();
+
 	if(GraphContext_HasIndices(op->gc)) {
 		for(int i = 0; i < node_count; i++) {
 			Node *n = op->deleted_nodes + i;
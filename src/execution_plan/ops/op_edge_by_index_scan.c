@@ -153,7 +153,7 @@ static inline void _UpdateRecord
 	int res;
 	UNUSED(res);
 	
-	Edge  e     = GE_NEW_LABELED_EDGE(op->edge->reltypes[0], op->edge->reltypeIDs[0]);
+	Edge  e     = GE_NEW_LABELED_EDGE(op->edge->reltypeIDs[0]);
 
 	EntityID  src_id   =  edge_key->src_id;
 	EntityID  dest_id  =  edge_key->dest_id;
@@ -292,6 +292,8 @@ pull_index:
 
 		// create iterator
 		ASSERT(rs_query_node != NULL);
+		// observe index updates made by this query
+		QueryCtx_FlushIndexBuffer();
 		op->iter = RediSearch_GetResultsIterator(rs_query_node, op->idx);
 	} else {
 		// build index query only once (first call)
@@ -301,6 +303,8 @@ pull_index:
 			RSQNode *rs_query_node = FilterTreeToQueryNode(
 					&op->unresolved_filters, op->filter, op->idx);
 			ASSERT(rs_query_node != NULL);
+			// observe index updates made by this query
+			QueryCtx_FlushIndexBuffer();
 			op->iter = RediSearch_GetResultsIterator(rs_query_node, op->idx);
 		} else {
 			// reset existing iterator
@@ -325,6 +329,8 @@ static Record EdgeIndexScanConsume
 		RSQNode *rs_query_node = FilterTreeToQueryNode(&op->unresolved_filters,
 				op->filter, op->idx);
 
+		// observe index updates made by this query
+		QueryCtx_FlushIndexBuffer();
 		op->iter = RediSearch_GetResultsIterator(rs_query_node, op->idx);
 	}
 
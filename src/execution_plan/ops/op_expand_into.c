@@ -9,7 +9,9 @@
 #include "../../query_ctx.h"
 
 // default number of records to accumulate before traversing
-#define BATCH_SIZE 16
+// connectivity of a batch is computed by a single masked multiplication
+// which favors large batches
+#define BATCH_SIZE 256
 
 // forward declarations
 static OpResult ExpandIntoInit(OpBase *opBase);
@@ -27,16 +29,19 @@ static inline void ExpandIntoToString
 	TraversalToString(ctx, buf, ((const OpExpandInto *)ctx)->ae);
 }
 
-// construct filter matrix F
+// construct filter matrix F and destination matrix D
 // F[i,j] = 1 if row the ith record ID(src) = j
+// D[i,j] = 1 if row the ith record ID(dest) = j
 static void _populate_filter_matrix
 (
 	OpExpandInto *op
 ) {
 	GrB_Matrix FM = RG_MATRIX_M(op->F);
+	GrB_Matrix DM = op->D;
 
-	// clear filter matrix
+	// clear filter and destination matrices
 	GrB_Matrix_clear(FM);
+	GrB_Matrix_clear(DM);
 
 	for(uint i = 0; i < op->record_count; i++) {
 		Record r = op->records[i];
@@ -46,16 +51,23 @@ static void _populate_filter_matrix
 		Node *n = Record_GetNode(r, op->srcNodeIdx);
 		NodeID srcId = ENTITY_GET_ID(n);
 		GrB_Matrix_setElement_BOOL(FM, true, i, srcId);
+
+		// update destination matrix D
+		// set row i at position destId
+		// D[i, destId] = true
+		n = Record_GetNode(r, op->destNodeIdx);
+		NodeID destId = ENTITY_GET_ID(n);
+		GrB_Matrix_setElement_BOOL(DM, true, i, destId);
 	}
 
 	GrB_Matrix_wait(FM, GrB_MATERIALIZE);
+	GrB_Matrix_wait(DM, GrB_MATERIALIZE);
 }
 
 // evaluate algebraic expression:
 // appends filter matrix as the left most operand
-// perform multiplications
-// removed filter matrix from original expression
-// clears filter matrix
+// perform multiplications, masked by the destination matrix
+// such that only the requested (src, dest) pairs are computed
 static void _traverse
 (
 	OpExpandInto *op
@@ -66,6 +78,7 @@ static void _traverse
 		size_t required_dim = Graph_RequiredMatrixDim(op->graph);
 		RG_Matrix_new(&op->M, GrB_BOOL, op->record_cap, required_dim);
 		RG_Matrix_new(&op->F, GrB_BOOL, op->record_cap, required_dim);
+		GrB_Matrix_new(&op->D, GrB_BOOL, op->record_cap, required_dim);
 
 		// prepend the filter matrix to algebraic expression
 		// as the leftmost operand
@@ -77,7 +90,8 @@ static void _traverse
 	_populate_filter_matrix(op);
 
 	// evaluate expression
-	AlgebraicExpression_Eval(op->ae, op->M);
+	// M[i, dest] is computed only for the ith record destination
+	AlgebraicExpression_EvalMasked(op->ae, op->D, op->M);
 }
 
 OpBase *NewExpandIntoOp
@@ -90,6 +104,7 @@ OpBase *NewExpandIntoOp
 
 	op->r               =  NULL;
 	op->F               =  NULL;
+	op->D               =  NULL;
 	op->M               =  NULL;
 	op->ae              =  ae;
 	op->graph           =  g;
@@ -222,10 +237,9 @@ static Record _handoff
 
 		Node *destNode  =  Record_GetNode(r, op->destNodeIdx);
 		NodeID col      =  ENTITY_GET_ID(destNode);
-		// TODO: in the case of multiple operands ()-[:A]->()-[:B]->()
-		// M is the result of F*A*B, in which case we can switch from
-		// M being a RG_Matrix to a GrB_Matrix, making the extract element
-		// operation a bit cheaper to compute
+		// in the case of multiple operands ()-[:A]->()-[:B]->()
+		// M is the result of F*A*B masked by D, which restricts
+		// each row to the record's destination
 		GrB_Info res    =  RG_Matrix_extractElement_BOOL(&x, op->M, row, col);
 
 		// src is not connected to dest, free the current record and continue
@@ -305,6 +319,9 @@ static Record ExpandIntoConsume
 		// did not managed to produce data, depleted
 		if(op->record_count == 0) return NULL;
 
+		// check for cancellation before evaluating the traversal
+		if(OpBase_Cancelled(opBase)) return NULL;
+
 		if(!op->single_operand) _traverse(op);
 	}
 
@@ -356,6 +373,11 @@ static void ExpandIntoFree
 		op->F = NULL;
 	}
 
+	if(op->D != NULL) {
+		GrB_free(&op->D);
+		op->D = NULL;
+	}
+
 	if(op->ae != NULL) {
 		// M was allocated by us
 		if(op->M != NULL && !op->single_operand) {
@@ -18,6 +18,7 @@ typedef struct {
 	Graph *graph;
 	AlgebraicExpression *ae;
 	RG_Matrix F;                // filter matrix
+	GrB_Matrix D;               // destination matrix, pairs to check
 	RG_Matrix M;                // algebraic expression result
 	EdgeTraverseCtx *edge_ctx;  // edge collection data if the edge needs to be set
 	int srcNodeIdx;             // source node index into record
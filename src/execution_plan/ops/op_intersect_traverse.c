@@ -0,0 +1,480 @@
+/*
+* Copyright 2018-2021 Redis Labs Ltd. and Contributors
+*
+* This file is available under the Redis Labs Source Available License Agreement
+*/
+
+#include "op_intersect_traverse.h"
+#include "RG.h"
+#include "../../util/arr.h"
+#include "../../query_ctx.h"
+
+// forward declarations
+static Record IntersectTraverseConsume(OpBase *opBase);
+static Record IntersectTraverseNoOp(OpBase *opBase);
+static OpResult IntersectTraverseReset(OpBase *opBase);
+static OpBase *IntersectTraverseClone(const ExecutionPlan *plan, const OpBase *opBase);
+static void IntersectTraverseFree(OpBase *opBase);
+
+// print destination node, e.g. (c:L)
+static void _DestToString
+(
+	const OpIntersectTraverse *op,
+	sds *buf
+) {
+	*buf = sdscatprintf(*buf, "(%s", op->dest);
+	uint label_count = array_len(op->labels);
+	for(uint i = 0; i < label_count; i++) {
+		*buf = sdscatprintf(*buf, ":%s", op->labels[i]);
+	}
+	*buf = sdscatprintf(*buf, ")");
+}
+
+// string representation of operation
+// Intersect Traverse | (a)-[:F]->(c), (b)<-[:F]-(c)
+static void IntersectTraverseToString
+(
+	const OpBase *ctx,
+	sds *buf
+) {
+	const OpIntersectTraverse *op = (const OpIntersectTraverse *)ctx;
+
+	*buf = sdscatprintf(*buf, "%s | ", ctx->name);
+	uint constraint_count = array_len(op->constraints);
+	for(uint i = 0; i < constraint_count; i++) {
+		const IntersectConstraint *c = op->constraints + i;
+		if(i > 0) *buf = sdscatprintf(*buf, ", ");
+
+		*buf = sdscatprintf(*buf, "(%s)%s[", c->alias, c->transpose ? "<-" : "-");
+		if(c->relation != NULL) *buf = sdscatprintf(*buf, ":%s", c->relation);
+		*buf = sdscatprintf(*buf, "]%s", c->transpose ? "-" : "->");
+		_DestToString(op, buf);
+	}
+}
+
+OpBase *NewIntersectTraverseOp
+(
+	const ExecutionPlan *plan,
+	Graph *g,
+	const char *dest
+) {
+	ASSERT(g != NULL);
+	ASSERT(dest != NULL);
+
+	OpIntersectTraverse *op = rm_malloc(sizeof(OpIntersectTraverse));
+
+	op->g               =  g;
+	op->r               =  NULL;
+	op->dest            =  dest;
+	op->iter            =  NULL;
+	op->labels          =  array_new(const char *, 0);
+	op->resolved        =  false;
+	op->candidates      =  array_new(NodeID, 0);
+	op->constraints     =  array_new(IntersectConstraint, 2);
+	op->candidate_pos   =  0;
+	op->label_matrices  =  NULL;
+
+	// set our Op operations
+	OpBase_Init((OpBase *)op, OPType_INTERSECT_TRAVERSE, "Intersect Traverse",
+			NULL, IntersectTraverseConsume, IntersectTraverseReset,
+			IntersectTraverseToString, IntersectTraverseClone,
+			IntersectTraverseFree, false, plan);
+
+	op->destNodeIdx = OpBase_Modifies((OpBase *)op, dest);
+
+	return (OpBase *)op;
+}
+
+void IntersectTraverseOp_AddConstraint
+(
+	OpIntersectTraverse *op,
+	const char *alias,
+	const char *relation,
+	bool transpose
+) {
+	ASSERT(op != NULL);
+	ASSERT(alias != NULL);
+
+	IntersectConstraint c;
+
+	c.M          =  NULL;
+	c.row        =  array_new(NodeID, 0);
+	c.alias      =  alias;
+	c.row_id     =  INVALID_ENTITY_ID;
+	c.relation   =  relation;
+	c.transpose  =  transpose;
+
+	// make sure bound node is represented in record
+	bool aware = OpBase_Aware((OpBase *)op, alias, &c.nodeIdx);
+	ASSERT(aware);
+	UNUSED(aware);
+
+	array_append(op->constraints, c);
+}
+
+void IntersectTraverseOp_AddLabel
+(
+	OpIntersectTraverse *op,
+	const char *label
+) {
+	ASSERT(op != NULL);
+	ASSERT(label != NULL);
+
+	array_append(op->labels, label);
+}
+
+// resolve relation and label matrices
+// missing relations are represented by a NULL matrix
+// returns false if any of the destination labels doesn't exists
+static bool _ResolveMatrices
+(
+	OpIntersectTraverse *op
+) {
+	GraphContext *gc = QueryCtx_GetGraphCtx();
+
+	uint constraint_count = array_len(op->constraints);
+	for(uint i = 0; i < constraint_count; i++) {
+		IntersectConstraint *c = op->constraints + i;
+		if(c->relation == NULL) {
+			c->M = Graph_GetAdjacencyMatrix(op->g, c->transpose);
+		} else {
+			Schema *s = GraphContext_GetSchema(gc, c->relation, SCHEMA_EDGE);
+			if(s != NULL) {
+				c->M = Graph_GetRelationMatrix(op->g, Schema_GetID(s), c->transpose);
+			}
+		}
+	}
+
+	uint label_count = array_len(op->labels);
+	op->label_matrices = array_new(RG_Matrix, label_count);
+	for(uint i = 0; i < label_count; i++) {
+		Schema *s = GraphContext_GetSchema(gc, op->labels[i], SCHEMA_NODE);
+		if(s == NULL) return false;
+		array_append(op->label_matrices, Graph_GetLabelMatrix(op->g, s->id));
+	}
+
+	return true;
+}
+
+static int _CompareNodeID
+(
+	const void *a,
+	const void *b
+) {
+	NodeID x = *(const NodeID *)a;
+	NodeID y = *(const NodeID *)b;
+	return (x > y) - (x < y);
+}
+
+// load the neighbours of node 'id' into constraint's row
+// rows are cached, consecutive records sharing a bound node
+// reuse the previously loaded row
+static void _LoadRow
+(
+	OpIntersectTraverse *op,
+	IntersectConstraint *c,
+	NodeID id
+) {
+	if(c->row_id == id) return;
+
+	c->row_id = id;
+	array_clear(c->row);
+	if(c->M == NULL) return;
+
+	if(op->iter == NULL) {
+		RG_MatrixTupleIter_new(&op->iter, c->M);
+	} else {
+		RG_MatrixTupleIter_reuse(op->iter, c->M);
+	}
+	RG_MatrixTupleIter_iterate_row(op->iter, id);
+
+	GrB_Index col;
+	bool sorted = true;
+	bool depleted = false;
+	while(true) {
+		RG_MatrixTupleIter_next(op->iter, NULL, &col, NULL, &depleted);
+		if(depleted) break;
+
+		uint len = array_len(c->row);
+		if(len > 0 && c->row[len - 1] > col) sorted = false;
+		array_append(c->row, col);
+	}
+
+	// pending additions are iterated after the main matrix entries
+	// in which case the row isn't sorted
+	if(!sorted) {
+		qsort(c->row, array_len(c->row), sizeof(NodeID), _CompareNodeID);
+	}
+}
+
+// returns the position of the first element in row[from..len)
+// which is greater or equal to target, len if no such element exists
+// gallops ahead to locate the range holding target
+// followed by a binary search within that range
+static uint _Seek
+(
+	const NodeID *row,
+	uint len,
+	uint from,
+	NodeID target
+) {
+	uint step = 1;
+	uint lo = from;
+	uint hi = from;
+
+	while(hi < len && row[hi] < target) {
+		lo = hi + 1;
+		hi += step;
+		step <<= 1;
+	}
+	if(hi > len) hi = len;
+
+	while(lo < hi) {
+		uint mid = lo + (hi - lo) / 2;
+		if(row[mid] < target) lo = mid + 1;
+		else hi = mid;
+	}
+
+	return lo;
+}
+
+// intersect candidates with row, in place
+static void _IntersectRow
+(
+	OpIntersectTraverse *op,
+	NodeID *row
+) {
+	uint pos = 0;
+	uint count = 0;
+	uint len = array_len(row);
+	uint candidate_count = array_len(op->candidates);
+
+	for(uint i = 0; i < candidate_count && pos < len; i++) {
+		NodeID id = op->candidates[i];
+		pos = _Seek(row, len, pos, id);
+		if(pos < len && row[pos] == id) op->candidates[count++] = id;
+	}
+
+	array_trimm_len(op->candidates, count);
+}
+
+// returns true if node possesses all destination labels
+static inline bool _NodeHasLabels
+(
+	const OpIntersectTraverse *op,
+	NodeID id
+) {
+	uint label_count = array_len(op->label_matrices);
+	for(uint i = 0; i < label_count; i++) {
+		bool x;
+		GrB_Info info = RG_Matrix_extractElement_BOOL(&x,
+				op->label_matrices[i], id, id);
+		if(info != GrB_SUCCESS) return false;
+	}
+
+	return true;
+}
+
+// compute the set of nodes connected to all bound nodes of record r
+// returns false if any of the bound nodes is missing
+static bool _Intersect
+(
+	OpIntersectTraverse *op,
+	Record r
+) {
+	uint constraint_count = array_len(op->constraints);
+	IntersectConstraint *smallest = NULL;
+	ASSERT(constraint_count > 0);
+
+	array_clear(op->candidates);
+	op->candidate_pos = 0;
+
+	// load rows, keeping track of the shortest one
+	for(uint i = 0; i < constraint_count; i++) {
+		IntersectConstraint *c = op->constraints + i;
+		// the record may not contain a bound node in scenarios like
+		// a failed OPTIONAL MATCH
+		Node *n = Record_GetNode(r, c->nodeIdx);
+		if(n == NULL) return false;
+
+		_LoadRow(op, c, ENTITY_GET_ID(n));
+		if(smallest == NULL || array_len(c->row) < array_len(smallest->row)) {
+			smallest = c;
+		}
+	}
+
+	// start with the shortest row
+	// and intersect it with each of the remaining rows
+	uint len = array_len(smallest->row);
+	for(uint i = 0; i < len; i++) array_append(op->candidates, smallest->row[i]);
+
+	for(uint i = 0; i < constraint_count && array_len(op->candidates) > 0; i++) {
+		IntersectConstraint *c = op->constraints + i;
+		if(c == smallest) continue;
+		_IntersectRow(op, c->row);
+	}
+
+	// discard candidates missing any of the destination labels
+	if(array_len(op->label_matrices) > 0) {
+		uint count = 0;
+		uint candidate_count = array_len(op->candidates);
+		for(uint i = 0; i < candidate_count; i++) {
+			NodeID id = op->candidates[i];
+			if(_NodeHasLabels(op, id)) op->candidates[count++] = id;
+		}
+		array_trimm_len(op->candidates, count);
+	}
+
+	return true;
+}
+
+static Record IntersectTraverseConsume
+(
+	OpBase *opBase
+) {
+	OpIntersectTraverse *op = (OpIntersectTraverse *)opBase;
+	OpBase *child = op->op.children[0];
+
+	if(!op->resolved) {
+		op->resolved = true;
+		// a destination label is missing, no node can satisfy the pattern
+		if(!_ResolveMatrices(op)) {
+			OpBase_UpdateConsume(opBase, IntersectTraverseNoOp);
+			return NULL;
+		}
+	}
+
+	// as long as the current record has no more candidates
+	while(op->candidate_pos >= array_len(op->candidates)) {
+		if(op->r != NULL) {
+			OpBase_DeleteRecord(op->r);
+			op->r = NULL;
+		}
+
+		Record r = OpBase_Consume(child);
+		if(r == NULL) return NULL;
+
+		if(!_Intersect(op, r)) {
+			OpBase_DeleteRecord(r);
+			continue;
+		}
+
+		op->r = r;
+	}
+
+	NodeID id = op->candidates[op->candidate_pos++];
+
+	// last candidate, no need to clone op->r
+	Record r;
+	if(op->candidate_pos == array_len(op->candidates)) {
+		r = op->r;
+		op->r = NULL;
+	} else {
+		r = OpBase_CloneRecord(op->r);
+	}
+
+	// populate the destination node and add it to the record
+	Node destNode = GE_NEW_NODE();
+	Graph_GetNode(op->g, id, &destNode);
+	Record_AddNode(r, op->destNodeIdx, destNode);
+
+	return r;
+}
+
+static Record IntersectTraverseNoOp
+(
+	OpBase *opBase
+) {
+	return NULL;
+}
+
+static OpResult IntersectTraverseReset
+(
+	OpBase *ctx
+) {
+	OpIntersectTraverse *op = (OpIntersectTraverse *)ctx;
+
+	if(op->r != NULL) {
+		OpBase_DeleteRecord(op->r);
+		op->r = NULL;
+	}
+
+	array_clear(op->candidates);
+	op->candidate_pos = 0;
+
+	// invalidate cached rows, the graph may have been modified
+	uint constraint_count = array_len(op->constraints);
+	for(uint i = 0; i < constraint_count; i++) {
+		op->constraints[i].row_id = INVALID_ENTITY_ID;
+	}
+
+	return OP_OK;
+}
+
+static OpBase *IntersectTraverseClone
+(
+	const ExecutionPlan *plan,
+	const OpBase *opBase
+) {
+	ASSERT(opBase->type == OPType_INTERSECT_TRAVERSE);
+
+	const OpIntersectTraverse *op = (const OpIntersectTraverse *)opBase;
+	OpIntersectTraverse *clone =
+		(OpIntersectTraverse *)NewIntersectTraverseOp(plan, op->g, op->dest);
+
+	uint constraint_count = array_len(op->constraints);
+	for(uint i = 0; i < constraint_count; i++) {
+		const IntersectConstraint *c = op->constraints + i;
+		IntersectTraverseOp_AddConstraint(clone, c->alias, c->relation,
+				c->transpose);
+	}
+
+	uint label_count = array_len(op->labels);
+	for(uint i = 0; i < label_count; i++) {
+		IntersectTraverseOp_AddLabel(clone, op->labels[i]);
+	}
+
+	return (OpBase *)clone;
+}
+
+static void IntersectTraverseFree
+(
+	OpBase *ctx
+) {
+	OpIntersectTraverse *op = (OpIntersectTraverse *)ctx;
+
+	if(op->r != NULL) {
+		OpBase_DeleteRecord(op->r);
+		op->r = NULL;
+	}
+
+	if(op->iter != NULL) {
+		RG_MatrixTupleIter_free(&op->iter);
+		op->iter = NULL;
+	}
+
+	if(op->constraints != NULL) {
+		uint constraint_count = array_len(op->constraints);
+		for(uint i = 0; i < constraint_count; i++) {
+			array_free(op->constraints[i].row);
+		}
+		array_free(op->constraints);
+		op->constraints = NULL;
+	}
+
+	if(op->labels != NULL) {
+		array_free(op->labels);
+		op->labels = NULL;
+	}
+
+	if(op->label_matrices != NULL) {
+		array_free(op->label_matrices);
+		op->label_matrices = NULL;
+	}
+
+	if(op->candidates != NULL) {
+		array_free(op->candidates);
+		op->candidates = NULL;
+	}
+}
+
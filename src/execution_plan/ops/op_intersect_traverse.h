@@ -0,0 +1,69 @@
+/*
+* Copyright 2018-2021 Redis Labs Ltd. and Contributors
+*
+* This file is available under the Redis Labs Source Available License Agreement
+*/
+
+#pragma once
+
+#include "op.h"
+#include "../execution_plan.h"
+#include "../../graph/graph.h"
+#include "../../graph/rg_matrix/rg_matrix_iter.h"
+
+// a single relationship the destination node must satisfy
+// the destination node is required to appear on row 'alias' of M
+typedef struct {
+	const char *alias;     // bound node alias
+	const char *relation;  // relationship type, NULL for any relationship
+	bool transpose;        // traverse incoming edges
+	int nodeIdx;           // bound node index into record
+	RG_Matrix M;           // relation matrix, NULL if relation doesn't exists
+	NodeID row_id;         // ID of the node currently loaded into row
+	NodeID *row;           // sorted neighbours of node 'row_id'
+} IntersectConstraint;
+
+// Intersect Traverse resolves a node connected to several bound nodes
+// e.g. MATCH (a)-[:F]->(c)<-[:F]-(b)
+// where both 'a' and 'b' are known, 'c' is resolved by intersecting
+// the rows of 'a' and 'b' in the relevant relation matrices
+typedef struct {
+	OpBase op;
+	Graph *g;
+	const char *dest;                  // destination node alias
+	int destNodeIdx;                   // destination node index into record
+	IntersectConstraint *constraints;  // rows to intersect
+	const char **labels;               // destination node labels
+	RG_Matrix *label_matrices;         // destination node label matrices
+	RG_MatrixTupleIter *iter;          // iterator used to load rows
+	NodeID *candidates;                // intersection of all rows
+	uint candidate_pos;                // next candidate to emit
+	Record r;                          // currently expanded record
+	bool resolved;                     // matrices resolved
+} OpIntersectTraverse;
+
+OpBase *NewIntersectTraverseOp
+(
+	const ExecutionPlan *plan,
+	Graph *g,
+	const char *dest
+);
+
+// require destination node to be connected to 'alias' via 'relation'
+// when transpose is set, destination is required to be the source
+// of the relationship, e.g. (dest)-[:relation]->(alias)
+void IntersectTraverseOp_AddConstraint
+(
+	OpIntersectTraverse *op,
+	const char *alias,
+	const char *relation,
+	bool transpose
+);
+
+// require destination node to be labeled as 'label'
+void IntersectTraverseOp_AddLabel
+(
+	OpIntersectTraverse *op,
+	const char *label
+);
+
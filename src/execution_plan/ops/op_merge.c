@@ -11,6 +11,7 @@
 #include "../../query_ctx.h"
 #include "../../schema/schema.h"
 #include "../../util/rax_extensions.h"
+#include "../../graph/rg_matrix/rg_matrix_iter.h"
 #include "../../arithmetic/arithmetic_expression.h"
 #include "../execution_plan_build/execution_plan_modify.h"
 
@@ -94,6 +95,205 @@ static OpBase *_LocateOp(OpBase *root, OPType type) {
 	return NULL;
 }
 
+//------------------------------------------------------------------------------
+// Batched match logic
+//------------------------------------------------------------------------------
+
+// determine if the pattern's existing matches can be resolved in bulk
+// this is the case for a single labeled node with inline properties
+// e.g. UNWIND $rows AS row MERGE (n:User {id: row.id})
+// in which case the Match stream is a label or index scan
+// returns the merged node, NULL if the pattern can't be batched
+static NodeCreateCtx *_BatchableNode
+(
+	OpMerge *op,
+	uint input_count  // number of records produced by the bound stream
+) {
+	if(input_count == 0) return NULL;
+
+	OpMergeCreate *create = (OpMergeCreate *)_LocateOp(op->create_stream,
+			OPType_MERGE_CREATE);
+	if(array_len(create->pending.nodes_to_create) != 1 ||
+	   array_len(create->pending.edges_to_create) != 0) return NULL;
+
+	NodeCreateCtx *n = create->pending.nodes_to_create;
+	if(array_len(n->labels) != 1 || n->properties == NULL) return NULL;
+
+	// Match stream must only scan the merged node
+	// Argument -> Label/Index Scan -> [Filter]
+	OpBase *scan = NULL;
+	OpBase *child = op->match_stream;
+	while(child != NULL) {
+		if(child->childCount > 1) return NULL;
+		switch(child->type) {
+			case OPType_FILTER:
+			case OPType_ARGUMENT:
+				break;
+			case OPType_NODE_BY_LABEL_SCAN:
+			case OPType_NODE_BY_INDEX_SCAN:
+				if(scan != NULL) return NULL;
+				scan = child;
+				break;
+			default:
+				return NULL;
+		}
+		child = (child->childCount > 0) ? child->children[0] : NULL;
+	}
+
+	if(scan == NULL || strcmp(scan->modifies[0], n->alias) != 0) return NULL;
+
+	// an index lookup per record is cheaper than scanning a large label
+	if(scan->type == OPType_NODE_BY_INDEX_SCAN) {
+		GraphContext *gc = QueryCtx_GetGraphCtx();
+		Schema *s = GraphContext_GetSchema(gc, n->labels[0], SCHEMA_NODE);
+		if(s != NULL) {
+			uint64_t label_count = Graph_LabeledNodeCount(gc->g, Schema_GetID(s));
+			if(label_count > (uint64_t)input_count * MERGE_BATCH_SCAN_FACTOR) {
+				return NULL;
+			}
+		}
+	}
+
+	return n;
+}
+
+// hash a set of merged property values
+static XXH64_hash_t _HashProperties
+(
+	const SIValue *values,
+	int count
+) {
+	XXH64_state_t state;
+	XXH_errorcode res = XXH64_reset(&state, 0);
+	UNUSED(res);
+	ASSERT(res != XXH_ERROR);
+
+	for(int i = 0; i < count; i++) SIValue_HashUpdate(values[i], &state);
+
+	return XXH64_digest(&state);
+}
+
+// collect the properties of 'n' specified by 'map'
+// returns false if any of the properties is missing
+static bool _GetNodeProperties
+(
+	const Node *n,
+	const PropertyMap *map,
+	SIValue *values
+) {
+	for(int i = 0; i < map->property_count; i++) {
+		SIValue *v = GraphEntity_GetProperty((GraphEntity *)n, map->keys[i]);
+		if(v == PROPERTY_NOTFOUND) return false;
+		values[i] = *v;
+	}
+	return true;
+}
+
+// scan the merged node's label once
+// mapping each node's merged properties to the node
+static void _BuildBatchMatches
+(
+	OpMerge *op
+) {
+	NodeCreateCtx *n = op->batch_node;
+	PropertyMap *map = n->properties;
+	GraphContext *gc = QueryCtx_GetGraphCtx();
+	op->batch_matches = raxNew();
+
+	Schema *s = GraphContext_GetSchema(gc, n->labels[0], SCHEMA_NODE);
+	if(s == NULL) return;  // label doesn't exist, nothing to match
+
+	bool depleted = false;
+	NodeID id;
+	SIValue values[map->property_count];
+	RG_MatrixTupleIter *it;
+	RG_Matrix L = Graph_GetLabelMatrix(gc->g, Schema_GetID(s));
+	RG_MatrixTupleIter_new(&it, L);
+
+	while(true) {
+		RG_MatrixTupleIter_next(it, NULL, &id, NULL, &depleted);
+		if(depleted) break;
+
+		Node node = GE_NEW_NODE();
+		Graph_GetNode(gc->g, id, &node);
+		if(!_GetNodeProperties(&node, map, values)) continue;
+
+		XXH64_hash_t hash = _HashProperties(values, map->property_count);
+		NodeID *ids = raxFind(op->batch_matches, (unsigned char *)&hash,
+				sizeof(hash));
+		if(ids == raxNotFound) {
+			ids = array_new(NodeID, 1);
+			array_append(ids, id);
+			raxInsert(op->batch_matches, (unsigned char *)&hash, sizeof(hash),
+					ids, NULL);
+		} else {
+			NodeID *updated = ids;
+			array_append(updated, id);
+			// array might have been relocated
+			if(updated != ids) {
+				raxInsert(op->batch_matches, (unsigned char *)&hash,
+						sizeof(hash), updated, NULL);
+			}
+		}
+	}
+
+	RG_MatrixTupleIter_free(&it);
+}
+
+// probe the existing nodes for matches of 'r'
+// emits a record per matching node, returns the number of matches
+static uint _ProbeBatchMatches
+(
+	OpMerge *op,
+	Record r
+) {
+	Graph *g = QueryCtx_GetGraph();
+	PropertyMap *map = op->batch_node->properties;
+	int property_count = map->property_count;
+	SIValue values[property_count];
+	SIValue props[property_count];
+	uint match_count = 0;
+	bool has_null = false;
+
+	for(int i = 0; i < property_count; i++) {
+		values[i] = AR_EXP_Evaluate(map->values[i], r);
+		has_null |= SIValue_IsNull(values[i]);
+	}
+
+	// null never matches
+	if(has_null) goto cleanup;
+
+	XXH64_hash_t hash = _HashProperties(values, property_count);
+	NodeID *ids = raxFind(op->batch_matches, (unsigned char *)&hash,
+			sizeof(hash));
+	if(ids == raxNotFound) goto cleanup;
+
+	uint id_count = array_len(ids);
+	for(uint i = 0; i < id_count; i++) {
+		Node node = GE_NEW_NODE();
+		Graph_GetNode(g, ids[i], &node);
+		_GetNodeProperties(&node, map, props);
+
+		// guard against hash collisions
+		bool match = true;
+		for(int j = 0; j < property_count && match; j++) {
+			int disjointOrNull = 0;
+			match = (SIValue_Compare(props[j], values[j], &disjointOrNull) == 0 &&
+					 disjointOrNull != DISJOINT);
+		}
+		if(!match) continue;
+
+		Record match_record = OpBase_CloneRecord(r);
+		Record_AddNode(match_record, op->batch_node_idx, node);
+		array_append(op->output_records, match_record);
+		match_count++;
+	}
+
+cleanup:
+	for(int i = 0; i < property_count; i++) SIValue_Free(values[i]);
+	return match_count;
+}
+
 static OpResult MergeInit(OpBase *opBase) {
 	/* Merge has 2 children if it is the first clause, and 3 otherwise
 	 * - If there are 3 children, the first should resolve the Merge pattern's bound variables
@@ -206,6 +406,17 @@ static Record MergeConsume(OpBase *opBase) {
 	// match pattern
 	//--------------------------------------------------------------------------
 
+	// resolve existing matches of the entire input batch in bulk if possible
+	if(op->input_records) {
+		op->batch_node = _BatchableNode(op, array_len(op->input_records));
+		if(op->batch_node) {
+			op->batch_node_idx = Record_GetEntryIdx(op->input_records[0],
+					op->batch_node->alias);
+			if(op->batch_node_idx == INVALID_INDEX) op->batch_node = NULL;
+		}
+		if(op->batch_node) _BuildBatchMatches(op);
+	}
+
 	uint  match_count          =  0;
 	bool  reading_matches      =  true;
 	bool  must_create_records  =  false;
@@ -220,22 +431,33 @@ static Record MergeConsume(OpBase *opBase) {
 
 			// pull a new input record
 			lhs_record = array_pop(op->input_records);
-			// propagate record to the top of the Match stream
-			// (must clone the Record, as it will be freed in the Match stream)
-			Argument_AddRecord(op->match_argument_tap, OpBase_CloneRecord(lhs_record));
 		} else {
 			// this loop only executes once if we don't have input records resolving bound variables
 			reading_matches = false;
 		}
 
-		Record rhs_record;
 		bool should_create_pattern = true;
-		// retrieve Records from the Match stream until it's depleted
-		while((rhs_record = _pullFromStream(op->match_stream))) {
-			// pattern was successfully matched
-			should_create_pattern = false;
-			array_append(op->output_records, rhs_record);
-			match_count++;
+		if(op->batch_node) {
+			// probe the existing nodes collected by the bulk scan
+			uint n = _ProbeBatchMatches(op, lhs_record);
+			should_create_pattern = (n == 0);
+			match_count += n;
+		} else {
+			// propagate record to the top of the Match stream
+			// (must clone the Record, as it will be freed in the Match stream)
+			if(lhs_record) {
+				Argument_AddRecord(op->match_argument_tap,
+						OpBase_CloneRecord(lhs_record));
+			}
+
+			Record rhs_record;
+			// retrieve Records from the Match stream until it's depleted
+			while((rhs_record = _pullFromStream(op->match_stream))) {
+				// pattern was successfully matched
+				should_create_pattern = false;
+				array_append(op->output_records, rhs_record);
+				match_count++;
+			}
 		}
 
 		if(should_create_pattern) {
@@ -374,6 +596,11 @@ static void MergeFree(OpBase *opBase) {
 		op->edge_pending_updates  =  NULL;
 	}
 
+	if(op->batch_matches) {
+		raxFreeWithCallback(op->batch_matches, array_free);
+		op->batch_matches = NULL;
+	}
+
 	if(op->on_match) {
 		raxFreeWithCallback(op->on_match, (void(*)(void *))UpdateCtx_Free);
 		op->on_match = NULL;
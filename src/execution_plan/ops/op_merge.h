@@ -9,9 +9,15 @@
 #include "op.h"
 #include "op_argument.h"
 #include "../execution_plan.h"
+#include "../../ast/ast_shared.h"
 #include "shared/update_functions.h"
 #include "../../resultset/resultset_statistics.h"
 
+// existing matches of a batch of merged nodes are resolved by a single label
+// scan when the pattern is served by an index and the label holds no more
+// than MERGE_BATCH_SCAN_FACTOR nodes per input record
+#define MERGE_BATCH_SCAN_FACTOR 8
+
 /* The Merge operation accepts exactly one path in the query and attempts to match it.
  * If the path is not found, it will be created, making new instances of every path variable
  * not bound in an earlier clause in the query. */
@@ -31,6 +37,9 @@ typedef struct {
 	PendingUpdateCtx *node_pending_updates;  // Pending updates to apply, generated 
 	PendingUpdateCtx *edge_pending_updates;  // Pending updates to apply, generated 
 	ResultSetStatistics *stats;              // Required for tracking statistics updates in ON MATCH.
+	NodeCreateCtx *batch_node;               // Merged node resolved in bulk, NULL if not batching.
+	int batch_node_idx;                      // Record index of the batched node.
+	rax *batch_matches;                      // Existing nodes keyed by their merged properties hash.
 } OpMerge;
 
 OpBase *NewMergeOp(const ExecutionPlan *plan, rax *on_match, rax *on_create);
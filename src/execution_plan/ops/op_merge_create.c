@@ -54,6 +54,7 @@ static void _RollbackPendingCreations(OpMergeCreate *op) {
 	uint edges_to_create_count = array_len(op->pending.edges_to_create);
 	for(uint i = 0; i < edges_to_create_count; i++) {
 		array_pop(op->pending.created_edges);
+		array_pop(op->pending.pending_edges);
 		PendingProperties *props = array_pop(op->pending.edge_properties);
 		PendingPropertiesFree(props);
 	}
@@ -150,11 +151,7 @@ static bool _CreateEntities(OpMergeCreate *op, Record r) {
 		}
 
 		// create the actual edge
-		Edge newEdge = {0};
-		newEdge.relationship = e->relation;
-		Edge_SetSrcNode(&newEdge, src_node);
-		Edge_SetDestNode(&newEdge, dest_node);
-
+		Edge newEdge = GE_NEW_EDGE();
 		Edge *edge_ref = Record_AddEdge(r, e->edge_idx, newEdge);
 
 		// convert query-level properties
@@ -184,7 +181,9 @@ static bool _CreateEntities(OpMergeCreate *op, Record r) {
 		}
 
 		/* Save edge for later insertion. */
+		PendingEdge pending_edge = { src_node, dest_node, e->relation };
 		array_append(op->pending.created_edges, edge_ref);
+		array_append(op->pending.pending_edges, pending_edge);
 
 		/* Save properties to insert with node. */
 		array_append(op->pending.edge_properties, converted_properties);
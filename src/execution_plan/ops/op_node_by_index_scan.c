@@ -34,6 +34,7 @@ OpBase *NewIndexScanOp(const ExecutionPlan *plan, Graph *g, NodeScanCtx n,
 	op->n                    =  n;
 	op->idx                  =  idx;
 	op->iter                 =  NULL;
+	op->topk                 =  NULL;
 	op->filter               =  filter;
 	op->child_record         =  NULL;
 	op->unresolved_filters   =  NULL;
@@ -47,6 +48,12 @@ OpBase *NewIndexScanOp(const ExecutionPlan *plan, Graph *g, NodeScanCtx n,
 	return (OpBase *)op;
 }
 
+void IndexScanOp_SetTopK(IndexScan *op, const IndexTopK *topk) {
+	ASSERT(op->topk == NULL);
+	op->topk = rm_malloc(sizeof(IndexTopK));
+	*op->topk = *topk;
+}
+
 static OpResult IndexScanInit(OpBase *opBase) {
 	IndexScan *op = (IndexScan *)opBase;
 
@@ -164,6 +171,8 @@ pull_index:
 
 		// create iterator
 		ASSERT(rs_query_node != NULL);
+		// observe index updates made by this query
+		QueryCtx_FlushIndexBuffer();
 		op->iter = RediSearch_GetResultsIterator(rs_query_node, op->idx);
 	} else {
 		// build index query only once (first call)
@@ -172,6 +181,8 @@ pull_index:
 			// first call to consume, create query and iterator
 			RSQNode *rs_query_node = FilterTreeToQueryNode(&op->unresolved_filters, op->filter, op->idx);
 			ASSERT(rs_query_node != NULL);
+			// observe index updates made by this query
+			QueryCtx_FlushIndexBuffer();
 			op->iter = RediSearch_GetResultsIterator(rs_query_node, op->idx);
 		} else {
 			// reset existing iterator
@@ -186,11 +197,19 @@ pull_index:
 static Record IndexScanConsume(OpBase *opBase) {
 	IndexScan *op = (IndexScan *)opBase;
 
+	// only scan the index window holding the top-k nodes
+	if(op->iter == NULL && op->topk != NULL) {
+		op->iter = IndexTopK_Iterator(op->topk, op->g, op->n.label_id,
+				op->filter);
+	}
+
 	// create iterator on first call
 	if(op->iter == NULL) {
 		RSQNode *rs_query_node = FilterTreeToQueryNode(&op->unresolved_filters,
 				op->filter, op->idx);
 
+		// observe index updates made by this query
+		QueryCtx_FlushIndexBuffer();
 		op->iter = RediSearch_GetResultsIterator(rs_query_node, op->idx);
 	}
 
@@ -255,5 +274,10 @@ static void IndexScanFree(OpBase *opBase) {
 		FilterTree_Free(op->unresolved_filters);
 		op->unresolved_filters = NULL;
 	}
+
+	if(op->topk) {
+		rm_free(op->topk);
+		op->topk = NULL;
+	}
 }
 
@@ -10,6 +10,7 @@
 #include "../execution_plan.h"
 #include "../../graph/graph.h"
 #include "../../index/index.h"
+#include "shared/index_topk.h"
 #include "shared/scan_functions.h"
 #include "redisearch_api.h"
 
@@ -23,6 +24,7 @@ typedef struct {
 	RSResultsIterator *iter;            // rediSearch iterator over an index with the appropriate filters
 	FT_FilterNode *filter;              // filter from which to compose index query
 	FT_FilterNode *unresolved_filters;  // subset of filter, contains filters that couldn't be resolved by index
+	IndexTopK *topk;                    // top-k requirement, NULL if none
 	Record child_record;                // the Record this op acts on if it is not a tap
 } IndexScan;
 
@@ -30,3 +32,6 @@ typedef struct {
 OpBase *NewIndexScanOp(const ExecutionPlan *plan, Graph *g, NodeScanCtx n,
 		RSIndex *idx, FT_FilterNode *filter);
 
+// restrict scan to an index window holding the top-k nodes, when possible
+void IndexScanOp_SetTopK(IndexScan *op, const IndexTopK *topk);
+
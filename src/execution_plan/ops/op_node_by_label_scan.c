@@ -8,12 +8,17 @@
 #include "RG.h"
 #include "shared/print_functions.h"
 #include "../../ast/ast.h"
+#include "../../util/arr.h"
 #include "../../query_ctx.h"
 
+// number of node IDs scanned at once when intersecting multiple labels
+#define LABEL_SCAN_BATCH_SIZE 1024
+
 /* Forward declarations. */
 static OpResult NodeByLabelScanInit(OpBase *opBase);
 static Record NodeByLabelScanConsume(OpBase *opBase);
 static Record NodeByLabelScanConsumeFromChild(OpBase *opBase);
+static Record NodeByLabelScanConsumeFromIndex(OpBase *opBase);
 static Record NodeByLabelScanNoOp(OpBase *opBase);
 static OpResult NodeByLabelScanReset(OpBase *opBase);
 static OpBase *NodeByLabelScanClone(const ExecutionPlan *plan, const OpBase *opBase);
@@ -21,7 +26,18 @@ static void NodeByLabelScanFree(OpBase *opBase);
 
 static inline void NodeByLabelScanToString(const OpBase *ctx, sds *buf) {
 	NodeByLabelScan *op = (NodeByLabelScan *)ctx;
-	ScanToString(ctx, buf, op->n.alias, op->n.label);
+	if(op->labels == NULL) {
+		ScanToString(ctx, buf, op->n.alias, op->n.label);
+		return;
+	}
+
+	// (alias:label:additional_label...)
+	*buf = sdscatprintf(*buf, "%s | (%s:%s", ctx->name, op->n.alias, op->n.label);
+	uint label_count = array_len(op->labels);
+	for(uint i = 0; i < label_count; i++) {
+		*buf = sdscatprintf(*buf, ":%s", op->labels[i]);
+	}
+	*buf = sdscatprintf(*buf, ")");
 }
 
 OpBase *NewNodeByLabelScanOp(const ExecutionPlan *plan, NodeScanCtx n) {
@@ -30,6 +46,13 @@ OpBase *NewNodeByLabelScanOp(const ExecutionPlan *plan, NodeScanCtx n) {
 	op->g = gc->g;
 	op->n = n;
 	op->iter = NULL;
+	op->topk = NULL;
+	op->index_iter = NULL;
+	op->labels = NULL;
+	op->label_matrices = NULL;
+	op->ids = NULL;
+	op->id_count = 0;
+	op->id_pos = 0;
 	op->child_record = NULL;
 	// Defaults to [0...UINT64_MAX].
 	op->id_range = UnsignedRange_New();
@@ -52,6 +75,104 @@ void NodeByLabelScanOp_SetIDRange(NodeByLabelScan *op, UnsignedRange *id_range)
 	op->op.name = "Node By Label and ID Scan";
 }
 
+void NodeByLabelScanOp_AddLabel(NodeByLabelScan *op, const char *label) {
+	ASSERT(label != NULL);
+	if(op->labels == NULL) op->labels = array_new(const char *, 1);
+	array_append(op->labels, label);
+}
+
+void NodeByLabelScanOp_SetTopK(NodeByLabelScan *op, const IndexTopK *topk) {
+	ASSERT(op->topk == NULL);
+	// The top-k window is computed over the primary label only.
+	ASSERT(op->labels == NULL);
+	op->topk = rm_malloc(sizeof(IndexTopK));
+	*op->topk = *topk;
+}
+
+// resolves the matrices of the additional labels
+// returns false if any of the labels doesn't exist
+static bool _ResolveLabels(NodeByLabelScan *op) {
+	if(op->labels == NULL || op->label_matrices != NULL) return true;
+
+	GraphContext *gc = QueryCtx_GetGraphCtx();
+	uint label_count = array_len(op->labels);
+	RG_Matrix *matrices = array_new(RG_Matrix, label_count);
+
+	for(uint i = 0; i < label_count; i++) {
+		Schema *s = GraphContext_GetSchema(gc, op->labels[i], SCHEMA_NODE);
+		if(s == NULL) {
+			array_free(matrices);
+			return false;
+		}
+		array_append(matrices, Graph_GetLabelMatrix(op->g, s->id));
+	}
+
+	op->label_matrices = matrices;
+	if(op->ids == NULL) {
+		op->ids = rm_malloc(sizeof(NodeID) * LABEL_SCAN_BATCH_SIZE);
+	}
+
+	return true;
+}
+
+// scans the next batch of IDs off the label's diagonal
+// keeping only IDs present in the diagonals of all additional labels
+// returns false once the iterator is depleted
+static bool _FillBatch(NodeByLabelScan *op) {
+	GrB_Index id;
+	bool depleted = false;
+	uint count = 0;
+
+	op->id_pos = 0;
+	op->id_count = 0;
+
+	while(count < LABEL_SCAN_BATCH_SIZE) {
+		RG_MatrixTupleIter_next(op->iter, NULL, &id, NULL, &depleted);
+		if(depleted) break;
+		op->ids[count++] = id;
+	}
+
+	if(count == 0) return false;
+
+	// intersect batch with each of the additional labels
+	// compacting IDs in place, preserving their order
+	uint label_count = array_len(op->label_matrices);
+	for(uint i = 0; i < label_count && count > 0; i++) {
+		uint kept = 0;
+		RG_Matrix L = op->label_matrices[i];
+		for(uint j = 0; j < count; j++) {
+			bool x;
+			GrB_Info info = RG_Matrix_extractElement_BOOL(&x, L, op->ids[j],
+					op->ids[j]);
+			if(info == GrB_SUCCESS) op->ids[kept++] = op->ids[j];
+		}
+		count = kept;
+	}
+
+	op->id_count = count;
+	return true;
+}
+
+// retrieves the next scanned node ID
+// returns false once the scan is depleted
+static inline bool _NextNodeID(NodeByLabelScan *op, GrB_Index *id) {
+	if(op->iter == NULL) return false;
+
+	if(op->label_matrices == NULL) {
+		bool depleted = true;
+		RG_MatrixTupleIter_next(op->iter, NULL, id, NULL, &depleted);
+		return !depleted;
+	}
+
+	// refill batch until it holds at least one ID
+	while(op->id_pos == op->id_count) {
+		if(!_FillBatch(op)) return false;
+	}
+
+	*id = op->ids[op->id_pos++];
+	return true;
+}
+
 static GrB_Info _ConstructIterator(NodeByLabelScan *op, Schema *schema) {
 	NodeID minId;
 	NodeID maxId;
@@ -108,6 +229,21 @@ static OpResult NodeByLabelScanInit(OpBase *opBase) {
 	// Resolve label ID at runtime.
 	op->n.label_id = schema->id;
 
+	// Missing additional label, no node can possess all labels.
+	if(!_ResolveLabels(op)) {
+		OpBase_UpdateConsume(opBase, NodeByLabelScanNoOp);
+		return OP_OK;
+	}
+
+	// Only scan the index window holding the top-k nodes.
+	if(op->topk) {
+		op->index_iter = IndexTopK_Iterator(op->topk, op->g, schema->id, NULL);
+		if(op->index_iter) {
+			OpBase_UpdateConsume(opBase, NodeByLabelScanConsumeFromIndex);
+			return OP_OK;
+		}
+	}
+
 	// The iterator build may fail if the ID range does not match the matrix dimensions.
 	GrB_Info iterator_built = _ConstructIterator(op, schema);
 	if(iterator_built != GrB_SUCCESS) {
@@ -127,6 +263,10 @@ static inline void _UpdateRecord(NodeByLabelScan *op, Record r, GrB_Index node_i
 }
 
 static inline void _ResetIterator(NodeByLabelScan *op) {
+	// discard the current batch
+	op->id_pos = 0;
+	op->id_count = 0;
+
 	NodeID minId = op->id_range->include_min ? op->id_range->min : op->id_range->min + 1;
 	NodeID maxId = op->id_range->include_max ? op->id_range->max : op->id_range->max - 1 ;
 	RG_MatrixTupleIter_iterate_range(op->iter, minId, maxId);
@@ -137,8 +277,7 @@ static Record NodeByLabelScanConsumeFromChild(OpBase *opBase) {
 
 	// Try to get new nodeID.
 	GrB_Index nodeId;
-	bool depleted = true;
-	RG_MatrixTupleIter_next(op->iter, NULL, &nodeId, NULL, &depleted);
+	bool depleted = !_NextNodeID(op, &nodeId);
 	/* depleted will be true in the following cases:
 	 * 1. No iterator: GxB_MatrixTupleIter_next will fail and depleted will stay true. This scenario means
 	 * that there was no consumption of a record from a child, otherwise there was an iterator.
@@ -158,6 +297,7 @@ static Record NodeByLabelScanConsumeFromChild(OpBase *opBase) {
 			Schema *schema = GraphContext_GetSchema(gc, op->n.label, SCHEMA_NODE);
 			// No label matrix, it might be created in the next iteration.
 			if(!schema) continue;
+			if(!_ResolveLabels(op)) continue;
 			if(_ConstructIterator(op, schema) != GrB_SUCCESS) continue;
 		} else {
 			// Iterator depleted - reset.
@@ -165,7 +305,7 @@ static Record NodeByLabelScanConsumeFromChild(OpBase *opBase) {
 			_ResetIterator(op);
 		}
 		// Try to get new NodeID.
-		RG_MatrixTupleIter_next(op->iter, NULL, &nodeId, NULL, &depleted);
+		depleted = !_NextNodeID(op, &nodeId);
 	}
 
 	// We've got a record and NodeID.
@@ -180,9 +320,7 @@ static Record NodeByLabelScanConsume(OpBase *opBase) {
 	NodeByLabelScan *op = (NodeByLabelScan *)opBase;
 
 	GrB_Index nodeId;
-	bool depleted = false;
-	RG_MatrixTupleIter_next(op->iter, NULL, &nodeId, NULL, &depleted);
-	if(depleted) return NULL;
+	if(!_NextNodeID(op, &nodeId)) return NULL;
 
 	Record r = OpBase_CreateRecord((OpBase *)op);
 
@@ -192,6 +330,21 @@ static Record NodeByLabelScanConsume(OpBase *opBase) {
 	return r;
 }
 
+static Record NodeByLabelScanConsumeFromIndex(OpBase *opBase) {
+	NodeByLabelScan *op = (NodeByLabelScan *)opBase;
+
+	const EntityID *nodeId = RediSearch_ResultsIteratorNext(op->index_iter,
+			op->topk->idx, NULL);
+	if(nodeId == NULL) return NULL;
+
+	Record r = OpBase_CreateRecord((OpBase *)op);
+
+	// Populate the Record with the actual node.
+	_UpdateRecord(op, r, *nodeId);
+
+	return r;
+}
+
 /* This function is invoked when the op has no children and no valid label is requested (either no label, or non existing label).
  * The op simply needs to return NULL */
 static Record NodeByLabelScanNoOp(OpBase *opBase) {
@@ -204,15 +357,17 @@ static OpResult NodeByLabelScanReset(OpBase *ctx) {
 		OpBase_DeleteRecord(op->child_record); // Free old record.
 		op->child_record = NULL;
 	}
-	_ResetIterator(op);
+	if(op->index_iter) RediSearch_ResultsIteratorReset(op->index_iter);
+	else _ResetIterator(op);
 	return OP_OK;
 }
 
 static OpBase *NodeByLabelScanClone(const ExecutionPlan *plan, const OpBase *opBase) {
 	ASSERT(opBase->type == OPType_NODE_BY_LABEL_SCAN);
 	NodeByLabelScan *op = (NodeByLabelScan *)opBase;
-	OpBase *clone = NewNodeByLabelScanOp(plan, op->n);
-	return clone;
+	NodeByLabelScan *clone = (NodeByLabelScan *)NewNodeByLabelScanOp(plan, op->n);
+	if(op->labels) array_clone(clone->labels, op->labels);
+	return (OpBase *)clone;
 }
 
 static void NodeByLabelScanFree(OpBase *op) {
@@ -223,6 +378,31 @@ static void NodeByLabelScanFree(OpBase *op) {
 		nodeByLabelScan->iter = NULL;
 	}
 
+	if(nodeByLabelScan->index_iter) {
+		RediSearch_ResultsIteratorFree(nodeByLabelScan->index_iter);
+		nodeByLabelScan->index_iter = NULL;
+	}
+
+	if(nodeByLabelScan->topk) {
+		rm_free(nodeByLabelScan->topk);
+		nodeByLabelScan->topk = NULL;
+	}
+
+	if(nodeByLabelScan->labels) {
+		array_free(nodeByLabelScan->labels);
+		nodeByLabelScan->labels = NULL;
+	}
+
+	if(nodeByLabelScan->label_matrices) {
+		array_free(nodeByLabelScan->label_matrices);
+		nodeByLabelScan->label_matrices = NULL;
+	}
+
+	if(nodeByLabelScan->ids) {
+		rm_free(nodeByLabelScan->ids);
+		nodeByLabelScan->ids = NULL;
+	}
+
 	if(nodeByLabelScan->child_record) {
 		OpBase_DeleteRecord(nodeByLabelScan->child_record);
 		nodeByLabelScan->child_record = NULL;
@@ -7,6 +7,7 @@
 #pragma once
 
 #include "op.h"
+#include "shared/index_topk.h"
 #include "shared/scan_functions.h"
 #include "../execution_plan.h"
 #include "../../graph/graph.h"
@@ -24,6 +25,13 @@ typedef struct {
 	unsigned int nodeRecIdx;    // Node position within record
 	UnsignedRange *id_range;    // ID range to iterate over
 	RG_MatrixTupleIter *iter;
+	IndexTopK *topk;            // Top-k requirement, NULL if none
+	RSResultsIterator *index_iter;  // Iterator over top-k window
+	const char **labels;        // Additional labels the node must possess, NULL if none
+	RG_Matrix *label_matrices;  // Matrices of the additional labels, resolved at runtime
+	NodeID *ids;                // Batch of scanned node IDs possessing all labels
+	uint id_count;              // Number of IDs in batch
+	uint id_pos;                // Position of the next ID to emit within batch
 	Record child_record;        // The Record this op acts on if it is not a tap
 } NodeByLabelScan;
 
@@ -33,3 +41,10 @@ OpBase *NewNodeByLabelScanOp(const ExecutionPlan *plan, NodeScanCtx n);
 /* Transform a simple label scan to perform additional range query over the label  matrix. */
 void NodeByLabelScanOp_SetIDRange(NodeByLabelScan *op, UnsignedRange *id_range);
 
+/* Require scanned nodes to possess an additional label,
+ * nodes are emitted only if they are present in the diagonals of all labels. */
+void NodeByLabelScanOp_AddLabel(NodeByLabelScan *op, const char *label);
+
+/* Restrict scan to an index window holding the top-k nodes, when possible. */
+void NodeByLabelScanOp_SetTopK(NodeByLabelScan *op, const IndexTopK *topk);
+
@@ -67,6 +67,10 @@ OpBase *NewProcCallOp
 	op->first_call  =  true;
 	op->yield_exps  =  yield_exps;
 
+	// no hints unless set by the optimizer
+	op->hints.limit  =  UNLIMITED;
+	op->hints.top_k  =  false;
+
 	// procedure must exist
 	op->procedure = Proc_Get(proc_name);
 	ASSERT(op->procedure != NULL);
@@ -122,6 +126,7 @@ static Record ProcCallConsume(OpBase *opBase) {
 		// TODO: replace with Proc_Reset
 		Proc_Free(op->procedure);
 		op->procedure = Proc_Get(op->proc_name);
+		Procedure_SetHints(op->procedure, op->hints);
 
 		// at the moment the only two procedures that can modify the graph are:
 		// proc_fulltext_create_index
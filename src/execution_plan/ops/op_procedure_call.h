@@ -31,6 +31,7 @@ typedef struct {
     AR_ExpNode **yield_exps;    // Yield expressions.
 	ProcedureCtx *procedure;    // Procedure to call.
 	OutputMap *yield_map;       // Maps between yield to procedure output and record idx.
+	ProcedureHints hints;       // Planner hints passed to each invocation.
     bool first_call;            // Indicate first call.
 } OpProcCall;
 
@@ -5,13 +5,19 @@
  */
 
 #include "op_semi_apply.h"
+#include "RG.h"
+#include "../../query_ctx.h"
 #include "../execution_plan.h"
 #include "../execution_plan_build/execution_plan_modify.h"
 
+// Number of bound branch records evaluated at once by a batched Semi Apply.
+#define BATCH_SIZE 64
+
 // Forward declarations.
 static OpResult SemiApplyInit(OpBase *opBase);
 static Record SemiApplyConsume(OpBase *opBase);
 static Record AntiSemiApplyConsume(OpBase *opBase);
+static Record BatchedSemiApplyConsume(OpBase *opBase);
 static OpResult SemiApplyReset(OpBase *opBase);
 static OpBase *SemiApplyClone(const ExecutionPlan *plan, const OpBase *opBase);
 static void SemiApplyFree(OpBase *opBase);
@@ -26,6 +32,17 @@ OpBase *NewSemiApplyOp(const ExecutionPlan *plan, bool anti) {
 	op->op_arg = NULL;
 	op->bound_branch = NULL;
 	op->match_branch = NULL;
+	op->g = NULL;
+	op->ae = NULL;
+	op->filter = NULL;
+	op->expand_into = false;
+	op->F = NULL;
+	op->M = NULL;
+	op->iter = NULL;
+	op->records = NULL;
+	op->matched = NULL;
+	op->record_count = 0;
+	op->record_pos = 0;
 	// Set our Op operations
 	if(anti) {
 		OpBase_Init((OpBase *)op, OPType_ANTI_SEMI_APPLY, "Anti Semi Apply", SemiApplyInit,
@@ -37,10 +54,40 @@ OpBase *NewSemiApplyOp(const ExecutionPlan *plan, bool anti) {
 	return (OpBase *) op;
 }
 
+void SemiApplyOp_SetBatched(OpSemiApply *op, Graph *g, AlgebraicExpression *ae,
+							FT_FilterNode *filter, bool expand_into) {
+	ASSERT(op->ae == NULL);
+	ASSERT(ae != NULL);
+
+	op->g = g;
+	op->ae = ae;
+	op->filter = filter;
+	op->expand_into = expand_into;
+	OpBase_UpdateConsume((OpBase *)op, BatchedSemiApplyConsume);
+
+	// Both traversal endpoints are represented in the record.
+	bool aware;
+	UNUSED(aware);
+	aware = OpBase_Aware((OpBase *)op, AlgebraicExpression_Src(ae), &op->srcNodeIdx);
+	ASSERT(aware);
+	aware = OpBase_Aware((OpBase *)op, AlgebraicExpression_Dest(ae), &op->destNodeIdx);
+	ASSERT(aware);
+}
+
 static OpResult SemiApplyInit(OpBase *opBase) {
+	OpSemiApply *op = (OpSemiApply *)opBase;
+
+	if(op->ae != NULL) {
+		// Batched evaluation, the match branch has been replaced by op->ae.
+		ASSERT(opBase->childCount == 1);
+		op->bound_branch = opBase->children[0];
+		op->records = rm_calloc(BATCH_SIZE, sizeof(Record));
+		op->matched = rm_calloc(BATCH_SIZE, sizeof(bool));
+		return OP_OK;
+	}
+
 	ASSERT(opBase->childCount == 2);
 
-	OpSemiApply *op = (OpSemiApply *)opBase;
 	/* The op bounded branch and match branch are set to be the first and second child, respectively,
 	 * during the operation building procedure at execution_plan_reduce_to_apply.c */
 	op->bound_branch = opBase->children[0];
@@ -113,19 +160,144 @@ static Record AntiSemiApplyConsume(OpBase *opBase) {
 	}
 }
 
+/* Evaluate the pattern for the current batch of records:
+ * F[i, src] is set for the ith record, and M = F * ae
+ * the ith record matches if row i of M contains a node passing the filters
+ * or in case the destination is bound, if M[i, dest] is set. */
+static void _evaluateBatch(OpSemiApply *op) {
+	// If op->F is null, this is the first time we are evaluating.
+	if(op->F == NULL) {
+		size_t required_dim = Graph_RequiredMatrixDim(op->g);
+		RG_Matrix_new(&op->M, GrB_BOOL, BATCH_SIZE, required_dim);
+		RG_Matrix_new(&op->F, GrB_BOOL, BATCH_SIZE, required_dim);
+
+		// Prepend the filter matrix to algebraic expression as the leftmost operand.
+		AlgebraicExpression_MultiplyToTheLeft(&op->ae, op->F);
+		AlgebraicExpression_Optimize(&op->ae);
+	}
+
+	// Populate filter matrix.
+	GrB_Matrix FM = RG_MATRIX_M(op->F);
+	for(uint i = 0; i < op->record_count; i++) {
+		op->matched[i] = false;
+		// The record may not contain the source node in scenarios like
+		// a failed OPTIONAL MATCH, such records can't match the pattern.
+		Node *n = Record_GetNode(op->records[i], op->srcNodeIdx);
+		if(n == NULL) continue;
+		GrB_Matrix_setElement_BOOL(FM, true, i, ENTITY_GET_ID(n));
+	}
+	GrB_Matrix_wait(FM, GrB_MATERIALIZE);
+
+	// Evaluate expression.
+	AlgebraicExpression_Eval(op->ae, op->M);
+	RG_Matrix_clear(op->F);
+
+	GrB_Matrix MM = RG_MATRIX_M(op->M);
+	if(op->iter == NULL) GxB_MatrixTupleIter_new(&op->iter, MM);
+	else GxB_MatrixTupleIter_reuse(op->iter, MM);
+
+	for(uint i = 0; i < op->record_count; i++) {
+		Record r = op->records[i];
+		if(Record_GetNode(r, op->srcNodeIdx) == NULL) continue;
+
+		if(op->expand_into) {
+			// Check if the record's source is connected to its destination.
+			bool x;
+			Node *dest = Record_GetNode(r, op->destNodeIdx);
+			if(dest == NULL) continue;
+			GrB_Info res = GrB_Matrix_extractElement_BOOL(&x, MM, i, ENTITY_GET_ID(dest));
+			if(res != GrB_SUCCESS) continue;
+			op->matched[i] = (op->filter == NULL ||
+							  FilterTree_applyFilters(op->filter, r) == FILTER_PASS);
+			continue;
+		}
+
+		// Look for a reached node passing the filters.
+		bool depleted = false;
+		GrB_Index dest_id;
+		GxB_MatrixTupleIter_iterate_row(op->iter, i);
+		while(!op->matched[i]) {
+			GxB_MatrixTupleIter_next(op->iter, NULL, &dest_id, NULL, &depleted);
+			if(depleted) break;
+			if(op->filter == NULL) {
+				op->matched[i] = true;
+				break;
+			}
+
+			Node dest = GE_NEW_NODE();
+			Graph_GetNode(op->g, dest_id, &dest);
+			Record_AddNode(r, op->destNodeIdx, dest);
+			op->matched[i] = (FilterTree_applyFilters(op->filter, r) == FILTER_PASS);
+		}
+
+		// The destination node is local to the pattern.
+		if(op->filter != NULL) Record_Remove(r, op->destNodeIdx);
+	}
+}
+
+static void _freeBatch(OpSemiApply *op) {
+	for(uint i = op->record_pos; i < op->record_count; i++) {
+		OpBase_DeleteRecord(op->records[i]);
+	}
+	op->record_count = 0;
+	op->record_pos = 0;
+}
+
+/* This function pulls a batch of records from the op's bounded branch and evaluates the pattern
+ * for the entire batch, bounded branch records are returned if they match the pattern,
+ * or in the case of Anti Semi Apply, if they don't. */
+static Record BatchedSemiApplyConsume(OpBase *opBase) {
+	OpSemiApply *op = (OpSemiApply *)opBase;
+	bool anti = (opBase->type == OPType_ANTI_SEMI_APPLY);
+
+	while(true) {
+		// Return the next record satisfying the predicate from the current batch.
+		while(op->record_pos < op->record_count) {
+			uint i = op->record_pos++;
+			Record r = op->records[i];
+			if(op->matched[i] != anti) return r;
+			OpBase_DeleteRecord(r);
+		}
+
+		// Batch depleted, pull a new batch from the bound stream.
+		op->record_pos = 0;
+		for(op->record_count = 0; op->record_count < BATCH_SIZE; op->record_count++) {
+			Record r = OpBase_Consume(op->bound_branch);
+			if(r == NULL) break;
+			Record_PersistScalars(r);
+			op->records[op->record_count] = r;
+		}
+
+		if(op->record_count == 0) return NULL; // Depleted.
+
+		// check for cancellation before evaluating the batch
+		if(OpBase_Cancelled(opBase)) return NULL;
+
+		_evaluateBatch(op);
+	}
+}
+
 static OpResult SemiApplyReset(OpBase *opBase) {
 	OpSemiApply *op = (OpSemiApply *)opBase;
 	if(op->r) {
 		OpBase_DeleteRecord(op->r);
 		op->r = NULL;
 	}
+	if(op->records) _freeBatch(op);
 	return OP_OK;
 }
 
 static inline OpBase *SemiApplyClone(const ExecutionPlan *plan, const OpBase *opBase) {
 	ASSERT(opBase->type == OPType_SEMI_APPLY || opBase->type == OPType_ANTI_SEMI_APPLY);
 	bool anti = opBase->type == OPType_ANTI_SEMI_APPLY;
-	return NewSemiApplyOp(plan, anti);
+	OpSemiApply *op = (OpSemiApply *)opBase;
+	OpSemiApply *clone = (OpSemiApply *)NewSemiApplyOp(plan, anti);
+	if(op->ae != NULL) {
+		FT_FilterNode *filter = (op->filter) ? FilterTree_Clone(op->filter) : NULL;
+		SemiApplyOp_SetBatched(clone, op->g, AlgebraicExpression_Clone(op->ae), filter,
+							   op->expand_into);
+	}
+	return (OpBase *)clone;
 }
 
 static void SemiApplyFree(OpBase *opBase) {
@@ -135,5 +307,41 @@ static void SemiApplyFree(OpBase *opBase) {
 		OpBase_DeleteRecord(op->r);
 		op->r = NULL;
 	}
+
+	if(op->records) {
+		_freeBatch(op);
+		rm_free(op->records);
+		op->records = NULL;
+	}
+
+	if(op->matched) {
+		rm_free(op->matched);
+		op->matched = NULL;
+	}
+
+	if(op->iter) {
+		GxB_MatrixTupleIter_free(&op->iter);
+		op->iter = NULL;
+	}
+
+	if(op->F) {
+		RG_Matrix_free(&op->F);
+		op->F = NULL;
+	}
+
+	if(op->M) {
+		RG_Matrix_free(&op->M);
+		op->M = NULL;
+	}
+
+	if(op->ae) {
+		AlgebraicExpression_Free(op->ae);
+		op->ae = NULL;
+	}
+
+	if(op->filter) {
+		FilterTree_Free(op->filter);
+		op->filter = NULL;
+	}
 }
 
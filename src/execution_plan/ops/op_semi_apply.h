@@ -9,6 +9,9 @@
 #include "op.h"
 #include "op_argument.h"
 #include "../execution_plan.h"
+#include "../../graph/graph.h"
+#include "../../filter_tree/filter_tree.h"
+#include "../../arithmetic/algebraic_expression.h"
 
 /* SemiApply operation tests for the presence of a pattern
  * Normal Semi Apply: Starts by pulling on the main execution plan branch,
@@ -18,7 +21,10 @@
  * Anti Semi Apply: Starts by pulling on the main execution plan branch,
  * for each record received it tries to get a record from the match branch
  * if no data is produced the main execution plan branch record is passed onward
- * otherwise it will try to fetch a new data point from the main execution plan branch. */
+ * otherwise it will try to fetch a new data point from the main execution plan branch.
+ * Batched Semi Apply: when the match branch is a single traversal, optionally followed by filters
+ * the match branch is replaced by the traversal's algebraic expression, which is evaluated
+ * for a batch of bound branch records at once, using a filter matrix as Conditional Traverse does. */
 
 typedef struct OpSemiApply {
 	OpBase op;
@@ -26,6 +32,25 @@ typedef struct OpSemiApply {
 	OpBase *bound_branch;           // Bound branch root;
 	OpBase *match_branch;           // Match branch root;
 	Argument *op_arg;               // Match branch tap.
+	Graph *g;                       // Graph, batched evaluation only.
+	AlgebraicExpression *ae;        // Match branch traversal, NULL if not batched.
+	FT_FilterNode *filter;          // Match branch filters, NULL if there are none.
+	bool expand_into;               // Traversal destination is bound.
+	int srcNodeIdx;                 // Traversal source node index into record.
+	int destNodeIdx;                // Traversal destination node index into record.
+	RG_Matrix F;                    // Filter matrix.
+	RG_Matrix M;                    // Algebraic expression result.
+	GxB_MatrixTupleIter *iter;      // Iterator over M.
+	Record *records;                // Batch of bound branch records.
+	bool *matched;                  // Batch records matching the pattern.
+	uint record_count;              // Number of records in batch.
+	uint record_pos;                // Next record in batch to inspect.
 } OpSemiApply;
 
 OpBase *NewSemiApplyOp(const ExecutionPlan *plan, bool anti);
+
+/* Evaluate the pattern for batches of bound branch records.
+ * The operation takes ownership over both 'ae' and 'filter',
+ * 'expand_into' indicates if the expression destination is bound by the bound branch. */
+void SemiApplyOp_SetBatched(OpSemiApply *op, Graph *g, AlgebraicExpression *ae,
+							FT_FilterNode *filter, bool expand_into);
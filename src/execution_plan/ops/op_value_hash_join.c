@@ -1,14 +1,17 @@
 /*
-* Copyright 2018-2020 Redis Labs Ltd. and Contributors
+* Copyright 2018-2021 Redis Labs Ltd. and Contributors
 *
 * This file is available under the Redis Labs Source Available License Agreement
 */
 
 #include "op_value_hash_join.h"
+#include "RG.h"
 #include "../../value.h"
 #include "../../util/arr.h"
 #include "../../util/rmalloc.h"
-#include "../../util/qsort.h"
+
+// marks the end of a bucket's chain of entries
+#define HASH_JOIN_NIL UINT64_MAX
 
 /* Forward declarations. */
 static OpResult ValueHashJoinInit(OpBase *opBase);
@@ -17,155 +20,164 @@ static OpResult ValueHashJoinReset(OpBase *opBase);
 static OpBase *ValueHashJoinClone(const ExecutionPlan *plan, const OpBase *opBase);
 static void ValueHashJoinFree(OpBase *opBase);
 
-/* Determins order between two records by inspecting
- * element stored at postion idx. */
-static bool _record_islt(Record l, Record r, uint idx) {
-	SIValue lv = Record_Get(l, idx);
-	SIValue rv = Record_Get(r, idx);
-	return SIValue_Compare(lv, rv, NULL) < 0;
-}
-
-/* `idx` is an actual variable in the caller function.
- * Using it in a macro like this is rather ugly,
- * but the macro passed to QSORT must accept only 2 arguments. */
-#define RECORD_SORT_ON_ENTRY(a, b) (_record_islt((*a), (*b), idx))
-
-// Performs binary search, returns the leftmost index of a match.
-static bool _binarySearchLeftmost(uint *idx, Record *array, uint array_len,
-								  int join_key_idx, SIValue v) {
-	ASSERT(idx != NULL);
-
-	SIValue x;
-	uint pos = 0;
-	uint left = 0;
-	uint right = array_len;
-
-	while(left < right) {
-		pos = (right + left) / 2;
-		x = Record_Get(array[pos], join_key_idx);
-		if(SIValue_Compare(x, v, NULL) < 0) left = pos + 1;
-		else right = pos;
+// evaluates join expressions against 'r' into 'keys'
+// returns false if any of the keys is NULL, in which case 'r' can't be joined
+static bool _EvaluateKeys
+(
+	AR_ExpNode **exps,
+	uint key_count,
+	Record r,
+	SIValue *keys
+) {
+	for(uint i = 0; i < key_count; i++) {
+		keys[i] = AR_EXP_Evaluate(exps[i], r);
+		if(SIValue_IsNull(keys[i])) {
+			for(uint j = 0; j < i; j++) SIValue_Free(keys[j]);
+			return false;
+		}
 	}
 
-	// Make sure value was found.
-	*idx = left;
+	return true;
+}
+
+// computes the hash code of join keys
+static XXH64_hash_t _HashKeys
+(
+	const SIValue *keys,
+	uint key_count
+) {
+	XXH64_state_t state;
+	XXH_errorcode res = XXH64_reset(&state, 0);
+	ASSERT(res != XXH_ERROR);
+	UNUSED(res);
 
-	if(left == array_len) return false;
+	for(uint i = 0; i < key_count; i++) SIValue_HashUpdate(keys[i], &state);
 
-	x = Record_Get(array[*idx], join_key_idx);
-	// Return false if the value wasn't found or evaluated to NULL.
-	int disjointOrNull = 0;
-	return (SIValue_Compare(x, v, &disjointOrNull) == 0 &&
-			disjointOrNull != COMPARED_NULL);
+	return XXH64_digest(&state);
 }
 
-// Performs binary search, returns the rightmost index of a match.
-// assuming 'v' exists in 'array'
-static bool _binarySearchRightmost(uint *idx, Record *array, uint array_len, int join_key_idx,
-								   SIValue v) {
-	ASSERT(idx != NULL);
-
-	SIValue x;
-	uint pos = 0;
-	uint left = 0;
-	uint right = array_len;
-
-	while(left < right) {
-		pos = (right + left) / 2;
-		x = Record_Get(array[pos], join_key_idx);
-		if(SIValue_Compare(v, x, NULL) < 0) right = pos;
-		else left = pos + 1;
+// returns true if all keys are equal
+// a comparison involving NULL, e.g. within a list, isn't a match
+static bool _KeysEqual
+(
+	const SIValue *a,
+	const SIValue *b,
+	uint key_count
+) {
+	for(uint i = 0; i < key_count; i++) {
+		int disjointOrNull = 0;
+		if(SIValue_Compare(a[i], b[i], &disjointOrNull) != 0 ||
+		   disjointOrNull == COMPARED_NULL) {
+			return false;
+		}
 	}
 
-	*idx = right - 1;
 	return true;
 }
 
-/* Retrive the next intersecting record
- * if such exists, otherwise returns NULL. */
-static Record _get_intersecting_record(OpValueHashJoin *op) {
-	// No more intersecting records.
-	if(op->intersect_idx == -1 ||
-	   op->number_of_intersections == 0) return NULL;
+/* Consumes all records coming from left branch
+ * into a hash table keyed by their join keys. */
+static void _BuildHashTable(OpValueHashJoin *op) {
+	ASSERT(op->entries == NULL);
 
-	Record cr = op->cached_records[op->intersect_idx];
+	uint key_count = op->key_count;
+	OpBase *left_child = op->op.children[0];
+	op->entries = array_new(HashJoinEntry, 32);
+	op->keys = array_new(SIValue, 32 * key_count);
 
-	// Update intersection trackers.
-	op->intersect_idx++;
-	op->number_of_intersections--;
+	Record r;
+	while((r = OpBase_Consume(left_child))) {
+		// records with a NULL join key can't be joined, discard them
+		if(!_EvaluateKeys(op->lhs_exps, key_count, r, op->probe_keys)) {
+			OpBase_DeleteRecord(r);
+			continue;
+		}
 
-	return cr;
-}
+		HashJoinEntry e = {
+			.r     =  r,
+			.next  =  HASH_JOIN_NIL,
+			.hash  =  _HashKeys(op->probe_keys, key_count)
+		};
+		array_append(op->entries, e);
+		for(uint i = 0; i < key_count; i++) {
+			array_append(op->keys, op->probe_keys[i]);
+		}
+	}
 
-/* Look up first intersecting cached record CR position.
- * Returns false if no intersecting record is found. */
-static bool _set_intersection_idx(OpValueHashJoin *op, SIValue v) {
-	op->intersect_idx = -1;
-	op->number_of_intersections = 0;
-	uint record_count = array_len(op->cached_records);
+	// use a power of 2 number of buckets, at least one per entry
+	uint64_t entry_count = array_len(op->entries);
+	uint64_t bucket_count = 1;
+	while(bucket_count < entry_count) bucket_count <<= 1;
+
+	op->bucket_mask = bucket_count - 1;
+	op->buckets = rm_malloc(sizeof(uint64_t) * bucket_count);
+	memset(op->buckets, 0xFF, sizeof(uint64_t) * bucket_count);  // HASH_JOIN_NIL
+
+	// chain entries in reverse, such that each chain lists entries
+	// in the order they were consumed
+	for(uint64_t i = entry_count; i > 0; i--) {
+		HashJoinEntry *e = op->entries + i - 1;
+		uint64_t b = e->hash & op->bucket_mask;
+		e->next = op->buckets[b];
+		op->buckets[b] = i - 1;
+	}
 
-	uint leftmost_idx = 0;
-	uint rightmost_idx = 0;
+	op->built = true;
+}
 
-	if(!_binarySearchLeftmost(&leftmost_idx, op->cached_records,
-							  array_len(op->cached_records), op->join_value_rec_idx, v)) {
-		return false;
-	}
+// retrieves the next cached record matching the current probe record
+// returns NULL if there are no more matches
+static Record _NextMatch(OpValueHashJoin *op) {
+	uint key_count = op->key_count;
 
-	/* Value was found
-	 * idx points to the first intersecting record.
-	 * update number_of_intersections to count how many
-	 * records share the same value. */
-	op->intersect_idx = leftmost_idx;
-
-	/* Count how many records share the same node.
-	 * reduce search space by truncating left bound */
-	bool found = _binarySearchRightmost(&rightmost_idx, op->cached_records +
-								  leftmost_idx, record_count - leftmost_idx,
-								  op->join_value_rec_idx, v);
-	UNUSED(found);
-	ASSERT(found == true);
-
-	// Compensate index.
-	rightmost_idx += leftmost_idx;
-	// +1 consider rightmost_idx == leftmost_idx.
-	op->number_of_intersections = rightmost_idx - leftmost_idx + 1;
-	ASSERT(op->number_of_intersections > 0);
+	while(op->probe_pos != HASH_JOIN_NIL) {
+		uint64_t idx = op->probe_pos;
+		HashJoinEntry *e = op->entries + idx;
+		op->probe_pos = e->next;
 
-	return true;
-}
+		if(e->hash == op->probe_hash &&
+		   _KeysEqual(op->keys + idx * key_count, op->probe_keys, key_count)) {
+			return e->r;
+		}
+	}
 
-/* Sorts cached records by joined value. */
-void _sort_cached_records(OpValueHashJoin *op) {
-	uint idx = op->join_value_rec_idx;
-	QSORT(Record, op->cached_records,
-		  array_len(op->cached_records), RECORD_SORT_ON_ENTRY);
+	return NULL;
 }
 
-/* Caches all records coming from left branch. */
-void _cache_records(OpValueHashJoin *op) {
-	ASSERT(op->cached_records == NULL);
-
-	OpBase *left_child = op->op.children[0];
-	op->cached_records = array_new(Record, 32);
+// discards the current probe record
+static void _ReleaseProbeRecord(OpValueHashJoin *op) {
+	if(op->rhs_rec == NULL) return;
 
-	Record r = left_child->consume(left_child);
-	if(!r) return;
+	for(uint i = 0; i < op->key_count; i++) SIValue_Free(op->probe_keys[i]);
+	OpBase_DeleteRecord(op->rhs_rec);
+	op->rhs_rec = NULL;
+	op->probe_pos = HASH_JOIN_NIL;
+}
 
-	// As long as there's data coming in from left branch.
-	do {
-		// Evaluate joined expression.
-		SIValue v = AR_EXP_Evaluate(op->lhs_exp, r);
+// frees the hash table and its cached records
+static void _FreeHashTable(OpValueHashJoin *op) {
+	if(op->entries) {
+		uint64_t entry_count = array_len(op->entries);
+		for(uint64_t i = 0; i < entry_count; i++) {
+			OpBase_DeleteRecord(op->entries[i].r);
+		}
+		array_free(op->entries);
+		op->entries = NULL;
+	}
 
-		// If the joined value is NULL, it cannot be compared to other values - skip this record.
-		if(SIValue_IsNull(v)) continue;
+	if(op->keys) {
+		uint64_t key_count = array_len(op->keys);
+		for(uint64_t i = 0; i < key_count; i++) SIValue_Free(op->keys[i]);
+		array_free(op->keys);
+		op->keys = NULL;
+	}
 
-		// Add joined value to record.
-		Record_AddScalar(r, op->join_value_rec_idx, v);
+	if(op->buckets) {
+		rm_free(op->buckets);
+		op->buckets = NULL;
+	}
 
-		// Cache the record.
-		array_append(op->cached_records, r);
-	} while((r = left_child->consume(left_child)));
+	op->built = false;
 }
 
 /* String representation of operation */
@@ -179,35 +191,52 @@ static void ValueHashJoinToString(const OpBase *ctx, sds *buff) {
 	/* Return early if we don't have arithmetic expressions to print.
 	 * This can occur when an upstream op like MERGE has
 	 * already freed this operation with PropagateFree. */
-	if(!(op->lhs_exp && op->rhs_exp)) return;
+	if(!(op->lhs_exps && op->rhs_exps)) return;
 
-	AR_EXP_ToString(op->lhs_exp, &exp_str);
-	*buff = sdscatprintf(*buff, "%s", exp_str);
-	rm_free(exp_str);
+	for(uint i = 0; i < op->key_count; i++) {
+		if(i > 0) *buff = sdscatprintf(*buff, " AND ");
 
-	*buff = sdscatprintf(*buff, " = ");
+		AR_EXP_ToString(op->lhs_exps[i], &exp_str);
+		*buff = sdscatprintf(*buff, "%s", exp_str);
+		rm_free(exp_str);
 
-	AR_EXP_ToString(op->rhs_exp, &exp_str);
-	*buff = sdscatprintf(*buff, "%s", exp_str);
-	rm_free(exp_str);
+		*buff = sdscatprintf(*buff, " = ");
+
+		AR_EXP_ToString(op->rhs_exps[i], &exp_str);
+		*buff = sdscatprintf(*buff, "%s", exp_str);
+		rm_free(exp_str);
+	}
 }
 
 /* Creates a new valueHashJoin operation */
-OpBase *NewValueHashJoin(const ExecutionPlan *plan, AR_ExpNode *lhs_exp, AR_ExpNode *rhs_exp) {
+OpBase *NewValueHashJoin
+(
+	const ExecutionPlan *plan,
+	AR_ExpNode **lhs_exps,
+	AR_ExpNode **rhs_exps
+) {
+	ASSERT(array_len(lhs_exps) > 0);
+	ASSERT(array_len(lhs_exps) == array_len(rhs_exps));
+
 	OpValueHashJoin *op = rm_malloc(sizeof(OpValueHashJoin));
-	op->rhs_rec = NULL;
-	op->lhs_exp = lhs_exp;
-	op->rhs_exp = rhs_exp;
-	op->intersect_idx = -1;
-	op->cached_records = NULL;
-	op->number_of_intersections = 0;
+	op->keys        =  NULL;
+	op->built       =  false;
+	op->rhs_rec     =  NULL;
+	op->buckets     =  NULL;
+	op->entries     =  NULL;
+	op->lhs_exps    =  lhs_exps;
+	op->rhs_exps    =  rhs_exps;
+	op->key_count   =  array_len(lhs_exps);
+	op->probe_pos   =  HASH_JOIN_NIL;
+	op->probe_hash  =  0;
+	op->bucket_mask =  0;
+	op->probe_keys  =  rm_malloc(sizeof(SIValue) * op->key_count);
 
 	// Set our Op operations
 	OpBase_Init((OpBase *)op, OPType_VALUE_HASH_JOIN, "Value Hash Join", ValueHashJoinInit,
 				ValueHashJoinConsume, ValueHashJoinReset, ValueHashJoinToString, ValueHashJoinClone,
 				ValueHashJoinFree, false, plan);
 
-	op->join_value_rec_idx = OpBase_Modifies((OpBase *)op, "pivot");
 	return (OpBase *)op;
 }
 
@@ -224,85 +253,56 @@ static Record ValueHashJoinConsume(OpBase *opBase) {
 	OpBase *right_child = op->op.children[1];
 
 	// Eager, pull from left branch until depleted.
-	if(op->cached_records == NULL) {
-		_cache_records(op);
-		// Sort cache on intersect node ID.
-		_sort_cached_records(op);
-	}
+	if(!op->built) _BuildHashTable(op);
+
+	// No cached records, nothing to join with.
+	if(array_len(op->entries) == 0) return NULL;
 
 	/* Try to produce a record:
 	 * given a right hand side record R,
-	 * evaluate V = exp on R,
-	 * see if there are any cached records
-	 * which V evaluated to V:
-	 * X in cached_records and X[idx] = V
+	 * evaluate its join keys K,
+	 * locate cached records X in K's bucket for which X's keys equal K,
 	 * return merged record:
 	 * X merged with R. */
-
-	Record l;
-	if(op->number_of_intersections > 0) {
-		while((l = _get_intersecting_record(op))) {
-			// Clone cached record before merging rhs.
-			Record c = OpBase_CloneRecord(l);
-			Record_Merge(c, op->rhs_rec);
-			return c;
+	while(true) {
+		if(op->rhs_rec) {
+			Record l = _NextMatch(op);
+			if(l) {
+				// Clone cached record before merging rhs.
+				Record c = OpBase_CloneRecord(l);
+				Record_Merge(c, op->rhs_rec);
+				return c;
+			}
+
+			/* If we're here there are no more
+			 * left hand side records which intersect with R
+			 * discard R. */
+			_ReleaseProbeRecord(op);
 		}
-	}
 
-	/* If we're here there are no more
-	 * left hand side records which intersect with R
-	 * discard R. */
-	if(op->rhs_rec) OpBase_DeleteRecord(op->rhs_rec);
-
-	/* Try to get new right hand side record
-	 * which intersect with a left hand side record. */
-	while(true) {
 		// Pull from right branch.
-		op->rhs_rec = right_child->consume(right_child);
+		op->rhs_rec = OpBase_Consume(right_child);
 		if(!op->rhs_rec) return NULL;
 
-		// Get value on which we're intersecting.
-		SIValue v = AR_EXP_Evaluate(op->rhs_exp, op->rhs_rec);
-
-		bool found_intersection = _set_intersection_idx(op, v);
-		SIValue_Free(v);
-		// No intersection, discard R.
-		if(!found_intersection) {
+		// Records with a NULL join key can't be joined, discard R.
+		if(!_EvaluateKeys(op->rhs_exps, op->key_count, op->rhs_rec,
+						  op->probe_keys)) {
 			OpBase_DeleteRecord(op->rhs_rec);
+			op->rhs_rec = NULL;
 			continue;
 		}
 
-		// Found atleast one intersecting record.
-		l = _get_intersecting_record(op);
-
-		// Clone cached record before merging rhs.
-		Record c = OpBase_CloneRecord(l);
-		Record_Merge(c, op->rhs_rec);
-
-		return c;
+		op->probe_hash = _HashKeys(op->probe_keys, op->key_count);
+		op->probe_pos = op->buckets[op->probe_hash & op->bucket_mask];
 	}
 }
 
 static OpResult ValueHashJoinReset(OpBase *ctx) {
 	OpValueHashJoin *op = (OpValueHashJoin *)ctx;
-	op->intersect_idx = -1;
-	op->number_of_intersections = 0;
 
 	// Clear cached records.
-	if(op->rhs_rec) {
-		OpBase_DeleteRecord(op->rhs_rec);
-		op->rhs_rec = NULL;
-	}
-
-	if(op->cached_records) {
-		uint record_count = array_len(op->cached_records);
-		for(uint i = 0; i < record_count; i++) {
-			Record r = op->cached_records[i];
-			OpBase_DeleteRecord(r);
-		}
-		array_free(op->cached_records);
-		op->cached_records = NULL;
-	}
+	_ReleaseProbeRecord(op);
+	_FreeHashTable(op);
 
 	return OP_OK;
 }
@@ -310,36 +310,38 @@ static OpResult ValueHashJoinReset(OpBase *ctx) {
 static inline OpBase *ValueHashJoinClone(const ExecutionPlan *plan, const OpBase *opBase) {
 	ASSERT(opBase->type == OPType_VALUE_HASH_JOIN);
 	OpValueHashJoin *op = (OpValueHashJoin *)opBase;
-	return NewValueHashJoin(plan, AR_EXP_Clone(op->lhs_exp), AR_EXP_Clone(op->rhs_exp));
+
+	AR_ExpNode **lhs_exps;
+	AR_ExpNode **rhs_exps;
+	array_clone_with_cb(lhs_exps, op->lhs_exps, AR_EXP_Clone);
+	array_clone_with_cb(rhs_exps, op->rhs_exps, AR_EXP_Clone);
+
+	return NewValueHashJoin(plan, lhs_exps, rhs_exps);
 }
 
 /* Frees ValueHashJoin */
 static void ValueHashJoinFree(OpBase *ctx) {
 	OpValueHashJoin *op = (OpValueHashJoin *)ctx;
+
 	// Free cached records.
-	if(op->rhs_rec) {
-		OpBase_DeleteRecord(op->rhs_rec);
-		op->rhs_rec = NULL;
-	}
+	_ReleaseProbeRecord(op);
+	_FreeHashTable(op);
 
-	if(op->cached_records) {
-		uint record_count = array_len(op->cached_records);
-		for(uint i = 0; i < record_count; i++) {
-			Record r = op->cached_records[i];
-			OpBase_DeleteRecord(r);
-		}
-		array_free(op->cached_records);
-		op->cached_records = NULL;
+	if(op->probe_keys) {
+		rm_free(op->probe_keys);
+		op->probe_keys = NULL;
 	}
 
-	if(op->lhs_exp) {
-		AR_EXP_Free(op->lhs_exp);
-		op->lhs_exp = NULL;
+	if(op->lhs_exps) {
+		for(uint i = 0; i < op->key_count; i++) AR_EXP_Free(op->lhs_exps[i]);
+		array_free(op->lhs_exps);
+		op->lhs_exps = NULL;
 	}
 
-	if(op->rhs_exp) {
-		AR_EXP_Free(op->rhs_exp);
-		op->rhs_exp = NULL;
+	if(op->rhs_exps) {
+		for(uint i = 0; i < op->key_count; i++) AR_EXP_Free(op->rhs_exps[i]);
+		array_free(op->rhs_exps);
+		op->rhs_exps = NULL;
 	}
 }
 
@@ -1,5 +1,5 @@
 /*
-* Copyright 2018-2020 Redis Labs Ltd. and Contributors
+* Copyright 2018-2021 Redis Labs Ltd. and Contributors
 *
 * This file is available under the Redis Labs Source Available License Agreement
 */
@@ -9,17 +9,43 @@
 #include "op.h"
 #include "../execution_plan.h"
 #include "../../arithmetic/arithmetic_expression.h"
+#include "xxhash.h"
 
+// entry within the join's hash table
+typedef struct {
+	XXH64_hash_t hash;   // hash of join keys
+	uint64_t next;       // next entry within the same bucket
+	Record r;            // build side record
+} HashJoinEntry;
+
+/* ValueHashJoin joins its left (build) and right (probe) streams
+ * on equality of one or more key expressions
+ * the build stream is consumed eagerly into an in-memory hash table
+ * which is probed by each record of the streamed probe side
+ * records with a NULL key never match */
 typedef struct {
 	OpBase op;
-	Record rhs_rec;                     // Right hand side record.
-	AR_ExpNode *lhs_exp;                // Left hand side expression to join on.
-	AR_ExpNode *rhs_exp;                // Right hand side expression to join on.
-	int64_t intersect_idx;              // Current intersection, < number_of_intersections
-	Record *cached_records;             // Cached left hand side records.
-	uint join_value_rec_idx;            // position on joined expression within record.
-	int64_t number_of_intersections;    // Number of intersections located.
+	Record rhs_rec;                 // Right hand side (probe) record.
+	AR_ExpNode **lhs_exps;          // Left hand side expressions to join on.
+	AR_ExpNode **rhs_exps;          // Right hand side expressions to join on.
+	uint key_count;                 // Number of join keys.
+	SIValue *keys;                  // Join keys of cached records, key_count per entry.
+	SIValue *probe_keys;            // Join keys of the current probe record.
+	XXH64_hash_t probe_hash;        // Hash of the current probe record's keys.
+	HashJoinEntry *entries;         // Cached left hand side records.
+	uint64_t *buckets;              // Hash table buckets, heads of entry chains.
+	uint64_t bucket_mask;           // Number of buckets - 1.
+	uint64_t probe_pos;             // Next entry to inspect for the probe record.
+	bool built;                     // Whether the hash table was built.
 } OpValueHashJoin;
 
-/* Creates a new ValueHashJoin operation */
-OpBase *NewValueHashJoin(const ExecutionPlan *plan, AR_ExpNode *lhs_exp, AR_ExpNode *rhs_exp);
+/* Creates a new ValueHashJoin operation
+ * 'lhs_exps' and 'rhs_exps' are arrays of the same length
+ * ownership of both arrays is transferred to the operation */
+OpBase *NewValueHashJoin
+(
+	const ExecutionPlan *plan,
+	AR_ExpNode **lhs_exps,
+	AR_ExpNode **rhs_exps
+);
+
@@ -38,4 +38,6 @@
 #include "op_semi_apply.h"
 #include "op_apply_multiplexer.h"
 #include "op_optional.h"
+#include "op_degree_count.h"
+#include "op_intersect_traverse.h"
 
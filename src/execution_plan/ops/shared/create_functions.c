@@ -13,10 +13,11 @@
 
 // Add properties to the GraphEntity.
 static inline void _AddProperties(ResultSetStatistics *stats, GraphEntity *ge,
-								  PendingProperties *props) {
+								  PendingProperties *props, StringPool *pool) {
 	int failed_updates = 0;
 	for(int i = 0; i < props->property_count; i++) {
-		bool updated = GraphEntity_AddProperty(ge, props->attr_keys[i], props->values[i]);
+		bool updated = GraphEntity_AddProperty(ge, props->attr_keys[i],
+											   props->values[i], pool);
 		if(!updated) failed_updates++;
 	}
 
@@ -60,6 +61,12 @@ static void _CommitNodesBlueprint(PendingCreations *pending) {
 	}
 }
 
+// nodes sharing the same labels array, labeled in bulk
+typedef struct {
+	int *labels;   // labels shared by all nodes in group
+	NodeID *ids;   // IDs of nodes to label
+} _LabelGroup;
+
 // commit nodes
 static void _CommitNodes(PendingCreations *pending) {
 	Node          *n          =  NULL;
@@ -70,27 +77,61 @@ static void _CommitNodes(PendingCreations *pending) {
 	// sync policy should be set to NOP, no need to sync/resize
 	ASSERT(Graph_GetMatrixPolicy(g) == SYNC_POLICY_NOP);
 
+	// nodes created by the same blueprint share their labels array
+	// group them such that each label matrix is updated once
+	_LabelGroup *groups = array_new(_LabelGroup, 1);
+
 	for(uint i = 0; i < node_count; i++) {
 		n = pending->created_nodes[i];
 		int *labels = pending->node_labels[i];
 		uint label_count = array_len(labels);
 
-		// introduce node into graph
-		Graph_CreateNode(g, n, labels, label_count);
+		// introduce node into graph, labels are set in bulk below
+		Graph_CreateNode(g, n, NULL, 0);
 
 		if(pending->node_properties[i]) {
 			_AddProperties(pending->stats, (GraphEntity *)n,
-						   pending->node_properties[i]);
+						   pending->node_properties[i], g->string_pool);
+		}
+
+		if(label_count == 0) continue;
+
+		// locate node's label group
+		_LabelGroup *group = NULL;
+		uint group_count = array_len(groups);
+		for(uint j = 0; j < group_count; j++) {
+			if(groups[j].labels == labels) {
+				group = groups + j;
+				break;
+			}
+		}
+
+		if(group == NULL) {
+			_LabelGroup new_group = {labels, array_new(NodeID, 1)};
+			array_append(groups, new_group);
+			group = groups + group_count;
 		}
 
-		// add node labels
-		for(uint i = 0; i < label_count; i++) {
-			Schema *s = GraphContext_GetSchemaByID(gc, labels[i], SCHEMA_NODE);
+		array_append(group->ids, ENTITY_GET_ID(n));
+
+		// add node to label indices
+		for(uint j = 0; j < label_count; j++) {
+			Schema *s = GraphContext_GetSchemaByID(gc, labels[j], SCHEMA_NODE);
 			ASSERT(s);
 
 			if(Schema_HasIndices(s)) Schema_AddNodeToIndices(s, n);
 		}
 	}
+
+	// label nodes
+	uint group_count = array_len(groups);
+	for(uint i = 0; i < group_count; i++) {
+		_LabelGroup *group = groups + i;
+		Graph_LabelNodes(g, group->ids, array_len(group->ids), group->labels,
+				array_len(group->labels));
+		array_free(group->ids);
+	}
+	array_free(groups);
 }
 
 // commit edge blueprints
@@ -123,6 +164,14 @@ static void _CommitEdgesBlueprint(EdgeCreateCtx *blueprints) {
 	Graph_GetAdjacencyMatrix(g, false);
 }
 
+// edges of the same relationship type, created in bulk
+typedef struct {
+	int relation_id;  // relationship type shared by all edges in group
+	NodeID *srcs;     // source node IDs
+	NodeID *dests;    // destination node IDs
+	Edge **edges;     // edges to create
+} _EdgeGroup;
+
 // commit edges
 static void _CommitEdges(PendingCreations *pending) {
 	Edge          *e          =  NULL;
@@ -133,32 +182,69 @@ static void _CommitEdges(PendingCreations *pending) {
 	// sync policy should be set to NOP, no need to sync/resize
 	ASSERT(Graph_GetMatrixPolicy(g) == SYNC_POLICY_NOP);
 
+	// edges are assigned IDs in creation order and are then
+	// grouped by relationship type such that each relation matrix
+	// is updated once
+	_EdgeGroup *groups = array_new(_EdgeGroup, 1);
+
 	for(uint i = 0; i < edge_count; i++) {
 		e = pending->created_edges[i];
-		NodeID srcNodeID;
-		NodeID destNodeID;
-
-		// Nodes which already existed prior to this query would
-		// have their ID set under e->srcNodeID and e->destNodeID
-		// Nodes which are created as part of this query would be
-		// saved under edge src/dest pointer.
-		if(e->srcNodeID != INVALID_ENTITY_ID) srcNodeID = e->srcNodeID;
-		else srcNodeID = ENTITY_GET_ID(Edge_GetSrcNode(e));
-		if(e->destNodeID != INVALID_ENTITY_ID) destNodeID = e->destNodeID;
-		else destNodeID = ENTITY_GET_ID(Edge_GetDestNode(e));
-
-		Schema *s = GraphContext_GetSchema(gc, e->relationship, SCHEMA_EDGE);
+		const PendingEdge *pending_edge = pending->pending_edges + i;
+
+		Schema *s = GraphContext_GetSchema(gc, pending_edge->relation,
+				SCHEMA_EDGE);
 		// all schemas have been created in the edge blueprint loop or earlier
 		ASSERT(s != NULL);
 		int relation_id = Schema_GetID(s);
 
-		Graph_CreateEdge(g, srcNodeID, destNodeID, relation_id, e);
+		// locate edge's group
+		_EdgeGroup *group = NULL;
+		uint group_count = array_len(groups);
+		for(uint j = 0; j < group_count; j++) {
+			if(groups[j].relation_id == relation_id) {
+				group = groups + j;
+				break;
+			}
+		}
+
+		if(group == NULL) {
+			_EdgeGroup new_group = {relation_id, array_new(NodeID, 1),
+				array_new(NodeID, 1), array_new(Edge *, 1)};
+			array_append(groups, new_group);
+			group = groups + group_count;
+		}
+
+		// nodes created as part of this query have just been assigned an ID
+		NodeID src   =  ENTITY_GET_ID(pending_edge->src);
+		NodeID dest  =  ENTITY_GET_ID(pending_edge->dest);
+		Graph_ReserveEdge(g, src, dest, relation_id, e);
+
+		array_append(group->srcs, src);
+		array_append(group->dests, dest);
+		array_append(group->edges, e);
+	}
+
+	// introduce edges into graph
+	uint group_count = array_len(groups);
+	for(uint i = 0; i < group_count; i++) {
+		_EdgeGroup *group = groups + i;
+		Graph_CreateEdges(g, group->relation_id, group->srcs, group->dests,
+				group->edges, array_len(group->edges));
+		array_free(group->srcs);
+		array_free(group->dests);
+		array_free(group->edges);
+	}
+	array_free(groups);
+
+	for(uint i = 0; i < edge_count; i++) {
+		e = pending->created_edges[i];
 
 		if(pending->edge_properties[i]) {
 			_AddProperties(pending->stats, (GraphEntity *)e,
-						   pending->edge_properties[i]);
+						   pending->edge_properties[i], g->string_pool);
 		}
 
+		Schema *s = GraphContext_GetSchemaByID(gc, e->relationID, SCHEMA_EDGE);
 		if(s && Schema_HasIndices(s)) Schema_AddEdgeToIndices(s, e);
 	}
 }
@@ -171,6 +257,7 @@ PendingCreations NewPendingCreationsContainer(NodeCreateCtx *nodes, EdgeCreateCt
 	pending.node_labels = array_new(int *, 0);
 	pending.created_nodes = array_new(Node *, 0);
 	pending.created_edges = array_new(Edge *, 0);
+	pending.pending_edges = array_new(PendingEdge, 0);
 	pending.node_properties = array_new(PendingProperties *, 0);
 	pending.edge_properties = array_new(PendingProperties *, 0);
 	pending.stats = NULL;
@@ -323,6 +410,11 @@ void PendingCreationsFree(PendingCreations *pending) {
 		pending->created_edges = NULL;
 	}
 
+	if(pending->pending_edges) {
+		array_free(pending->pending_edges);
+		pending->pending_edges = NULL;
+	}
+
 	// Free all graph-committed properties associated with nodes.
 	if(pending->node_properties) {
 		uint prop_count = array_len(pending->node_properties);
@@ -17,6 +17,15 @@ typedef struct {
 	int property_count;            // Number of properties to be added.
 } PendingProperties;
 
+// endpoints and relationship type of an edge pending creation
+// nodes created by the same operation are only assigned an ID on commit
+// as such the edge keeps a reference to its endpoints within the record
+typedef struct {
+	const Node *src;       // source node
+	const Node *dest;      // destination node
+	const char *relation;  // relationship type
+} PendingEdge;
+
 typedef struct {
 	NodeCreateCtx *nodes_to_create;
 	EdgeCreateCtx *edges_to_create;
@@ -27,6 +36,7 @@ typedef struct {
 	int **node_labels;
 	Node **created_nodes;
 	Edge **created_edges;
+	PendingEdge *pending_edges;
 	ResultSetStatistics *stats;
 } PendingCreations;
 
@@ -0,0 +1,221 @@
+/*
+ * Copyright 2018-2021 Redis Labs Ltd. and Contributors
+ *
+ * This file is available under the Redis Labs Source Available License Agreement
+ */
+
+#include "index_topk.h"
+#include "RG.h"
+#include "../../../query_ctx.h"
+#include "../../../filter_tree/ft_to_rsq.h"
+#include <math.h>
+
+// max number of index queries issued while searching for a window
+#define TOPK_MAX_PROBES 256
+
+// composes a query matching 'filter' documents
+// whose 'field' value is within [min, max]
+static RSQNode *_WindowQuery
+(
+	const IndexTopK *topk,
+	const FT_FilterNode *filter,
+	double min,
+	double max
+) {
+	double rs_min = (min == -INFINITY) ? RSRANGE_NEG_INF : min;
+	double rs_max = (max == INFINITY) ? RSRANGE_INF : max;
+	RSQNode *window = RediSearch_CreateNumericNode(topk->idx, topk->field,
+			rs_max, rs_min, true, true);
+
+	if(filter == NULL) return window;
+
+	FT_FilterNode *unresolved = NULL;
+	RSQNode *root = RediSearch_CreateIntersectNode(topk->idx, false);
+	RediSearch_QueryNodeAddChild(root,
+			FilterTreeToQueryNode(&unresolved, filter, topk->idx));
+	RediSearch_QueryNodeAddChild(root, window);
+
+	// filter was verified to be fully resolved by the index
+	ASSERT(unresolved == NULL);
+
+	return root;
+}
+
+// counts documents matching 'query', counting stops at 'cap'
+static uint64_t _CountDocuments
+(
+	RSIndex *idx,
+	RSQNode *query,
+	uint64_t cap
+) {
+	uint64_t n = 0;
+	RSResultsIterator *iter = RediSearch_GetResultsIterator(query, idx);
+	while(n < cap && RediSearch_ResultsIteratorNext(iter, idx, NULL) != NULL) {
+		n++;
+	}
+	RediSearch_ResultsIteratorFree(iter);
+
+	return n;
+}
+
+// counts documents ranked at 'score' or higher, counting stops at k
+// a document's score is its value when ranked in descending order
+// and its negated value otherwise
+static uint64_t _CountRanked
+(
+	const IndexTopK *topk,
+	const FT_FilterNode *filter,
+	double score
+) {
+	RSQNode *query = (topk->desc) ?
+		_WindowQuery(topk, filter, score, INFINITY) :
+		_WindowQuery(topk, filter, -INFINITY, -score);
+
+	return _CountDocuments(topk->idx, query, topk->k);
+}
+
+// returns true if 'filter' can be fully resolved by the index
+static bool _ResolvedFilter
+(
+	const IndexTopK *topk,
+	const FT_FilterNode *filter
+) {
+	FT_FilterNode *unresolved = NULL;
+	RSQNode *query = FilterTreeToQueryNode(&unresolved, filter, topk->idx);
+
+	// hand query over to an iterator, which is in charge of freeing it
+	RediSearch_ResultsIteratorFree(
+			RediSearch_GetResultsIterator(query, topk->idx));
+
+	if(unresolved == NULL) return true;
+
+	FilterTree_Free(unresolved);
+	return false;
+}
+
+// reads the sorted attribute of the next document within 'iter'
+static bool _NextValue
+(
+	const IndexTopK *topk,
+	Graph *g,
+	RSResultsIterator *iter,
+	SIValue *v
+) {
+	const EntityID *id = RediSearch_ResultsIteratorNext(iter, topk->idx, NULL);
+	if(id == NULL) return false;
+
+	Node n = GE_NEW_NODE();
+	int res = Graph_GetNode(g, *id, &n);
+	ASSERT(res != 0);
+	UNUSED(res);
+
+	*v = *GraphEntity_GetProperty((GraphEntity *)&n, topk->attr);
+	return true;
+}
+
+RSResultsIterator *IndexTopK_Iterator
+(
+	const IndexTopK *topk,
+	Graph *g,
+	int label_id,
+	const FT_FilterNode *filter
+) {
+	ASSERT(g    != NULL);
+	ASSERT(topk != NULL);
+	ASSERT(topk->k > 0);
+
+	uint64_t  k      =  topk->k;
+	RSIndex   *idx   =  topk->idx;
+
+	// observe index updates made by this query
+	QueryCtx_FlushIndexBuffer();
+
+	//--------------------------------------------------------------------------
+	// validate documents are ranked by value
+	//--------------------------------------------------------------------------
+
+	// values of different types are ranked by type, see SIValue_Compare
+	// types ordered before numerics rank first in ascending order
+	// types ordered after numerics, e.g. missing values, rank first otherwise
+	// such values aren't indexed as numerics and can't be windowed
+	SIType types  = Index_FieldTypes(topk->index, topk->attr);
+	SIType before = T_INT64 - 1;
+	SIType after  = ~(before | SI_NUMERIC);
+	if(types & ((topk->desc) ? after : before)) return NULL;
+
+	// booleans rank after numerics in descending order
+	// but are indexed as 0 and 1, windows reaching 1 must be discarded
+	bool boolean = (types & T_BOOL);
+
+	if(filter != NULL && !_ResolvedFilter(topk, filter)) return NULL;
+
+	// nothing to gain when every document is required
+	if(filter == NULL && Graph_LabeledNodeCount(g, label_id) <= k) return NULL;
+	RSQNode *all = _WindowQuery(topk, filter, -INFINITY, INFINITY);
+	if(_CountDocuments(idx, all, k + 1) <= k) return NULL;
+
+	//--------------------------------------------------------------------------
+	// search for a threshold score ranking at least k documents
+	//--------------------------------------------------------------------------
+
+	// start from an arbitrary document's score
+	SIValue v;
+	RSResultsIterator *iter = RediSearch_GetResultsIterator(
+			_WindowQuery(topk, filter, -INFINITY, INFINITY), idx);
+	bool found = _NextValue(topk, g, iter, &v);
+	RediSearch_ResultsIteratorFree(iter);
+
+	if(!found || !(SI_TYPE(v) & (SI_NUMERIC | T_BOOL))) return NULL;
+	double origin = SI_GET_NUMERIC(v);
+	if(!isfinite(origin)) return NULL;
+	if(!topk->desc) origin = -origin;
+
+	double  good;        // score ranking at least k documents
+	double  bad;         // score ranking less than k documents
+	uint    probes = 0;
+	double  step   = fmax(fabs(origin), 1);
+
+	// exponential search, moving away from origin
+	if(_CountRanked(topk, filter, origin) == k) {
+		good = origin;
+		bad  = origin + step;
+		while(_CountRanked(topk, filter, bad) == k) {
+			if(++probes == TOPK_MAX_PROBES) return NULL;
+			good = bad;
+			step *= 2;
+			bad = origin + step;
+		}
+	} else {
+		bad  = origin;
+		good = origin - step;
+		while(_CountRanked(topk, filter, good) < k) {
+			if(++probes == TOPK_MAX_PROBES) return NULL;
+			bad = good;
+			step *= 2;
+			good = origin - step;
+		}
+	}
+
+	// narrow window by bisection
+	while(probes++ < TOPK_MAX_PROBES) {
+		double mid = good + (bad - good) / 2;
+		if(mid <= good || mid >= bad) break;
+		if(_CountRanked(topk, filter, mid) == k) good = mid;
+		else bad = mid;
+	}
+
+	//--------------------------------------------------------------------------
+	// scan window
+	//--------------------------------------------------------------------------
+
+	// booleans within the window were counted as numerics
+	if(boolean && topk->desc && good <= 1) return NULL;
+
+	// any document ranked below 'good' is outranked by at least k documents
+	RSQNode *window = (topk->desc) ?
+		_WindowQuery(topk, filter, good, INFINITY) :
+		_WindowQuery(topk, filter, -INFINITY, -good);
+
+	return RediSearch_GetResultsIterator(window, idx);
+}
+
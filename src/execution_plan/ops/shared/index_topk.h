@@ -0,0 +1,39 @@
+/*
+ * Copyright 2018-2021 Redis Labs Ltd. and Contributors
+ *
+ * This file is available under the Redis Labs Source Available License Agreement
+ */
+
+#pragma once
+
+#include "../../../index/index.h"
+#include "../../../graph/graph.h"
+#include "../../../filter_tree/filter_tree.h"
+#include "redisearch_api.h"
+
+// IndexTopK describes the top ranked documents of an index scan's consumer
+// e.g. MATCH (n:Event) RETURN n ORDER BY n.ts DESC LIMIT 50
+// requires the 50 documents with the highest 'ts' value
+typedef struct {
+	RSIndex *idx;        // index holding the sorted attribute
+	const Index *index;  // index statistics
+	const char *field;   // sorted attribute
+	Attribute_ID attr;   // sorted attribute ID
+	bool desc;           // rank documents in descending order
+	uint k;              // number of top ranked documents required
+} IndexTopK;
+
+// creates an iterator over the documents matching 'filter' whose 'field'
+// value is within the narrowest window found to hold the top k documents
+// a NULL 'filter' matches every node labeled 'label_id'
+// returns NULL if such a window can't be established
+// e.g. documents holding a non-numeric value may rank ahead of numerics
+// in which case all documents must be ranked
+RSResultsIterator *IndexTopK_Iterator
+(
+	const IndexTopK *topk,        // top-k requirement
+	Graph *g,                     // graph
+	int label_id,                 // scanned label
+	const FT_FilterNode *filter   // [optional] filter
+);
+
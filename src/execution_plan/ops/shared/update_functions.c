@@ -16,7 +16,7 @@
  * for NULL values, the property will be deleted if present
  * and nothing will be done otherwise
  * returns 1 if a property was set or deleted */
-static int _UpdateEntity(PendingUpdateCtx *update) {
+static int _UpdateEntity(PendingUpdateCtx *update, StringPool *pool) {
 	int           res        =  0;
 	GraphEntity   *ge        =  update->ge;
 	Attribute_ID  attr_id    =  update->attr_id;
@@ -31,11 +31,11 @@ static int _UpdateEntity(PendingUpdateCtx *update) {
 	if(old_value == PROPERTY_NOTFOUND) {
 		// adding a new property; do nothing if its value is NULL
 		if(SI_TYPE(new_value) != T_NULL) {
-			res = GraphEntity_AddProperty(ge, attr_id, new_value);
+			res = GraphEntity_AddProperty(ge, attr_id, new_value, pool);
 		}
 	} else {
 		// update property
-		res = GraphEntity_SetProperty(ge, attr_id, new_value);
+		res = GraphEntity_SetProperty(ge, attr_id, new_value, pool);
 	}
 
 	SIValue_Free(new_value);
@@ -154,7 +154,7 @@ void CommitUpdates(GraphContext *gc, ResultSetStatistics *stats,
 		if(GraphEntity_IsDeleted(ge)) continue;
 
 		// update the property on the graph entity
-		int updated = _UpdateEntity(update);
+		int updated = _UpdateEntity(update, gc->g->string_pool);
 		properties_set += updated;
 		// reindex only if update performed
 		reindex |= update->update_index & (bool)updated;
@@ -272,7 +272,7 @@ void EvalEntityUpdates(GraphContext *gc, PendingUpdateCtx **node_updates,
 				SIValue value;
 				Map_GetIdx(m, j, &key, &value);
 				Attribute_ID attr_id = GraphContext_FindOrAddAttribute(gc,
-																	   key.stringval);
+																	   SI_STRINGVAL(key));
 
 				update = _PreparePendingUpdate(gc, accepted_properties, entity,
 											   attr_id, value, st);
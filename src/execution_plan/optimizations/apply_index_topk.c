@@ -0,0 +1,151 @@
+/*
+* Copyright 2018-2021 Redis Labs Ltd. and Contributors
+*
+* This file is available under the Redis Labs Source Available License Agreement
+*/
+
+#include "RG.h"
+#include "../ops/op_sort.h"
+#include "../ops/op_project.h"
+#include "../ops/op_node_by_label_scan.h"
+#include "../ops/op_node_by_index_scan.h"
+#include "../../query_ctx.h"
+#include "../execution_plan_build/execution_plan_modify.h"
+#include "../../ast/ast_build_op_contexts.h"
+
+/* applyIndexTopK will look for a limited sort of nodes by a single indexed
+ * attribute, where the sorted nodes are produced by a label or index scan
+ * the scan is restricted to the window of attribute values holding the
+ * top ranked nodes, such that only a fraction of the scanned nodes are sorted
+ *
+ * e.g.
+ * MATCH (n:Event) RETURN n ORDER BY n.ts DESC LIMIT 50
+ *
+ * given an index on Event's ts attribute, the label scan only produces
+ * nodes which might be among the 50 most recent events
+ *
+ * RediSearch iterates documents by ID rather than by value, as such
+ * the window is established by counting documents within value ranges */
+
+// resolves the sorted attribute and the entity it is accessed on
+// 'name' must be passed as is by the projections between 'op' and 'scan'
+// returns NULL if 'name' doesn't refer to an attribute of a projected entity
+static const char *_ResolveAttribute
+(
+	const OpBase *op,    // operation to start from
+	const OpBase *scan,  // scan operation
+	const char *name,    // name to resolve
+	const char **alias   // [output] entity alias
+) {
+	const char *attr = NULL;
+
+	for(; op != scan; op = op->children[0]) {
+		ASSERT(op->type == OPType_PROJECT);
+
+		// locate projection of 'name'
+		const OpProject *project = (const OpProject *)op;
+		const AR_ExpNode *exp = NULL;
+		for(uint i = 0; i < project->exp_count; i++) {
+			if(strcmp(project->exps[i]->resolved_name, name) == 0) {
+				exp = project->exps[i];
+				break;
+			}
+		}
+		if(exp == NULL) return NULL;
+
+		if(AR_EXP_IsVariadic(exp)) {
+			// 'name' is an alias of a previously projected name
+			name = exp->operand.variadic.entity_alias;
+		} else if(attr == NULL && AR_EXP_IsAttribute(exp, (char **)&attr)) {
+			// 'name' is an attribute of a previously projected entity
+			const AR_ExpNode *entity = exp->op.children[0];
+			if(!AR_EXP_IsVariadic(entity)) return NULL;
+			name = entity->operand.variadic.entity_alias;
+		} else {
+			return NULL;
+		}
+	}
+
+	*alias = name;
+	return attr;
+}
+
+static void _ApplyTopK
+(
+	OpSort *sort
+) {
+	// ties on a single sort key are resolved arbitrarily
+	if(array_len(sort->exps) != 1) return;
+	if(sort->limit == UNLIMITED || sort->limit == 0) return;
+
+	uint k = sort->limit + sort->skip;
+	if(k < sort->limit) return;  // overflow
+
+	// sorted records must be produced by a scan, passed through projections
+	OpBase *scan = ((OpBase *)sort)->children[0];
+	while(scan->type == OPType_PROJECT) scan = scan->children[0];
+	if(scan->childCount != 0) return;
+
+	NodeScanCtx *n = NULL;
+	if(scan->type == OPType_NODE_BY_LABEL_SCAN) {
+		NodeByLabelScan *label_scan = (NodeByLabelScan *)scan;
+		// the window is computed over the scanned label only
+		// nodes lacking any of the additional labels would be discarded
+		// after the window is formed, yielding less than k nodes
+		if(label_scan->labels != NULL) return;
+		n = &label_scan->n;
+	} else if(scan->type == OPType_NODE_BY_INDEX_SCAN) {
+		n = &((IndexScan *)scan)->n;
+	} else {
+		return;
+	}
+
+	const char *alias = NULL;
+	const char *attr = _ResolveAttribute(((OpBase *)sort)->children[0], scan,
+			sort->exps[0]->resolved_name, &alias);
+	if(attr == NULL || strcmp(alias, n->alias) != 0) return;
+
+	// attribute must be indexed
+	GraphContext *gc = QueryCtx_GetGraphCtx();
+	Attribute_ID attr_id = GraphContext_GetAttributeID(gc, attr);
+	if(attr_id == ATTRIBUTE_NOTFOUND) return;
+
+	Index *idx = GraphContext_GetIndex(gc, n->label, &attr_id, IDX_EXACT_MATCH,
+			SCHEMA_NODE);
+	if(idx == NULL) return;
+
+	// reference the index's copy of the attribute name
+	const char *field = NULL;
+	const char **fields = Index_GetFields(idx);
+	uint field_count = Index_FieldsCount(idx);
+	for(uint i = 0; i < field_count; i++) {
+		if(strcmp(fields[i], attr) == 0) field = fields[i];
+	}
+	ASSERT(field != NULL);
+
+	IndexTopK topk = {
+		.k      =  k,
+		.idx    =  idx->idx,
+		.index  =  idx,
+		.attr   =  attr_id,
+		.desc   =  (sort->directions[0] == DIR_DESC),
+		.field  =  field
+	};
+
+	if(scan->type == OPType_NODE_BY_LABEL_SCAN) {
+		NodeByLabelScanOp_SetTopK((NodeByLabelScan *)scan, &topk);
+	} else {
+		IndexScanOp_SetTopK((IndexScan *)scan, &topk);
+	}
+}
+
+void applyIndexTopK(ExecutionPlan *plan) {
+	OpBase **sorts = ExecutionPlan_CollectOps(plan->root, OPType_SORT);
+
+	for(uint i = 0; i < array_len(sorts); i++) {
+		_ApplyTopK((OpSort *)sorts[i]);
+	}
+
+	array_free(sorts);
+}
+
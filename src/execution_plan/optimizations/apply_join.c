@@ -5,6 +5,7 @@
 */
 
 #include "../../util/arr.h"
+#include "../../query_ctx.h"
 #include "../ops/op_filter.h"
 #include "../../util/strcmp.h"
 #include "../ops/op_value_hash_join.h"
@@ -21,9 +22,11 @@
  * prior to this optimization a and b will be combined via a
  * cartesian product O(n^2) because a and b are related,
  * we require a.v = b.v, v acts as a join key in which case
- * replacing the cartesian product by a join operation will
+ * replacing the cartesian product by a hash join operation will
  * 1. consume N additional memory
- * 2. reduce the overall runtime by a factor of magnitude. */
+ * 2. reduce the overall runtime to O(n + m)
+ * all equality filters relating the same two streams become keys
+ * of a single join, e.g. a.x = b.x AND a.y = b.y */
 
 // To be used as a possible output of _relate_exp_to_stream.
 
@@ -72,22 +75,31 @@ static OpFilter **_locate_filters(OpBase *cp) {
 
 // This function builds a Hash Join operation given its left and right branches and join criteria.
 static OpBase *_build_hash_join_op(const ExecutionPlan *plan, OpBase *left_branch,
-								   OpBase *right_branch, AR_ExpNode *lhs_join_exp, AR_ExpNode *rhs_join_exp) {
+								   OpBase *right_branch, AR_ExpNode **lhs_join_exps,
+								   AR_ExpNode **rhs_join_exps) {
 	OpBase *value_hash_join;
 
-	/* The Value Hash Join will cache its left-hand stream. To reduce the cache size,
-	 * prefer to cache the stream which will produce the smallest number of records.
-	 * Our current heuristic for this is to prefer a stream which contains a filter operation. */
+	/* The Value Hash Join will build a hash table from its left-hand stream.
+	 * To reduce the table size, prefer to build on the stream which will
+	 * produce the smallest number of records, as estimated by the streams'
+	 * scans and filters. The estimated filter selectivity is a rough guess,
+	 * on a tie prefer a stream which contains a filter operation. */
+	Graph *g = QueryCtx_GetGraph();
+	uint64_t left_records = ExecutionPlan_EstimateRecords(left_branch, g);
+	uint64_t right_records = ExecutionPlan_EstimateRecords(right_branch, g);
 	bool left_branch_filtered = (ExecutionPlan_LocateOp(left_branch, OPType_FILTER) != NULL);
 	bool right_branch_filtered = (ExecutionPlan_LocateOp(right_branch, OPType_FILTER) != NULL);
-	if(!left_branch_filtered && right_branch_filtered) {
-		// Only the RHS stream is filtered, swap the input streams and expressions.
-		value_hash_join = NewValueHashJoin(plan, rhs_join_exp, lhs_join_exp);
+	bool swap = (right_records < left_records) ||
+				(right_records == left_records && !left_branch_filtered &&
+				 right_branch_filtered);
+	if(swap) {
+		// The RHS stream is expected to be smaller, swap the input streams and expressions.
+		value_hash_join = NewValueHashJoin(plan, rhs_join_exps, lhs_join_exps);
 		OpBase *t = left_branch;
 		left_branch = right_branch;
 		right_branch = t;
 	} else {
-		value_hash_join = NewValueHashJoin(plan, lhs_join_exp, rhs_join_exp);
+		value_hash_join = NewValueHashJoin(plan, lhs_join_exps, rhs_join_exps);
 	}
 
 	// Add the detached streams to the join op.
@@ -137,8 +149,37 @@ static void _reduce_cp_to_hashjoin(ExecutionPlan *plan, OpBase *cp) {
 		}
 
 		// Clone the filter expressions.
-		lhs = AR_EXP_Clone(lhs);
-		rhs = AR_EXP_Clone(rhs);
+		AR_ExpNode **lhs_exps = array_new(AR_ExpNode *, 1);
+		AR_ExpNode **rhs_exps = array_new(AR_ExpNode *, 1);
+		array_append(lhs_exps, AR_EXP_Clone(lhs));
+		array_append(rhs_exps, AR_EXP_Clone(rhs));
+
+		// Additional equality filters relating the same two streams
+		// become additional join keys.
+		for(uint j = i + 1; j < filter_count;) {
+			FT_FilterNode *other = filter_ops[j]->filterTree;
+			int other_lhs_stream = _relate_exp_to_stream(other->pred.lhs, stream_entities, stream_count);
+			int other_rhs_stream = _relate_exp_to_stream(other->pred.rhs, stream_entities, stream_count);
+
+			if(other_lhs_stream == (int)lhs_resolving_stream &&
+			   other_rhs_stream == (int)rhs_resolving_stream) {
+				array_append(lhs_exps, AR_EXP_Clone(other->pred.lhs));
+				array_append(rhs_exps, AR_EXP_Clone(other->pred.rhs));
+			} else if(other_lhs_stream == (int)rhs_resolving_stream &&
+					  other_rhs_stream == (int)lhs_resolving_stream) {
+				array_append(lhs_exps, AR_EXP_Clone(other->pred.rhs));
+				array_append(rhs_exps, AR_EXP_Clone(other->pred.lhs));
+			} else {
+				j++;
+				continue;
+			}
+
+			// The filter will be resolved by the join operation; remove it.
+			ExecutionPlan_RemoveOp(plan, (OpBase *)filter_ops[j]);
+			OpBase_Free((OpBase *)filter_ops[j]);
+			array_del(filter_ops, j);
+			filter_count--;
+		}
 
 		// Retrieve the relevant branch roots.
 		OpBase *right_branch = cp->children[rhs_resolving_stream];
@@ -148,7 +189,7 @@ static void _reduce_cp_to_hashjoin(ExecutionPlan *plan, OpBase *cp) {
 		ExecutionPlan_DetachOp(left_branch);
 		// Build hash join op.
 		OpBase *value_hash_join = _build_hash_join_op
-								  (cp->plan, left_branch, right_branch, lhs, rhs);
+								  (cp->plan, left_branch, right_branch, lhs_exps, rhs_exps);
 
 		// The filter will now be resolved by the join operation; remove it.
 		ExecutionPlan_RemoveOp(plan, (OpBase *)filter_op);
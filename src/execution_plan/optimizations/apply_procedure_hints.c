@@ -0,0 +1,163 @@
+/*
+* Copyright 2018-2021 Redis Labs Ltd. and Contributors
+*
+* This file is available under the Redis Labs Source Available License Agreement
+*/
+
+#include "RG.h"
+#include "../ops/op_sort.h"
+#include "../ops/op_skip.h"
+#include "../ops/op_limit.h"
+#include "../ops/op_project.h"
+#include "../ops/op_procedure_call.h"
+#include "../execution_plan_build/execution_plan_modify.h"
+#include "../../ast/ast_build_op_contexts.h"
+
+/* applyProcedureHints will look for procedure calls whose records are
+ * consumed by a Limit operation, optionally sorted along the way.
+ * procedures able to honor a limit are told how many records are required,
+ * procedures able to compute top-k are told how many records are required
+ * when these are sorted by the procedure's order output,
+ * and a sort by the order output of a procedure which yields its records
+ * in that order is removed altogether.
+ *
+ * e.g.
+ * CALL algo.pageRank(NULL, NULL) YIELD node, score
+ * RETURN node, score ORDER BY score DESC LIMIT 20
+ *
+ * only the top 20 ranked nodes are materialized */
+
+// resolves the procedure output 'name' refers to
+// 'name' must be passed as is by the projections between 'op' and 'call'
+// returns NULL if 'name' doesn't refer to a procedure output
+static const char *_ResolveOutput
+(
+	const OpBase *op,          // operation to start from
+	const OpProcCall *call,    // procedure call
+	const char *name           // name to resolve
+) {
+	for(; op != (const OpBase *)call; op = op->children[0]) {
+		if(op->type != OPType_PROJECT) continue;
+
+		// locate projection of 'name'
+		const OpProject *project = (const OpProject *)op;
+		const AR_ExpNode *exp = NULL;
+		for(uint i = 0; i < project->exp_count; i++) {
+			if(strcmp(project->exps[i]->resolved_name, name) == 0) {
+				exp = project->exps[i];
+				break;
+			}
+		}
+
+		// 'name' must be an alias of a previously projected name
+		if(exp == NULL || !AR_EXP_IsVariadic(exp)) return NULL;
+		name = exp->operand.variadic.entity_alias;
+	}
+
+	uint yield_count = array_len(call->yield_exps);
+	for(uint i = 0; i < yield_count; i++) {
+		const AR_ExpNode *yield = call->yield_exps[i];
+		if(strcmp(yield->resolved_name, name) == 0) {
+			return yield->operand.variadic.entity_alias;
+		}
+	}
+
+	return NULL;
+}
+
+// returns true if 'sort' orders records by the ranking of 'call'
+static bool _SortByProcedureOrder
+(
+	const OpSort *sort,
+	const OpProcCall *call
+) {
+	// ties on a single sort key are resolved arbitrarily
+	// additional keys dictate an order the procedure isn't aware of
+	if(array_len(sort->exps) != 1) return false;
+
+	bool desc;
+	const char *order_by = Procedure_GetOrder(call->procedure, &desc);
+	if(order_by == NULL) return false;
+	if(desc != (sort->directions[0] == DIR_DESC)) return false;
+
+	const char *output = _ResolveOutput(((const OpBase *)sort)->children[0],
+			call, sort->exps[0]->resolved_name);
+
+	return (output != NULL && strcmp(output, order_by) == 0);
+}
+
+static void _ApplyHints
+(
+	ExecutionPlan *plan,
+	OpProcCall *call
+) {
+	OpSort  *sort   =  NULL;
+	uint    skip    =  0;
+	uint    limit   =  UNLIMITED;
+
+	// walk up the operations consuming procedure records
+	// as long as these neither discard nor duplicate records
+	OpBase *op = ((OpBase *)call)->parent;
+	while(op != NULL && limit == UNLIMITED) {
+		switch(op->type) {
+			case OPType_PROJECT:
+				break;
+			case OPType_SORT:
+				// order of a prior sort is irrelevant
+				if(sort != NULL) return;
+				sort = (OpSort *)op;
+				break;
+			case OPType_SKIP:
+				skip += ((OpSkip *)op)->skip;
+				break;
+			case OPType_LIMIT:
+				limit = ((OpLimit *)op)->limit;
+				break;
+			default:
+				// operation might filter records
+				op = NULL;
+				continue;
+		}
+		op = op->parent;
+	}
+
+	bool ordered = false;
+	if(sort != NULL) {
+		// records are required in an order the procedure isn't aware of
+		if(!_SortByProcedureOrder(sort, call)) return;
+
+		// a procedure invoked once, which yields records in the required
+		// order, doesn't need its records sorted
+		// multiple invocations are ordered individually, not as a whole
+		if(((OpBase *)call)->childCount == 0 &&
+		   Procedure_HasCapability(call->procedure, PROCEDURE_CAP_ORDERED)) {
+			ExecutionPlan_RemoveOp(plan, (OpBase *)sort);
+			OpBase_Free((OpBase *)sort);
+			ordered = true;
+		}
+	}
+
+	if(limit == UNLIMITED) return;
+
+	// each invocation yields at most 'limit' + 'skip' required records
+	ProcedureHints hints = { .limit = limit + skip, .top_k = (sort != NULL) };
+	if(hints.limit < limit) return;  // overflow
+
+	// an ordered procedure's first records are its top records
+	if(ordered) hints.top_k = false;
+
+	ProcedureCapability cap = (hints.top_k) ?
+		PROCEDURE_CAP_TOPK : PROCEDURE_CAP_LIMIT;
+	if(Procedure_HasCapability(call->procedure, cap)) call->hints = hints;
+}
+
+void applyProcedureHints(ExecutionPlan *plan) {
+	OpBase **calls = ExecutionPlan_CollectOps(plan->root, OPType_PROC_CALL);
+
+	for(uint i = 0; i < array_len(calls); i++) {
+		_ApplyHints(plan, (OpProcCall *)calls[i]);
+	}
+
+	array_free(calls);
+}
+
@@ -0,0 +1,112 @@
+/*
+* Copyright 2018-2021 Redis Labs Ltd. and Contributors
+*
+* This file is available under the Redis Labs Source Available License Agreement
+*/
+
+#include "RG.h"
+#include "../ops/ops.h"
+#include "../../util/arr.h"
+#include "../../query_ctx.h"
+#include "../execution_plan_build/execution_plan_modify.h"
+
+/* batchSemiApply looks for Semi Apply and Anti Semi Apply operations
+ * testing for the presence of a single traversal pattern, e.g.
+ * MATCH (n:User) WHERE NOT (n)-[:BLOCKED]->(:User {id: $me}) RETURN n
+ * planned as:
+ * ANTI SEMI APPLY
+ *     NODE BY LABEL SCAN (n:User)
+ *     FILTER (anon.id = $me)
+ *         CONDITIONAL TRAVERSE (n)->(anon:User)
+ *             ARGUMENT
+ *
+ * the match branch is reset and re-run for every bound record,
+ * instead, the match branch is folded into the apply operation,
+ * which evaluates the traversal for a batch of bound records at once
+ * using a filter matrix and applies the filters to the reached nodes
+ * per row, patterns which aren't a single traversal keep the per record
+ * evaluation */
+
+static void _batchSemiApply
+(
+	OpSemiApply *apply
+) {
+	OpBase *op = (OpBase *)apply;
+
+	// expecting both a bound branch and a match branch
+	if(op->childCount != 2 || apply->ae != NULL) return;
+
+	// match branch: [FILTER ...] -> TRAVERSE -> ARGUMENT
+	OpBase *branch = op->children[1];
+	OpBase *traverse = branch;
+	while(traverse->type == OPType_FILTER) {
+		if(traverse->childCount != 1) return;
+		traverse = traverse->children[0];
+	}
+
+	if(traverse->childCount != 1 ||
+	   traverse->children[0]->type != OPType_ARGUMENT) return;
+
+	// the traversed edge can't be referenced by the filters
+	Graph *g;
+	AlgebraicExpression *ae;
+	bool expand_into;
+	if(traverse->type == OPType_CONDITIONAL_TRAVERSE) {
+		OpCondTraverse *cond_traverse = (OpCondTraverse *)traverse;
+		if(cond_traverse->edge_ctx != NULL) return;
+		g = cond_traverse->graph;
+		ae = cond_traverse->ae;
+		cond_traverse->ae = NULL;
+		expand_into = false;
+	} else if(traverse->type == OPType_EXPAND_INTO) {
+		OpExpandInto *expand = (OpExpandInto *)traverse;
+		if(expand->edge_ctx != NULL) return;
+		g = expand->graph;
+		ae = expand->ae;
+		expand->ae = NULL;
+		expand_into = true;
+	} else {
+		return;
+	}
+
+	// collect and combine the match branch filters
+	FT_FilterNode **filters = array_new(FT_FilterNode *, 1);
+	for(OpBase *f = branch; f != traverse; f = f->children[0]) {
+		OpFilter *filter = (OpFilter *)f;
+		array_append(filters, filter->filterTree);
+		filter->filterTree = NULL;
+	}
+
+	uint filter_count = array_len(filters);
+	FT_FilterNode *filter = (filter_count > 0) ?
+		FilterTree_Combine(filters, filter_count) : NULL;
+	array_free(filters);
+
+	SemiApplyOp_SetBatched(apply, g, ae, filter, expand_into);
+
+	// discard the match branch
+	ExecutionPlan_DetachOp(branch);
+	while(branch != NULL) {
+		OpBase *child = (branch->childCount > 0) ? branch->children[0] : NULL;
+		OpBase_Free(branch);
+		branch = child;
+	}
+}
+
+void batchSemiApply
+(
+	ExecutionPlan *plan
+) {
+	ASSERT(plan != NULL);
+
+	const OPType types[2] = {OPType_SEMI_APPLY, OPType_ANTI_SEMI_APPLY};
+	OpBase **applies = ExecutionPlan_CollectOpsMatchingType(plan->root, types, 2);
+
+	uint count = array_len(applies);
+	for(uint i = 0; i < count; i++) {
+		_batchSemiApply((OpSemiApply *)applies[i]);
+	}
+
+	array_free(applies);
+}
+
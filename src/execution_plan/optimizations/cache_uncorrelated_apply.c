@@ -0,0 +1,174 @@
+/*
+* Copyright 2018-2021 Redis Labs Ltd. and Contributors
+*
+* This file is available under the Redis Labs Source Available License Agreement
+*/
+
+#include "RG.h"
+#include "../ops/ops.h"
+#include "../../util/arr.h"
+#include "../execution_plan_build/execution_plan_modify.h"
+
+// cacheUncorrelatedApply looks for Apply operations
+// whose right-hand branch doesn't refer to any variable bound by the
+// left-hand branch, e.g.
+// MATCH (u:User) OPTIONAL MATCH (c:Config {key: 'theme'}) RETURN u, c
+// planned as:
+// APPLY
+//     NODE BY LABEL SCAN (u:User)
+//     OPTIONAL
+//         FILTER (c.key = 'theme')
+//             NODE BY LABEL SCAN (c:Config)
+//                 ARGUMENT
+//
+// the right-hand branch is reset and re-executed for every 'u'
+// although it produces the same records each time
+// once marked as uncorrelated, Apply executes the branch once
+// and merges its cached records with every bound record
+//
+// a branch is considered uncorrelated only if it is made of operations
+// whose references are known, anything else keeps the per record execution
+
+// collect aliases referenced by filter tree
+// returns false if filter can't be evaluated once for all records
+static bool _CollectFilterReferences
+(
+	const FT_FilterNode *ft,
+	rax *refs
+) {
+	if(ft == NULL) return true;
+
+	// a random predicate must be re-evaluated for each bound record
+	FT_FilterNode *node;
+	if(FilterTree_ContainsFunc(ft, "rand", &node)) return false;
+
+	rax *modified = FilterTree_CollectModified(ft);
+	raxIterator it;
+	raxStart(&it, modified);
+	raxSeek(&it, "^", NULL, 0);
+	while(raxNext(&it)) raxTryInsert(refs, it.key, it.key_len, NULL, NULL);
+	raxStop(&it);
+	raxFree(modified);
+
+	return true;
+}
+
+static inline void _AddReference
+(
+	rax *refs,
+	const char *alias
+) {
+	if(alias == NULL) return;
+	raxTryInsert(refs, (unsigned char *)alias, strlen(alias), NULL, NULL);
+}
+
+// collect aliases referenced by the operations of branch
+// returns false if branch contains an operation
+// which may depend on the bound records in an unknown way
+static bool _CollectReferences
+(
+	OpBase *op,
+	rax *refs
+) {
+	switch(op->type) {
+		case OPType_ARGUMENT:
+			// argument introduces the bound variables, it doesn't read them
+			return true;
+		case OPType_OPTIONAL:
+		case OPType_CARTESIAN_PRODUCT:
+		case OPType_ALL_NODE_SCAN:
+		case OPType_NODE_BY_LABEL_SCAN:
+		case OPType_NODE_BY_ID_SEEK:
+			break;
+		case OPType_FILTER:
+			if(!_CollectFilterReferences(((OpFilter *)op)->filterTree,
+						refs)) {
+				return false;
+			}
+			break;
+		case OPType_NODE_BY_INDEX_SCAN: {
+			IndexScan *scan = (IndexScan *)op;
+			if(!_CollectFilterReferences(scan->filter, refs) ||
+			   !_CollectFilterReferences(scan->unresolved_filters, refs)) {
+				return false;
+			}
+			break;
+		}
+		case OPType_CONDITIONAL_TRAVERSE: {
+			AlgebraicExpression *ae = ((OpCondTraverse *)op)->ae;
+			_AddReference(refs, AlgebraicExpression_Src(ae));
+			_AddReference(refs, AlgebraicExpression_Dest(ae));
+			break;
+		}
+		case OPType_EXPAND_INTO: {
+			AlgebraicExpression *ae = ((OpExpandInto *)op)->ae;
+			_AddReference(refs, AlgebraicExpression_Src(ae));
+			_AddReference(refs, AlgebraicExpression_Dest(ae));
+			break;
+		}
+		case OPType_INTERSECT_TRAVERSE: {
+			OpIntersectTraverse *intersect = (OpIntersectTraverse *)op;
+			uint constraint_count = array_len(intersect->constraints);
+			for(uint i = 0; i < constraint_count; i++) {
+				_AddReference(refs, intersect->constraints[i].alias);
+			}
+			break;
+		}
+		default:
+			return false;
+	}
+
+	// every modified alias is referenced as well
+	uint modifies_count = array_len(op->modifies);
+	for(uint i = 0; i < modifies_count; i++) _AddReference(refs, op->modifies[i]);
+
+	for(int i = 0; i < op->childCount; i++) {
+		if(!_CollectReferences(op->children[i], refs)) return false;
+	}
+
+	return true;
+}
+
+// returns true if branch doesn't refer to any variable
+// introduced by its argument operation
+static bool _UncorrelatedBranch
+(
+	OpBase *branch
+) {
+	OpBase *arg = ExecutionPlan_LocateOp(branch, OPType_ARGUMENT);
+	if(arg == NULL) return false;
+
+	rax *refs = raxNew();
+	bool uncorrelated = _CollectReferences(branch, refs);
+
+	uint arg_count = array_len(arg->modifies);
+	for(uint i = 0; i < arg_count && uncorrelated; i++) {
+		const char *alias = arg->modifies[i];
+		if(raxFind(refs, (unsigned char *)alias, strlen(alias)) != raxNotFound) {
+			uncorrelated = false;
+		}
+	}
+
+	raxFree(refs);
+	return uncorrelated;
+}
+
+void cacheUncorrelatedApply
+(
+	ExecutionPlan *plan
+) {
+	ASSERT(plan != NULL);
+
+	OpBase **applies = ExecutionPlan_CollectOps(plan->root, OPType_APPLY);
+
+	uint count = array_len(applies);
+	for(uint i = 0; i < count; i++) {
+		Apply *apply = (Apply *)applies[i];
+		OpBase *op = (OpBase *)apply;
+		if(op->childCount != 2) continue;
+		if(_UncorrelatedBranch(op->children[1])) ApplyOp_SetUncorrelated(apply);
+	}
+
+	array_free(applies);
+}
+
@@ -0,0 +1,258 @@
+/*
+* Copyright 2018-2021 Redis Labs Ltd. and Contributors
+*
+* This file is available under the Redis Labs Source Available License Agreement
+*/
+
+#include "RG.h"
+#include "../ops/ops.h"
+#include "../../util/arr.h"
+#include "../../util/strcmp.h"
+#include "../execution_plan_build/execution_plan_modify.h"
+
+// intersectTraversals looks for cyclic patterns
+// e.g. MATCH (a)-[:F]->(b)-[:F]->(c)-[:F]->(a)
+// which are planned as:
+// SCAN (a)
+// TRAVERSE (a)-[:F]->(b)
+// TRAVERSE (b)-[:F]->(c)
+// EXPAND INTO (c)-[:F]->(a)
+//
+// the last traversal produces every neighbour of 'b'
+// only to have most of them discarded by expand into
+// this optimization merges the traversal and the expand into operations
+// into a single Intersect Traverse operation which resolves 'c'
+// by intersecting the neighbours of both 'b' and 'a':
+// SCAN (a)
+// TRAVERSE (a)-[:F]->(b)
+// INTERSECT TRAVERSE (b)-[:F]->(c), (a)<-[:F]-(c)
+//
+// as such 'c' is bound one variable at a time
+// to the intersection of all of its bound neighbours rows
+// which is the generic worst-case optimal join scheme
+
+// a traversal expression reduced to a single relation
+typedef struct {
+	const char *src;        // relation source alias
+	const char *dest;       // relation destination alias
+	const char *relation;   // relation type, NULL for any relation
+	bool transpose;         // relation is transposed
+	const char **labels;    // labels applied to the 'labeled' alias
+	const char *labeled;    // alias of labeled node
+} _SimpleTraversal;
+
+// collect expression's relation operand and diagonal label operands
+// returns false if expression isn't made of a single relation operand
+// possibly transposed and multiplied by label operands
+static bool _CollectOperands
+(
+	const AlgebraicExpression *exp,
+	bool transposed,
+	_SimpleTraversal *t,
+	bool *relation_found
+) {
+	if(exp->type == AL_OPERAND) {
+		if(exp->operand.diagonal) {
+			// label operand, make sure it filters a single node
+			if(exp->operand.label == NULL) return false;
+			if(RG_STRCMP(exp->operand.src, exp->operand.dest)) return false;
+			if(t->labeled != NULL && RG_STRCMP(t->labeled, exp->operand.src)) {
+				return false;
+			}
+			t->labeled = exp->operand.src;
+			array_append(t->labels, exp->operand.label);
+			return true;
+		}
+
+		// relation operand, expecting a single one
+		// referenced edges can't be resolved by intersection
+		if(*relation_found || exp->operand.edge != NULL) return false;
+		*relation_found = true;
+
+		t->relation = exp->operand.label;
+		t->transpose = transposed;
+		t->src = transposed ? exp->operand.dest : exp->operand.src;
+		t->dest = transposed ? exp->operand.src : exp->operand.dest;
+		return true;
+	}
+
+	AL_EXP_OP op = exp->operation.op;
+	if(op != AL_EXP_MUL && op != AL_EXP_TRANSPOSE) return false;
+	if(op == AL_EXP_TRANSPOSE) transposed = !transposed;
+
+	uint child_count = AlgebraicExpression_ChildCount(exp);
+	for(uint i = 0; i < child_count; i++) {
+		if(!_CollectOperands(exp->operation.children[i], transposed, t,
+					relation_found)) {
+			return false;
+		}
+	}
+
+	return true;
+}
+
+// reduce expression to a simple traversal
+static bool _SimpleTraversal_New
+(
+	const AlgebraicExpression *exp,
+	_SimpleTraversal *t
+) {
+	bool relation_found = false;
+
+	t->src = NULL;
+	t->dest = NULL;
+	t->labeled = NULL;
+	t->relation = NULL;
+	t->transpose = false;
+	t->labels = array_new(const char *, 0);
+
+	if(!_CollectOperands(exp, false, t, &relation_found) || !relation_found) {
+		array_free(t->labels);
+		t->labels = NULL;
+		return false;
+	}
+
+	return true;
+}
+
+static inline void _SimpleTraversal_Free
+(
+	_SimpleTraversal *t
+) {
+	if(t->labels != NULL) array_free(t->labels);
+	t->labels = NULL;
+}
+
+// adds traversal as a constraint of 'dest'
+// returns false if traversal doesn't connects 'dest' to a different node
+static bool _AddConstraint
+(
+	OpIntersectTraverse *op,
+	const _SimpleTraversal *t
+) {
+	const char *dest = op->dest;
+
+	// self loops aren't intersections
+	if(!RG_STRCMP(t->src, t->dest)) return false;
+
+	if(!RG_STRCMP(t->dest, dest)) {
+		// (x)-[:R]->(dest)
+		IntersectTraverseOp_AddConstraint(op, t->src, t->relation,
+				t->transpose);
+	} else if(!RG_STRCMP(t->src, dest)) {
+		// (dest)-[:R]->(x)
+		IntersectTraverseOp_AddConstraint(op, t->dest, t->relation,
+				!t->transpose);
+	} else {
+		return false;
+	}
+
+	return true;
+}
+
+// convert a conditional traverse into an intersect traverse
+// returns NULL if traversal can't be converted
+static OpIntersectTraverse *_ConvertTraverse
+(
+	OpCondTraverse *traverse
+) {
+	if(traverse->edge_ctx != NULL) return NULL;
+
+	_SimpleTraversal t;
+	if(!_SimpleTraversal_New(traverse->ae, &t)) return NULL;
+
+	OpIntersectTraverse *op = NULL;
+	const char *dest = AlgebraicExpression_Dest(traverse->ae);
+
+	// labels may only filter the resolved node
+	if(t.labeled != NULL && RG_STRCMP(t.labeled, dest)) goto cleanup;
+
+	op = (OpIntersectTraverse *)NewIntersectTraverseOp(traverse->op.plan,
+			traverse->graph, dest);
+	if(!_AddConstraint(op, &t)) {
+		OpBase_Free((OpBase *)op);
+		op = NULL;
+		goto cleanup;
+	}
+
+	uint label_count = array_len(t.labels);
+	for(uint i = 0; i < label_count; i++) {
+		IntersectTraverseOp_AddLabel(op, t.labels[i]);
+	}
+
+cleanup:
+	_SimpleTraversal_Free(&t);
+	return op;
+}
+
+// try to fold expand into operation into the traversal resolving
+// one of its endpoints
+static void _IntersectExpandInto
+(
+	ExecutionPlan *plan,
+	OpExpandInto *expand_into
+) {
+	if(expand_into->edge_ctx != NULL) return;
+
+	// locate the operation resolving one of expand into endpoints
+	// skipping filters and other expand into operations
+	OpBase *op = expand_into->op.children[0];
+	while(op->type == OPType_FILTER || op->type == OPType_EXPAND_INTO) {
+		op = op->children[0];
+	}
+
+	if(op->plan != expand_into->op.plan) return;
+	if(op->type != OPType_CONDITIONAL_TRAVERSE &&
+	   op->type != OPType_INTERSECT_TRAVERSE) {
+		return;
+	}
+
+	_SimpleTraversal t;
+	if(!_SimpleTraversal_New(expand_into->ae, &t)) return;
+
+	// expand into endpoints are already verified for labels
+	// self loops aren't intersections
+	if(array_len(t.labels) > 0 || !RG_STRCMP(t.src, t.dest)) goto cleanup;
+
+	if(op->type == OPType_CONDITIONAL_TRAVERSE) {
+		OpCondTraverse *traverse = (OpCondTraverse *)op;
+		const char *dest = AlgebraicExpression_Dest(traverse->ae);
+		// expand into must be connected to the traversed node
+		if(RG_STRCMP(t.src, dest) && RG_STRCMP(t.dest, dest)) goto cleanup;
+
+		OpIntersectTraverse *intersect = _ConvertTraverse(traverse);
+		if(intersect == NULL) goto cleanup;
+
+		ExecutionPlan_ReplaceOp(plan, op, (OpBase *)intersect);
+		OpBase_Free(op);
+		op = (OpBase *)intersect;
+	}
+
+	if(!_AddConstraint((OpIntersectTraverse *)op, &t)) goto cleanup;
+
+	// expand into is now redundant
+	ExecutionPlan_RemoveOp(plan, (OpBase *)expand_into);
+	OpBase_Free((OpBase *)expand_into);
+
+cleanup:
+	_SimpleTraversal_Free(&t);
+}
+
+void intersectTraversals
+(
+	ExecutionPlan *plan
+) {
+	ASSERT(plan != NULL);
+
+	OPType t = OPType_EXPAND_INTO;
+	OpBase **expand_intos = ExecutionPlan_CollectOpsMatchingType(plan->root,
+			&t, 1);
+
+	uint count = array_len(expand_intos);
+	for(uint i = 0; i < count; i++) {
+		_IntersectExpandInto(plan, (OpExpandInto *)expand_intos[i]);
+	}
+
+	array_free(expand_intos);
+}
+
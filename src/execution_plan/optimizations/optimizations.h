@@ -28,9 +28,15 @@ void reduceCartesianProductStreamCount(ExecutionPlan *plan);
 void applyJoin(ExecutionPlan *plan);
 void reduceFilters(ExecutionPlan *plan);
 void reduceTraversal(ExecutionPlan *plan);
+void intersectTraversals(ExecutionPlan *plan);
+void batchSemiApply(ExecutionPlan *plan);
+void cacheUncorrelatedApply(ExecutionPlan *plan);
 void reduceDistinct(ExecutionPlan *plan);
 void reduceCount(ExecutionPlan *plan);
+void reduceDegreeCount(ExecutionPlan *plan);
 void applyLimit(ExecutionPlan *plan);
 void applySkip(ExecutionPlan *plan);
+void applyProcedureHints(ExecutionPlan *plan);
+void applyIndexTopK(ExecutionPlan *plan);
 void optimizeLabelScan(ExecutionPlan *plan);
 
@@ -31,8 +31,109 @@
 //
 // Scan(B)
 // Traverse A*R
+//
+// once the scanned label is set, in case the following traversal only
+// intersects the scanned node's labels, e.g. MATCH (n:A:B) RETURN n
+//
+// Scan(A)
+// Traverse B
+//
+// the traversal is absorbed by the scan, which checks the remaining labels
+// on batches of scanned IDs, sparing a record per A node and a matrix
+// multiplication per batch of records
+//
+// Scan(A:B)
+
+// switch scanned label, patching the following traversal
+// which now has to apply the previously scanned label
+static void _switchScannedLabel
+(
+	NodeByLabelScan *scan,
+	int label_id,
+	const char *label
+) {
+	OpBase *op = (OpBase*)scan;
+	const char *prev_label = scan->n.label;
+
+	// swap current label with minimum label
+	scan->n.label     =  label;
+	scan->n.label_id  =  label_id;
+
+	// patch following traversal, skip filters
+	OpBase *parent = op->parent;
+	while(OpBase_Type(parent) == OPType_FILTER) parent = parent->parent;
+	ASSERT(OpBase_Type(parent) == OPType_CONDITIONAL_TRAVERSE);
+
+	OpCondTraverse *op_traverse = (OpCondTraverse*)parent;
+	AlgebraicExpression *ae = op_traverse->ae;
+	AlgebraicExpression *operand;
+
+	const char *row_domain = scan->n.alias;
+	const char *column_domain = scan->n.alias;
+
+	bool found = AlgebraicExpression_LocateOperand(ae, &operand, NULL,
+			row_domain, column_domain, NULL, label);
+	ASSERT(found == true);
+
+	AlgebraicExpression *replacement = AlgebraicExpression_NewOperand(NULL,
+			true, AlgebraicExpression_Src(operand),
+			AlgebraicExpression_Dest(operand), NULL, prev_label);
+
+	_AlgebraicExpression_InplaceRepurpose(operand, replacement);
+}
+
+// absorb a traversal which only intersects the scanned node's labels
+static void _absorbLabelTraversal
+(
+	ExecutionPlan *plan,
+	NodeByLabelScan *scan
+) {
+	OpBase *parent = ((OpBase*)scan)->parent;
+	while(parent != NULL && OpBase_Type(parent) == OPType_FILTER) {
+		parent = parent->parent;
+	}
+	if(parent == NULL || OpBase_Type(parent) != OPType_CONDITIONAL_TRAVERSE) {
+		return;
+	}
 
-static void _optimizeLabelScan(NodeByLabelScan *scan) {
+	OpCondTraverse *op_traverse = (OpCondTraverse*)parent;
+	AlgebraicExpression *ae = op_traverse->ae;
+	const char *alias = scan->n.alias;
+
+	// traversal must map the scanned node onto itself without an edge
+	if(AlgebraicExpression_Edge(ae) != NULL) return;
+	if(strcmp(AlgebraicExpression_Src(ae), alias) != 0) return;
+	if(strcmp(AlgebraicExpression_Dest(ae), alias) != 0) return;
+	if(AlgebraicExpression_ContainsOp(ae, AL_EXP_ADD)) return;
+	if(AlgebraicExpression_ContainsOp(ae, AL_EXP_TRANSPOSE)) return;
+
+	// all operands must be label matrices
+	uint operand_count = AlgebraicExpression_OperandCount(ae);
+	for(uint i = 0; i < operand_count; i++) {
+		if(!AlgebraicExpression_DiagonalOperand(ae, i)) return;
+	}
+
+	// migrate labels to the scan
+	while(ae != NULL) {
+		AlgebraicExpression *operand = AlgebraicExpression_RemoveSource(&ae);
+		const char *label = AlgebraicExpression_Label(operand);
+		ASSERT(label != NULL);
+		if(strcmp(label, scan->n.label) != 0) {
+			NodeByLabelScanOp_AddLabel(scan, label);
+		}
+		AlgebraicExpression_Free(operand);
+	}
+
+	op_traverse->ae = NULL;
+	ExecutionPlan_RemoveOp(plan, parent);
+	OpBase_Free(parent);
+}
+
+static void _optimizeLabelScan
+(
+	ExecutionPlan *plan,
+	NodeByLabelScan *scan
+) {
 	ASSERT(scan != NULL);	
 
 	OpBase      *op  =  (OpBase*)scan;
@@ -67,35 +168,12 @@ static void _optimizeLabelScan(NodeByLabelScan *scan) {
 		}
 	}
 
-	// scanned label has the minimum number of entries
-	// no switching required
-	if(min_label_id == scan->n.label_id) return;
-
-	// swap current label with minimum label
-	scan->n.label     =  min_label_str;
-	scan->n.label_id  =  min_label_id;
-
-	// patch following traversal, skip filters
-	OpBase *parent = op->parent;
-	while(OpBase_Type(parent) == OPType_FILTER) parent = parent->parent;
-	ASSERT(OpBase_Type(parent) == OPType_CONDITIONAL_TRAVERSE);
-
-	OpCondTraverse *op_traverse = (OpCondTraverse*)parent;
-	AlgebraicExpression *ae = op_traverse->ae;
-	AlgebraicExpression *operand;
-
-	const char *row_domain = scan->n.alias;
-	const char *column_domain = scan->n.alias;
-
-	bool found = AlgebraicExpression_LocateOperand(ae, &operand, NULL,
-			row_domain, column_domain, NULL, min_label_str);
-	ASSERT(found == true);
-
-	AlgebraicExpression *replacement = AlgebraicExpression_NewOperand(NULL,
-			true, AlgebraicExpression_Src(operand),
-			AlgebraicExpression_Dest(operand), NULL, min_label_str);
+	// switch to the label with the minimum number of entries
+	if(min_label_id != scan->n.label_id) {
+		_switchScannedLabel(scan, min_label_id, min_label_str);
+	}
 
-	_AlgebraicExpression_InplaceRepurpose(operand, replacement);
+	_absorbLabelTraversal(plan, scan);
 }
 
 void optimizeLabelScan(ExecutionPlan *plan) {
@@ -110,7 +188,7 @@ void optimizeLabelScan(ExecutionPlan *plan) {
 	uint op_count = array_len(label_scan_ops);
 	for(uint i = 0; i < op_count; i++) {
 		NodeByLabelScan *label_scan = (NodeByLabelScan*)label_scan_ops[i];
-		_optimizeLabelScan(label_scan);
+		_optimizeLabelScan(plan, label_scan);
 	}
 	array_free(label_scan_ops);
 }
@@ -49,16 +49,37 @@ void optimizePlan(ExecutionPlan *plan) {
 	// into an expand into operation
 	reduceTraversal(plan);
 
+	// resolve nodes closing a cycle by intersecting
+	// the neighbours of all of their bound endpoints
+	intersectTraversals(plan);
+
+	// evaluate single traversal pattern predicates
+	// for batches of records rather than per record
+	batchSemiApply(plan);
+
+	// execute apply branches which don't depend on
+	// the bound records only once
+	cacheUncorrelatedApply(plan);
+
 	// try to reduce distinct if it follows aggregation
 	reduceDistinct(plan);
 
 	// try to reduce execution plan incase it perform node or edge counting
 	reduceCount(plan);
 
+	// try to reduce per node counting into a single matrix reduction
+	reduceDegreeCount(plan);
+
 	// let operations know about specified limit(s)
 	applyLimit(plan);
 
 	// let operations know about specified skip(s)
 	applySkip(plan);
+
+	// let procedures know about the records their consumers require
+	applyProcedureHints(plan);
+
+	// restrict scans feeding a limited sort to the top ranked nodes
+	applyIndexTopK(plan);
 }
 
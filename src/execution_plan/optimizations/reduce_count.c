@@ -67,11 +67,13 @@ static int _identifyNodeCountPattern(OpBase *root, OpResult **opResult, OpAggreg
 		return 0;
 	}
 
-	*opScan = op;
 	if(op->type == OPType_NODE_BY_LABEL_SCAN) {
 		NodeByLabelScan *labelScan = (NodeByLabelScan *)op;
+		// Node count isn't tracked for an intersection of labels.
+		if(labelScan->labels != NULL) return 0;
 		*label = labelScan->n.label;
 	}
+	*opScan = op;
 
 	return 1;
 }
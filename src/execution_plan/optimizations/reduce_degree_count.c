@@ -0,0 +1,369 @@
+/*
+* Copyright 2018-2021 Redis Labs Ltd. and Contributors
+*
+* This file is available under the Redis Labs Source Available License Agreement
+*/
+
+#include "RG.h"
+#include "../ops/ops.h"
+#include "../../util/arr.h"
+#include "../../query_ctx.h"
+#include "../../arithmetic/aggregate_funcs/agg_funcs.h"
+#include "../execution_plan_build/execution_plan_modify.h"
+
+/* The reduceDegreeCount optimization looks for aggregations counting
+ * the connections of every source node:
+ * MATCH (a:User)-[:FOLLOWS]->(b) RETURN a, count(b)
+ * planned as "Scan -> Conditional Traverse -> Aggregate"
+ * in which case the Scan, Traverse and Aggregate operations are replaced
+ * by a single Degree Count operation computing all counts with a single
+ * row reduction of the relationship matrix
+ * sums of a constant or of a destination node attribute are reduced as well:
+ * MATCH (a:User)-[:FOLLOWS]->(b) RETURN a, sum(b.score)
+ *
+ * when the counted traversal doesn't start at a scan, e.g.
+ * MATCH (a:User)-[:FOLLOWS]->(b)-[:FOLLOWS]->(c) RETURN a, count(c)
+ * the last traversal is factorized instead, emitting a single record per
+ * source node holding the number of reached destinations, which the
+ * aggregation counts at once, avoiding a record per destination */
+
+// checks if 'exp' is a none distinct count over a single argument
+// sets 'counted' to the counted alias, NULL if a constant is counted
+static bool _identifyCount
+(
+	const AR_ExpNode *exp,
+	const char **counted
+) {
+	*counted = NULL;
+
+	if(exp->type != AR_EXP_OP                 ||
+	   exp->op.f->aggregate != true           ||
+	   strcasecmp(exp->op.func_name, "count") ||
+	   Aggregate_PerformsDistinct(exp->op.f->privdata)) return false;
+
+	if(exp->op.child_count != 1) return false;
+
+	const AR_ExpNode *arg = exp->op.children[0];
+	if(arg->type != AR_EXP_OPERAND) return false;
+
+	// count(*), count(1)
+	if(arg->operand.type == AR_EXP_CONSTANT) {
+		return !SIValue_IsNull(arg->operand.constant);
+	}
+
+	if(arg->operand.type != AR_EXP_VARIADIC) return false;
+
+	*counted = arg->operand.variadic.entity_alias;
+	return true;
+}
+
+// checks if 'exp' is a none distinct sum over a numeric constant
+// or over an attribute of 'dest', e.g. sum(1), sum(b.score)
+// sets 'attr' to the summed attribute, NULL if a constant is summed
+static bool _identifySum
+(
+	const AR_ExpNode *exp,
+	const char *dest,
+	const char **attr,
+	double *constant
+) {
+	*attr = NULL;
+
+	if(exp->type != AR_EXP_OP                 ||
+	   exp->op.f->aggregate != true           ||
+	   strcasecmp(exp->op.func_name, "sum")   ||
+	   Aggregate_PerformsDistinct(exp->op.f->privdata)) return false;
+
+	if(exp->op.child_count != 1) return false;
+
+	const AR_ExpNode *arg = exp->op.children[0];
+
+	// sum(1)
+	if(AR_EXP_IsConstant(arg)) {
+		SIValue v = arg->operand.constant;
+		if(!(SI_TYPE(v) & SI_NUMERIC)) return false;
+		*constant = SI_GET_NUMERIC(v);
+		return true;
+	}
+
+	// sum(b.score)
+	char *name;
+	if(!AR_EXP_IsAttribute(arg, &name)) return false;
+
+	const AR_ExpNode *entity = arg->op.children[0];
+	if(entity->type != AR_EXP_OPERAND                ||
+	   entity->operand.type != AR_EXP_VARIADIC       ||
+	   strcmp(entity->operand.variadic.entity_alias, dest) != 0) return false;
+
+	*attr = name;
+	return true;
+}
+
+// checks if 'exp' is a none diagonal operand
+static inline bool _relationOperand
+(
+	const AlgebraicExpression *exp
+) {
+	return (exp->type == AL_OPERAND && !exp->operand.diagonal);
+}
+
+// strips a transpose operation from 'exp'
+// sets 'transposed' to true if 'exp' is a transpose operation
+static inline const AlgebraicExpression *_unwrapTranspose
+(
+	const AlgebraicExpression *exp,
+	bool *transposed
+) {
+	*transposed = (exp->type == AL_OPERATION &&
+				   exp->operation.op == AL_EXP_TRANSPOSE);
+	return (*transposed) ? exp->operation.children[0] : exp;
+}
+
+// breaks traversal expression into source label operands and
+// relationship operands, supported forms:
+// [L0 * L1 * ...] * R
+// [L0 * L1 * ...] * Transpose(R)
+// [L0 * L1 * ...] * (R0 + R1 + ...)
+// [L0 * L1 * ...] * Transpose(R0 + R1 + ...)
+// [L0 * L1 * ...] * (Transpose(R0) + Transpose(R1) + ...)
+static bool _analyzeExpression
+(
+	const AlgebraicExpression *ae,  // traversal expression
+	const char ***labels,           // [output] source labels
+	const char ***relations,        // [output] relationship types
+	bool *transpose                 // [output] expression is transposed
+) {
+	const AlgebraicExpression *rel = ae;
+
+	// collect source label operands
+	if(ae->type == AL_OPERATION && ae->operation.op == AL_EXP_MUL) {
+		uint child_count = AlgebraicExpression_ChildCount(ae);
+		for(uint i = 0; i < child_count - 1; i++) {
+			const AlgebraicExpression *child = ae->operation.children[i];
+			if(child->type != AL_OPERAND          ||
+			   !child->operand.diagonal           ||
+			   child->operand.matrix == IDENTITY_MATRIX) return false;
+			array_append(*labels, child->operand.label);
+		}
+		rel = ae->operation.children[child_count - 1];
+	}
+
+	rel = _unwrapTranspose(rel, transpose);
+
+	if(_relationOperand(rel)) {
+		// a typeless traversal is represented by a NULL relations array
+		if(rel->operand.label != NULL) {
+			*relations = array_new(const char *, 1);
+			array_append(*relations, rel->operand.label);
+		}
+		return true;
+	}
+
+	if(rel->type != AL_OPERATION || rel->operation.op != AL_EXP_ADD) {
+		return false;
+	}
+
+	// multiple relationship types -[:R0|R1]->
+	// transpose might have been pushed down to the individual operands
+	bool outer_transpose = *transpose;
+	uint child_count = AlgebraicExpression_ChildCount(rel);
+	*relations = array_new(const char *, child_count);
+	for(uint i = 0; i < child_count; i++) {
+		bool transposed;
+		const AlgebraicExpression *child =
+			_unwrapTranspose(rel->operation.children[i], &transposed);
+
+		if(!_relationOperand(child) || child->operand.label == NULL) {
+			return false;
+		}
+
+		// all operands must agree on direction
+		if(outer_transpose && transposed) return false;
+		if(i == 0) *transpose |= transposed;
+		else if(!outer_transpose && transposed != *transpose) return false;
+
+		// make sure each relationship type is counted once
+		for(uint j = 0; j < i; j++) {
+			if(strcmp((*relations)[j], child->operand.label) == 0) return false;
+		}
+		array_append(*relations, child->operand.label);
+	}
+
+	return true;
+}
+
+static bool _reduceDegreeCount
+(
+	ExecutionPlan *plan,
+	OpAggregate *aggregate
+) {
+	OpBase *op = (OpBase *)aggregate;
+
+	// expecting a single key and a single aggregation: RETURN a, count(b)
+	if(aggregate->key_count != 1 || aggregate->aggregate_count != 1) {
+		return false;
+	}
+
+	// Aggregate -> Conditional Traverse -> Scan
+	if(op->childCount != 1) return false;
+	OpBase *traverse = op->children[0];
+	if(traverse->type != OPType_CONDITIONAL_TRAVERSE ||
+	   traverse->childCount != 1) return false;
+
+	OpBase *scan = traverse->children[0];
+	if((scan->type != OPType_ALL_NODE_SCAN &&
+		scan->type != OPType_NODE_BY_LABEL_SCAN) ||
+	   scan->childCount != 0) return false;
+
+	// all operations must be part of the same segment
+	if(traverse->plan != op->plan || scan->plan != op->plan) return false;
+
+	OpCondTraverse *cond_traverse = (OpCondTraverse *)traverse;
+	AlgebraicExpression *ae = cond_traverse->ae;
+	const char *src = AlgebraicExpression_Src(ae);
+	const char *dest = AlgebraicExpression_Dest(ae);
+	const char *edge = AlgebraicExpression_Edge(ae);
+
+	// scanned node must be the traversal source
+	if(strcmp(scan->modifies[0], src) != 0) return false;
+
+	// group key must be the source node itself
+	AR_ExpNode *key = aggregate->key_exps[0];
+	if(key->type != AR_EXP_OPERAND                  ||
+	   key->operand.type != AR_EXP_VARIADIC         ||
+	   strcmp(key->operand.variadic.entity_alias, src) != 0) return false;
+
+	// aggregation must either count destination nodes or edges
+	// or sum a constant or a destination node attribute
+	bool        sum       =  false;
+	double      constant  =  1;
+	const char  *counted  =  NULL;
+	const char  *summed   =  NULL;
+	AR_ExpNode  *agg      =  aggregate->aggregate_exps[0];
+	if(_identifyCount(agg, &counted)) {
+		if(counted != NULL &&
+		   strcmp(counted, dest) != 0 &&
+		   (edge == NULL || strcmp(counted, edge) != 0)) return false;
+	} else if(_identifySum(agg, dest, &summed, &constant)) {
+		sum = true;
+	} else {
+		return false;
+	}
+
+	// the traversal produces a record per edge when the edge is populated
+	// otherwise a record per connected node
+	bool count_edges = (cond_traverse->edge_ctx != NULL);
+
+	bool         transpose;
+	const char   **relations  =  NULL;
+	const char   **labels     =  array_new(const char *, 1);
+
+	if(scan->type == OPType_NODE_BY_LABEL_SCAN) {
+		NodeByLabelScan *label_scan = (NodeByLabelScan *)scan;
+		array_append(labels, label_scan->n.label);
+		// additional labels the scanned node must possess
+		uint label_count = array_len(label_scan->labels);
+		for(uint i = 0; i < label_count; i++) {
+			array_append(labels, label_scan->labels[i]);
+		}
+	}
+
+	bool supported = _analyzeExpression(ae, &labels, &relations, &transpose);
+
+	// connected nodes can't be summed across multiple relationship types
+	// as the same node might be reachable via different types
+	if(supported && !count_edges && relations && array_len(relations) > 1) {
+		supported = false;
+	}
+
+	if(!supported) {
+		array_free(labels);
+		if(relations) array_free(relations);
+		return false;
+	}
+
+	// take ownership over the traversal expression
+	cond_traverse->ae = NULL;
+
+	OpBase *degree_count = NewDegreeCountOp(op->plan, QueryCtx_GetGraph(), ae,
+			labels, relations, transpose, count_edges, key->resolved_name,
+			agg->resolved_name);
+
+	if(sum) {
+		OpDegreeCount *degree_sum = (OpDegreeCount *)degree_count;
+		if(summed) DegreeCountOp_SumAttribute(degree_sum, summed);
+		else DegreeCountOp_SumConstant(degree_sum, constant);
+	}
+
+	// new execution plan: "Degree Count -> ..."
+	ExecutionPlan_RemoveOp(plan, scan);
+	OpBase_Free(scan);
+
+	ExecutionPlan_RemoveOp(plan, traverse);
+	OpBase_Free(traverse);
+
+	ExecutionPlan_ReplaceOp(plan, op, degree_count);
+	OpBase_Free(op);
+
+	return true;
+}
+
+// factorize a traversal feeding an aggregation which only counts its output
+// e.g. MATCH (a)-[]->(b)-[]->(c) RETURN a, count(c)
+static bool _factorizeCount
+(
+	OpAggregate *aggregate
+) {
+	OpBase *op = (OpBase *)aggregate;
+
+	// Aggregate -> Conditional Traverse
+	if(op->childCount != 1) return false;
+	OpBase *traverse = op->children[0];
+	if(traverse->type != OPType_CONDITIONAL_TRAVERSE) return false;
+	if(traverse->plan != op->plan) return false;
+
+	// the traversal produces a record per edge when the edge is populated
+	OpCondTraverse *cond_traverse = (OpCondTraverse *)traverse;
+	if(cond_traverse->edge_ctx != NULL || cond_traverse->factorized) {
+		return false;
+	}
+
+	const char *dest = AlgebraicExpression_Dest(cond_traverse->ae);
+
+	// every aggregation must count either the destination node or a constant
+	if(aggregate->aggregate_count == 0) return false;
+	for(uint i = 0; i < aggregate->aggregate_count; i++) {
+		const char *counted;
+		if(!_identifyCount(aggregate->aggregate_exps[i], &counted)) return false;
+		if(counted != NULL && strcmp(counted, dest) != 0) return false;
+	}
+
+	// group keys must not refer to the destination node
+	bool refers_dest = false;
+	rax *entities = raxNew();
+	for(uint i = 0; i < aggregate->key_count; i++) {
+		AR_EXP_CollectEntities(aggregate->key_exps[i], entities);
+	}
+	refers_dest = (raxFind(entities, (unsigned char *)dest, strlen(dest))
+			!= raxNotFound);
+	raxFree(entities);
+	if(refers_dest) return false;
+
+	CondTraverseOp_Factorize(cond_traverse);
+	AggregateOp_SetMultiplicity(aggregate, dest);
+
+	return true;
+}
+
+void reduceDegreeCount(ExecutionPlan *plan) {
+	OpBase **aggregations = ExecutionPlan_CollectOps(plan->root,
+			OPType_AGGREGATE);
+
+	uint aggregation_count = array_len(aggregations);
+	for(uint i = 0; i < aggregation_count; i++) {
+		OpAggregate *aggregate = (OpAggregate *)aggregations[i];
+		if(!_reduceDegreeCount(plan, aggregate)) _factorizeCount(aggregate);
+	}
+
+	array_free(aggregations);
+}
@@ -125,7 +125,7 @@ static RSQNode *_FilterTreeToInQueryNode
 		switch(SI_TYPE(v)) {
 		case T_STRING:
 			parent = RediSearch_CreateTagNode(idx, field);
-			node = RediSearch_CreateTokenNode(idx, field, v.stringval);
+			node = RediSearch_CreateTokenNode(idx, field, SI_STRINGVAL(v));
 			RediSearch_QueryNodeAddChild(parent, node);
 			node = parent;
 			break;
@@ -198,7 +198,7 @@ static bool _predicateTreeToRange
 			sr = StringRange_New();
 			raxTryInsert(string_ranges, (unsigned char *)prop, prop_len, sr, NULL);
 		}
-		StringRange_TightenRange(sr, op, c.stringval);
+		StringRange_TightenRange(sr, op, SI_STRINGVAL(c));
 	}
 
 	return true;
@@ -445,19 +445,19 @@ static bool _FilterTreePredicateToQueryNode
 	if(t == T_STRING) {
 		switch(tree->pred.op) {
 			case OP_LT:    // <
-				node = RediSearch_CreateLexRangeNode(idx, field, RSLEXRANGE_NEG_INF, v.stringval, 0, 0);
+				node = RediSearch_CreateLexRangeNode(idx, field, RSLEXRANGE_NEG_INF, SI_STRINGVAL(v), 0, 0);
 				break;
 			case OP_LE:    // <=
-				node = RediSearch_CreateLexRangeNode(idx, field, RSLEXRANGE_NEG_INF, v.stringval, 0, 1);
+				node = RediSearch_CreateLexRangeNode(idx, field, RSLEXRANGE_NEG_INF, SI_STRINGVAL(v), 0, 1);
 				break;
 			case OP_GT:    // >
-				node = RediSearch_CreateLexRangeNode(idx, field, v.stringval, RSLECRANGE_INF, 0, 0);
+				node = RediSearch_CreateLexRangeNode(idx, field, SI_STRINGVAL(v), RSLECRANGE_INF, 0, 0);
 				break;
 			case OP_GE:    // >=
-				node = RediSearch_CreateLexRangeNode(idx, field, v.stringval, RSLECRANGE_INF, 1, 0);
+				node = RediSearch_CreateLexRangeNode(idx, field, SI_STRINGVAL(v), RSLECRANGE_INF, 1, 0);
 				break;
 			case OP_EQUAL:  // ==
-				node = RediSearch_CreateTokenNode(idx, field, v.stringval);
+				node = RediSearch_CreateTokenNode(idx, field, SI_STRINGVAL(v));
 				break;
 			default:
 				ASSERT(false && "unexpected operation");
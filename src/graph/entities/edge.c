@@ -27,43 +27,13 @@ int Edge_GetRelationID(const Edge *edge) {
 	return edge->relationID;
 }
 
-Node *Edge_GetSrcNode(Edge *e) {
-	ASSERT(e);
-	return e->src;
-}
-
-Node *Edge_GetDestNode(Edge *e) {
-	ASSERT(e);
-	return e->dest;
-}
-
-RG_Matrix Edge_GetMatrix(Edge *e) {
-	ASSERT(e);
-
-	// retrieve matrix from graph if edge matrix isn't set
-	if(!e->mat) {
-		Graph *g = QueryCtx_GetGraph();
-
-		// get relation matrix
-		if(e->relationID == GRAPH_UNKNOWN_RELATION) {
-			e->mat = Graph_GetZeroMatrix(g);
-		} else {
-			e->mat = Graph_GetRelationMatrix(g, e->relationID, false);
-		}
-	}
-
-	return e->mat;
-}
-
-void Edge_SetSrcNode(Edge *e, Node *src) {
+void Edge_SetSrcNode(Edge *e, const Node *src) {
 	ASSERT(e && src);
-	e->src = src;
 	e->srcNodeID = ENTITY_GET_ID(src);
 }
 
-void Edge_SetDestNode(Edge *e, Node *dest) {
+void Edge_SetDestNode(Edge *e, const Node *dest) {
 	ASSERT(e && dest);
-	e->dest = dest;
 	e->destNodeID = ENTITY_GET_ID(dest);
 }
 
@@ -19,27 +19,19 @@
 (Edge) {                              \
 	.entity = NULL,                   \
 	.id = INVALID_ENTITY_ID,          \
-	.relationship = NULL,             \
-	.relationID = GRAPH_NO_RELATION,  \
-	.src = NULL,                      \
-	.dest = NULL,                     \
 	.srcNodeID = INVALID_ENTITY_ID,   \
 	.destNodeID = INVALID_ENTITY_ID,  \
-	.mat = NULL                       \
+	.relationID = GRAPH_NO_RELATION   \
 }
 
 // instantiate a new edge with relation data
-#define GE_NEW_LABELED_EDGE(r_str, r_id)    \
+#define GE_NEW_LABELED_EDGE(r_id)           \
 (Edge) {                                    \
 	.entity = NULL,                         \
 	.id = INVALID_ENTITY_ID,                \
-	.relationship = (r_str),                \
-	.relationID = (r_id),                   \
-	.src = NULL,                            \
-	.dest = NULL,                           \
 	.srcNodeID = INVALID_ENTITY_ID,         \
 	.destNodeID = INVALID_ENTITY_ID,        \
-	.mat = NULL                             \
+	.relationID = (r_id)                    \
 }
 
 // resolves to the label ID of the given Node.
@@ -52,18 +44,15 @@ __extension__({
 	(e)->relationID;                                                                       \
 })
 
-/* TODO: note it is possible to get into an inconsistency
- * if we set src and srcNodeID to different nodes. */
+// edges are kept compact as they're embedded within every record
+// relationship type name is resolved from the graph's schemas via relationID
+// and the entity's attributes via its DataBlock item
 struct Edge {
 	Entity *entity;             // MUST be the first member
 	EntityID id;                // Unique id, MUST be the second member
-	const char *relationship;   // Label attached to edge
-	int relationID;             // Relation ID
-	Node *src;                  // Pointer to source node
-	Node *dest;                 // Pointer to destination node
 	NodeID srcNodeID;           // Source node ID
 	NodeID destNodeID;          // Destination node ID
-	RG_Matrix mat;              // Adjacency matrix, associated with edge
+	int relationID;             // Relation ID
 };
 
 typedef struct Edge Edge;
@@ -80,20 +69,11 @@ NodeID Edge_GetDestNodeID(const Edge *edge); // graph.c, serializer, all_paths,
 // Retrieve edge relation ID.
 int Edge_GetRelationID(const Edge *edge); // graph.c, replies
 
-// Retrieve edge source node.
-Node *Edge_GetSrcNode(Edge *e); // opcreate
-
-// Retrieve edge destination node. // opcreate
-Node *Edge_GetDestNode(Edge *e);
-
-// Retrieves edge matrix.
-RG_Matrix Edge_GetMatrix(Edge *e); // AE
-
-// Sets edge source node.
-void Edge_SetSrcNode(Edge *e, Node *src); // QG
+// Sets edge source node ID.
+void Edge_SetSrcNode(Edge *e, const Node *src);
 
-// Sets edge destination node.
-void Edge_SetDestNode(Edge *e, Node *dest); // QG
+// Sets edge destination node ID.
+void Edge_SetDestNode(Edge *e, const Node *dest);
 
 // Sets edge relation type.
 void Edge_SetRelationID(Edge *e, int relationID); // QG, graph.c
@@ -17,6 +17,15 @@ SIValue *PROPERTY_NOTFOUND = &(SIValue) {
 	.longval = 0, .type = T_NULL
 };
 
+/* Creates the copy of value stored as an entity property,
+ * strings are shared through the graph's string pool. */
+static inline SIValue _GraphEntity_PropertyValue(SIValue value, StringPool *pool) {
+	if(pool != NULL && SI_TYPE(value) == T_STRING) {
+		return SI_InternStringVal(pool, SI_STRINGVAL(value));
+	}
+	return SI_CloneValue(value);
+}
+
 /* Removes entity's property. */
 static bool _GraphEntity_RemoveProperty(const GraphEntity *e, Attribute_ID attr_id) {
 	// Quick return if attribute is missing.
@@ -66,7 +75,8 @@ int GraphEntity_ClearProperties(GraphEntity *e) {
 }
 
 /* Add a new property to entity */
-bool GraphEntity_AddProperty(GraphEntity *e, Attribute_ID attr_id, SIValue value) {
+bool GraphEntity_AddProperty(GraphEntity *e, Attribute_ID attr_id, SIValue value,
+							 StringPool *pool) {
 	ASSERT(e);
 	if(!(SI_TYPE(value) & SI_VALID_PROPERTY_VALUE)) return false;
 
@@ -79,7 +89,7 @@ bool GraphEntity_AddProperty(GraphEntity *e, Attribute_ID attr_id, SIValue value
 
 	int prop_idx = e->entity->prop_count;
 	e->entity->properties[prop_idx].id = attr_id;
-	e->entity->properties[prop_idx].value = SI_CloneValue(value);
+	e->entity->properties[prop_idx].value = _GraphEntity_PropertyValue(value, pool);
 	e->entity->prop_count++;
 
 	return true;
@@ -107,7 +117,8 @@ SIValue *GraphEntity_GetProperty(const GraphEntity *e, Attribute_ID attr_id) {
 }
 
 // Updates existing property value.
-bool GraphEntity_SetProperty(const GraphEntity *e, Attribute_ID attr_id, SIValue value) {
+bool GraphEntity_SetProperty(const GraphEntity *e, Attribute_ID attr_id, SIValue value,
+							 StringPool *pool) {
 	ASSERT(e);
 
 	// Setting an attribute value to NULL removes that attribute.
@@ -121,7 +132,7 @@ bool GraphEntity_SetProperty(const GraphEntity *e, Attribute_ID attr_id, SIValue
 
 	// value != current, update entity
 	SIValue_Free(*current);
-	*current = SI_CloneValue(value);
+	*current = _GraphEntity_PropertyValue(value, pool);
 	return true;
 }
 
@@ -222,13 +233,19 @@ void GraphEntity_ToString
 
 			case GETYPE_EDGE: {
 				Edge *edge = (Edge *)e;
-				if(edge->relationship) {
-					size_t relationshipLen = strlen(edge->relationship);
+				int relation_id = Edge_GetRelationID(edge);
+				if(relation_id >= 0) {
+					// resolve relationship type name
+					GraphContext *gc = QueryCtx_GetGraphCtx();
+					Schema *s = GraphContext_GetSchemaByID(gc, relation_id, SCHEMA_EDGE);
+					const char *relationship = Schema_GetName(s);
+
+					size_t relationshipLen = strlen(relationship);
 					if(*bufferLen - *bytesWritten < relationshipLen) {
 						*bufferLen += relationshipLen;
 						*buffer = rm_realloc(*buffer, sizeof(char) * *bufferLen);
 					}
-					*bytesWritten += snprintf(*buffer + *bytesWritten, *bufferLen, ":%s", edge->relationship);
+					*bytesWritten += snprintf(*buffer + *bytesWritten, *bufferLen, ":%s", relationship);
 				}
 				break;
 			}
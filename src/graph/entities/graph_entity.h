@@ -67,16 +67,20 @@ typedef struct {
 int GraphEntity_ClearProperties(GraphEntity *e);
 
 /* Adds property to entity
+ * string values are interned in 'pool' when it is provided
  * returns - reference to newly added property. */
-bool GraphEntity_AddProperty(GraphEntity *e, Attribute_ID attr_id, SIValue value);
+bool GraphEntity_AddProperty(GraphEntity *e, Attribute_ID attr_id, SIValue value,
+							 StringPool *pool);
 
 /* Retrieves entity's property
  * NOTE: If the key does not exist, we return the special
  * constant value PROPERTY_NOTFOUND. */
 SIValue *GraphEntity_GetProperty(const GraphEntity *e, Attribute_ID attr_id);
 
-/* Updates existing attribute value, return true if property been updated. */
-bool GraphEntity_SetProperty(const GraphEntity *e, Attribute_ID attr_id, SIValue value);
+/* Updates existing attribute value, return true if property been updated.
+ * string values are interned in 'pool' when it is provided */
+bool GraphEntity_SetProperty(const GraphEntity *e, Attribute_ID attr_id, SIValue value,
+							 StringPool *pool);
 
 /* Prints the graph entity into a buffer, returns what is the string length, buffer can be re-allocated at need. */
 void GraphEntity_ToString(const GraphEntity *e, char **buffer, size_t *bufferLen,
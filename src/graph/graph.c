@@ -66,6 +66,7 @@ static inline size_t _Graph_EdgeCap(const Graph *g) {
 static void _CollectEdgesFromEntry
 (
 	const Graph *g,
+	RG_Matrix R,
 	NodeID src,
 	NodeID dest,
 	int r,
@@ -85,9 +86,10 @@ static void _CollectEdgesFromEntry
 		array_append(*edges, e);
 	} else {
 		// multiple edges connecting src to dest,
-		// entry is a pointer to an array of edge IDs
-		EdgeID *edgeIds = (EdgeID *)(CLEAR_MSB(edgeId));
-		uint edgeCount = array_len(edgeIds);
+		// entry is the ID of a list of edge IDs
+		uint32_t edgeCount;
+		const EdgeID *edgeIds = MultiEdgeStore_GetEdges(
+				RG_MATRIX_MULTI_EDGE_STORE(R), CLEAR_MSB(edgeId), &edgeCount);
 
 		for(uint i = 0; i < edgeCount; i++) {
 			edgeId = edgeIds[i];
@@ -122,7 +124,7 @@ void _Graph_GetEdgesConnectingNodes
 	// no entry at [dest, src], src is not connected to dest with relation R
 	if(res == GrB_NO_VALUE) return;
 
-	_CollectEdgesFromEntry(g, src, dest, r, id, edges);
+	_CollectEdgesFromEntry(g, M, src, dest, r, id, edges);
 }
 
 static inline Entity *_Graph_GetEntity(const DataBlock *entities, EntityID id) {
@@ -133,6 +135,25 @@ static inline Entity *_Graph_GetEntity(const DataBlock *entities, EntityID id) {
 // Matrix synchronization and resizing functions
 //------------------------------------------------------------------------------
 
+// returns true if 'm' accumulated so many pending changes that they
+// should be merged inline rather than wait for a background flush
+static bool _Graph_FlushOverdue
+(
+	const RG_Matrix m
+) {
+	uint64_t delta_max_pending_changes;
+	Config_Option_get(Config_DELTA_MAX_PENDING_CHANGES,
+			&delta_max_pending_changes);
+
+	GrB_Index dp_nvals;
+	GrB_Index dm_nvals;
+	GrB_Matrix_nvals(&dp_nvals, RG_MATRIX_DELTA_PLUS(m));
+	GrB_Matrix_nvals(&dm_nvals, RG_MATRIX_DELTA_MINUS(m));
+
+	return (dp_nvals + dm_nvals >=
+			delta_max_pending_changes * DELTA_INLINE_FLUSH_FACTOR);
+}
+
 // resize given matrix, such that its number of row and columns
 // matches the number of nodes in the graph. Also, synchronize
 // matrix to execute any pending operations
@@ -175,10 +196,16 @@ void _MatrixSynchronize
 		ASSERT(info == GrB_SUCCESS);
 	}
 
-	// flush pending changes if dirty
+	// materialize pending changes if dirty
+	// merging pending changes into the main matrix is left to a background
+	// flush (see Graph_FlushPending), unless flushing falls far behind
 	if(RG_Matrix_isDirty(m)) {
-		info = RG_Matrix_wait(m, false);
+		info = RG_Matrix_materialize(m);
 		ASSERT(info == GrB_SUCCESS);
+		if(_Graph_FlushOverdue(m)) {
+			info = RG_Matrix_wait(m, true);
+			ASSERT(info == GrB_SUCCESS);
+		}
 	}
 
 cleanup:
@@ -287,6 +314,140 @@ void Graph_ApplyAllPending
 	}
 }
 
+// returns the i-th matrix considered for flushing
+// NULL if 'i' is out of range
+static RG_Matrix _Graph_FlushTarget
+(
+	const Graph *g,
+	uint i
+) {
+	if(i == 0) return g->adjacency_matrix;
+	if(i == 1) return g->node_labels;
+	i -= 2;
+
+	uint label_count = array_len(g->labels);
+	if(i < label_count) return g->labels[i];
+	i -= label_count;
+
+	uint relation_count = array_len(g->relations);
+	if(i < relation_count) return g->relations[i];
+
+	return NULL;
+}
+
+bool Graph_RequiresFlush
+(
+	const Graph *g
+) {
+	ASSERT(g != NULL);
+
+	RG_Matrix M;
+	for(uint i = 0; (M = _Graph_FlushTarget(g, i)) != NULL; i++) {
+		if(RG_Matrix_requiresFlush(M)) return true;
+	}
+
+	return false;
+}
+
+// merge pending changes of a single matrix into its main matrix
+// returns false if the graph is no longer flushable
+static bool _Graph_FlushMatrix
+(
+	Graph *g,
+	uint i,
+	FlushSwapCheck check,  // [optional] swap check
+	void *arg,             // check's argument
+	bool *done             // [output] set to true once all matrices were visited
+) {
+	GrB_Info    info;
+	uint64_t    version;
+	RG_Matrix   M   =  NULL;
+	GrB_Matrix  A   =  NULL;
+	GrB_Matrix  AT  =  NULL;
+
+	UNUSED(info);
+
+	//--------------------------------------------------------------------------
+	// compute M + DP - DM under the read lock
+	//--------------------------------------------------------------------------
+
+	// readers proceed while the merged matrix is being built
+	Graph_AcquireReadLock(g);
+
+	// graph is being bulk loaded or deleted
+	if(g->SynchronizeMatrix != _MatrixSynchronize) {
+		Graph_ReleaseLock(g);
+		return false;
+	}
+
+	M = _Graph_FlushTarget(g, i);
+	if(M == NULL) {
+		*done = true;
+		Graph_ReleaseLock(g);
+		return true;
+	}
+
+	// resize and materialize pending changes
+	_MatrixSynchronize(g, M);
+
+	if(!RG_Matrix_requiresFlush(M)) {
+		Graph_ReleaseLock(g);
+		return true;
+	}
+
+	version = RG_Matrix_version(M);
+	info = RG_Matrix_export(&A, M);
+	ASSERT(info == GrB_SUCCESS);
+	if(RG_MATRIX_MAINTAIN_TRANSPOSE(M)) {
+		info = RG_Matrix_export(&AT, RG_Matrix_getTranspose(M));
+		ASSERT(info == GrB_SUCCESS);
+	}
+
+	Graph_ReleaseLock(g);
+
+	//--------------------------------------------------------------------------
+	// swap in merged matrix under the write lock
+	//--------------------------------------------------------------------------
+
+	Graph_AcquireWriteLock(g);
+
+	// discard merged matrix if M was modified in the meantime
+	bool swap = (RG_Matrix_version(M) == version) &&
+		(check == NULL || check(arg));
+
+	if(swap) {
+		info = RG_Matrix_replace(M, &A);
+		ASSERT(info == GrB_SUCCESS);
+		if(AT != NULL) {
+			info = RG_Matrix_replace(RG_Matrix_getTranspose(M), &AT);
+			ASSERT(info == GrB_SUCCESS);
+		}
+	} else {
+		GrB_Matrix_free(&A);
+		if(AT != NULL) GrB_Matrix_free(&AT);
+	}
+
+	Graph_ReleaseLock(g);
+
+	return true;
+}
+
+void Graph_FlushPending
+(
+	Graph *g,
+	FlushSwapCheck check,
+	void *arg
+) {
+	ASSERT(g != NULL);
+
+	// matrices are flushed one at a time, limiting both the amount of
+	// memory held by merged matrices and the duration of each lock
+	bool done = false;
+	for(uint i = 0; !done; i++) {
+		if(!_Graph_FlushMatrix(g, i, check, arg, &done)) break;
+	}
+}
+
 bool Graph_Pending
 (
 	const Graph *g
@@ -367,6 +528,9 @@ Graph *Graph_New
 	// init graph statistics
 	GraphStatistics_init(&g->stats);
 
+	// pool of string property values shared across entities
+	g->string_pool = StringPool_New();
+
 	// initialize a read-write lock scoped to the individual graph
 	int res;
 	UNUSED(res);
@@ -501,9 +665,11 @@ int Graph_GetEdgeRelation
 		} else {
 			// multiple edges exists between src and dest
 			// see if given edge is one of them
-			EdgeID *edges = (EdgeID *)(CLEAR_MSB(edgeId));
-			int edge_count = array_len(edges);
-			for(int j = 0; j < edge_count; j++) {
+			uint32_t edge_count;
+			const EdgeID *edges = MultiEdgeStore_GetEdges(
+					RG_MATRIX_MULTI_EDGE_STORE(M), CLEAR_MSB(edgeId),
+					&edge_count);
+			for(uint32_t j = 0; j < edge_count; j++) {
 				if(edges[j] == id) {
 					Edge_SetRelationID(e, i);
 					rel = i;
@@ -586,6 +752,46 @@ static void _Graph_LabelNode
 	}
 }
 
+void Graph_LabelNodes
+(
+	Graph *g,
+	const NodeID *ids,
+	uint id_count,
+	int *labels,
+	uint label_count
+) {
+	ASSERT(g != NULL);
+	ASSERT(id_count == 0 || ids != NULL);
+	ASSERT(label_count == 0 || labels != NULL);
+
+	if(id_count == 0 || label_count == 0) return;
+
+	GrB_Info info;
+	UNUSED(info);
+
+	// node-label matrix columns, one per labeled node
+	GrB_Index *cols = rm_malloc(sizeof(GrB_Index) * id_count);
+	RG_Matrix nl = Graph_GetNodeLabelMatrix(g);
+
+	for(uint i = 0; i < label_count; i++) {
+		int l = labels[i];
+		// set matrix at positions [id, id]
+		RG_Matrix m = Graph_GetLabelMatrix(g, l);
+		info = RG_Matrix_setElements_BOOL(m, ids, ids, id_count);
+		ASSERT(info == GrB_SUCCESS);
+
+		// map this label in each node's set of labels
+		for(uint j = 0; j < id_count; j++) cols[j] = l;
+		info = RG_Matrix_setElements_BOOL(nl, ids, cols, id_count);
+		ASSERT(info == GrB_SUCCESS);
+
+		// nodes with 'label' have just been created, update statistics
+		GraphStatistics_IncNodeCount(&g->stats, l, id_count);
+	}
+
+	rm_free(cols);
+}
+
 void Graph_CreateNode
 (
 	Graph *g,
@@ -652,6 +858,21 @@ void Graph_CreateEdge
 	ASSERT(Graph_GetNode(g, dest, &node) == 1);
 #endif
 
+	Graph_ReserveEdge(g, src, dest, r, e);
+	Graph_FormConnection(g, src, dest, ENTITY_GET_ID(e), r);
+}
+
+void Graph_ReserveEdge
+(
+	Graph *g,
+	NodeID src,
+	NodeID dest,
+	int r,
+	Edge *e
+) {
+	ASSERT(g != NULL);
+	ASSERT(e != NULL);
+
 	EdgeID id;
 	Entity *en = DataBlock_AllocateItem(g->edges, &id);
 
@@ -662,8 +883,47 @@ void Graph_CreateEdge
 	e->relationID   =  r;
 	en->prop_count  =  0;
 	en->properties  =  NULL;
+}
+
+void Graph_CreateEdges
+(
+	Graph *g,
+	int r,
+	const NodeID *srcs,
+	const NodeID *dests,
+	Edge **edges,
+	uint edge_count
+) {
+	ASSERT(g != NULL);
+	ASSERT(r < Graph_RelationTypeCount(g));
+	ASSERT(edge_count == 0 || (srcs != NULL && dests != NULL && edges != NULL));
+
+	if(edge_count == 0) return;
+
+	GrB_Info info;
+	UNUSED(info);
+	RG_Matrix  M    =  Graph_GetRelationMatrix(g, r, false);
+	RG_Matrix  adj  =  Graph_GetAdjacencyMatrix(g, false);
 
-	Graph_FormConnection(g, src, dest, id, r);
+	for(uint i = 0; i < edge_count; i++) {
+		const Edge *e = edges[i];
+		ASSERT(e->entity     != NULL);
+		ASSERT(e->relationID == r);
+		ASSERT(e->srcNodeID  == srcs[i]);
+		ASSERT(e->destNodeID == dests[i]);
+
+		// relation matrix entries may hold multiple edges, set one by one
+		info = RG_Matrix_setElement_UINT64(M, ENTITY_GET_ID(e), srcs[i],
+				dests[i]);
+		ASSERT(info == GrB_SUCCESS);
+	}
+
+	// rows represent source nodes, columns represent destination nodes
+	info = RG_Matrix_setElements_BOOL(adj, srcs, dests, edge_count);
+	ASSERT(info == GrB_SUCCESS);
+
+	// edges of type r have just been created, update statistics
+	GraphStatistics_IncEdgeCount(&g->stats, r, edge_count);
 }
 
 // retrieves all either incoming or outgoing edges
@@ -711,7 +971,8 @@ void Graph_GetNodeEdges
 
 			// collect all edges (src)->(dest)
 			if(edgeType != GRAPH_NO_RELATION) {
-				_CollectEdgesFromEntry(g, srcID, destID, edgeType, edgeID, edges);
+				_CollectEdgesFromEntry(g, M, srcID, destID, edgeType, edgeID,
+						edges);
 			} else {
 				Graph_GetEdgesConnectingNodes(g, srcID, destID, edgeType, edges);
 			}
@@ -734,7 +995,8 @@ void Graph_GetNodeEdges
 			RG_Matrix_extractElement_UINT64(&edgeID, M, destID, srcID);
 			// collect all edges connecting destId to srcId
 			if(edgeType != GRAPH_NO_RELATION) {
-				_CollectEdgesFromEntry(g, destID, srcID, edgeType, edgeID, edges);
+				_CollectEdgesFromEntry(g, M, destID, srcID, edgeType, edgeID,
+						edges);
 			} else {
 				Graph_GetEdgesConnectingNodes(g, destID, srcID, edgeType, edges);
 			}
@@ -1266,6 +1528,9 @@ void Graph_Free(Graph *g) {
 	DataBlock_Free(g->nodes);
 	DataBlock_Free(g->edges);
 
+	// free string pool once all entities released their properties
+	StringPool_Free(g->string_pool);
+
 	int res;
 	UNUSED(res);
 
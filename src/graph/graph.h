@@ -14,6 +14,7 @@
 #include "../redismodule.h"
 #include "graph_statistics.h"
 #include "rg_matrix/rg_matrix.h"
+#include "../util/string_pool.h"
 #include "../util/datablock/datablock.h"
 #include "../util/datablock/datablock_iterator.h"
 #include "../../deps/GraphBLAS/Include/GraphBLAS.h"
@@ -27,6 +28,7 @@
 #define GRAPH_NO_RELATION -1                    // Relations are numbered [0-N], -1 represents no relation.
 #define GRAPH_UNKNOWN_RELATION -2               // Relations are numbered [0-N], -2 represents an unknown relation.
 #define EDGE_BULK_DELETE_THRESHOLD 4            // Max number of deletions to perform without choosing the bulk delete routine.
+#define DELTA_INLINE_FLUSH_FACTOR 4             // Pending changes, as a multiple of DELTA_MAX_PENDING_CHANGES, beyond which matrices are flushed inline.
 
 typedef enum {
 	GRAPH_EDGE_DIR_INCOMING,
@@ -58,6 +60,7 @@ struct Graph {
 	bool _writelocked;                  // true if the read-write lock was acquired by a writer
 	SyncMatrixFunc SynchronizeMatrix;   // function pointer to matrix synchronization routine
 	GraphStatistics stats;              // graph related statistics
+	StringPool *string_pool;            // interned string property values
 };
 
 // graph synchronization functions
@@ -114,6 +117,28 @@ bool Graph_Pending
 	const Graph *g
 );
 
+// returns true if any of the graph's matrices accumulated enough
+// pending changes to be merged into its main matrix
+bool Graph_RequiresFlush
+(
+	const Graph *g
+);
+
+// consulted while holding the graph's write lock before a merged matrix
+// is swapped in, returning false discards the merged matrix
+typedef bool (*FlushSwapCheck)(void *arg);
+
+// merge pending changes into the main matrix of every matrix which
+// requires flushing, merged matrices are computed while holding the
+// graph's read lock and swapped in under its write lock
+// the caller must not hold the graph's lock
+void Graph_FlushPending
+(
+	Graph *g,
+	FlushSwapCheck check,  // [optional] swap check
+	void *arg              // check's argument
+);
+
 // create a new graph
 Graph *Graph_New
 (
@@ -136,6 +161,17 @@ void Graph_LabelNode
 	uint label_count
 );
 
+// label each node in 'ids' with each label in 'labels'
+// matrix entries are set in bulk, prefer over labeling nodes one by one
+void Graph_LabelNodes
+(
+	Graph *g,
+	const NodeID *ids,
+	uint id_count,
+	int *labels,
+	uint label_count
+);
+
 // creates a new relation matrix, returns id given to relation
 int Graph_AddRelationType
 (
@@ -177,6 +213,30 @@ void Graph_CreateEdge
 	Edge *e
 );
 
+// allocates an edge of type r connecting src to dest
+// the edge is assigned an ID but isn't connected, see Graph_CreateEdges
+void Graph_ReserveEdge
+(
+	Graph *g,           // graph on which to operate
+	NodeID src,         // source node ID
+	NodeID dest,        // destination node ID
+	int r,              // edge type
+	Edge *e             // [output] reserved edge
+);
+
+// connects multiple reserved edges of the same type
+// edges[i] connects srcs[i] to dests[i]
+// adjacency matrix entries are set in bulk
+void Graph_CreateEdges
+(
+	Graph *g,              // graph on which to operate
+	int r,                 // edges type
+	const NodeID *srcs,    // source node IDs
+	const NodeID *dests,   // destination node IDs
+	Edge **edges,          // edges reserved by Graph_ReserveEdge
+	uint edge_count        // number of edges to connect
+);
+
 // removes node and all of its connections within the graph
 void Graph_DeleteNode
 (
@@ -38,8 +38,9 @@ static inline void _GraphContext_DecreaseRefCount(GraphContext *gc) {
 		Config_Option_get(Config_ASYNC_DELETE, &async_delete);
 
 		if(async_delete) {
-			// Async delete
-			ThreadPools_AddWorkWriter(_GraphContext_Free, gc);
+			// Async delete, shouldn't delay pending queries
+			ThreadPools_AddWorkWriter(_GraphContext_Free, gc,
+					THPOOL_PRIORITY_LOW, gc);
 		} else {
 			// Sync delete
 			_GraphContext_Free(gc);
@@ -58,6 +59,7 @@ GraphContext *GraphContext_New(const char *graph_name, size_t node_cap, size_t e
 	gc->version          = 0;  // initial graph version
 	gc->slowlog          = SlowLog_New();
 	gc->ref_count        = 0;  // no refences
+	gc->flush_scheduled  = false;
 	gc->attributes       = raxNew();
 	gc->index_count      = 0;  // no indicies
 	gc->string_mapping   = array_new(char *, 64);
@@ -153,6 +155,42 @@ void GraphContext_Release(GraphContext *gc) {
 	_GraphContext_DecreaseRefCount(gc);
 }
 
+// merged matrices must not be swapped in while the graph is being encoded
+// as the encoder iterates over relation matrices across multiple calls
+static bool _GraphContext_FlushSwapAllowed(void *arg) {
+	GraphContext *gc = (GraphContext *)arg;
+	EncodeState state = GraphEncodeContext_GetEncodeState(gc->encoding_context);
+	return (state == ENCODE_STATE_INIT);
+}
+
+static void _GraphContext_Flush(void *arg) {
+	GraphContext *gc = (GraphContext *)arg;
+
+	Graph_FlushPending(gc->g, _GraphContext_FlushSwapAllowed, gc);
+
+	__atomic_store_n(&gc->flush_scheduled, false, __ATOMIC_RELAXED);
+	GraphContext_Release(gc);
+}
+
+void GraphContext_ScheduleFlush(GraphContext *gc) {
+	ASSERT(gc);
+
+	// flush already scheduled
+	if(__atomic_exchange_n(&gc->flush_scheduled, true, __ATOMIC_RELAXED)) {
+		return;
+	}
+
+	// the flush job holds a reference to the graph
+	_GraphContext_IncreaseRefCount(gc);
+	if(ThreadPools_AddWorkWriter(_GraphContext_Flush, gc,
+				THPOOL_PRIORITY_LOW, gc) != 0) {
+		// failed to enqueue job, pending changes are merged
+		// by a later flush
+		__atomic_store_n(&gc->flush_scheduled, false, __ATOMIC_RELAXED);
+		_GraphContext_DecreaseRefCount(gc);
+	}
+}
+
 void GraphContext_MarkWriter(RedisModuleCtx *ctx, GraphContext *gc) {
 	RedisModuleString *graphID = RedisModule_CreateString(ctx, gc->graph_name, strlen(gc->graph_name));
 
@@ -424,6 +462,8 @@ int GraphContext_DeleteIndex
 	Schema *s = GraphContext_GetSchema(gc, label, schema_type);
 
 	if(s != NULL) {
+		// buffered updates might refer to the removed index
+		QueryCtx_FlushIndexBuffer();
 		res = Schema_RemoveIndex(s, field, type);
 		if(res != INDEX_FAIL) {
 			// update resultset statistics
@@ -444,9 +484,10 @@ void GraphContext_DeleteNodeFromIndices
 	ASSERT(n  != NULL);
 	ASSERT(gc != NULL);
 
-	Schema    *s       =  NULL;
-	Graph     *g       =  gc->g;
-	EntityID  node_id  =  ENTITY_GET_ID(n);
+	Schema       *s       =  NULL;
+	Graph        *g       =  gc->g;
+	EntityID     node_id  =  ENTITY_GET_ID(n);
+	IndexBuffer  *buf     =  QueryCtx_GetIndexBuffer();
 
 	// retrieve node labels
 	uint label_count;
@@ -459,16 +500,17 @@ void GraphContext_DeleteNodeFromIndices
 
 		// Update any indices this entity is represented in
 		Index *idx = Schema_GetIndex(s, NULL, IDX_FULLTEXT);
-		if(idx) Index_RemoveNode(idx, n);
+		if(idx) IndexBuffer_RemoveNode(buf, idx, n);
 
 		idx = Schema_GetIndex(s, NULL, IDX_EXACT_MATCH);
-		if(idx) Index_RemoveNode(idx, n);
+		if(idx) IndexBuffer_RemoveNode(buf, idx, n);
 	}
 }
 
 void GraphContext_DeleteEdgeFromIndices(GraphContext *gc, Edge *e) {
-	Schema  *s  =  NULL;
-	Graph   *g  =  gc->g;
+	Schema       *s    =  NULL;
+	Graph        *g    =  gc->g;
+	IndexBuffer  *buf  =  QueryCtx_GetIndexBuffer();
 
 	int relation_id = EDGE_GET_RELATION_ID(e, g);
 
@@ -476,10 +518,10 @@ void GraphContext_DeleteEdgeFromIndices(GraphContext *gc, Edge *e) {
 
 	// update any indices this entity is represented in
 	Index *idx = Schema_GetIndex(s, NULL, IDX_FULLTEXT);
-	if(idx) Index_RemoveEdge(idx, e);
+	if(idx) IndexBuffer_RemoveEdge(buf, idx, e);
 
 	idx = Schema_GetIndex(s, NULL, IDX_EXACT_MATCH);
-	if(idx) Index_RemoveEdge(idx, e);
+	if(idx) IndexBuffer_RemoveEdge(buf, idx, e);
 }
 
 //------------------------------------------------------------------------------
@@ -40,6 +40,7 @@ typedef struct {
 	GraphDecodeContext *decoding_context;   // decode context of the graph
 	Cache *cache;                           // global cache of execution plans
 	XXH32_hash_t version;                   // graph version
+	bool flush_scheduled;                   // background matrix flush pending
 } GraphContext;
 
 //------------------------------------------------------------------------------
@@ -70,6 +71,14 @@ void GraphContext_Release
 	GraphContext *gc
 );
 
+// schedule a background job merging the graph's pending matrix changes
+// the job runs on the writer thread at low priority, such that it is
+// performed once no writes are queued
+void GraphContext_ScheduleFlush
+(
+	GraphContext *gc
+);
+
 // mark graph key as "dirty" for Redis to pick up on
 void GraphContext_MarkWriter
 (
@@ -0,0 +1,257 @@
+/*
+* Copyright 2018-2021 Redis Labs Ltd. and Contributors
+*
+* This file is available under the Redis Labs Source Available License Agreement
+*/
+
+#include "RG.h"
+#include "multi_edge_store.h"
+#include "../../util/arr.h"
+#include "../../util/rmalloc.h"
+#include <string.h>
+
+// minimal number of slots in the pool
+#define MULTI_EDGE_STORE_MIN_CAP 64
+
+// reserve 'n' slots at the end of the pool
+// returns the offset of the first reserved slot
+static uint64_t _MultiEdgeStore_Reserve
+(
+	MultiEdgeStore *store,
+	uint64_t n
+) {
+	if(store->size + n > store->cap) {
+		uint64_t cap = store->cap * 2;
+		if(cap < store->size + n) cap = store->size + n;
+		store->edges = rm_realloc(store->edges, sizeof(uint64_t) * cap);
+		store->cap = cap;
+	}
+
+	uint64_t offset = store->size;
+	store->size += n;
+	return offset;
+}
+
+// returns true once most of the pool isn't reserved by any list
+// garbage must outgrow the live slots before the pool is rewritten
+// so the cost of a compaction is amortized over the operations
+// which produced that garbage
+static inline bool _MultiEdgeStore_Fragmented
+(
+	const MultiEdgeStore *store
+) {
+	return store->garbage >= MULTI_EDGE_STORE_MIN_CAP &&
+		store->garbage * 2 > store->size;
+}
+
+// rewrite the pool such that lists occupy consecutive ranges
+static void _MultiEdgeStore_Compact
+(
+	MultiEdgeStore *store
+) {
+	ASSERT(_MultiEdgeStore_Fragmented(store));
+
+	uint64_t  size   =  store->size - store->garbage;
+	uint64_t  cap    =  size + size / 2;
+	if(cap < MULTI_EDGE_STORE_MIN_CAP) cap = MULTI_EDGE_STORE_MIN_CAP;
+
+	uint64_t  *edges  =  rm_malloc(sizeof(uint64_t) * cap);
+	uint64_t  offset  =  0;
+
+	uint64_t list_count = array_len(store->lists);
+	for(uint64_t i = 0; i < list_count; i++) {
+		EdgeList *l = store->lists + i;
+		if(l->cap == 0) continue;  // freed list
+
+		memcpy(edges + offset, store->edges + l->offset,
+				sizeof(uint64_t) * l->len);
+		l->offset = offset;
+		offset += l->cap;
+	}
+	ASSERT(offset == size);
+
+	rm_free(store->edges);
+	store->edges    =  edges;
+	store->size     =  size;
+	store->cap      =  cap;
+	store->garbage  =  0;
+}
+
+MultiEdgeStore *MultiEdgeStore_New(void) {
+	MultiEdgeStore *store = rm_malloc(sizeof(MultiEdgeStore));
+
+	store->cap       =  MULTI_EDGE_STORE_MIN_CAP;
+	store->size      =  0;
+	store->garbage   =  0;
+	store->edges     =  rm_malloc(sizeof(uint64_t) * store->cap);
+	store->lists     =  array_new(EdgeList, 0);
+	store->free_ids  =  array_new(uint64_t, 0);
+
+	return store;
+}
+
+uint64_t MultiEdgeStore_NewList
+(
+	MultiEdgeStore *store,
+	uint64_t a,
+	uint64_t b
+) {
+	ASSERT(store != NULL);
+
+	uint64_t id;
+	EdgeList l = {.offset = _MultiEdgeStore_Reserve(store, 2), .len = 2,
+		.cap = 2};
+
+	store->edges[l.offset]     = a;
+	store->edges[l.offset + 1] = b;
+
+	// reuse a freed list ID if one is available
+	if(array_len(store->free_ids) > 0) {
+		id = array_pop(store->free_ids);
+		store->lists[id] = l;
+	} else {
+		id = array_len(store->lists);
+		array_append(store->lists, l);
+	}
+
+	return id;
+}
+
+void MultiEdgeStore_Append
+(
+	MultiEdgeStore *store,
+	uint64_t id,
+	uint64_t edge
+) {
+	ASSERT(store != NULL);
+	ASSERT(id < array_len(store->lists));
+
+	EdgeList *l = store->lists + id;
+	ASSERT(l->cap > 0);
+
+	bool relocated = false;
+	if(l->len == l->cap) {
+		if(l->offset + l->cap == store->size) {
+			// list is located at the end of the pool, grow in place
+			_MultiEdgeStore_Reserve(store, l->cap);
+		} else {
+			// relocate list to the end of the pool
+			uint64_t offset = _MultiEdgeStore_Reserve(store, l->cap * 2);
+			memcpy(store->edges + offset, store->edges + l->offset,
+					sizeof(uint64_t) * l->len);
+			store->garbage += l->cap;
+			l->offset = offset;
+			relocated = true;
+		}
+		l->cap *= 2;
+	}
+
+	// only a relocation produces garbage
+	if(relocated && _MultiEdgeStore_Fragmented(store)) {
+		_MultiEdgeStore_Compact(store);
+	}
+
+	store->edges[l->offset + l->len] = edge;
+	l->len++;
+}
+
+const uint64_t *MultiEdgeStore_GetEdges
+(
+	const MultiEdgeStore *store,
+	uint64_t id,
+	uint32_t *n
+) {
+	ASSERT(n     != NULL);
+	ASSERT(store != NULL);
+	ASSERT(id    < array_len(store->lists));
+
+	const EdgeList *l = store->lists + id;
+	ASSERT(l->cap > 0);
+
+	*n = l->len;
+	return store->edges + l->offset;
+}
+
+bool MultiEdgeStore_Remove
+(
+	MultiEdgeStore *store,
+	uint64_t id,
+	uint64_t edge,
+	uint64_t *remaining
+) {
+	ASSERT(store     != NULL);
+	ASSERT(remaining != NULL);
+	ASSERT(id        < array_len(store->lists));
+
+	EdgeList  *l      =  store->lists + id;
+	uint64_t  *edges  =  store->edges + l->offset;
+
+	// search for edge
+	uint32_t i = 0;
+	for(; i < l->len; i++) {
+		if(edges[i] == edge) break;
+	}
+	ASSERT(i < l->len);
+
+	// migrate last edge into the vacated slot
+	l->len--;
+	edges[i] = edges[l->len];
+
+	// in case we're left with a single edge free list
+	if(l->len == 1) {
+		*remaining = edges[0];
+		MultiEdgeStore_FreeList(store, id);
+		return true;
+	}
+
+	return false;
+}
+
+void MultiEdgeStore_FreeList
+(
+	MultiEdgeStore *store,
+	uint64_t id
+) {
+	ASSERT(store != NULL);
+	ASSERT(id < array_len(store->lists));
+
+	EdgeList *l = store->lists + id;
+	ASSERT(l->cap > 0);
+
+	if(l->offset + l->cap == store->size) {
+		// list is located at the end of the pool, reclaim its slots
+		store->size -= l->cap;
+	} else {
+		store->garbage += l->cap;
+	}
+
+	l->len = 0;
+	l->cap = 0;
+	array_append(store->free_ids, id);
+
+	if(_MultiEdgeStore_Fragmented(store)) _MultiEdgeStore_Compact(store);
+}
+
+uint64_t MultiEdgeStore_ListCount
+(
+	const MultiEdgeStore *store
+) {
+	ASSERT(store != NULL);
+	return array_len(store->lists) - array_len(store->free_ids);
+}
+
+void MultiEdgeStore_Free
+(
+	MultiEdgeStore **store
+) {
+	ASSERT(store != NULL && *store != NULL);
+
+	MultiEdgeStore *s = *store;
+
+	rm_free(s->edges);
+	array_free(s->lists);
+	array_free(s->free_ids);
+	rm_free(s);
+
+	*store = NULL;
+}
@@ -0,0 +1,94 @@
+/*
+* Copyright 2018-2021 Redis Labs Ltd. and Contributors
+*
+* This file is available under the Redis Labs Source Available License Agreement
+*/
+
+#pragma once
+
+#include <stdint.h>
+#include <stdbool.h>
+
+// MultiEdgeStore holds the edge IDs of every relation matrix entry
+// representing more than a single edge
+// instead of allocating an array per entry, all edge lists are kept within
+// a single pool where each list occupies a contiguous range of slots
+// a multi-edge matrix entry holds the ID of its list (MSB on)
+// list IDs are stable, lists are relocated within the pool when they outgrow
+// their range, and the pool is compacted once most of it is unused
+// the store is not thread-safe, it is modified by graph writers while holding
+// the graph's write lock
+
+typedef struct {
+	uint64_t offset;  // position of the list's first edge within the pool
+	uint32_t len;     // number of edges in the list
+	uint32_t cap;     // number of slots reserved for the list, 0 if free
+} EdgeList;
+
+typedef struct {
+	uint64_t *edges;     // pool of edge IDs
+	uint64_t size;       // number of pool slots in use, including unused ranges
+	uint64_t cap;        // number of pool slots allocated
+	uint64_t garbage;    // number of pool slots not reserved by any list
+	EdgeList *lists;     // edge lists, indexed by list ID
+	uint64_t *free_ids;  // IDs of freed lists, available for reuse
+} MultiEdgeStore;
+
+// create a new multi-edge store
+MultiEdgeStore *MultiEdgeStore_New(void);
+
+// creates a new list holding edges 'a' and 'b'
+// returns the ID of the new list
+uint64_t MultiEdgeStore_NewList
+(
+	MultiEdgeStore *store,  // store
+	uint64_t a,             // first edge ID
+	uint64_t b              // second edge ID
+);
+
+// appends edge to list, amortized O(1)
+void MultiEdgeStore_Append
+(
+	MultiEdgeStore *store,  // store
+	uint64_t id,            // list ID
+	uint64_t edge           // edge ID to append
+);
+
+// returns the edges of list 'id' and sets 'n' to their number
+// the returned array is valid until the store is modified
+const uint64_t *MultiEdgeStore_GetEdges
+(
+	const MultiEdgeStore *store,  // store
+	uint64_t id,                  // list ID
+	uint32_t *n                   // [output] number of edges
+);
+
+// removes edge from list
+// in case a single edge remains, the list is freed, 'remaining' is set to
+// the remaining edge ID and true is returned
+bool MultiEdgeStore_Remove
+(
+	MultiEdgeStore *store,  // store
+	uint64_t id,            // list ID
+	uint64_t edge,          // edge ID to remove
+	uint64_t *remaining     // [output] last remaining edge
+);
+
+// frees list 'id', its ID is reused by future lists
+void MultiEdgeStore_FreeList
+(
+	MultiEdgeStore *store,  // store
+	uint64_t id             // list ID
+);
+
+// returns the number of live lists in the store
+uint64_t MultiEdgeStore_ListCount
+(
+	const MultiEdgeStore *store
+);
+
+// free store
+void MultiEdgeStore_Free
+(
+	MultiEdgeStore **store
+);
@@ -6,28 +6,7 @@
 
 #include "RG.h"
 #include "rg_matrix.h"
-#include "../../util/arr.h"
 #include "../../util/rmalloc.h"
-#include "../entities/graph_entity.h"
-
-// free multi-edge arrays GraphBLAS unary operation
-static GrB_UnaryOp free_multi_edge_op = NULL;
-
-// unary GraphBLAS operation which frees all multi-edge array entries
-// within a matrix
-static void free_multiedge_array(void *out, const void *in) {
-	EdgeID *_out = (EdgeID *)out;
-	const EdgeID *id = (const EdgeID *)in;
-
-	if(!(SINGLE_EDGE(*id))) {
-		// entry is a pointer to dynamic array, free it
-		EdgeID *ids = (EdgeID *)(CLEAR_MSB(*id));
-		array_free(ids);
-	}
-
-	// set out to 0
-	*_out = 0;
-}
 
 // free RG_Matrix's internal matrices:
 // M, delta-plus, delta-minus and transpose
@@ -47,21 +26,8 @@ void RG_Matrix_free
 	info = RG_Matrix_wait(M, true);
 	ASSERT(info == GrB_SUCCESS);
 
-	GrB_Matrix m = RG_MATRIX_M(M);
-
-	// free edges
-	if(RG_MATRIX_MULTI_EDGE(M)) {
-		if(free_multi_edge_op == NULL) {
-			// create unary operation
-			info = GrB_UnaryOp_new(&free_multi_edge_op, free_multiedge_array, 
-				GrB_UINT64, GrB_UINT64);
-			ASSERT(info == GrB_SUCCESS);
-		}
-
-		// frees multi-edge arrays
-		info = GrB_Matrix_apply(m, NULL, NULL, free_multi_edge_op, m, NULL);
-		ASSERT(info == GrB_SUCCESS);
-	}
+	// free multi-edge lists
+	if(M->multi_edges != NULL) MultiEdgeStore_Free(&M->multi_edges);
 
 	info = GrB_Matrix_free(&M->matrix);
 	ASSERT(info == GrB_SUCCESS);
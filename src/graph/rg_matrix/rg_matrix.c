@@ -14,7 +14,11 @@ void RG_Matrix_setDirty
 ) {
 	ASSERT(C);
 	C->dirty = true;
-	if(RG_MATRIX_MAINTAIN_TRANSPOSE(C)) C->transposed->dirty = true;
+	C->version++;
+	if(RG_MATRIX_MAINTAIN_TRANSPOSE(C)) {
+		C->transposed->dirty = true;
+		C->transposed->version++;
+	}
 }
 
 RG_Matrix RG_Matrix_getTranspose
@@ -33,6 +37,14 @@ bool RG_Matrix_isDirty
 	return C->dirty;
 }
 
+uint64_t RG_Matrix_version
+(
+	const RG_Matrix C
+) {
+	ASSERT(C);
+	return C->version;
+}
+
 // locks the matrix
 void RG_Matrix_Lock
 (
@@ -121,14 +133,18 @@ GrB_Info RG_Matrix_clear
 	info = GrB_Matrix_clear(m);
 	ASSERT(info == GrB_SUCCESS);
 
-	info = GrB_Matrix_clear(m);
+	info = GrB_Matrix_clear(delta_plus);
 	ASSERT(info == GrB_SUCCESS);
 
-	info = GrB_Matrix_clear(m);
+	info = GrB_Matrix_clear(delta_minus);
 	ASSERT(info == GrB_SUCCESS);
 
 	A->dirty = false;
-	if(RG_MATRIX_MAINTAIN_TRANSPOSE(A)) A->transposed->dirty = false;
+	A->version++;
+	if(RG_MATRIX_MAINTAIN_TRANSPOSE(A)) {
+		A->transposed->dirty = false;
+		A->transposed->version++;
+	}
 
 	return info;
 }
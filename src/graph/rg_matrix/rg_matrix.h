@@ -7,6 +7,7 @@
 #pragma once
 
 #include <pthread.h>
+#include "multi_edge_store.h"
 #include "../../deps/GraphBLAS/Include/GraphBLAS.h"
 
 // forward declaration of RG_Matrix type
@@ -28,6 +29,8 @@ typedef _RG_Matrix *RG_Matrix;
 #define RG_MATRIX_DELTA_PLUS(C) (C)->delta_plus
 #define RG_MATRIX_DELTA_MINUS(C) (C)->delta_minus
 
+#define RG_MATRIX_MULTI_EDGE_STORE(C) (C)->multi_edges
+
 #define RG_MATRIX_TM(C) (C)->transposed->matrix
 #define RG_MATRIX_TDELTA_PLUS(C) (C)->transposed->delta_plus
 #define RG_MATRIX_TDELTA_MINUS(C) (C)->transposed->delta_minus
@@ -126,10 +129,12 @@ typedef _RG_Matrix *RG_Matrix;
 
 struct _RG_Matrix {
 	bool dirty;                         // Indicates if matrix requires sync
+	uint64_t version;                   // Modification counter
 	GrB_Matrix matrix;                  // Underlying GrB_Matrix
 	GrB_Matrix delta_plus;              // Pending additions
 	GrB_Matrix delta_minus;             // Pending deletions
 	RG_Matrix transposed;               // Transposed matrix
+	MultiEdgeStore *multi_edges;        // Multi-edge lists, UINT64 matrices only
 	pthread_mutex_t mutex;              // Lock
 };
 
@@ -158,6 +163,13 @@ bool RG_Matrix_isDirty
 	const RG_Matrix C
 );
 
+// returns matrix modification counter
+// the counter advances whenever the matrix content or dimensions change
+uint64_t RG_Matrix_version
+(
+	const RG_Matrix C
+);
+
 // locks the matrix
 void RG_Matrix_Lock
 (
@@ -202,6 +214,16 @@ GrB_Info RG_Matrix_setElement_BOOL      // C (i,j) = x
 	GrB_Index j                         // column index
 );
 
+// sets multiple entries at once
+// C (I[k],J[k]) = true for k in [0, nvals)
+GrB_Info RG_Matrix_setElements_BOOL     // C (I[k],J[k]) = true
+(
+	RG_Matrix C,                        // matrix to modify
+	const GrB_Index *I,                 // row indices
+	const GrB_Index *J,                 // column indices
+	GrB_Index nvals                     // number of entries
+);
+
 GrB_Info RG_Matrix_setElement_UINT64      // C (i,j) = x
 (
 	RG_Matrix C,                        // matrix to modify
@@ -258,6 +280,17 @@ GrB_Info RG_mxm                     // C = A * B
 	const RG_Matrix B               // second input: matrix B
 );
 
+// computes C<Mask> = A * B
+// entries of C not present in 'Mask' are neither computed nor kept
+GrB_Info RG_mxm_masked              // C<Mask> = A * B
+(
+	RG_Matrix C,                    // input/output matrix for results
+	const GrB_Matrix Mask,          // structural mask for C
+	const GrB_Semiring semiring,    // defines '+' and '*' for A*B
+	const RG_Matrix A,              // first input:  matrix A
+	const RG_Matrix B               // second input: matrix B
+);
+
 GrB_Info RG_eWiseAdd                // C = A + B
 (
     RG_Matrix C,                    // input/output matrix for results
@@ -297,6 +330,28 @@ GrB_Info RG_Matrix_wait
 	bool force_sync
 );
 
+// materialize pending changes without merging them into M
+GrB_Info RG_Matrix_materialize
+(
+	RG_Matrix C
+);
+
+// returns true if C accumulated enough pending changes to be
+// merged into M, as determined by DELTA_MAX_PENDING_CHANGES
+bool RG_Matrix_requiresFlush
+(
+	const RG_Matrix C
+);
+
+// replace C's main matrix with M, discarding C's pending changes
+// M is expected to hold C's content (M + DP - DM) as computed by
+// RG_Matrix_export, C takes ownership over M
+GrB_Info RG_Matrix_replace
+(
+	RG_Matrix C,
+	GrB_Matrix *M
+);
+
 void RG_Matrix_free
 (
 	RG_Matrix *C
@@ -104,3 +104,90 @@ GrB_Info RG_mxm                     // C = A * B
 	return info;
 }
 
+
+GrB_Info RG_mxm_masked              // C<Mask> = A * B
+(
+    RG_Matrix C,                    // input/output matrix for results
+    const GrB_Matrix Mask,          // structural mask for C
+    const GrB_Semiring semiring,    // defines '+' and '*' for A*B
+    const RG_Matrix A,              // first input:  matrix A
+    const RG_Matrix B               // second input: matrix B
+) {
+	ASSERT(C    != NULL);
+	ASSERT(A    != NULL);
+	ASSERT(B    != NULL);
+	ASSERT(Mask != NULL);
+
+	// multiply RG_Matrix by RG_Matrix
+	// computing only the entries present in 'Mask'
+	// this operation performs: A * B by computing:
+	// ((A * M)<!(A * 'delta-minus')> + A * 'delta-plus')<Mask>
+
+	// validate A is fully synced
+	ASSERT(!RG_Matrix_isDirty(A));
+
+	// validate C is fully synced
+	ASSERT(!RG_Matrix_isDirty(C));
+
+	GrB_Info info;
+	GrB_Index nrows;     // number of rows in result matrix
+	GrB_Index ncols;     // number of columns in result matrix
+	GrB_Index dp_nvals;  // number of entries in 'dp'
+	GrB_Index dm_nvals;  // number of entries in 'dm'
+
+	GrB_Matrix  _A     =  RG_MATRIX_M(A);
+	GrB_Matrix  _B     =  RG_MATRIX_M(B);
+	GrB_Matrix  _C     =  RG_MATRIX_M(C);
+	GrB_Matrix  dp     =  RG_MATRIX_DELTA_PLUS(B);
+	GrB_Matrix  dm     =  RG_MATRIX_DELTA_MINUS(B);
+	GrB_Matrix  mask   =  NULL;  // entities removed
+	GrB_Matrix  accum  =  NULL;  // entities added
+
+	RG_Matrix_nrows(&nrows, C);
+	RG_Matrix_ncols(&ncols, C);
+	GrB_Matrix_nvals(&dp_nvals, dp);
+	GrB_Matrix_nvals(&dm_nvals, dm);
+
+	// A and C might be the same matrix
+	// compute delta products before overwriting C
+
+	if(dm_nvals > 0) {
+		// compute (A * 'delta-minus')<Mask>
+		info = GrB_Matrix_new(&mask, GrB_BOOL, nrows, ncols);
+		ASSERT(info == GrB_SUCCESS);
+
+		info = GrB_mxm(mask, Mask, NULL, GxB_ANY_PAIR_BOOL, _A, dm, GrB_DESC_S);
+		ASSERT(info == GrB_SUCCESS);
+	}
+
+	if(dp_nvals > 0) {
+		// compute (A * 'delta-plus')<Mask>
+		info = GrB_Matrix_new(&accum, GrB_BOOL, nrows, ncols);
+		ASSERT(info == GrB_SUCCESS);
+
+		info = GrB_mxm(accum, Mask, NULL, semiring, _A, dp, GrB_DESC_S);
+		ASSERT(info == GrB_SUCCESS);
+	}
+
+	// compute (A * B)<Mask>
+	info = GrB_mxm(_C, Mask, NULL, semiring, _A, _B, GrB_DESC_RS);
+	ASSERT(info == GrB_SUCCESS);
+
+	if(mask) {
+		// drop entries reached via deleted entries
+		info = GrB_Matrix_apply(_C, mask, NULL, GrB_IDENTITY_BOOL, _C,
+				GrB_DESC_RSC);
+		ASSERT(info == GrB_SUCCESS);
+	}
+
+	if(accum) {
+		info = GrB_eWiseAdd(_C, NULL, NULL, GxB_ANY_PAIR_BOOL, _C, accum, NULL);
+		ASSERT(info == GrB_SUCCESS);
+	}
+
+	// clean up
+	if(mask)  GrB_free(&mask);
+	if(accum) GrB_free(&accum);
+
+	return info;
+}
@@ -77,10 +77,11 @@ GrB_Info RG_Matrix_new
 	ASSERT(info == GrB_SUCCESS);
 
 	//--------------------------------------------------------------------------
-	// create transpose matrix if required
+	// create multi-edge store and transpose matrix if required
 	//--------------------------------------------------------------------------
 
 	if(type == GrB_UINT64) {
+		matrix->multi_edges = MultiEdgeStore_New();
 		matrix->transposed = rm_calloc(1, sizeof(_RG_Matrix));
 		info = _RG_Matrix_init(matrix->transposed, GrB_BOOL, ncols, nrows);
 		ASSERT(info == GrB_SUCCESS);
@@ -7,7 +7,6 @@
 #include "RG.h"
 #include "rg_matrix.h"
 #include "rg_utils.h"
-#include "../../util/arr.h"
 #include "../../util/rmalloc.h"
 
 GrB_Info RG_Matrix_removeElement_BOOL
@@ -147,8 +146,7 @@ GrB_Info RG_Matrix_removeElement_UINT64
 	if(in_m) {
 		// free multi-edge entry, leave M[i,j] dirty
 		if((SINGLE_EDGE(m_x)) == false) {
-			m_x = CLEAR_MSB(m_x);
-			array_free((uint64_t *)m_x);
+			MultiEdgeStore_FreeList(RG_MATRIX_MULTI_EDGE_STORE(C), CLEAR_MSB(m_x));
 		}
 
 		// mark deletion in delta minus
@@ -163,8 +161,7 @@ GrB_Info RG_Matrix_removeElement_UINT64
 	if(in_dp) {
 		// free multi-edge entry
 		if((SINGLE_EDGE(dp_x)) == false) {
-			dp_x = CLEAR_MSB(dp_x);
-			array_free((uint64_t *)dp_x);
+			MultiEdgeStore_FreeList(RG_MATRIX_MULTI_EDGE_STORE(C), CLEAR_MSB(dp_x));
 		}
 
 		// remove entry from 'dp'
@@ -7,67 +7,28 @@
 #include "RG.h"
 #include "rg_utils.h"
 #include "rg_matrix.h"
-#include "../../util/arr.h"
 #include "../../util/rmalloc.h"
 
-static bool _removeEntryFromMultiValArr
-(
-	uint64_t **entries,  // multi-value array
-	uint64_t entry       // element to remove output new value
-) {
-	ASSERT(*entries != NULL);
-
-	uint  i  =  0;
-	uint  n  =  array_len(*entries);
-
-	// search for entry
-	for(; i < n; i++) {
-		if((*entries)[i] == entry) {
-			break;
-		}
-	}
-
-	ASSERT(i < n);
-
-	// remove located entry
-	// migrate last element and reduce array size
-	array_del_fast(*entries, i);
-
-	// incase we're left with a single entry revert back to scalar
-	if(array_len(*entries) == 1) {
-		entry = (*entries)[0];
-		array_free(*entries);
-		*entries = (uint64_t *)entry;
-		return true;
-	}
-
-	return false;
-}
-
 static GrB_Info _removeElementMultiVal
 (
-    GrB_Matrix A,                   // matrix to remove entry from
-    GrB_Index i,                    // row index
-    GrB_Index j,                    // column index
+	RG_Matrix C,                    // matrix owning A
+	GrB_Matrix A,                   // matrix to remove entry from
+	GrB_Index i,                    // row index
+	GrB_Index j,                    // column index
+	uint64_t  x,                    // current value of A[i,j]
 	uint64_t  v                     // value to remove
 ) {
 	ASSERT(A);
-
-	uint64_t  x;
-	uint64_t  tx;
-	GrB_Info  info;
-
-	info = GrB_Matrix_extractElement(&x, A, i, j);
-	ASSERT(info == GrB_SUCCESS);
 	ASSERT((SINGLE_EDGE(x)) == false);
 
+	GrB_Info  info  =  GrB_SUCCESS;
+	uint64_t  remaining;
+
 	// remove entry from multi-value
-	x  = CLEAR_MSB(x);
-	uint64_t *entries  = (uint64_t *)x;
-	if(_removeEntryFromMultiValArr(&entries, v)) {
-		// update entry
-		x = (uint64_t)entries;
-		info = GrB_Matrix_setElement(A, x, i, j);
+	// incase we're left with a single entry revert back to scalar
+	if(MultiEdgeStore_Remove(RG_MATRIX_MULTI_EDGE_STORE(C), CLEAR_MSB(x), v,
+				&remaining)) {
+		info = GrB_Matrix_setElement(A, remaining, i, j);
 	}
 
 	return info;
@@ -134,9 +95,8 @@ GrB_Info RG_Matrix_removeEntry
 			ASSERT(info == GrB_SUCCESS);
 			info = RG_Matrix_removeElement_BOOL(C->transposed, j, i);
 			ASSERT(info == GrB_SUCCESS)
-			RG_Matrix_setDirty(C);
 		} else {
-			info = _removeElementMultiVal(m, i, j, v);
+			info = _removeElementMultiVal(C, m, i, j, m_x, v);
 			ASSERT(info == GrB_SUCCESS);
 		}
 	}
@@ -151,13 +111,16 @@ GrB_Info RG_Matrix_removeEntry
 			ASSERT(info == GrB_SUCCESS);
 			info = RG_Matrix_removeElement_BOOL(C->transposed, j, i);
 			ASSERT(info == GrB_SUCCESS)
-			RG_Matrix_setDirty(C);
 		} else {
-			info = _removeElementMultiVal(dp, i, j, v);
+			info = _removeElementMultiVal(C, dp, i, j, dp_x, v);
 			ASSERT(info == GrB_SUCCESS);
 		}
 	}
 
+	// multi-edge lists are modified in place, C's version must be bumped
+	// on every path such that exports taken earlier are discarded
+	RG_Matrix_setDirty(C);
+
 	return info;
 }
 
@@ -33,7 +33,9 @@ GrB_Info RG_Matrix_resize       // change the size of a matrix
 	
 	info = GrB_Matrix_resize(delta_minus, nrows_new, ncols_new);
 	ASSERT(info == GrB_SUCCESS);
-	
+
+	C->version++;
+
 	return info;
 }
 
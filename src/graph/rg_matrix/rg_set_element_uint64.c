@@ -7,53 +7,31 @@
 #include "RG.h"
 #include "rg_utils.h"
 #include "rg_matrix.h"
-#include "../../util/arr.h"
-
-static GrB_BinaryOp _graph_edge_accum = NULL;
-
-void _edge_accum(void *_z, const void *_x, const void *_y) {
-	uint64_t *ids;
-	uint64_t       *z  =  (uint64_t *)        _z;
-	const uint64_t *x  =  (const uint64_t *)  _x;
-	const uint64_t *y  =  (const uint64_t *)  _y;
-
-	// single edge ID,
-	// switching from single edge ID to multiple IDs
-	if(SINGLE_EDGE(*x)) {
-		ids = array_new(uint64_t, 2);
-		array_append(ids, *x);
-		array_append(ids, *y);
-	} else {
-		// multiple edges, adding another edge
-		ids = (uint64_t *)(CLEAR_MSB(*x));
-		array_append(ids, *y);
-	}
 
-	*z = (uint64_t)SET_MSB(ids);
-}
-
-// dealing with multi-value entries
-static GrB_Info setMultiEdgeEntry
+// adds edge 'x' to the existing entry A[i,j]
+// a single edge entry is converted into a multi-edge list
+// while an existing list is appended to, leaving A untouched
+static GrB_Info _addEdgeToEntry
 (
-    GrB_Matrix A,                       // matrix to modify
-    uint64_t x,                         // scalar to assign to A(i,j)
-    GrB_Index i,                        // row index
-    GrB_Index j                         // column index
+	RG_Matrix C,                        // matrix owning A
+	GrB_Matrix A,                       // matrix to modify, M or delta-plus
+	uint64_t v,                         // current value of A[i,j]
+	uint64_t x,                         // edge ID to add
+	GrB_Index i,                        // row index
+	GrB_Index j                         // column index
 ) {
-	GrB_Info info;
+	GrB_Info info = GrB_SUCCESS;
+	MultiEdgeStore *store = RG_MATRIX_MULTI_EDGE_STORE(C);
 
-	// create edge accumulator binary function
-	// TODO: remove if condition, initialize binary operation at module load
-	if(!_graph_edge_accum) {
-		info = GrB_BinaryOp_new(&_graph_edge_accum, _edge_accum, GrB_UINT64, 
-								GrB_UINT64, GrB_UINT64);
-		ASSERT(info == GrB_SUCCESS);
+	if(SINGLE_EDGE(v)) {
+		// switching from single edge ID to multiple IDs
+		uint64_t id = MultiEdgeStore_NewList(store, v, x);
+		info = GrB_Matrix_setElement_UINT64(A, SET_MSB(id), i, j);
+	} else {
+		// multiple edges, adding another edge
+		MultiEdgeStore_Append(store, CLEAR_MSB(v), x);
 	}
 
-	info = GxB_Matrix_subassign_UINT64(A, NULL, _graph_edge_accum, 
-									   x, &i, 1, &j, 1, NULL);
-	ASSERT(info == GrB_SUCCESS);
-
 	return info;
 }
 
@@ -119,10 +97,16 @@ GrB_Info RG_Matrix_setElement_UINT64    // C (i,j) = x
 
 		if(entry_exists) {
 			// update entry at m[i,j]
-			info = setMultiEdgeEntry(m, x, i, j);
+			info = _addEdgeToEntry(C, m, v, x, i, j);
 		} else {
-			// update entry at dp[i,j]
-			info = setMultiEdgeEntry(dp, x, i, j);
+			info = GrB_Matrix_extractElement_UINT64(&v, dp, i, j);
+			if(info == GrB_SUCCESS) {
+				// update entry at dp[i,j]
+				info = _addEdgeToEntry(C, dp, v, x, i, j);
+			} else {
+				// new entry at dp[i,j]
+				info = GrB_Matrix_setElement_UINT64(dp, x, i, j);
+			}
 		}
 	}
 
@@ -0,0 +1,88 @@
+/*
+* Copyright 2018-2021 Redis Labs Ltd. and Contributors
+*
+* This file is available under the Redis Labs Source Available License Agreement
+*/
+
+#include "RG.h"
+#include "rg_utils.h"
+#include "rg_matrix.h"
+
+// below this number of entries, entries are set one by one
+// building a temporary matrix isn't worth it
+#define BUILD_THRESHOLD 64
+
+GrB_Info RG_Matrix_setElements_BOOL     // C (I[k],J[k]) = true
+(
+	RG_Matrix C,                        // matrix to modify
+	const GrB_Index *I,                 // row indices
+	const GrB_Index *J,                 // column indices
+	GrB_Index nvals                     // number of entries
+) {
+	ASSERT(C != NULL);
+	ASSERT(!RG_MATRIX_MULTI_EDGE(C));
+	ASSERT(nvals == 0 || (I != NULL && J != NULL));
+
+	GrB_Info info = GrB_SUCCESS;
+
+	if(nvals < BUILD_THRESHOLD) {
+		for(GrB_Index k = 0; k < nvals; k++) {
+			info = RG_Matrix_setElement_BOOL(C, I[k], J[k]);
+			ASSERT(info == GrB_SUCCESS);
+		}
+		return info;
+	}
+
+	if(RG_MATRIX_MAINTAIN_TRANSPOSE(C)) {
+		info = RG_Matrix_setElements_BOOL(C->transposed, J, I, nvals);
+		ASSERT(info == GrB_SUCCESS);
+	}
+
+	GrB_Matrix m  = RG_MATRIX_M(C);
+	GrB_Matrix dp = RG_MATRIX_DELTA_PLUS(C);
+	GrB_Matrix dm = RG_MATRIX_DELTA_MINUS(C);
+
+	GrB_Index nrows;
+	GrB_Index ncols;
+	GrB_Index dm_nvals;
+	info = GrB_Matrix_nrows(&nrows, m);
+	ASSERT(info == GrB_SUCCESS);
+	info = GrB_Matrix_ncols(&ncols, m);
+	ASSERT(info == GrB_SUCCESS);
+
+	// build all entries at once, duplicates are allowed
+	GrB_Matrix  T  =  NULL;
+	GrB_Scalar  x  =  NULL;
+
+	info = GrB_Scalar_new(&x, GrB_BOOL);
+	ASSERT(info == GrB_SUCCESS);
+	info = GrB_Scalar_setElement_BOOL(x, true);
+	ASSERT(info == GrB_SUCCESS);
+
+	info = GrB_Matrix_new(&T, GrB_BOOL, nrows, ncols);
+	ASSERT(info == GrB_SUCCESS);
+	info = GxB_Matrix_build_Scalar(T, I, J, x, nvals);
+	ASSERT(info == GrB_SUCCESS);
+
+	// entries marked for deletion already exist in m
+	// unset them from delta-minus
+	info = GrB_Matrix_nvals(&dm_nvals, dm);
+	ASSERT(info == GrB_SUCCESS);
+	if(dm_nvals > 0) {
+		info = GrB_transpose(dm, T, GrB_NULL, dm, GrB_DESC_RSCT0);
+		ASSERT(info == GrB_SUCCESS);
+	}
+
+	// add entries missing from m to delta-plus, dp<!m> |= T
+	info = GrB_Matrix_assign(dp, m, GrB_LOR, T, GrB_ALL, nrows, GrB_ALL,
+			ncols, GrB_DESC_SC);
+	ASSERT(info == GrB_SUCCESS);
+
+	GrB_free(&T);
+	GrB_free(&x);
+
+	RG_Matrix_setDirty(C);
+
+	return info;
+}
+
@@ -92,38 +92,53 @@ static GrB_Info RG_Matrix_sync
 	return info;
 }
 
-GrB_Info RG_Matrix_wait
+// materialize delta-plus and delta-minus
+static GrB_Info _RG_Matrix_materializeDeltas
 (
-	RG_Matrix A,
-	bool force_sync
+	RG_Matrix C
 ) {
-	ASSERT(A != NULL);
-	if(RG_MATRIX_MAINTAIN_TRANSPOSE(A)) {
-		RG_Matrix_wait(A->transposed, force_sync);
-	}
-	
-	GrB_Info    info         =  GrB_SUCCESS;
-	GrB_Matrix  m            =  RG_MATRIX_M(A);
-	GrB_Matrix  delta_plus   =  RG_MATRIX_DELTA_PLUS(A);
-	GrB_Matrix  delta_minus  =  RG_MATRIX_DELTA_MINUS(A);
+	GrB_Info info;
 
-	info = GrB_wait(delta_plus, GrB_MATERIALIZE);
+	info = GrB_wait(RG_MATRIX_DELTA_PLUS(C), GrB_MATERIALIZE);
 	ASSERT(info == GrB_SUCCESS);
 
-	info = GrB_wait(delta_minus, GrB_MATERIALIZE);
+	info = GrB_wait(RG_MATRIX_DELTA_MINUS(C), GrB_MATERIALIZE);
 	ASSERT(info == GrB_SUCCESS);
 
-	// check if merge is required
-	
+	return info;
+}
+
+bool RG_Matrix_requiresFlush
+(
+	const RG_Matrix C
+) {
+	ASSERT(C != NULL);
+
 	GrB_Index delta_plus_nvals;
 	GrB_Index delta_minus_nvals;
-	GrB_Matrix_nvals(&delta_plus_nvals, delta_plus);
-	GrB_Matrix_nvals(&delta_minus_nvals, delta_minus);
+	GrB_Matrix_nvals(&delta_plus_nvals, RG_MATRIX_DELTA_PLUS(C));
+	GrB_Matrix_nvals(&delta_minus_nvals, RG_MATRIX_DELTA_MINUS(C));
 
 	uint64_t delta_max_pending_changes;
 	Config_Option_get(Config_DELTA_MAX_PENDING_CHANGES, &delta_max_pending_changes);
-	if(force_sync ||
-	   delta_plus_nvals + delta_minus_nvals >= delta_max_pending_changes) {
+
+	return (delta_plus_nvals + delta_minus_nvals >= delta_max_pending_changes);
+}
+
+GrB_Info RG_Matrix_wait
+(
+	RG_Matrix A,
+	bool force_sync
+) {
+	ASSERT(A != NULL);
+	if(RG_MATRIX_MAINTAIN_TRANSPOSE(A)) {
+		RG_Matrix_wait(A->transposed, force_sync);
+	}
+
+	GrB_Info info = _RG_Matrix_materializeDeltas(A);
+
+	// check if merge is required
+	if(force_sync || RG_Matrix_requiresFlush(A)) {
 		info = RG_Matrix_sync(A);
 	}
 
@@ -132,3 +147,71 @@ GrB_Info RG_Matrix_wait
 	return info;
 }
 
+GrB_Info RG_Matrix_materialize
+(
+	RG_Matrix A
+) {
+	ASSERT(A != NULL);
+	if(RG_MATRIX_MAINTAIN_TRANSPOSE(A)) {
+		RG_Matrix_materialize(A->transposed);
+	}
+
+	GrB_Info info = _RG_Matrix_materializeDeltas(A);
+
+	_SetUndirty(A);
+
+	return info;
+}
+
+GrB_Info RG_Matrix_replace
+(
+	RG_Matrix C,
+	GrB_Matrix *M
+) {
+	ASSERT(C  != NULL);
+	ASSERT(M  != NULL);
+	ASSERT(*M != NULL);
+
+	GrB_Info    info;
+	GrB_Type    m_type;
+	GrB_Type    a_type;
+	GrB_Matrix  m   =  RG_MATRIX_M(C);
+	GrB_Matrix  a   =  *M;
+
+	UNUSED(m_type);
+	UNUSED(a_type);
+
+	// replacement must hold the same type of entries
+	info = GxB_Matrix_type(&m_type, m);
+	ASSERT(info == GrB_SUCCESS);
+	info = GxB_Matrix_type(&a_type, a);
+	ASSERT(info == GrB_SUCCESS);
+	ASSERT(m_type == a_type);
+
+	// M's multi-edge entries refer to lists held by C's multi-edge store
+	// which is retained, only C's main matrix is freed
+	info = GrB_Matrix_free(&m);
+	ASSERT(info == GrB_SUCCESS);
+
+	// main matrix is never hypersparse
+	info = GxB_set(a, GxB_SPARSITY_CONTROL, GxB_SPARSE);
+	ASSERT(info == GrB_SUCCESS);
+	info = GxB_set(a, GxB_HYPER_SWITCH, GxB_NEVER_HYPER);
+	ASSERT(info == GrB_SUCCESS);
+	info = GrB_wait(a, GrB_MATERIALIZE);
+	ASSERT(info == GrB_SUCCESS);
+
+	RG_MATRIX_M(C) = a;
+	*M = NULL;
+
+	// pending changes are accounted for by M
+	info = GrB_Matrix_clear(RG_MATRIX_DELTA_PLUS(C));
+	ASSERT(info == GrB_SUCCESS);
+	info = GrB_Matrix_clear(RG_MATRIX_DELTA_MINUS(C));
+	ASSERT(info == GrB_SUCCESS);
+
+	C->dirty = false;
+	C->version++;
+
+	return info;
+}
@@ -90,22 +90,26 @@ RSDoc *Index_IndexGraphEntity
 			// value must be of type string
 			if(t == T_STRING) {
 				*doc_field_count += 1;
-				RediSearch_DocumentAddFieldString(doc, field_name, v->stringval,
-						strlen(v->stringval), RSFLDTYPE_FULLTEXT);
+				RediSearch_DocumentAddFieldString(doc, field_name, SI_STRINGVAL(*v),
+						strlen(SI_STRINGVAL(*v)), RSFLDTYPE_FULLTEXT);
 			}
 		}
 	} else {
 		for(uint i = 0; i < field_count; i++) {
 			field_name = idx->fields[i];
 			v = GraphEntity_GetProperty(e, idx->fields_ids[i]);
-			if(v == PROPERTY_NOTFOUND) continue;
+			if(v == PROPERTY_NOTFOUND) {
+				idx->fields_types[i] |= T_NULL;
+				continue;
+			}
 
 			SIType t = SI_TYPE(*v);
+			idx->fields_types[i] |= t;
 
 			*doc_field_count += 1;
 			if(t == T_STRING) {
-				RediSearch_DocumentAddFieldString(doc, field_name, v->stringval,
-						strlen(v->stringval), RSFLDTYPE_TAG);
+				RediSearch_DocumentAddFieldString(doc, field_name, SI_STRINGVAL(*v),
+						strlen(SI_STRINGVAL(*v)), RSFLDTYPE_TAG);
 			} else if(t & (SI_NUMERIC | T_BOOL)) {
 				double d = SI_GET_NUMERIC(*v);
 				RediSearch_DocumentAddFieldNumber(doc, field_name, d,
@@ -168,6 +172,7 @@ Index *Index_New
 	idx->fields        =  array_new(char *, 0);
 	idx->label_id      =  label_id;
 	idx->fields_ids    =  array_new(Attribute_ID, 0);
+	idx->fields_types  =  array_new(SIType, 0);
 	idx->language      =  NULL;
 	idx->stopwords     =  NULL;
 	idx->entity_type   =  entity_type;
@@ -189,6 +194,7 @@ void Index_AddField
 
 	array_append(idx->fields, rm_strdup(field));
 	array_append(idx->fields_ids, fieldID);
+	array_append(idx->fields_types, 0);
 }
 
 // removes fields from index
@@ -210,6 +216,7 @@ void Index_RemoveField
 			rm_free(idx->fields[i]);
 			array_del_fast(idx->fields, i);
 			array_del_fast(idx->fields_ids, i);
+			array_del_fast(idx->fields_types, i);
 			break;
 		}
 	}
@@ -274,6 +281,9 @@ void Index_Construct
 		RediSearch_TagFieldSetCaseSensitive(rsIdx, fieldID, 1);
 	}
 
+	// types are collected again as entities are re-indexed
+	for(uint i = 0; i < fields_count; i++) idx->fields_types[i] = 0;
+
 	idx->idx = rsIdx;
 	if(idx->entity_type == GETYPE_NODE) populateNodeIndex(idx);
 	else populateEdgeIndex(idx);
@@ -289,6 +299,9 @@ RSResultsIterator *Index_Query
 	ASSERT(idx   != NULL);
 	ASSERT(query != NULL);
 
+	// make sure the calling query observes its own updates
+	QueryCtx_FlushIndexBuffer();
+
 	return RediSearch_IterateQuery(idx->idx, query, strlen(query), err);
 }
 
@@ -312,6 +325,22 @@ const char **Index_GetFields
 	return (const char **)idx->fields;
 }
 
+SIType Index_FieldTypes
+(
+	const Index *idx,
+	Attribute_ID attribute_id
+) {
+	ASSERT(idx != NULL);
+
+	uint fields_count = array_len(idx->fields);
+	for(uint i = 0; i < fields_count; i++) {
+		if(idx->fields_ids[i] == attribute_id) return idx->fields_types[i];
+	}
+
+	ASSERT(false && "attribute isn't indexed");
+	return 0;
+}
+
 bool Index_ContainsAttribute
 (
 	const Index *idx,
@@ -396,6 +425,7 @@ void Index_Free(Index *idx) {
 	}
 	array_free(idx->fields);
 	array_free(idx->fields_ids);
+	array_free(idx->fields_types);
 
 	if(idx->stopwords) {
 		uint stopwords_count = array_len(idx->stopwords);
@@ -33,6 +33,7 @@ typedef struct {
 	int label_id;                 // indexed label ID
 	char **fields;                // indexed fields
 	Attribute_ID *fields_ids;     // indexed field IDs
+	SIType *fields_types;         // value types seen per field, T_NULL if missing
 	char *language;               // language
 	char **stopwords;             // stopwords
 	GraphEntityType entity_type;  // entity type (node/edge) indexed
@@ -115,6 +116,15 @@ const char **Index_GetFields
 	const Index *idx
 );
 
+// returns the types of values indexed under attribute since index construction
+// T_NULL is included if an entity lacking the attribute was indexed
+// types are never removed, the result may include types no longer held
+SIType Index_FieldTypes
+(
+	const Index *idx,
+	Attribute_ID attribute_id  // indexed attribute id
+);
+
 // checks if given attribute is indexed
 bool Index_ContainsAttribute
 (
@@ -0,0 +1,231 @@
+/*
+* Copyright 2018-2021 Redis Labs Ltd. and Contributors
+*
+* This file is available under the Redis Labs Source Available License Agreement
+*/
+
+#include "RG.h"
+#include "index_buffer.h"
+#include "../util/rmalloc.h"
+#include "../graph/entities/graph_entity.h"
+#include <string.h>
+
+// buffered update key: index followed by document key
+#define UPDATE_KEY_MAX_LEN (sizeof(Index *) + sizeof(EdgeIndexKey))
+
+// a single buffered update
+typedef struct {
+	Index *idx;    // index to update
+	bool remove;   // remove document rather than index entity
+	union {
+		Node n;    // node to update
+		Edge e;    // edge to update
+	};
+} PendingIndexUpdate;
+
+// compose update key for node 'n' under 'idx'
+// returns key length
+static size_t _NodeUpdateKey
+(
+	unsigned char *key,
+	const Index *idx,
+	const Node *n
+) {
+	EntityID id = ENTITY_GET_ID(n);
+
+	memcpy(key, &idx, sizeof(Index *));
+	memcpy(key + sizeof(Index *), &id, sizeof(EntityID));
+
+	return sizeof(Index *) + sizeof(EntityID);
+}
+
+// compose update key for edge 'e' under 'idx'
+// returns key length
+static size_t _EdgeUpdateKey
+(
+	unsigned char *key,
+	const Index *idx,
+	const Edge *e
+) {
+	EdgeIndexKey edge_key = {
+		.src_id   =  Edge_GetSrcNodeID(e),
+		.dest_id  =  Edge_GetDestNodeID(e),
+		.edge_id  =  ENTITY_GET_ID(e)
+	};
+
+	memcpy(key, &idx, sizeof(Index *));
+	memcpy(key + sizeof(Index *), &edge_key, sizeof(EdgeIndexKey));
+
+	return sizeof(Index *) + sizeof(EdgeIndexKey);
+}
+
+// get or create the update associated with 'key'
+// a later update to a document replaces any earlier one
+static PendingIndexUpdate *_GetUpdate
+(
+	IndexBuffer *buf,
+	unsigned char *key,
+	size_t key_len
+) {
+	PendingIndexUpdate *update = raxFind(buf->updates, key, key_len);
+	if(update == raxNotFound) {
+		update = rm_malloc(sizeof(PendingIndexUpdate));
+		raxInsert(buf->updates, key, key_len, update, NULL);
+	}
+	return update;
+}
+
+static void _ApplyNodeUpdate
+(
+	PendingIndexUpdate *update
+) {
+	Node *n = &update->n;
+
+	if(update->remove) {
+		Index_RemoveNode(update->idx, n);
+	} else {
+		// buffers are flushed prior to deletions
+		// an entity pending indexing is expected to be alive
+		ASSERT(!GraphEntity_IsDeleted((GraphEntity *)n));
+		Index_IndexNode(update->idx, n);
+	}
+}
+
+static void _ApplyEdgeUpdate
+(
+	PendingIndexUpdate *update
+) {
+	Edge *e = &update->e;
+
+	if(update->remove) {
+		Index_RemoveEdge(update->idx, e);
+	} else {
+		ASSERT(!GraphEntity_IsDeleted((GraphEntity *)e));
+		Index_IndexEdge(update->idx, e);
+	}
+}
+
+IndexBuffer *IndexBuffer_New(void) {
+	IndexBuffer *buf = rm_malloc(sizeof(IndexBuffer));
+	buf->updates = raxNew();
+	return buf;
+}
+
+void IndexBuffer_IndexNode
+(
+	IndexBuffer *buf,
+	Index *idx,
+	const Node *n
+) {
+	ASSERT(n   != NULL);
+	ASSERT(buf != NULL);
+	ASSERT(idx != NULL);
+
+	unsigned char key[UPDATE_KEY_MAX_LEN];
+	size_t key_len = _NodeUpdateKey(key, idx, n);
+
+	PendingIndexUpdate *update = _GetUpdate(buf, key, key_len);
+	update->n       =  *n;
+	update->idx     =  idx;
+	update->remove  =  false;
+}
+
+void IndexBuffer_IndexEdge
+(
+	IndexBuffer *buf,
+	Index *idx,
+	const Edge *e
+) {
+	ASSERT(e   != NULL);
+	ASSERT(buf != NULL);
+	ASSERT(idx != NULL);
+
+	unsigned char key[UPDATE_KEY_MAX_LEN];
+	size_t key_len = _EdgeUpdateKey(key, idx, e);
+
+	PendingIndexUpdate *update = _GetUpdate(buf, key, key_len);
+	update->e       =  *e;
+	update->idx     =  idx;
+	update->remove  =  false;
+}
+
+void IndexBuffer_RemoveNode
+(
+	IndexBuffer *buf,
+	Index *idx,
+	const Node *n
+) {
+	ASSERT(n   != NULL);
+	ASSERT(buf != NULL);
+	ASSERT(idx != NULL);
+
+	unsigned char key[UPDATE_KEY_MAX_LEN];
+	size_t key_len = _NodeUpdateKey(key, idx, n);
+
+	PendingIndexUpdate *update = _GetUpdate(buf, key, key_len);
+	update->n       =  *n;
+	update->idx     =  idx;
+	update->remove  =  true;
+}
+
+void IndexBuffer_RemoveEdge
+(
+	IndexBuffer *buf,
+	Index *idx,
+	const Edge *e
+) {
+	ASSERT(e   != NULL);
+	ASSERT(buf != NULL);
+	ASSERT(idx != NULL);
+
+	unsigned char key[UPDATE_KEY_MAX_LEN];
+	size_t key_len = _EdgeUpdateKey(key, idx, e);
+
+	PendingIndexUpdate *update = _GetUpdate(buf, key, key_len);
+	update->e       =  *e;
+	update->idx     =  idx;
+	update->remove  =  true;
+}
+
+uint64_t IndexBuffer_PendingCount
+(
+	const IndexBuffer *buf
+) {
+	ASSERT(buf != NULL);
+	return raxSize(buf->updates);
+}
+
+void IndexBuffer_Flush
+(
+	IndexBuffer *buf
+) {
+	ASSERT(buf != NULL);
+
+	if(raxSize(buf->updates) == 0) return;
+
+	// updates are sorted by key, which is prefixed by the index
+	// as such all updates to an index are applied consecutively
+	raxIterator it;
+	raxStart(&it, buf->updates);
+	raxSeek(&it, "^", NULL, 0);
+	while(raxNext(&it)) {
+		PendingIndexUpdate *update = it.data;
+		if(update->idx->entity_type == GETYPE_NODE) _ApplyNodeUpdate(update);
+		else _ApplyEdgeUpdate(update);
+	}
+	raxStop(&it);
+
+	raxFreeWithCallback(buf->updates, rm_free);
+	buf->updates = raxNew();
+}
+
+void IndexBuffer_Free
+(
+	IndexBuffer *buf
+) {
+	ASSERT(buf != NULL);
+
+	raxFreeWithCallback(buf->updates, rm_free);
+	rm_free(buf);
+}
+
@@ -0,0 +1,74 @@
+/*
+* Copyright 2018-2021 Redis Labs Ltd. and Contributors
+*
+* This file is available under the Redis Labs Source Available License Agreement
+*/
+
+#pragma once
+
+#include "index.h"
+#include "rax.h"
+
+// IndexBuffer collects index updates issued by a write query
+// updates are keyed by index and document, such that multiple updates
+// to the same entity collapse into a single document operation
+// buffered updates are applied in bulk, index by index, when flushed
+// the buffer is owned by a single query and only modified while the
+// graph's write lock is held
+typedef struct {
+	rax *updates;  // pending updates, keyed by index and document key
+} IndexBuffer;
+
+// create a new index buffer
+IndexBuffer *IndexBuffer_New(void);
+
+// buffer indexing of node 'n' under 'idx'
+void IndexBuffer_IndexNode
+(
+	IndexBuffer *buf,  // buffer
+	Index *idx,        // index to update
+	const Node *n      // node to index
+);
+
+// buffer indexing of edge 'e' under 'idx'
+void IndexBuffer_IndexEdge
+(
+	IndexBuffer *buf,  // buffer
+	Index *idx,        // index to update
+	const Edge *e      // edge to index
+);
+
+// buffer removal of node 'n' from 'idx'
+void IndexBuffer_RemoveNode
+(
+	IndexBuffer *buf,  // buffer
+	Index *idx,        // index to update
+	const Node *n      // node to remove
+);
+
+// buffer removal of edge 'e' from 'idx'
+void IndexBuffer_RemoveEdge
+(
+	IndexBuffer *buf,  // buffer
+	Index *idx,        // index to update
+	const Edge *e      // edge to remove
+);
+
+// returns number of buffered updates
+uint64_t IndexBuffer_PendingCount
+(
+	const IndexBuffer *buf
+);
+
+// apply all buffered updates and clear buffer
+void IndexBuffer_Flush
+(
+	IndexBuffer *buf
+);
+
+// free buffer, discarding any buffered updates
+void IndexBuffer_Free
+(
+	IndexBuffer *buf
+);
+
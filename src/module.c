@@ -27,6 +27,7 @@
 #include "configuration/reconf_handler.h"
 #include "serializers/graphcontext_type.h"
 #include "arithmetic/arithmetic_expression.h"
+#include "execution_plan/ops/op_degree_count.h"
 
 //------------------------------------------------------------------------------
 // Minimal supported Redis version
@@ -40,6 +41,7 @@
 //------------------------------------------------------------------------------
 GraphContext **graphs_in_keyspace;  // Global array tracking all extant GraphContexts.
 bool process_is_child;              // Flag indicating whether the running process is a child.
+bool rdb_serves_replicas;           // Flag indicating the RDB being saved is sent to replicas.
 
 extern CommandCtx **command_ctxs;
 
@@ -59,6 +61,7 @@ static int _RegisterDataTypes(RedisModuleCtx *ctx) {
 static void _PrepareModuleGlobals(RedisModuleCtx *ctx, RedisModuleString **argv, int argc) {
 	graphs_in_keyspace = array_new(GraphContext *, 1);
 	process_is_child = false;
+	rdb_serves_replicas = false;
 }
 
 static int GraphBLAS_Init(RedisModuleCtx *ctx) {
@@ -86,6 +89,9 @@ int RedisModule_OnLoad(RedisModuleCtx *ctx, RedisModuleString **argv, int argc)
 	int res = GraphBLAS_Init(ctx);
 	if(res != REDISMODULE_OK) return res;
 
+	// GraphBLAS operators shared by queries
+	if(!DegreeCountOp_Init()) return REDISMODULE_ERR;
+
 	// validate minimum redis-server version
 	if(!Redis_Version_GreaterOrEqual(MIN_REDIS_VERION_MAJOR,
 									 MIN_REDIS_VERION_MINOR, MIN_REDIS_VERION_PATCH)) {
@@ -15,6 +15,7 @@
 #include "configuration/config.h"
 #include "serializers/graphmeta_type.h"
 #include "serializers/graphcontext_type.h"
+#include "execution_plan/ops/op_degree_count.h"
 
 // indicates the possibility of half-baked graphs in the keyspace
 #define INTERMEDIATE_GRAPHS (aux_field_counter > 0)
@@ -23,6 +24,8 @@
 extern GraphContext **graphs_in_keyspace;
 // flag indicating whether the running process is a child
 extern bool process_is_child;
+// flag indicating the RDB being saved is sent to replicas
+extern bool rdb_serves_replicas;
 // graphContext type as it is registered at Redis
 extern RedisModuleType *GraphContextRedisModuleType;
 // graph meta keys type as it is registered at Redis
@@ -209,6 +212,28 @@ static bool _IsEventPersistenceEnd(RedisModuleEvent eid, uint64_t subevent) {
 		   );
 }
 
+// Checks if replicas await the RDB about to be saved
+// in which case the RDB is generated for replication rather than backup.
+static bool _ReplicasAwaitRDB(RedisModuleCtx *ctx) {
+	if(!RedisModule_GetServerInfo) return false;
+
+	bool await = false;
+	RedisModuleServerInfoData *info = RedisModule_GetServerInfo(ctx,
+			"replication");
+	long long replica_count = RedisModule_ServerInfoGetFieldSigned(info,
+			"connected_slaves", NULL);
+
+	for(long long i = 0; i < replica_count && !await; i++) {
+		char field[32];
+		sprintf(field, "slave%lld", i);
+		const char *replica = RedisModule_ServerInfoGetFieldC(info, field);
+		await = (replica != NULL && strstr(replica, "state=wait_bgsave"));
+	}
+
+	RedisModule_FreeServerInfo(ctx, info);
+	return await;
+}
+
 // server persistence event handler
 static void _PersistenceEventHandler(RedisModuleCtx *ctx, RedisModuleEvent eid,
 		uint64_t subevent, void *data) {
@@ -231,8 +256,13 @@ static void _PersistenceEventHandler(RedisModuleCtx *ctx, RedisModuleEvent eid,
 	}
 
 	if(_IsEventPersistenceStart(eid, subevent)) {
+		// SAVE and AOF rewrites are never sent to replicas
+		rdb_serves_replicas = (subevent ==
+				REDISMODULE_SUBEVENT_PERSISTENCE_RDB_START &&
+				_ReplicasAwaitRDB(ctx));
 		_CreateKeySpaceMetaKeys(ctx);
 	} else if(_IsEventPersistenceEnd(eid, subevent)) {
+		rdb_serves_replicas = false;
 		_ClearKeySpaceMetaKeys(ctx, false);
 	}
 }
@@ -242,6 +272,8 @@ static void _ShutdownEventHandler(RedisModuleCtx *ctx, RedisModuleEvent eid, uin
 		void *data) {
 	// Stop threads before finalize GraphBLAS.
 	ThreadPools_Destroy();
+	// Free shared GraphBLAS operators.
+	DegreeCountOp_Finalize();
 	// Server is shutting down, finalize GraphBLAS.
 	GrB_finalize();
 }
@@ -0,0 +1,270 @@
+/*
+* Copyright 2018-2021 Redis Labs Ltd. and Contributors
+*
+* This file is available under the Redis Labs Source Available License Agreement
+*/
+
+#include "proc_algo_utils.h"
+#include "../RG.h"
+#include "../util/arr.h"
+#include "../query_ctx.h"
+#include "../util/rmalloc.h"
+#include "../graph/graphcontext.h"
+
+// retrieve the content of 'm'
+// returns true if the content was materialized into a new matrix
+// otherwise 'm's main matrix is returned as is, avoiding a copy
+static bool _ResolveMatrix
+(
+	RG_Matrix m,
+	GrB_Matrix *A
+) {
+	GrB_Info   info;
+	GrB_Index  dp_nvals;
+	GrB_Index  dm_nvals;
+
+	UNUSED(info);
+
+	info = GrB_Matrix_nvals(&dp_nvals, RG_MATRIX_DELTA_PLUS(m));
+	ASSERT(info == GrB_SUCCESS);
+	info = GrB_Matrix_nvals(&dm_nvals, RG_MATRIX_DELTA_MINUS(m));
+	ASSERT(info == GrB_SUCCESS);
+
+	if(dp_nvals == 0 && dm_nvals == 0) {
+		*A = RG_MATRIX_M(m);
+		return false;
+	}
+
+	info = RG_Matrix_export(A, m);
+	ASSERT(info == GrB_SUCCESS);
+	return true;
+}
+
+// populate V with every node in the graph
+static void _AllNodes
+(
+	const Graph *g,
+	GrB_Vector V
+) {
+	GrB_Info    info;
+	NodeID      id;
+	GrB_Index   n       =  0;
+	GrB_Scalar  x       =  NULL;
+	GrB_Index   *ids    =  rm_malloc(sizeof(GrB_Index) * Graph_NodeCount(g));
+
+	UNUSED(info);
+
+	DataBlockIterator *it = Graph_ScanNodes(g);
+	while(DataBlockIterator_Next(it, &id) != NULL) ids[n++] = id;
+	DataBlockIterator_Free(it);
+
+	info = GrB_Scalar_new(&x, GrB_BOOL);
+	ASSERT(info == GrB_SUCCESS);
+	info = GrB_Scalar_setElement_BOOL(x, true);
+	ASSERT(info == GrB_SUCCESS);
+
+	info = GxB_Vector_build_Scalar(V, ids, x, n);
+	ASSERT(info == GrB_SUCCESS);
+
+	GrB_free(&x);
+	rm_free(ids);
+}
+
+bool AlgoInput_ReadArgs
+(
+	const SIValue *args,
+	const char **label,
+	const char **relation
+) {
+	ASSERT(args     != NULL);
+	ASSERT(label    != NULL);
+	ASSERT(relation != NULL);
+
+	if(!(SI_TYPE(args[0]) & (T_STRING | T_NULL))) return false;
+	if(!(SI_TYPE(args[1]) & (T_STRING | T_NULL))) return false;
+
+	*label     =  SIValue_IsNull(args[0]) ? NULL : SI_STRINGVAL(args[0]);
+	*relation  =  SIValue_IsNull(args[1]) ? NULL : SI_STRINGVAL(args[1]);
+
+	return true;
+}
+
+bool AlgoInput_Init
+(
+	AlgoInput *input,
+	const char *label,
+	const char *relation
+) {
+	ASSERT(input != NULL);
+
+	GrB_Info      info;
+	GrB_Index     n;
+	Schema        *s   =  NULL;
+	RG_Matrix     R    =  NULL;
+	RG_Matrix     L    =  NULL;
+	GraphContext  *gc  =  QueryCtx_GetGraphCtx();
+	Graph         *g   =  gc->g;
+
+	UNUSED(info);
+
+	input->A      =  NULL;
+	input->V      =  NULL;
+	input->own_A  =  false;
+
+	if(relation != NULL) {
+		s = GraphContext_GetSchema(gc, relation, SCHEMA_EDGE);
+		if(s == NULL) return false;
+		R = Graph_GetRelationMatrix(g, Schema_GetID(s), false);
+	} else {
+		R = Graph_GetAdjacencyMatrix(g, false);
+	}
+
+	if(label != NULL) {
+		s = GraphContext_GetSchema(gc, label, SCHEMA_NODE);
+		if(s == NULL) return false;
+		L = Graph_GetLabelMatrix(g, Schema_GetID(s));
+	}
+
+	input->own_A = _ResolveMatrix(R, &input->A);
+
+	info = GrB_Matrix_nrows(&n, input->A);
+	ASSERT(info == GrB_SUCCESS);
+	info = GrB_Vector_new(&input->V, GrB_BOOL, n);
+	ASSERT(info == GrB_SUCCESS);
+
+	if(L != NULL) {
+		// labeled nodes reside on the label matrix diagonal
+		GrB_Matrix l;
+		bool own_l = _ResolveMatrix(L, &l);
+		info = GxB_Vector_diag(input->V, l, 0, NULL);
+		ASSERT(info == GrB_SUCCESS);
+		if(own_l) GrB_free(&l);
+	} else {
+		_AllNodes(g, input->V);
+	}
+
+	return true;
+}
+
+void AlgoInput_Free
+(
+	AlgoInput *input
+) {
+	ASSERT(input != NULL);
+
+	if(input->own_A) GrB_free(&input->A);
+	if(input->V) GrB_free(&input->V);
+
+	input->A = NULL;
+	input->V = NULL;
+}
+
+AlgoOutput *AlgoOutput_New
+(
+	GrB_Vector values,
+	const char **yield,
+	const char *value_name
+) {
+	ASSERT(yield      != NULL);
+	ASSERT(value_name != NULL);
+
+	GrB_Info info;
+	UNUSED(info);
+
+	AlgoOutput *out = rm_calloc(1, sizeof(AlgoOutput));
+	out->g       =  QueryCtx_GetGraph();
+	out->node    =  GE_NEW_NODE();
+	out->output  =  array_new(SIValue, 2);
+
+	int idx = 0;
+	for(uint i = 0; i < array_len(yield); i++) {
+		if(strcasecmp("node", yield[i]) == 0) {
+			out->yield_node = out->output + idx;
+			idx++;
+			continue;
+		}
+
+		if(strcasecmp(value_name, yield[i]) == 0) {
+			out->yield_value = out->output + idx;
+			idx++;
+			continue;
+		}
+	}
+
+	if(values == NULL) return out;
+
+	GrB_Type t;
+	info = GxB_Vector_type(&t, values);
+	ASSERT(info == GrB_SUCCESS);
+	info = GrB_Vector_nvals(&out->n, values);
+	ASSERT(info == GrB_SUCCESS);
+
+	out->fp   =  (t == GrB_FP64);
+	out->ids  =  rm_malloc(sizeof(GrB_Index) * out->n);
+
+	if(out->fp) {
+		out->values = rm_malloc(sizeof(double) * out->n);
+		info = GrB_Vector_extractTuples_FP64(out->ids, out->values, &out->n,
+				values);
+	} else {
+		out->values = rm_malloc(sizeof(int64_t) * out->n);
+		info = GrB_Vector_extractTuples_INT64(out->ids, out->values, &out->n,
+				values);
+	}
+	ASSERT(info == GrB_SUCCESS);
+
+	GrB_free(&values);
+
+	return out;
+}
+
+SIValue *AlgoOutput_Step
+(
+	AlgoOutput *out
+) {
+	ASSERT(out != NULL);
+
+	// depleted
+	if(out->i >= out->n) return NULL;
+
+	GrB_Index i = out->i++;
+
+	Graph_GetNode(out->g, out->ids[i], &out->node);
+	if(out->yield_node) *out->yield_node = SI_Node(&out->node);
+	if(out->yield_value) {
+		*out->yield_value = (out->fp)
+			? SI_DoubleVal(((double *)out->values)[i])
+			: SI_LongVal(((int64_t *)out->values)[i]);
+	}
+
+	return out->output;
+}
+
+void AlgoOutput_Free
+(
+	AlgoOutput *out
+) {
+	ASSERT(out != NULL);
+
+	array_free(out->output);
+	if(out->ids) rm_free(out->ids);
+	if(out->values) rm_free(out->values);
+	rm_free(out);
+}
+
+SIValue *Proc_AlgoOutputStep
+(
+	ProcedureCtx *ctx
+) {
+	ASSERT(ctx->privateData != NULL);
+	return AlgoOutput_Step(ctx->privateData);
+}
+
+ProcedureResult Proc_AlgoOutputFree
+(
+	ProcedureCtx *ctx
+) {
+	if(ctx->privateData) AlgoOutput_Free(ctx->privateData);
+	return PROCEDURE_OK;
+}
+
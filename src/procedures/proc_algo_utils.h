@@ -0,0 +1,94 @@
+/*
+* Copyright 2018-2021 Redis Labs Ltd. and Contributors
+*
+* This file is available under the Redis Labs Source Available License Agreement
+*/
+
+#pragma once
+
+#include "proc_ctx.h"
+#include "../graph/graph.h"
+#include "../../deps/GraphBLAS/Include/GraphBLAS.h"
+
+// graph an analytics procedure operates on
+typedef struct {
+	GrB_Matrix A;  // relationship matrix, n x n
+	GrB_Vector V;  // nodes considered by the procedure, boolean
+	bool own_A;    // A was materialized for the procedure and must be freed
+} AlgoInput;
+
+// reads the optional label and relationship type procedure arguments
+// from args[0] and args[1] respectively
+// returns false if either argument is neither a string nor NULL
+bool AlgoInput_ReadArgs
+(
+	const SIValue *args,   // procedure arguments
+	const char **label,    // [output] label, NULL if unspecified
+	const char **relation  // [output] relationship type, NULL if unspecified
+);
+
+// resolves the graph an analytics procedure operates on
+// 'label' restricts the graph to nodes of the given label, NULL for all nodes
+// 'relation' restricts the graph to edges of the given type, NULL for all edges
+// graph matrices are used as is, unless they hold pending changes
+// returns false if either 'label' or 'relation' doesn't exist
+bool AlgoInput_Init
+(
+	AlgoInput *input,     // input to initialize
+	const char *label,    // [optional] node label
+	const char *relation  // [optional] relationship type
+);
+
+void AlgoInput_Free
+(
+	AlgoInput *input
+);
+
+// streams the nodes of an analytics procedure's result
+// along with their computed value
+typedef struct {
+	Graph *g;              // graph
+	Node node;             // current node
+	GrB_Index i;           // current result
+	GrB_Index n;           // number of results
+	GrB_Index *ids;        // node IDs
+	void *values;          // node values, either int64_t or double
+	bool fp;               // values are of type double
+	SIValue *output;       // array with up to 2 entries [node, value]
+	SIValue *yield_node;   // yield node
+	SIValue *yield_value;  // yield value
+} AlgoOutput;
+
+// creates an output streaming the entries of 'values'
+// 'value_name' is the name values are yielded under
+// 'values' may be NULL, in which case nothing is streamed
+AlgoOutput *AlgoOutput_New
+(
+	GrB_Vector values,       // computed values, freed by the output
+	const char **yield,      // yield outputs
+	const char *value_name   // name of value output
+);
+
+// returns the next [node, value] result, NULL once depleted
+SIValue *AlgoOutput_Step
+(
+	AlgoOutput *out
+);
+
+void AlgoOutput_Free
+(
+	AlgoOutput *out
+);
+
+// step function of procedures streaming an AlgoOutput as their private data
+SIValue *Proc_AlgoOutputStep
+(
+	ProcedureCtx *ctx
+);
+
+// free function of procedures streaming an AlgoOutput as their private data
+ProcedureResult Proc_AlgoOutputFree
+(
+	ProcedureCtx *ctx
+);
+
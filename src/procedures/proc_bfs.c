@@ -89,7 +89,7 @@ static ProcedureResult Proc_BFS_Invoke
 
 	Node *source_node = args[0].ptrval;
 	int64_t max_level = args[1].longval;
-	const char *reltype = SIValue_IsNull(args[2]) ? NULL : args[2].stringval;
+	const char *reltype = SIValue_IsNull(args[2]) ? NULL : SI_STRINGVAL(args[2]);
 
 	// the BFS algorithm uses a level of 1 to indicate the source node
 	// if this value is not zero (unlimited), increment it by 1
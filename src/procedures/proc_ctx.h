@@ -25,6 +25,20 @@ typedef enum {
 	PROCEDURE_ERROR = (1 << 2),     // Whenever an error occurred.
 } ProcedureState;
 
+// Procedure capabilities, planner hints a procedure is able to honor.
+typedef enum {
+	PROCEDURE_CAP_NONE = 0,
+	PROCEDURE_CAP_LIMIT = (1 << 0),    // Yields no more than the required number of records.
+	PROCEDURE_CAP_TOPK = (1 << 1),     // Yields only the top required records by its order output.
+	PROCEDURE_CAP_ORDERED = (1 << 2),  // Yields records sorted by its order output.
+} ProcedureCapability;
+
+// Hints the planner passes to a procedure prior to its invocation.
+typedef struct {
+	uint limit;  // Max number of records consumed, UNLIMITED if unknown.
+	bool top_k;  // Consumer keeps the top 'limit' records by the procedure's order output.
+} ProcedureHints;
+
 // Procedure output
 typedef struct {
 	char *name;     // Name of output.
@@ -53,6 +67,10 @@ struct ProcedureCtx {
 	ProcInvoke Invoke;          //
 	ProcFree Free;              //
 	bool readOnly;              // Indicates if the procedure is able to mutate the graph.
+	ProcedureCapability caps;   // Planner hints the procedure honors.
+	const char *order_by;       // Output records are ranked by, NULL if unranked.
+	bool order_desc;            // Records are ranked in descending order.
+	ProcedureHints hints;       // Hints passed by the planner.
 };
 typedef struct ProcedureCtx ProcedureCtx;
 
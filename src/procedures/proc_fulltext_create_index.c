@@ -40,7 +40,7 @@ static ProcedureResult _validateIndexConfigMap(SIValue config) {
 
 	if(multi_config) {
 		GraphContext *gc = QueryCtx_GetGraphCtx();
-		Schema *s = GraphContext_GetSchema(gc, label.stringval, SCHEMA_NODE);
+		Schema *s = GraphContext_GetSchema(gc, SI_STRINGVAL(label), SCHEMA_NODE);
 		if(s && Schema_GetIndex(s, NULL, IDX_FULLTEXT)) {
 			ErrorCtx_SetError("Index already exists configuration can't be changed");
 			return PROCEDURE_ERR;
@@ -104,6 +104,7 @@ ProcedureResult Proc_FulltextCreateNodeIdxInvoke(ProcedureCtx *ctx,
 	// create full-text index
 	SIValue sw;
 	SIValue lang;
+	SIValue label_value;
 	int res               = INDEX_FAIL;
 	Index *idx            = NULL;
 	GraphContext *gc      = QueryCtx_GetGraphCtx();
@@ -113,16 +114,15 @@ ProcedureResult Proc_FulltextCreateNodeIdxInvoke(ProcedureCtx *ctx,
 	const SIValue *fields = args + 1; // skip index name
 
 	if(SI_TYPE(label_config) == T_STRING) {
-		label = label_config.stringval;
+		label = SI_STRINGVAL(label_config);
 	} else if(SI_TYPE(label_config) == T_MAP) {
-		SIValue label_value;
 		MAP_GET(label_config, "label", label_value);
-		label = label_value.stringval;
+		label = SI_STRINGVAL(label_value);
 	}
 
 	// introduce fields to index
 	for(uint i = 0; i < fields_count; i++) {
-		const char *field = fields[i].stringval;
+		const char *field = SI_STRINGVAL(fields[i]);
 		res = GraphContext_AddIndex(&idx, gc, SCHEMA_NODE, label, field,
 			IDX_FULLTEXT);
 	}
@@ -136,11 +136,11 @@ ProcedureResult Proc_FulltextCreateNodeIdxInvoke(ProcedureCtx *ctx,
 			idx->stopwords = array_new(char*, stopwords_count);
 			for (uint i = 0; i < stopwords_count; i++) {
 				SIValue stopword = SIArray_Get(sw, i);
-				array_append(idx->stopwords, rm_strdup(stopword.stringval));
+				array_append(idx->stopwords, rm_strdup(SI_STRINGVAL(stopword)));
 			}
 		}
 		if(lang_exists) {
-			idx->language = rm_strdup(lang.stringval);
+			idx->language = rm_strdup(SI_STRINGVAL(lang));
 		}
 	}
 
@@ -23,7 +23,7 @@ ProcedureResult Proc_FulltextDropIndexInvoke(ProcedureCtx *ctx,
 	if(array_len((SIValue *)args) != 1) return PROCEDURE_ERR;
 	if(!(SI_TYPE(args[0]) & T_STRING)) return PROCEDURE_ERR;
 
-	const char *label = args[0].stringval;
+	const char *label = SI_STRINGVAL(args[0]);
 	GraphContext *gc = QueryCtx_GetGraphCtx();
 	GraphContext_DeleteIndex(gc, SCHEMA_NODE, label, NULL, IDX_FULLTEXT);
 
@@ -68,8 +68,8 @@ ProcedureResult Proc_FulltextQueryNodeInvoke
 
 	// see if there's a full-text index for given label
 	char *err = NULL;
-	const char *label = args[0].stringval;
-	const char *query = args[1].stringval;
+	const char *label = SI_STRINGVAL(args[0]);
+	const char *query = SI_STRINGVAL(args[1]);
 
 	// get full-text index from schema
 	Schema *s = GraphContext_GetSchema(gc, label, SCHEMA_NODE);
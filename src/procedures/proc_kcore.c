@@ -0,0 +1,73 @@
+/*
+* Copyright 2018-2021 Redis Labs Ltd. and Contributors
+*
+* This file is available under the Redis Labs Source Available License Agreement
+*/
+
+#include "proc_kcore.h"
+#include "proc_algo_utils.h"
+#include "../RG.h"
+#include "../value.h"
+#include "../util/arr.h"
+#include "../algorithms/kcore.h"
+
+// CALL algo.kCore(NULL, NULL, 3)         YIELD node, degree
+// CALL algo.kCore('Person', NULL, 3)     YIELD node, degree
+// CALL algo.kCore(NULL, 'KNOWS', 3)      YIELD node, degree
+// CALL algo.kCore('Person', 'KNOWS', 3)  YIELD node, degree
+
+ProcedureResult Proc_KCoreInvoke
+(
+	ProcedureCtx *ctx,
+	const SIValue *args,
+	const char **yield
+) {
+	// expecting 3 arguments
+	if(array_len((SIValue *)args) != 3) return PROCEDURE_ERR;
+
+	// read arguments
+	const char *label     =  NULL;  // node filter
+	const char *relation  =  NULL;  // edge filter
+	if(!AlgoInput_ReadArgs(args, &label, &relation)) return PROCEDURE_ERR;
+
+	// arg2, k, must be a non-negative integer
+	if(SI_TYPE(args[2]) != T_INT64) return PROCEDURE_ERR;
+	int64_t k = args[2].longval;
+	if(k < 0) return PROCEDURE_ERR;
+
+	GrB_Info    info;
+	AlgoInput   input;
+	GrB_Vector  core = NULL;
+
+	UNUSED(info);
+
+	// unknown label or relation, nothing to compute
+	if(AlgoInput_Init(&input, label, relation)) {
+		info = KCore(&core, input.A, input.V, k);
+		ASSERT(info == GrB_SUCCESS);
+		AlgoInput_Free(&input);
+	}
+
+	ctx->privateData = AlgoOutput_New(core, yield, "degree");
+
+	return PROCEDURE_OK;
+}
+
+ProcedureCtx *Proc_KCoreCtx() {
+	void *privateData = NULL;
+	ProcedureOutput *outputs = array_new(ProcedureOutput, 2);
+	ProcedureOutput output_node = {.name = "node", .type = T_NODE};
+	ProcedureOutput output_degree = {.name = "degree", .type = T_INT64};
+	array_append(outputs, output_node);
+	array_append(outputs, output_degree);
+
+	ProcedureCtx *ctx = ProcCtxNew("algo.kCore",
+								   3,
+								   outputs,
+								   Proc_AlgoOutputStep,
+								   Proc_KCoreInvoke,
+								   Proc_AlgoOutputFree,
+								   privateData,
+								   true);
+	return ctx;
+}
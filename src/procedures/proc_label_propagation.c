@@ -0,0 +1,72 @@
+/*
+* Copyright 2018-2021 Redis Labs Ltd. and Contributors
+*
+* This file is available under the Redis Labs Source Available License Agreement
+*/
+
+#include "proc_label_propagation.h"
+#include "proc_algo_utils.h"
+#include "../RG.h"
+#include "../value.h"
+#include "../util/arr.h"
+#include "../algorithms/label_propagation.h"
+
+// maximum number of label propagation iterations
+#define LABEL_PROPAGATION_MAX_ITER 20
+
+// CALL algo.labelPropagation(NULL, NULL)         YIELD node, communityId
+// CALL algo.labelPropagation('Person', NULL)     YIELD node, communityId
+// CALL algo.labelPropagation(NULL, 'KNOWS')      YIELD node, communityId
+// CALL algo.labelPropagation('Person', 'KNOWS')  YIELD node, communityId
+
+ProcedureResult Proc_LabelPropagationInvoke
+(
+	ProcedureCtx *ctx,
+	const SIValue *args,
+	const char **yield
+) {
+	// expecting 2 arguments
+	if(array_len((SIValue *)args) != 2) return PROCEDURE_ERR;
+
+	// read arguments
+	const char *label     =  NULL;  // node filter
+	const char *relation  =  NULL;  // edge filter
+	if(!AlgoInput_ReadArgs(args, &label, &relation)) return PROCEDURE_ERR;
+
+	GrB_Info    info;
+	AlgoInput   input;
+	GrB_Vector  communities = NULL;
+
+	UNUSED(info);
+
+	// unknown label or relation, nothing to compute
+	if(AlgoInput_Init(&input, label, relation)) {
+		info = LabelPropagation(&communities, input.A, input.V,
+				LABEL_PROPAGATION_MAX_ITER);
+		ASSERT(info == GrB_SUCCESS);
+		AlgoInput_Free(&input);
+	}
+
+	ctx->privateData = AlgoOutput_New(communities, yield, "communityId");
+
+	return PROCEDURE_OK;
+}
+
+ProcedureCtx *Proc_LabelPropagationCtx() {
+	void *privateData = NULL;
+	ProcedureOutput *outputs = array_new(ProcedureOutput, 2);
+	ProcedureOutput output_node = {.name = "node", .type = T_NODE};
+	ProcedureOutput output_community = {.name = "communityId", .type = T_INT64};
+	array_append(outputs, output_node);
+	array_append(outputs, output_community);
+
+	ProcedureCtx *ctx = ProcCtxNew("algo.labelPropagation",
+								   2,
+								   outputs,
+								   Proc_AlgoOutputStep,
+								   Proc_LabelPropagationInvoke,
+								   Proc_AlgoOutputFree,
+								   privateData,
+								   true);
+	return ctx;
+}
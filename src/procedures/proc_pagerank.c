@@ -8,6 +8,7 @@
 #include "../RG.h"
 #include "../value.h"
 #include "../util/arr.h"
+#include "../ast/ast.h"
 #include "../query_ctx.h"
 #include "../util/rmalloc.h"
 #include "../graph/graphcontext.h"
@@ -69,8 +70,8 @@ ProcedureResult Proc_PagerankInvoke
 	// read arguments
 	const char *label = NULL;    // node filter
 	const char *relation = NULL; // edge filter
-	if(arg0_t == T_STRING) label = args[0].stringval;
-	if(arg1_t == T_STRING) relation = args[1].stringval;
+	if(arg0_t == T_STRING) label = SI_STRINGVAL(args[0]);
+	if(arg1_t == T_STRING) relation = SI_STRINGVAL(args[1]);
 
 	// pagerank config arguments
 	int iters;               // iterations performed
@@ -163,8 +164,14 @@ ProcedureResult Proc_PagerankInvoke
 	info = GrB_Matrix_nvals(&nvals, r);
 	ASSERT(info == GrB_SUCCESS);
 
-	if(nvals > 0) {
-		info = Pagerank(&ranking, r, itermax, tol, &iters);
+	// only the top ranked nodes are required when a limit is specified
+	GrB_Index top = n;
+	if(ctx->hints.limit != UNLIMITED && ctx->hints.limit < n) {
+		top = ctx->hints.limit;
+	}
+
+	if(nvals > 0 && top > 0) {
+		info = Pagerank(&ranking, r, top, itermax, tol, &iters);
 		ASSERT(info == GrB_SUCCESS);
 	}
 
@@ -175,7 +182,7 @@ ProcedureResult Proc_PagerankInvoke
 	}
 
 	// update context
-	pdata->n        =  n;
+	pdata->n        =  top;
 	pdata->mapping  =  mapping;
 	pdata->ranking  =  ranking;
 
@@ -235,6 +242,14 @@ ProcedureCtx *Proc_PagerankCtx() {
 								   Proc_PagerankFree,
 								   privateData,
 								   true);
+
+	// nodes are yielded in descending score order
+	// as such the top ranked nodes are the first nodes yielded
+	ctx->caps        =  PROCEDURE_CAP_LIMIT | PROCEDURE_CAP_TOPK |
+						PROCEDURE_CAP_ORDERED;
+	ctx->order_by    =  "score";
+	ctx->order_desc  =  true;
+
 	return ctx;
 }
 
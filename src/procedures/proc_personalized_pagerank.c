@@ -0,0 +1,121 @@
+/*
+* Copyright 2018-2021 Redis Labs Ltd. and Contributors
+*
+* This file is available under the Redis Labs Source Available License Agreement
+*/
+
+#include "proc_personalized_pagerank.h"
+#include "proc_algo_utils.h"
+#include "../RG.h"
+#include "../value.h"
+#include "../util/arr.h"
+#include "../util/rmalloc.h"
+#include "../datatypes/array.h"
+#include "../algorithms/personalized_pagerank.h"
+
+// personalized pagerank config
+#define PPR_DAMPING  0.85  // probability of following an edge
+#define PPR_TOL      1e-6  // tolerance
+#define PPR_MAX_ITER 100   // max iterations
+
+// CALL algo.personalizedPageRank(n, NULL, NULL)          YIELD node, score
+// CALL algo.personalizedPageRank([a, b], 'Page', NULL)   YIELD node, score
+// CALL algo.personalizedPageRank(n, NULL, 'LINKS')       YIELD node, score
+// CALL algo.personalizedPageRank([a, b], 'Page', 'LINKS') YIELD node, score
+
+// collect source nodes from 'sources', either a node or an array of nodes
+// sources which are not part of 'V' are discarded
+// returns false if 'sources' holds a value which isn't a node
+static bool _CollectSources
+(
+	SIValue sources,     // node or array of nodes
+	const GrB_Vector V,  // nodes considered
+	GrB_Index **ids      // [output] source node IDs
+) {
+	bool     in_v;
+	GrB_Info info;
+	uint32_t n = (SI_TYPE(sources) == T_ARRAY) ? SIArray_Length(sources) : 1;
+
+	*ids = array_new(GrB_Index, n);
+
+	for(uint32_t i = 0; i < n; i++) {
+		SIValue v = (SI_TYPE(sources) == T_ARRAY)
+			? SIArray_Get(sources, i)
+			: sources;
+		if(SI_TYPE(v) != T_NODE) return false;
+
+		// discard sources outside of the considered graph
+		GrB_Index id = ENTITY_GET_ID((Node *)v.ptrval);
+		info = GrB_Vector_extractElement_BOOL(&in_v, V, id);
+		if(info == GrB_SUCCESS) array_append(*ids, id);
+	}
+
+	return true;
+}
+
+ProcedureResult Proc_PersonalizedPagerankInvoke
+(
+	ProcedureCtx *ctx,
+	const SIValue *args,
+	const char **yield
+) {
+	// expecting 3 arguments
+	if(array_len((SIValue *)args) != 3) return PROCEDURE_ERR;
+
+	// arg0 is either a node or an array of nodes
+	if(!(SI_TYPE(args[0]) & (T_NODE | T_ARRAY))) return PROCEDURE_ERR;
+
+	// read arguments
+	const char *label     =  NULL;  // node filter
+	const char *relation  =  NULL;  // edge filter
+	if(!AlgoInput_ReadArgs(args + 1, &label, &relation)) return PROCEDURE_ERR;
+
+	GrB_Info    info;
+	AlgoInput   input;
+	GrB_Index   *sources  =  NULL;
+	GrB_Vector  ranks     =  NULL;
+
+	UNUSED(info);
+
+	// unknown label or relation, nothing to compute
+	if(AlgoInput_Init(&input, label, relation)) {
+		if(!_CollectSources(args[0], input.V, &sources)) {
+			array_free(sources);
+			AlgoInput_Free(&input);
+			return PROCEDURE_ERR;
+		}
+
+		// no walks without sources
+		if(array_len(sources) > 0) {
+			info = PersonalizedPageRank(&ranks, input.A, input.V, sources,
+					array_len(sources), PPR_DAMPING, PPR_TOL, PPR_MAX_ITER);
+			ASSERT(info == GrB_SUCCESS);
+		}
+
+		array_free(sources);
+		AlgoInput_Free(&input);
+	}
+
+	ctx->privateData = AlgoOutput_New(ranks, yield, "score");
+
+	return PROCEDURE_OK;
+}
+
+ProcedureCtx *Proc_PersonalizedPagerankCtx() {
+	void *privateData = NULL;
+	ProcedureOutput *outputs = array_new(ProcedureOutput, 2);
+	ProcedureOutput output_node = {.name = "node", .type = T_NODE};
+	ProcedureOutput output_score = {.name = "score", .type = T_DOUBLE};
+	array_append(outputs, output_node);
+	array_append(outputs, output_score);
+
+	ProcedureCtx *ctx = ProcCtxNew("algo.personalizedPageRank",
+								   3,
+								   outputs,
+								   Proc_AlgoOutputStep,
+								   Proc_PersonalizedPagerankInvoke,
+								   Proc_AlgoOutputFree,
+								   privateData,
+								   true);
+	return ctx;
+}
@@ -0,0 +1,68 @@
+/*
+* Copyright 2018-2021 Redis Labs Ltd. and Contributors
+*
+* This file is available under the Redis Labs Source Available License Agreement
+*/
+
+#include "proc_triangle_count.h"
+#include "proc_algo_utils.h"
+#include "../RG.h"
+#include "../value.h"
+#include "../util/arr.h"
+#include "../algorithms/triangle_count.h"
+
+// CALL algo.triangleCount(NULL, NULL)         YIELD node, triangles
+// CALL algo.triangleCount('Person', NULL)     YIELD node, triangles
+// CALL algo.triangleCount(NULL, 'KNOWS')      YIELD node, triangles
+// CALL algo.triangleCount('Person', 'KNOWS')  YIELD node, triangles
+
+ProcedureResult Proc_TriangleCountInvoke
+(
+	ProcedureCtx *ctx,
+	const SIValue *args,
+	const char **yield
+) {
+	// expecting 2 arguments
+	if(array_len((SIValue *)args) != 2) return PROCEDURE_ERR;
+
+	// read arguments
+	const char *label     =  NULL;  // node filter
+	const char *relation  =  NULL;  // edge filter
+	if(!AlgoInput_ReadArgs(args, &label, &relation)) return PROCEDURE_ERR;
+
+	GrB_Info    info;
+	AlgoInput   input;
+	GrB_Vector  triangles = NULL;
+
+	UNUSED(info);
+
+	// unknown label or relation, nothing to compute
+	if(AlgoInput_Init(&input, label, relation)) {
+		info = TriangleCount(&triangles, input.A, input.V);
+		ASSERT(info == GrB_SUCCESS);
+		AlgoInput_Free(&input);
+	}
+
+	ctx->privateData = AlgoOutput_New(triangles, yield, "triangles");
+
+	return PROCEDURE_OK;
+}
+
+ProcedureCtx *Proc_TriangleCountCtx() {
+	void *privateData = NULL;
+	ProcedureOutput *outputs = array_new(ProcedureOutput, 2);
+	ProcedureOutput output_node = {.name = "node", .type = T_NODE};
+	ProcedureOutput output_triangles = {.name = "triangles", .type = T_INT64};
+	array_append(outputs, output_node);
+	array_append(outputs, output_triangles);
+
+	ProcedureCtx *ctx = ProcCtxNew("algo.triangleCount",
+								   2,
+								   outputs,
+								   Proc_AlgoOutputStep,
+								   Proc_TriangleCountInvoke,
+								   Proc_AlgoOutputFree,
+								   privateData,
+								   true);
+	return ctx;
+}
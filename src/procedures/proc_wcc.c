@@ -0,0 +1,68 @@
+/*
+* Copyright 2018-2021 Redis Labs Ltd. and Contributors
+*
+* This file is available under the Redis Labs Source Available License Agreement
+*/
+
+#include "proc_wcc.h"
+#include "proc_algo_utils.h"
+#include "../RG.h"
+#include "../value.h"
+#include "../util/arr.h"
+#include "../algorithms/wcc.h"
+
+// CALL algo.WCC(NULL, NULL)           YIELD node, componentId
+// CALL algo.WCC('Person', NULL)       YIELD node, componentId
+// CALL algo.WCC(NULL, 'KNOWS')        YIELD node, componentId
+// CALL algo.WCC('Person', 'KNOWS')    YIELD node, componentId
+
+ProcedureResult Proc_WCCInvoke
+(
+	ProcedureCtx *ctx,
+	const SIValue *args,
+	const char **yield
+) {
+	// expecting 2 arguments
+	if(array_len((SIValue *)args) != 2) return PROCEDURE_ERR;
+
+	// read arguments
+	const char *label     =  NULL;  // node filter
+	const char *relation  =  NULL;  // edge filter
+	if(!AlgoInput_ReadArgs(args, &label, &relation)) return PROCEDURE_ERR;
+
+	GrB_Info    info;
+	AlgoInput   input;
+	GrB_Vector  components = NULL;
+
+	UNUSED(info);
+
+	// unknown label or relation, nothing to compute
+	if(AlgoInput_Init(&input, label, relation)) {
+		info = WCC(&components, input.A, input.V);
+		ASSERT(info == GrB_SUCCESS);
+		AlgoInput_Free(&input);
+	}
+
+	ctx->privateData = AlgoOutput_New(components, yield, "componentId");
+
+	return PROCEDURE_OK;
+}
+
+ProcedureCtx *Proc_WCCCtx() {
+	void *privateData = NULL;
+	ProcedureOutput *outputs = array_new(ProcedureOutput, 2);
+	ProcedureOutput output_node = {.name = "node", .type = T_NODE};
+	ProcedureOutput output_component = {.name = "componentId", .type = T_INT64};
+	array_append(outputs, output_node);
+	array_append(outputs, output_component);
+
+	ProcedureCtx *ctx = ProcCtxNew("algo.WCC",
+								   2,
+								   outputs,
+								   Proc_AlgoOutputStep,
+								   Proc_WCCInvoke,
+								   Proc_AlgoOutputFree,
+								   privateData,
+								   true);
+	return ctx;
+}
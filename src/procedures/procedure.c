@@ -8,6 +8,7 @@
 #include "procedures.h"
 #include "rax.h"
 #include "../RG.h"
+#include "../ast/ast.h"
 #include "../util/arr.h"
 #include "../util/rmalloc.h"
 #include "../util/strutil.h"
@@ -35,6 +36,11 @@ void Proc_Register() {
 	// Register graph algorithms.
 	_procRegister("algo.BFS", Proc_BFS_Ctx);
 	_procRegister("algo.pageRank", Proc_PagerankCtx);
+	_procRegister("algo.WCC", Proc_WCCCtx);
+	_procRegister("algo.kCore", Proc_KCoreCtx);
+	_procRegister("algo.triangleCount", Proc_TriangleCountCtx);
+	_procRegister("algo.labelPropagation", Proc_LabelPropagationCtx);
+	_procRegister("algo.personalizedPageRank", Proc_PersonalizedPagerankCtx);
 
 	// Register FullText Search generator.
 	_procRegister("db.idx.fulltext.drop", Proc_FulltextDropIdxGen);
@@ -60,6 +66,11 @@ ProcedureCtx *ProcCtxNew(const char *name,
 	ctx->Invoke = fInvoke;
 	ctx->privateData = privateData;
 	ctx->readOnly = readOnly;
+	ctx->caps = PROCEDURE_CAP_NONE;
+	ctx->order_by = NULL;
+	ctx->order_desc = false;
+	ctx->hints.limit = UNLIMITED;
+	ctx->hints.top_k = false;
 	return ctx;
 }
 
@@ -145,6 +156,30 @@ bool Procedure_IsReadOnly(const ProcedureCtx *proc) {
 	return proc->readOnly;
 }
 
+bool Procedure_HasCapability(const ProcedureCtx *proc, ProcedureCapability cap) {
+	ASSERT(proc != NULL);
+	return (proc->caps & cap) == cap;
+}
+
+const char *Procedure_GetOrder(const ProcedureCtx *proc, bool *desc) {
+	ASSERT(proc != NULL);
+	ASSERT(desc != NULL);
+	*desc = proc->order_desc;
+	return proc->order_by;
+}
+
+void Procedure_SetHints(ProcedureCtx *proc, ProcedureHints hints) {
+	ASSERT(proc != NULL);
+	ASSERT(proc->state == PROCEDURE_NOT_INIT);
+
+	// procedure must be able to honor the hints
+	ASSERT(hints.limit == UNLIMITED ||
+		   Procedure_HasCapability(proc, (hints.top_k) ?
+			   PROCEDURE_CAP_TOPK : PROCEDURE_CAP_LIMIT));
+
+	proc->hints = hints;
+}
+
 void Proc_Free(ProcedureCtx *proc) {
 	if(!proc) return;
 	proc->Free(proc);
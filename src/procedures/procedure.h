@@ -49,3 +49,14 @@ bool Procedure_IsReadOnly(const ProcedureCtx *proc);
 
 // Returns the procedure's name.
 const char *Procedure_GetName(const ProcedureCtx *proc);
+
+// Returns true if the procedure honors the given planner hint.
+bool Procedure_HasCapability(const ProcedureCtx *proc, ProcedureCapability cap);
+
+/* Returns the name of the output procedure records are ranked by,
+ * NULL if records are unranked, 'desc' is set to the ranking direction. */
+const char *Procedure_GetOrder(const ProcedureCtx *proc, bool *desc);
+
+/* Passes planner hints to procedure, hints must be set prior to invocation
+ * and are only set if the procedure declared the matching capability. */
+void Procedure_SetHints(ProcedureCtx *proc, ProcedureHints hints);
@@ -7,9 +7,14 @@
 #pragma once
 
 #include "proc_bfs.h"
+#include "proc_wcc.h"
+#include "proc_kcore.h"
 #include "proc_labels.h"
 #include "proc_pagerank.h"
 #include "proc_relations.h"
+#include "proc_triangle_count.h"
+#include "proc_label_propagation.h"
+#include "proc_personalized_pagerank.h"
 #include "proc_procedures.h"
 #include "proc_list_indexes.h"
 #include "proc_property_keys.h"
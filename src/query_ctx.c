@@ -7,6 +7,7 @@
 #include "query_ctx.h"
 #include "RG.h"
 #include "errors.h"
+#include "util/cron.h"
 #include "util/simple_timer.h"
 #include "arithmetic/arithmetic_expression.h"
 #include "serializers/graphcontext_type.h"
@@ -16,12 +17,24 @@ extern RedisModuleType *GraphContextRedisModuleType;
 
 pthread_key_t _tlsQueryCtxKey;  // Thread local storage query context key.
 
+// group commit state, owned by the thread executing the group
+typedef struct {
+	GraphContext *gc;           // graph written to
+	RedisModuleCtx *redis_ctx;  // thread safe context holding the GIL
+	RedisModuleKey *key;        // graph key opened for writing
+} GroupCommit;
+
+static __thread GroupCommit *_group_commit = NULL;
+
 // retrieve or instantiate new QueryCtx
 static inline QueryCtx *_QueryCtx_GetCreateCtx(void) {
 	QueryCtx *ctx = pthread_getspecific(_tlsQueryCtxKey);
 	if(!ctx) {
 		// Set a new thread-local QueryCtx if one has not been created.
 		ctx = rm_calloc(1, sizeof(QueryCtx));
+		ctx->internal_exec_ctx.status = rm_malloc(sizeof(QueryStatus));
+		ctx->internal_exec_ctx.status->state = QUERY_ACTIVE;
+		ctx->internal_exec_ctx.status->ref_count = 1;
 		pthread_setspecific(_tlsQueryCtxKey, ctx);
 	}
 	return ctx;
@@ -63,6 +76,8 @@ void QueryCtx_SetGlobalExecutionCtx(CommandCtx *cmd_ctx) {
 	QueryCtx *ctx = _QueryCtx_GetCreateCtx();
 	ctx->gc = CommandCtx_GetGraphContext(cmd_ctx);
 	ctx->query_data.query = CommandCtx_GetQuery(cmd_ctx);
+	ctx->query_data.binary_params = CommandCtx_GetBinaryParams(cmd_ctx,
+			&ctx->query_data.binary_params_len);
 	ctx->global_exec_ctx.bc = CommandCtx_GetBlockingClient(cmd_ctx);
 	ctx->global_exec_ctx.redis_ctx = CommandCtx_GetRedisCtx(cmd_ctx);
 	ctx->global_exec_ctx.command_name = CommandCtx_GetCommandName(cmd_ctx);
@@ -136,6 +151,23 @@ ResultSetStatistics *QueryCtx_GetResultSetStatistics(void) {
 	return stats;
 }
 
+IndexBuffer *QueryCtx_GetIndexBuffer(void) {
+	QueryCtx *ctx = _QueryCtx_GetCreateCtx();
+	IndexBuffer *buf = ctx->internal_exec_ctx.index_buffer;
+	if(buf == NULL) {
+		buf = IndexBuffer_New();
+		ctx->internal_exec_ctx.index_buffer = buf;
+	}
+	return buf;
+}
+
+void QueryCtx_FlushIndexBuffer(void) {
+	QueryCtx *ctx = _QueryCtx_GetCtx();
+	if(ctx == NULL || ctx->internal_exec_ctx.index_buffer == NULL) return;
+
+	IndexBuffer_Flush(ctx->internal_exec_ctx.index_buffer);
+}
+
 void QueryCtx_PrintQuery(void) {
 	QueryCtx *ctx = _QueryCtx_GetCreateCtx();
 	printf("%s\n", ctx->query_data.query);
@@ -152,6 +184,26 @@ static void _QueryCtx_ThreadSafeContextUnlock(QueryCtx *ctx) {
 bool QueryCtx_LockForCommit(void) {
 	QueryCtx *ctx = _QueryCtx_GetCreateCtx();
 	if(ctx->internal_exec_ctx.locked_for_commit) return true;
+
+	// once committing, the query can no longer be cancelled
+	// a cancelled query discards its pending changes
+	QueryState expected = QUERY_ACTIVE;
+	QueryState *state = &ctx->internal_exec_ctx.status->state;
+	if(!__atomic_compare_exchange_n(state, &expected, QUERY_COMMITTING, false,
+				__ATOMIC_SEQ_CST, __ATOMIC_SEQ_CST) &&
+	   expected == QUERY_CANCELLED) {
+		ErrorCtx_SetError("Query timed out");
+		ErrorCtx_RaiseRuntimeException(NULL);
+		return false;
+	}
+
+	// locks are already held by the group commit
+	if(_group_commit != NULL) {
+		ASSERT(_group_commit->gc == ctx->gc);
+		ctx->internal_exec_ctx.key = _group_commit->key;
+		ctx->internal_exec_ctx.locked_for_commit = true;
+		return true;
+	}
 	// Lock GIL.
 	RedisModuleCtx *redis_ctx = ctx->global_exec_ctx.redis_ctx;
 	GraphContext *gc = ctx->gc;
@@ -196,16 +248,42 @@ static void _QueryCtx_UnlockCommit(QueryCtx *ctx) {
 	GraphContext *gc = ctx->gc;
 	RedisModuleCtx *redis_ctx = ctx->global_exec_ctx.redis_ctx;
 
+	// apply buffered index updates while the graph is still locked
+	if(ctx->internal_exec_ctx.index_buffer != NULL) {
+		IndexBuffer_Flush(ctx->internal_exec_ctx.index_buffer);
+	}
+
 	if(ResultSetStat_IndicateModification(ctx->internal_exec_ctx.result_set->stats)) {
 		// Replicate only in case of changes.
-		RedisModule_Replicate(redis_ctx, ctx->global_exec_ctx.command_name, "cc!", gc->graph_name,
-							  ctx->query_data.query);
+		if(ctx->query_data.binary_params != NULL) {
+			// binary parameters are replicated verbatim, their numbers are
+			// little-endian (see binary_params.h) so replicas decode them
+			// identically regardless of host byte order
+			RedisModule_Replicate(redis_ctx, ctx->global_exec_ctx.command_name,
+					"cccb!", gc->graph_name, ctx->query_data.query, "PARAMS",
+					ctx->query_data.binary_params,
+					ctx->query_data.binary_params_len);
+		} else {
+			RedisModule_Replicate(redis_ctx, ctx->global_exec_ctx.command_name, "cc!", gc->graph_name,
+								  ctx->query_data.query);
+		}
 	}
 
 	ctx->internal_exec_ctx.locked_for_commit = false;
+
+	// locks are released once the entire group is committed
+	if(_group_commit != NULL) return;
+
+	// check if pending matrix changes should be merged
+	// while the graph is still locked
+	bool flush = Graph_RequiresFlush(gc->g);
+
 	// Release graph R/W lock.
 	Graph_ReleaseLock(gc->g);
 
+	// merge pending changes in the background
+	if(flush) GraphContext_ScheduleFlush(gc);
+
 	// Close Key.
 	RedisModule_CloseKey(ctx->internal_exec_ctx.key);
 
@@ -241,6 +319,134 @@ void QueryCtx_ForceUnlockCommit() {
 	_QueryCtx_UnlockCommit(ctx);
 }
 
+bool QueryCtx_BeginGroupCommit(GraphContext *gc, int db) {
+	ASSERT(gc != NULL);
+	ASSERT(_group_commit == NULL);
+
+	// lock GIL
+	RedisModuleCtx *redis_ctx = RedisModule_GetThreadSafeContext(NULL);
+	RedisModule_ThreadSafeContextLock(redis_ctx);
+
+	// a detached context starts at DB 0, select the graph's database
+	int res = RedisModule_SelectDb(redis_ctx, db);
+	ASSERT(res == REDISMODULE_OK);
+	UNUSED(res);
+
+	// open key and verify
+	RedisModuleString *graphID = RedisModule_CreateString(redis_ctx,
+			gc->graph_name, strlen(gc->graph_name));
+	RedisModuleKey *key = RedisModule_OpenKey(redis_ctx, graphID,
+			REDISMODULE_WRITE);
+	RedisModule_FreeString(redis_ctx, graphID);
+
+	// in case the key no longer holds the graph
+	// each query reports the failure as it attempts to commit
+	if(RedisModule_KeyType(key) == REDISMODULE_KEYTYPE_EMPTY                  ||
+	   RedisModule_ModuleTypeGetType(key) != GraphContextRedisModuleType     ||
+	   RedisModule_ModuleTypeGetValue(key) != gc) {
+		RedisModule_CloseKey(key);
+		RedisModule_ThreadSafeContextUnlock(redis_ctx);
+		RedisModule_FreeThreadSafeContext(redis_ctx);
+		return false;
+	}
+
+	// acquire graph write lock
+	Graph_AcquireWriteLock(gc->g);
+
+	_group_commit = rm_malloc(sizeof(GroupCommit));
+	_group_commit->gc         =  gc;
+	_group_commit->key        =  key;
+	_group_commit->redis_ctx  =  redis_ctx;
+
+	return true;
+}
+
+bool QueryCtx_InGroupCommit(void) {
+	return (_group_commit != NULL);
+}
+
+void QueryCtx_EndGroupCommit(void) {
+	ASSERT(_group_commit != NULL);
+
+	GroupCommit *group = _group_commit;
+	_group_commit = NULL;
+
+	// check if pending matrix changes should be merged
+	// while the graph is still locked
+	GraphContext *gc = group->gc;
+	bool flush = Graph_RequiresFlush(gc->g);
+
+	// release graph R/W lock
+	Graph_ReleaseLock(gc->g);
+
+	// merge pending changes in the background
+	if(flush) GraphContext_ScheduleFlush(gc);
+
+	// close key and unlock GIL
+	RedisModule_CloseKey(group->key);
+	RedisModule_ThreadSafeContextUnlock(group->redis_ctx);
+	RedisModule_FreeThreadSafeContext(group->redis_ctx);
+
+	rm_free(group);
+}
+
+static void _QueryStatus_Release(QueryStatus *status) {
+	if(__atomic_sub_fetch(&status->ref_count, 1, __ATOMIC_SEQ_CST) == 0) {
+		rm_free(status);
+	}
+}
+
+// timeout handler, invoked on the cron thread
+// cancels the query, execution stops at the next cancellation check
+static void _QueryCtx_TimedOut(void *pdata) {
+	ASSERT(pdata != NULL);
+	QueryStatus *status = pdata;
+
+	// a query which started committing or completed runs to completion
+	QueryState expected = QUERY_ACTIVE;
+	__atomic_compare_exchange_n(&status->state, &expected, QUERY_CANCELLED,
+			false, __ATOMIC_SEQ_CST, __ATOMIC_SEQ_CST);
+
+	_QueryStatus_Release(status);
+}
+
+void QueryCtx_SetTimeout(uint timeout) {
+	QueryCtx *ctx = _QueryCtx_GetCreateCtx();
+	QueryStatus *status = ctx->internal_exec_ctx.status;
+
+	// the task holds its own reference to the query's status
+	// the query might be freed by the time the task executes
+	__atomic_add_fetch(&status->ref_count, 1, __ATOMIC_SEQ_CST);
+	Cron_AddTask(timeout, _QueryCtx_TimedOut, status);
+}
+
+bool QueryCtx_Complete(void) {
+	QueryCtx *ctx = _QueryCtx_GetCtx();
+	ASSERT(ctx != NULL);
+
+	QueryState expected = QUERY_ACTIVE;
+	QueryState *state = &ctx->internal_exec_ctx.status->state;
+	__atomic_compare_exchange_n(state, &expected, QUERY_COMPLETED, false,
+			__ATOMIC_SEQ_CST, __ATOMIC_SEQ_CST);
+
+	return (expected != QUERY_CANCELLED);
+}
+
+bool QueryCtx_Cancelled(void) {
+	QueryCtx *ctx = _QueryCtx_GetCtx();
+	if(ctx == NULL) return false;
+
+	QueryState state = __atomic_load_n(&ctx->internal_exec_ctx.status->state,
+			__ATOMIC_RELAXED);
+	return (state == QUERY_CANCELLED);
+}
+
+const QueryState *QueryCtx_GetState(void) {
+	QueryCtx *ctx = _QueryCtx_GetCtx();
+	if(ctx == NULL) return NULL;
+	return &ctx->internal_exec_ctx.status->state;
+}
+
 double QueryCtx_GetExecutionTime(void) {
 	QueryCtx *ctx = _QueryCtx_GetCtx();
 	ASSERT(ctx != NULL);
@@ -256,6 +462,16 @@ void QueryCtx_Free(void) {
 		ctx->query_data.params = NULL;
 	}
 
+	if(ctx->internal_exec_ctx.index_buffer) {
+		// buffer is flushed once the query releases its commit locks
+		ASSERT(IndexBuffer_PendingCount(ctx->internal_exec_ctx.index_buffer) == 0);
+		IndexBuffer_Free(ctx->internal_exec_ctx.index_buffer);
+		ctx->internal_exec_ctx.index_buffer = NULL;
+	}
+
+	// a pending timeout task retains the status
+	_QueryStatus_Release(ctx->internal_exec_ctx.status);
+
 	rm_free(ctx);
 	// NULL-set the context for reuse the next time this thread receives a query
 	QueryCtx_RemoveFromTLS();
@@ -8,10 +8,12 @@
 
 #include "ast/ast.h"
 #include "redismodule.h"
+#include "query_state.h"
 #include "util/rmalloc.h"
 #include "graph/graphcontext.h"
 #include "commands/cmd_context.h"
 #include "resultset/resultset.h"
+#include "index/index_buffer.h"
 #include "execution_plan/ops/op.h"
 #include <pthread.h>
 
@@ -21,14 +23,26 @@ typedef struct {
 	AST *ast;       // The scoped AST associated with this query.
 	rax *params;    // Query parameters.
 	const char *query;    // Query string.
+	const char *binary_params;  // Binary query parameters, if specified.
+	size_t binary_params_len;   // Length of binary query parameters.
 } QueryCtx_QueryData;
 
+// query execution status, shared by a query and its timeout task
+// such that a task firing after the query is freed doesn't access it
+// freed once released by both
+typedef struct {
+	QueryState state;    // execution state, accessed atomically
+	uint ref_count;      // number of holders, accessed atomically
+} QueryStatus;
+
 typedef struct {
 	double timer[2];            // Query execution time tracking.
+	QueryStatus *status;        // Query execution status.
 	RedisModuleKey *key;        // Saves an open key value, for later extraction and closing.
 	ResultSet *result_set;      // Save the execution result set.
 	bool locked_for_commit;     // Indicates if a call for QueryCtx_LockForCommit issued before.
 	OpBase *last_writer;        // The last writer operation which indicates the need for commit.
+	IndexBuffer *index_buffer;  // Index updates pending to be applied.
 } QueryCtx_InternalExecCtx;
 
 typedef struct {
@@ -88,6 +102,14 @@ RedisModuleCtx *QueryCtx_GetRedisModuleCtx(void);
 ResultSet *QueryCtx_GetResultSet(void);
 /* Retrive the resultset statistics. */
 ResultSetStatistics *QueryCtx_GetResultSetStatistics(void);
+/* Retrieve the query's index buffer, creating it if missing.
+ * Index updates issued by the query are buffered and applied in bulk. */
+IndexBuffer *QueryCtx_GetIndexBuffer(void);
+
+/* Apply the query's buffered index updates.
+ * Must be called while holding the graph write lock, prior to the query
+ * accessing an index it might have modified and prior to releasing the lock. */
+void QueryCtx_FlushIndexBuffer(void);
 
 /* Print the current query. */
 void QueryCtx_PrintQuery(void);
@@ -101,7 +123,7 @@ void QueryCtx_PrintQuery(void);
  * locks in this call or a previous call. In case that the locks are already locked, there will
  * be no attempt to lock them again.
  * This method returns false if the key has changed from the current graph,
- * and sets the relevant error message. */
+ * or if the query has been cancelled, and sets the relevant error message. */
 bool QueryCtx_LockForCommit(void);
 
 /* Starts an ulocking flow and notifies Redis after commiting changes in the graph and Redis keyspace.
@@ -115,6 +137,21 @@ bool QueryCtx_LockForCommit(void);
  * 4. Unlock GIL */
 void QueryCtx_UnlockCommit(OpBase *writer_op);
 
+/* Begins a group commit on the calling thread.
+ * The GIL, the graph key and the graph write lock are acquired once and held
+ * while a group of write queries executes back to back on this thread,
+ * each query's commit flow reuses the held locks rather than acquiring them.
+ * Callers are expected to bound the duration the locks are held for.
+ * 'db' is the database holding the graph key.
+ * Returns false if the key no longer holds the graph. */
+bool QueryCtx_BeginGroupCommit(GraphContext *gc, int db);
+
+/* Returns true if the calling thread is executing a group commit. */
+bool QueryCtx_InGroupCommit(void);
+
+/* Releases the locks held by the calling thread's group commit. */
+void QueryCtx_EndGroupCommit(void);
+
 /*
  * -------------------------FOR SAFETY ONLY---------------------------
  *
@@ -122,6 +159,24 @@ void QueryCtx_UnlockCommit(OpBase *writer_op);
  * some reason the last writer op has not invoked QueryCtx_UnlockCommit and Redis is locked.*/
 void QueryCtx_ForceUnlockCommit(void);
 
+/* Cancels the query once 'timeout' milliseconds elapse, unless it has
+ * started committing its changes or completed by then. */
+void QueryCtx_SetTimeout(uint timeout);
+
+/* Marks the query as completed, it can no longer be cancelled.
+ * Returns false if the query has been cancelled before completing. */
+bool QueryCtx_Complete(void);
+
+/* Returns true if this thread's query has been cancelled.
+ * Long running operations are expected to check for cancellation
+ * periodically and stop producing data once cancelled. */
+bool QueryCtx_Cancelled(void);
+
+/* Returns this thread's query execution state, NULL if there's no query.
+ * The state remains valid until the QueryCtx is freed, allowing
+ * hot paths to check for cancellation without a thread-local lookup. */
+const QueryState *QueryCtx_GetState(void);
+
 /* Compute and return elapsed query execution time. */
 double QueryCtx_GetExecutionTime(void);
 
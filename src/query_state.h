@@ -0,0 +1,17 @@
+/*
+* Copyright 2018-2021 Redis Labs Ltd. and Contributors
+*
+* This file is available under the Redis Labs Source Available License Agreement
+*/
+
+#pragma once
+
+// query execution state, used for cooperative cancellation
+// a query is either cancelled or committed, but never both
+typedef enum {
+	QUERY_ACTIVE = 0,   // query is executing
+	QUERY_CANCELLED,    // query was cancelled, e.g. timed out
+	QUERY_COMMITTING,   // query started committing changes, can't be cancelled
+	QUERY_COMPLETED,    // query finished executing, can't be cancelled
+} QueryState;
+
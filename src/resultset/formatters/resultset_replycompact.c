@@ -57,7 +57,7 @@ static void _ResultSet_CompactReplyWithSIValue(RedisModuleCtx *ctx, GraphContext
 
 	switch(SI_TYPE(v)) {
 	case T_STRING:
-		RedisModule_ReplyWithStringBuffer(ctx, v.stringval, strlen(v.stringval));
+		RedisModule_ReplyWithStringBuffer(ctx, SI_STRINGVAL(v), strlen(SI_STRINGVAL(v)));
 		return;
 	case T_INT64:
 		RedisModule_ReplyWithLongLong(ctx, v.longval);
@@ -254,7 +254,7 @@ static void _ResultSet_CompactReplyWithMap(RedisModuleCtx *ctx, GraphContext *gc
 	for(int i = 0; i < key_count; i++) {
 		Pair     p     =  m[i];
 		SIValue  val   =  p.val;
-		char     *key  =  p.key.stringval;
+		char     *key  =  SI_STRINGVAL(p.key);
 
 		// emit key
 		RedisModule_ReplyWithCString(ctx, key);
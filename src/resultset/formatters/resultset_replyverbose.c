@@ -23,7 +23,7 @@ static void _ResultSet_VerboseReplyWithSIValue(RedisModuleCtx *ctx, GraphContext
 											   const SIValue v) {
 	switch(SI_TYPE(v)) {
 	case T_STRING:
-		RedisModule_ReplyWithStringBuffer(ctx, v.stringval, strlen(v.stringval));
+		RedisModule_ReplyWithStringBuffer(ctx, SI_STRINGVAL(v), strlen(SI_STRINGVAL(v)));
 		return;
 	case T_INT64:
 		RedisModule_ReplyWithLongLong(ctx, v.longval);
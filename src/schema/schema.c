@@ -213,6 +213,7 @@ int Schema_RemoveIndex
 }
 
 // index node under all schema indices
+// the update is buffered and applied once the query flushes its index buffer
 void Schema_AddNodeToIndices
 (
 	const Schema *s,
@@ -221,16 +222,18 @@ void Schema_AddNodeToIndices
 	ASSERT(s != NULL);
 	ASSERT(n != NULL);
 
-	Index *idx = NULL;
+	Index        *idx  =  NULL;
+	IndexBuffer  *buf  =  QueryCtx_GetIndexBuffer();
 
 	idx = s->fulltextIdx;
-	if(idx) Index_IndexNode(idx, n);
+	if(idx) IndexBuffer_IndexNode(buf, idx, n);
 
 	idx = s->index;
-	if(idx) Index_IndexNode(idx, n);
+	if(idx) IndexBuffer_IndexNode(buf, idx, n);
 }
 
 // index edge under all schema indices
+// the update is buffered and applied once the query flushes its index buffer
 void Schema_AddEdgeToIndices
 (
 	const Schema *s,
@@ -239,13 +242,14 @@ void Schema_AddEdgeToIndices
 	ASSERT(s != NULL);
 	ASSERT(e != NULL);
 
-	Index *idx = NULL;
+	Index        *idx  =  NULL;
+	IndexBuffer  *buf  =  QueryCtx_GetIndexBuffer();
 
 	idx = s->fulltextIdx;
-	if(idx) Index_IndexEdge(idx, e);
+	if(idx) IndexBuffer_IndexEdge(buf, idx, e);
 
 	idx = s->index;
-	if(idx) Index_IndexEdge(idx, e);
+	if(idx) IndexBuffer_IndexEdge(buf, idx, e);
 }
 
 void Schema_Free
@@ -9,6 +9,7 @@
 #include "../util/arr.h"
 #include "../util/rmalloc.h"
 #include "../util/rax_extensions.h"
+#include "matrix_snapshot.h"
 
 GraphDecodeContext *GraphDecodeContext_New() {
 	GraphDecodeContext *ctx = rm_malloc(sizeof(GraphDecodeContext));
@@ -16,6 +17,7 @@ GraphDecodeContext *GraphDecodeContext_New() {
 	ctx->graph_keys_count = 1;
 	ctx->meta_keys = raxNew();
 	ctx->multi_edge = NULL;
+	ctx->snapshot = NULL;
 	return ctx;
 }
 
@@ -29,6 +31,11 @@ void GraphDecodeContext_Reset(GraphDecodeContext *ctx) {
 		array_free(ctx->multi_edge);
 		ctx->multi_edge = NULL;
 	}
+
+	if(ctx->snapshot) {
+		MatrixSnapshot_Free(ctx->snapshot);
+		ctx->snapshot = NULL;
+	}
 }
 
 void GraphDecodeContext_SetKeyCount(GraphDecodeContext *ctx, uint64_t key_count) {
@@ -76,6 +83,7 @@ bool GraphDecodeContext_GetProcessedKeyCount(const GraphDecodeContext *ctx) {
 void GraphDecodeContext_Free(GraphDecodeContext *ctx) {
 	if(ctx) {
 		raxFree(ctx->meta_keys);
+		if(ctx->snapshot) MatrixSnapshot_Free(ctx->snapshot);
 		rm_free(ctx);
 	}
 }
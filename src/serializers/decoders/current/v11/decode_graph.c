@@ -95,6 +95,15 @@ static GraphContext *_DecodeHeader
 		}
 
 		GraphDecodeContext_SetKeyCount(gc->decoding_context, key_number);
+
+		// load relationship matrices from snapshot if available
+		bool matrix_snapshot;
+		Config_Option_get(Config_MATRIX_SNAPSHOT, &matrix_snapshot);
+		if(matrix_snapshot) {
+			gc->decoding_context->snapshot = MatrixSnapshot_Open(gc->graph_name,
+					node_count, edge_count, relation_count,
+					gc->decoding_context->multi_edge);
+		}
 	}
 
 	// decode graph schemas
@@ -195,6 +204,21 @@ GraphContext *RdbLoadGraphContext_v11
 
 	if(GraphDecodeContext_Finished(gc->decoding_context)) {
 		Graph *g = gc->g;
+		RedisModuleCtx *ctx = RedisModule_GetContextFromIO(rdb);
+
+		// connect edges deferred to the matrix snapshot
+		MatrixSnapshot *snapshot = gc->decoding_context->snapshot;
+		if(snapshot != NULL) {
+			// flush pending connections prior to replacing matrices
+			Graph_ApplyAllPending(g, true);
+			if(MatrixSnapshot_Apply(snapshot, g)) {
+				RedisModule_Log(ctx, "notice",
+						"Loaded matrix snapshot of graph %s", gc->graph_name);
+			} else {
+				RedisModule_Log(ctx, "notice",
+						"Matrix snapshot of graph %s is stale, ignored", gc->graph_name);
+			}
+		}
 
 		// revert to default synchronization behavior
 		Graph_SetMatrixPolicy(g, SYNC_POLICY_FLUSH_RESIZE);
@@ -214,7 +238,6 @@ GraphContext *RdbLoadGraphContext_v11
 
 		GraphDecodeContext_Reset(gc->decoding_context);
 
-		RedisModuleCtx *ctx = RedisModule_GetContextFromIO(rdb);
 		RedisModule_Log(ctx, "notice", "Done decoding graph %s", gc->graph_name);
 	}
 
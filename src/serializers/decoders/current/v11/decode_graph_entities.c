@@ -85,7 +85,7 @@ static void _RdbLoadEntity
 	for(int i = 0; i < propCount; i++) {
 		Attribute_ID attr_id = RedisModule_LoadUnsigned(rdb);
 		SIValue attr_value = _RdbLoadSIValue(rdb);
-		GraphEntity_AddProperty(e, attr_id, attr_value);
+		GraphEntity_AddProperty(e, attr_id, attr_value, gc->g->string_pool);
 		SIValue_Free(attr_value);
 	}
 }
@@ -161,6 +161,8 @@ void RdbLoadEdges_v11
 	// } X N
 	// edge properties X N
 
+	MatrixSnapshot *snapshot = gc->decoding_context->snapshot;
+
 	// construct connections
 	for(uint64_t i = 0; i < edge_count; i++) {
 		Edge e;
@@ -168,9 +170,16 @@ void RdbLoadEdges_v11
 		NodeID    srcId     =  RedisModule_LoadUnsigned(rdb);
 		NodeID    destId    =  RedisModule_LoadUnsigned(rdb);
 		uint64_t  relation  =  RedisModule_LoadUnsigned(rdb);
-		Serializer_Graph_SetEdge(gc->g,
-				gc->decoding_context->multi_edge[relation], edgeId, srcId,
-				destId, relation, &e);
+		if(snapshot != NULL && MatrixSnapshot_Covers(snapshot, relation)) {
+			// edge is connected once the entire graph is decoded
+			Serializer_Graph_AllocateEdge(gc->g, edgeId, srcId, destId,
+					relation, &e);
+			MatrixSnapshot_AddEdge(snapshot, edgeId, srcId, destId, relation);
+		} else {
+			Serializer_Graph_SetEdge(gc->g,
+					gc->decoding_context->multi_edge[relation], edgeId, srcId,
+					destId, relation, &e);
+		}
 		_RdbLoadEntity(rdb, gc, (GraphEntity *)&e);
 
 		// index edge
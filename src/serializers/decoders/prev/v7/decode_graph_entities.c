@@ -60,7 +60,7 @@ static void _RdbLoadEntity(RedisModuleIO *rdb, GraphContext *gc, GraphEntity *e)
 	for(int i = 0; i < propCount; i++) {
 		Attribute_ID attr_id = RedisModule_LoadUnsigned(rdb);
 		SIValue attr_value = _RdbLoadSIValue(rdb);
-		GraphEntity_AddProperty(e, attr_id, attr_value);
+		GraphEntity_AddProperty(e, attr_id, attr_value, gc->g->string_pool);
 		SIValue_Free(attr_value);
 	}
 }
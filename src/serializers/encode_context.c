@@ -46,6 +46,7 @@ void GraphEncodeContext_Reset(GraphEncodeContext *ctx) {
 	ctx->multiple_edges_src_id = 0;
 	ctx->multiple_edges_dest_id = 0;
 	ctx->multiple_edges_array = NULL;
+	ctx->multiple_edges_count = 0;
 	ctx->current_relation_matrix_id = 0;
 	ctx->multiple_edges_current_index = 0;
 
@@ -170,20 +171,26 @@ void GraphEncodeContext_SetMatrixTupleIterator(GraphEncodeContext *ctx,
 	ctx->matrix_tuple_iterator = iter;
 }
 
-void GraphEncodeContext_SetMutipleEdgesArray(GraphEncodeContext *ctx, EdgeID *edges,
-											 uint current_index, NodeID src, NodeID dest) {
+void GraphEncodeContext_SetMutipleEdgesArray(GraphEncodeContext *ctx, const EdgeID *edges,
+											 uint edge_count, uint current_index, NodeID src, NodeID dest) {
 	ASSERT(ctx);
 	ctx->multiple_edges_array = edges;
+	ctx->multiple_edges_count = edge_count;
 	ctx->multiple_edges_current_index = current_index;
 	ctx->multiple_edges_src_id = src;
 	ctx->multiple_edges_dest_id = dest;
 }
 
-EdgeID *GraphEncodeContext_GetMultipleEdgesArray(const GraphEncodeContext *ctx) {
+const EdgeID *GraphEncodeContext_GetMultipleEdgesArray(const GraphEncodeContext *ctx) {
 	ASSERT(ctx);
 	return ctx->multiple_edges_array;
 }
 
+uint GraphEncodeContext_GetMultipleEdgesCount(const GraphEncodeContext *ctx) {
+	ASSERT(ctx);
+	return ctx->multiple_edges_count;
+}
+
 uint GraphEncodeContext_GetMultipleEdgesCurrentIndex(const GraphEncodeContext *ctx) {
 	ASSERT(ctx);
 	return ctx->multiple_edges_current_index;
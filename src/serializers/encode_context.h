@@ -47,7 +47,8 @@ typedef struct {
 	uint64_t vkey_entity_count;                 // Number of entities in a single virtual key.
 	NodeID multiple_edges_src_id;               // The current edges array sourc node id.
 	NodeID multiple_edges_dest_id;              // The current edges array destination node id.
-	EdgeID *multiple_edges_array;               // Multiple edges array, save in the context.
+	const EdgeID *multiple_edges_array;         // Multiple edges array, save in the context.
+	uint multiple_edges_count;                  // Number of edges in the multiple edges array.
 	uint current_relation_matrix_id;            // Current encoded relationship matrix.
 	uint multiple_edges_current_index;          // The current index of the encoded edges array.
 	DataBlockIterator *datablock_iterator;      // Datablock iterator to be saved in the context.
@@ -110,11 +111,14 @@ RG_MatrixTupleIter *GraphEncodeContext_GetMatrixTupleIterator(const GraphEncodeC
 void GraphEncodeContext_SetMatrixTupleIterator(GraphEncodeContext *ctx, RG_MatrixTupleIter *iter);
 
 // Sets a multiple edges array and the current index, for saving the state of multiple edges encoding.
-void GraphEncodeContext_SetMutipleEdgesArray(GraphEncodeContext *ctx, EdgeID *edges,
-											 uint current_index, NodeID src, NodeID dest);
+void GraphEncodeContext_SetMutipleEdgesArray(GraphEncodeContext *ctx, const EdgeID *edges,
+											 uint edge_count, uint current_index, NodeID src, NodeID dest);
 
 // Retrive the multiple edges array, to continue array of multiple edge encoding.
-EdgeID *GraphEncodeContext_GetMultipleEdgesArray(const GraphEncodeContext *ctx);
+const EdgeID *GraphEncodeContext_GetMultipleEdgesArray(const GraphEncodeContext *ctx);
+
+// Retrive the number of edges in the multiple edges array.
+uint GraphEncodeContext_GetMultipleEdgesCount(const GraphEncodeContext *ctx);
 
 // Retrive the multiple edges array current index, to continue array of multiple edge encoding.
 uint GraphEncodeContext_GetMultipleEdgesCurrentIndex(const GraphEncodeContext *ctx);
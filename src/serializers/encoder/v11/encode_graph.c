@@ -7,6 +7,7 @@
 #include "encode_v11.h"
 
 extern bool process_is_child; // Global variable declared in module.c
+extern bool rdb_serves_replicas; // Global variable declared in module.c
 
 // Determine whether we are in the context of a bgsave, in which case
 // the process is independent and should not acquire locks.
@@ -198,6 +199,18 @@ void RdbSaveGraph_v11
 	if(current_state == ENCODE_STATE_INIT) {
 		// inital state, populate encoding context header
 		GraphEncodeContext_InitHeader(gc->encoding_context, gc->graph_name, gc->g);
+
+		// save relationship matrices alongside the RDB
+		// replicas receive the RDB alone, a snapshot would only be written
+		// to the primary's disk while not describing its own RDB file
+		bool matrix_snapshot;
+		Config_Option_get(Config_MATRIX_SNAPSHOT, &matrix_snapshot);
+		matrix_snapshot = matrix_snapshot && !rdb_serves_replicas;
+		if(matrix_snapshot && !MatrixSnapshot_Save(gc)) {
+			RedisModuleCtx *ctx = RedisModule_GetContextFromIO(rdb);
+			RedisModule_Log(ctx, "warning",
+					"Failed saving matrix snapshot of graph %s", gc->graph_name);
+		}
 	}
 
 	// save header
@@ -53,7 +53,7 @@ static void _RdbSaveSIValue
 			RedisModule_SaveDouble(rdb, v->doubleval);
 			return;
 		case T_STRING:
-			RedisModule_SaveStringBuffer(rdb, v->stringval, strlen(v->stringval) + 1);
+			RedisModule_SaveStringBuffer(rdb, SI_STRINGVAL(*v), strlen(SI_STRINGVAL(*v)) + 1);
 			return;
 		case T_ARRAY:
 			_RdbSaveSIArray(rdb, *v);
@@ -243,14 +243,14 @@ static void _RdbSaveMultipleEdges
 	RedisModuleIO *rdb,                  // RDB IO.
 	GraphContext *gc,                    // Graph context.
 	uint r,                              // Edges relation id.
-	EdgeID *multiple_edges_array,        // Multiple edges array (passed by ref).
+	const EdgeID *multiple_edges_array,  // Multiple edges array.
+	uint edgeCount,                      // Number of edges in the array.
 	uint *multiple_edges_current_index,  // Current index of the array to start encoding from (passed by ref).
 	uint64_t *encoded_edges,             // Number of encoded edges in this phase (passed by ref).
 	uint64_t edges_to_encode,            // Allowed capacity for encoding edges.
 	NodeID src,                          // Edges source node id.
 	NodeID dest                          // Edges destination node id.
 ) {
-	uint edgeCount = array_len(multiple_edges_array);
 
 	// define function local variables from passed-by-reference parameters.
 	uint i = *multiple_edges_current_index;
@@ -313,14 +313,15 @@ void RdbSaveEdges_v11
 	if(!iter) RG_MatrixTupleIter_new(&iter, M);
 
 	// first, see if the last edges encoding stopped at multiple edges array
-	EdgeID *multiple_edges_array = GraphEncodeContext_GetMultipleEdgesArray(gc->encoding_context);
+	const EdgeID *multiple_edges_array = GraphEncodeContext_GetMultipleEdgesArray(gc->encoding_context);
+	uint multiple_edges_count = GraphEncodeContext_GetMultipleEdgesCount(gc->encoding_context);
 	NodeID src = GraphEncodeContext_GetMultipleEdgesSourceNode(gc->encoding_context);
 	NodeID dest = GraphEncodeContext_GetMultipleEdgesDestinationNode(gc->encoding_context);
 	uint multiple_edges_current_index = GraphEncodeContext_GetMultipleEdgesCurrentIndex(
 											gc->encoding_context);
 	if(multiple_edges_array) {
 		_RdbSaveMultipleEdges(rdb, gc, r, multiple_edges_array,
-							  &multiple_edges_current_index,
+							  multiple_edges_count, &multiple_edges_current_index,
 							  &encoded_edges, edges_to_encode, src, dest);
 		// if the multiple edges array filled the capacity of entities allowed
 		// to be encoded, finish encoding
@@ -329,6 +330,7 @@ void RdbSaveEdges_v11
 		} else {
 			// reset the multiple edges context for re-use
 			multiple_edges_array = NULL;
+			multiple_edges_count = 0;
 			multiple_edges_current_index = 0;
 		}
 	}
@@ -369,9 +371,14 @@ void RdbSaveEdges_v11
 			_RdbSaveEdge(rdb, gc->g, &e, r);
 			encoded_edges++;
 		} else {
-			multiple_edges_array = (EdgeID *)(CLEAR_MSB(edgeID));
+			// edges connecting src to dest are stored contiguously
+			// within the relation's multi-edge store
+			multiple_edges_array = MultiEdgeStore_GetEdges(
+					RG_MATRIX_MULTI_EDGE_STORE(M), CLEAR_MSB(edgeID),
+					&multiple_edges_count);
 			_RdbSaveMultipleEdges(rdb, gc, r, multiple_edges_array,
-								  &multiple_edges_current_index, &encoded_edges, edges_to_encode, src, dest);
+								  multiple_edges_count, &multiple_edges_current_index,
+								  &encoded_edges, edges_to_encode, src, dest);
 			// if the multiple edges array filled the capacity of entities
 			// allowed to be encoded, finish encoding
 			if(encoded_edges == edges_to_encode) {
@@ -379,6 +386,7 @@ void RdbSaveEdges_v11
 			} else {
 				// reset the multiple edges context for re-use
 				multiple_edges_array = NULL;
+				multiple_edges_count = 0;
 				multiple_edges_current_index = 0;
 			}
 		}
@@ -397,6 +405,6 @@ finish:
 	GraphEncodeContext_SetCurrentRelationID(gc->encoding_context, r);
 	GraphEncodeContext_SetMatrixTupleIterator(gc->encoding_context, iter);
 	GraphEncodeContext_SetMutipleEdgesArray(gc->encoding_context, multiple_edges_array,
-											multiple_edges_current_index, src, dest);
+											multiple_edges_count, multiple_edges_current_index, src, dest);
 }
 
@@ -133,19 +133,16 @@ static void _OptimizedSingleEdgeFormConnection
 	GraphStatistics_IncEdgeCount(&g->stats, r, 1);
 }
 
-// set a given edge in the graph - Used for deserialization of graph
-void Serializer_Graph_SetEdge
+// allocate a given edge without connecting it
+void Serializer_Graph_AllocateEdge
 (
 	Graph *g,
-	bool multi_edge,
 	EdgeID edge_id,
 	NodeID src,
 	NodeID dest,
 	int r,
 	Edge *e
 ) {
-	GrB_Info info;
-
 	Entity *en = DataBlock_AllocateItemOutOfOrder(g->edges, edge_id);
 	en->prop_count = 0;
 	en->properties = NULL;
@@ -154,6 +151,20 @@ void Serializer_Graph_SetEdge
 	e->relationID = r;
 	e->srcNodeID = src;
 	e->destNodeID = dest;
+}
+
+// set a given edge in the graph - Used for deserialization of graph
+void Serializer_Graph_SetEdge
+(
+	Graph *g,
+	bool multi_edge,
+	EdgeID edge_id,
+	NodeID src,
+	NodeID dest,
+	int r,
+	Edge *e
+) {
+	Serializer_Graph_AllocateEdge(g, edge_id, src, dest, r, e);
 
 	if(multi_edge) {
 		Graph_FormConnection(g, src, dest, edge_id, r);
@@ -24,6 +24,17 @@ void Serializer_Graph_SetNodeLabels
 	Graph *g
 );
 
+// allocate a given edge in the graph, without connecting its endpoints
+void Serializer_Graph_AllocateEdge
+(
+	Graph *g,               // graph to add edge to
+	EdgeID edge_id,         // edge ID
+	NodeID src,             // edge source
+	NodeID dest,            // edge destination
+	int r,                  // edge relationship-type
+	Edge *e                 // pointer to edge
+);
+
 // set a given edge in the graph
 void Serializer_Graph_SetEdge
 (
@@ -0,0 +1,511 @@
+/*
+* Copyright 2018-2021 Redis Labs Ltd. and Contributors
+*
+* This file is available under the Redis Labs Source Available License Agreement
+*/
+
+#include "matrix_snapshot.h"
+#include "../RG.h"
+#include "xxhash.h"
+#include "../util/arr.h"
+#include "../util/rmalloc.h"
+#include "../graph/rg_matrix/rg_matrix_iter.h"
+#include <stdio.h>
+#include <fcntl.h>
+#include <limits.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+// snapshot file extension
+#define MATRIX_SNAPSHOT_EXT ".rgsnap"
+
+// length of the "." separated graph name hash within the snapshot file name
+#define MATRIX_SNAPSHOT_HASH_LEN 17
+
+// snapshot file signature, followed by format version
+#define MATRIX_SNAPSHOT_MAGIC "RGMSNAP1"
+
+// functions declerations - implemented in graph.c
+void Graph_FormConnection(Graph *g, NodeID src, NodeID dest, EdgeID edge_id, int r);
+
+// Snapshot file format:
+//  Header
+//  Relation entry X relation count
+//  Serialized relationship matrices
+typedef struct {
+	char magic[8];            // MATRIX_SNAPSHOT_MAGIC
+	uint64_t node_count;      // number of nodes in graph
+	uint64_t edge_count;      // number of edges in graph
+	uint64_t relation_count;  // number of relationship types
+	uint64_t edge_hash;       // combined hash of covered edges
+} SnapshotHeader;
+
+typedef struct {
+	uint64_t covered;     // relationship matrix is included in snapshot
+	uint64_t edge_count;  // number of edges of this relationship
+	uint64_t offset;      // serialized matrix offset within file
+	uint64_t size;        // serialized matrix size
+} SnapshotRelation;
+
+// an edge registered while decoding the graph
+typedef struct {
+	EdgeID id;
+	NodeID src;
+	NodeID dest;
+} SnapshotEdge;
+
+struct MatrixSnapshot {
+	const char *addr;                   // mapped snapshot file
+	size_t size;                        // mapped size
+	const SnapshotHeader *header;       // snapshot header
+	const SnapshotRelation *relations;  // snapshot relation entries
+	uint64_t edge_hash;                 // combined hash of registered edges
+	SnapshotEdge **edges;               // registered edges per relationship
+};
+
+// compose snapshot file path of graph 'graph_name'
+// snapshots are saved in the working directory, next to the RDB
+// returns false if path is too long
+static bool _SnapshotPath
+(
+	const char *graph_name,
+	char *path
+) {
+	size_t len = strlen(graph_name);
+	if(len + MATRIX_SNAPSHOT_HASH_LEN + sizeof(MATRIX_SNAPSHOT_EXT) +
+			sizeof(".tmp") > PATH_MAX) {
+		return false;
+	}
+
+	// graph names may contain characters which are invalid within a path
+	for(size_t i = 0; i < len; i++) {
+		char c = graph_name[i];
+		bool valid = (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z') ||
+			(c >= '0' && c <= '9') || c == '_' || c == '-';
+		path[i] = (valid) ? c : '_';
+	}
+
+	// replaced characters may collide names, e.g. "a:b" and "a_b"
+	// distinguish between such names by the hash of the original name
+	XXH64_hash_t hash = XXH64(graph_name, len, 0);
+	sprintf(path + len, ".%016llx%s", (unsigned long long)hash,
+			MATRIX_SNAPSHOT_EXT);
+
+	return true;
+}
+
+// hash of a single edge
+static inline uint64_t _EdgeHash
+(
+	EdgeID id,
+	NodeID src,
+	NodeID dest,
+	int r
+) {
+	uint64_t x[4] = {r, src, dest, id};
+	uint64_t h = 0;
+
+	// splitmix64 finalizer applied to each component
+	for(int i = 0; i < 4; i++) {
+		uint64_t z = (h ^ x[i]) + 0x9e3779b97f4a7c15ULL;
+		z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ULL;
+		z = (z ^ (z >> 27)) * 0x94d049bb133111ebULL;
+		h = z ^ (z >> 31);
+	}
+
+	return h;
+}
+
+// combined hash of relationship 'r' edges
+// edges are combined by addition, which is independent of order
+// returns false if 'R' holds multi-edge entries
+static bool _HashRelation
+(
+	RG_Matrix R,
+	int r,
+	uint64_t *hash,
+	uint64_t *edge_count
+) {
+	NodeID  src;
+	NodeID  dest;
+	EdgeID  id;
+	bool    depleted  =  false;
+	bool    single    =  true;
+
+	*hash = 0;
+	*edge_count = 0;
+
+	RG_MatrixTupleIter *it;
+	RG_MatrixTupleIter_new(&it, R);
+	while(single) {
+		RG_MatrixTupleIter_next(it, &src, &dest, &id, &depleted);
+		if(depleted) break;
+
+		single = SINGLE_EDGE(id);
+		*hash += _EdgeHash(id, src, dest, r);
+		(*edge_count)++;
+	}
+	RG_MatrixTupleIter_free(&it);
+
+	return single;
+}
+
+// write relationship 'r' matrix to 'f'
+// returns false if relationship isn't included in snapshot
+static bool _SaveRelation
+(
+	FILE *f,
+	Graph *g,
+	int r,
+	SnapshotRelation *relation,
+	uint64_t *hash
+) {
+	GrB_Info    info;
+	void        *blob;
+	GrB_Index   nvals;
+	GrB_Index   blob_size;
+	GrB_Matrix  m          =  NULL;
+	uint64_t    edge_count =  0;
+	RG_Matrix   R          =  Graph_GetRelationMatrix(g, r, false);
+
+	if(!_HashRelation(R, r, hash, &edge_count)) return false;
+
+	// serialize relationship matrix, including pending changes
+	info = RG_Matrix_export(&m, R);
+	ASSERT(info == GrB_SUCCESS);
+
+	info = GrB_Matrix_nvals(&nvals, m);
+	ASSERT(info == GrB_SUCCESS);
+
+	// matrix must hold exactly the encoded edges
+	if(nvals == edge_count) {
+		info = GxB_Matrix_serialize(&blob, &blob_size, m, NULL);
+	} else {
+		info = GrB_INVALID_VALUE;
+	}
+	GrB_Matrix_free(&m);
+
+	if(info != GrB_SUCCESS) return false;
+
+	bool written = (fwrite(blob, 1, blob_size, f) == blob_size);
+	rm_free(blob);
+	if(!written) return false;
+
+	relation->covered     =  true;
+	relation->edge_count  =  edge_count;
+	relation->size        =  blob_size;
+
+	return true;
+}
+
+bool MatrixSnapshot_Save
+(
+	GraphContext *gc
+) {
+	ASSERT(gc != NULL);
+
+	char path[PATH_MAX];
+	char tmp_path[PATH_MAX];
+	if(!_SnapshotPath(gc->graph_name, path)) return false;
+	sprintf(tmp_path, "%s.tmp", path);
+
+	Graph *g = gc->g;
+	const GraphEncodeHeader *encode_header = &gc->encoding_context->header;
+	uint relation_count = encode_header->relationship_matrix_count;
+
+	SnapshotHeader header;
+	memcpy(header.magic, MATRIX_SNAPSHOT_MAGIC, sizeof(header.magic));
+	header.node_count      =  encode_header->node_count;
+	header.edge_count      =  encode_header->edge_count;
+	header.relation_count  =  relation_count;
+	header.edge_hash       =  0;
+
+	SnapshotRelation *relations = rm_calloc(relation_count + 1,
+			sizeof(SnapshotRelation));
+
+	FILE *f = fopen(tmp_path, "wb");
+	if(f == NULL) {
+		rm_free(relations);
+		return false;
+	}
+
+	// header and relation entries are written last
+	uint64_t offset = sizeof(SnapshotHeader) +
+		sizeof(SnapshotRelation) * relation_count;
+	bool success = (fseek(f, offset, SEEK_SET) == 0);
+
+	for(uint r = 0; r < relation_count && success; r++) {
+		// multi-edge entries refer to the relationship's edge lists
+		if(encode_header->multi_edge[r]) continue;
+
+		uint64_t hash;
+		relations[r].offset = offset;
+		if(_SaveRelation(f, g, r, relations + r, &hash)) {
+			header.edge_hash += hash;
+			offset += relations[r].size;
+		} else {
+			// relationship isn't covered, discard partial writes
+			relations[r].offset = 0;
+			success = (fseek(f, offset, SEEK_SET) == 0);
+		}
+	}
+
+	success = success &&
+		fseek(f, 0, SEEK_SET) == 0 &&
+		fwrite(&header, sizeof(SnapshotHeader), 1, f) == 1 &&
+		fwrite(relations, sizeof(SnapshotRelation), relation_count, f) ==
+			relation_count;
+	success = (fclose(f) == 0) && success;
+
+	// replace previous snapshot atomically
+	if(success) success = (rename(tmp_path, path) == 0);
+	if(!success) remove(tmp_path);
+
+	rm_free(relations);
+	return success;
+}
+
+MatrixSnapshot *MatrixSnapshot_Open
+(
+	const char *graph_name,
+	uint64_t node_count,
+	uint64_t edge_count,
+	uint64_t relation_count,
+	const uint64_t *multi_edge
+) {
+	ASSERT(graph_name != NULL);
+
+	char path[PATH_MAX];
+	if(!_SnapshotPath(graph_name, path)) return NULL;
+
+	int fd = open(path, O_RDONLY);
+	if(fd == -1) return NULL;
+
+	struct stat st;
+	const char *addr = MAP_FAILED;
+	if(fstat(fd, &st) == 0 && st.st_size >= (off_t)sizeof(SnapshotHeader)) {
+		addr = mmap(NULL, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+	}
+	close(fd);
+	if(addr == MAP_FAILED) return NULL;
+
+	size_t size = st.st_size;
+	const SnapshotHeader *header = (const SnapshotHeader *)addr;
+	const SnapshotRelation *relations =
+		(const SnapshotRelation *)(addr + sizeof(SnapshotHeader));
+
+	//--------------------------------------------------------------------------
+	// validate snapshot describes the graph being decoded
+	//--------------------------------------------------------------------------
+
+	bool valid =
+		memcmp(header->magic, MATRIX_SNAPSHOT_MAGIC, sizeof(header->magic)) == 0 &&
+		header->node_count == node_count &&
+		header->edge_count == edge_count &&
+		header->relation_count == relation_count &&
+		(size - sizeof(SnapshotHeader)) / sizeof(SnapshotRelation) >=
+			relation_count;
+
+	for(uint64_t r = 0; r < relation_count && valid; r++) {
+		const SnapshotRelation *relation = relations + r;
+		if(!relation->covered) continue;
+		valid = !multi_edge[r] &&
+			relation->edge_count <= edge_count &&
+			relation->offset <= size &&
+			relation->size <= size - relation->offset;
+	}
+
+	if(!valid) {
+		munmap((void *)addr, size);
+		return NULL;
+	}
+
+	// matrices are read once all edges are decoded
+	madvise((void *)addr, size, MADV_WILLNEED);
+
+	MatrixSnapshot *snapshot = rm_malloc(sizeof(MatrixSnapshot));
+	snapshot->addr       =  addr;
+	snapshot->size       =  size;
+	snapshot->header     =  header;
+	snapshot->relations  =  relations;
+	snapshot->edge_hash  =  0;
+	snapshot->edges      =  rm_calloc(relation_count + 1, sizeof(SnapshotEdge *));
+
+	for(uint64_t r = 0; r < relation_count; r++) {
+		if(relations[r].covered) {
+			snapshot->edges[r] = array_new(SnapshotEdge, relations[r].edge_count);
+		}
+	}
+
+	return snapshot;
+}
+
+bool MatrixSnapshot_Covers
+(
+	const MatrixSnapshot *snapshot,
+	int r
+) {
+	ASSERT(snapshot != NULL);
+	ASSERT(r < snapshot->header->relation_count);
+
+	return snapshot->relations[r].covered;
+}
+
+void MatrixSnapshot_AddEdge
+(
+	MatrixSnapshot *snapshot,
+	EdgeID id,
+	NodeID src,
+	NodeID dest,
+	int r
+) {
+	ASSERT(snapshot != NULL);
+	ASSERT(MatrixSnapshot_Covers(snapshot, r));
+
+	// edges are retained in case the snapshot turns out to be stale
+	SnapshotEdge e = {.id = id, .src = src, .dest = dest};
+	array_append(snapshot->edges[r], e);
+	snapshot->edge_hash += _EdgeHash(id, src, dest, r);
+}
+
+// replace relationship 'r' matrix with 'm'
+// and introduce its entries to the adjacency matrix
+static void _LoadRelation
+(
+	Graph *g,
+	int r,
+	GrB_Matrix m
+) {
+	GrB_Info   info;
+	GrB_Index  n;
+	GrB_Index  nvals;
+	GrB_Matrix t    =  NULL;
+	RG_Matrix  R    =  Graph_GetRelationMatrix(g, r, false);
+	RG_Matrix  adj  =  Graph_GetAdjacencyMatrix(g, false);
+
+	UNUSED(info);
+
+	info = RG_Matrix_nrows(&n, R);
+	ASSERT(info == GrB_SUCCESS);
+	info = GrB_Matrix_nvals(&nvals, m);
+	ASSERT(info == GrB_SUCCESS);
+
+	// the transposed relation matrix is boolean, only its structure is
+	// copied from 'm' whose entries are edge IDs and multi-edge lists
+	info = GrB_Matrix_new(&t, GrB_BOOL, n, n);
+	ASSERT(info == GrB_SUCCESS);
+	info = GrB_Matrix_apply(t, NULL, NULL, GxB_ONE_BOOL, m, GrB_DESC_T0);
+	ASSERT(info == GrB_SUCCESS);
+
+	// rows represent source nodes, columns represent destination nodes
+	info = GrB_Matrix_assign_BOOL(RG_MATRIX_M(adj), m, NULL, true, GrB_ALL, n,
+			GrB_ALL, n, GrB_DESC_S);
+	ASSERT(info == GrB_SUCCESS);
+	info = GrB_Matrix_assign_BOOL(RG_MATRIX_TM(adj), t, NULL, true, GrB_ALL, n,
+			GrB_ALL, n, GrB_DESC_S);
+	ASSERT(info == GrB_SUCCESS);
+
+	info = RG_Matrix_replace(R, &m);
+	ASSERT(info == GrB_SUCCESS);
+	info = RG_Matrix_replace(RG_Matrix_getTranspose(R), &t);
+	ASSERT(info == GrB_SUCCESS);
+
+	GraphStatistics_IncEdgeCount(&g->stats, r, nvals);
+}
+
+bool MatrixSnapshot_Apply
+(
+	MatrixSnapshot *snapshot,
+	Graph *g
+) {
+	ASSERT(g        != NULL);
+	ASSERT(snapshot != NULL);
+
+	GrB_Info   info;
+	uint64_t   relation_count  =  snapshot->header->relation_count;
+	GrB_Matrix *matrices       =  rm_calloc(relation_count + 1, sizeof(GrB_Matrix));
+
+	// snapshot must describe the decoded edges
+	bool match = (snapshot->edge_hash == snapshot->header->edge_hash);
+
+	//--------------------------------------------------------------------------
+	// deserialize relationship matrices
+	//--------------------------------------------------------------------------
+
+	for(uint64_t r = 0; r < relation_count && match; r++) {
+		const SnapshotRelation *relation = snapshot->relations + r;
+		if(!relation->covered) continue;
+
+		match = (array_len(snapshot->edges[r]) == relation->edge_count);
+		if(!match) break;
+
+		GrB_Index n;
+		GrB_Index nvals;
+		RG_Matrix R = Graph_GetRelationMatrix(g, r, false);
+		RG_Matrix_nrows(&n, R);
+
+		info = GxB_Matrix_deserialize(matrices + r, GrB_UINT64,
+				snapshot->addr + relation->offset, relation->size, NULL);
+		match = (info == GrB_SUCCESS);
+		if(!match) break;
+
+		// saved matrix dimensions might differ from the decoded graph's
+		info = GrB_Matrix_resize(matrices[r], n, n);
+		match = (info == GrB_SUCCESS) &&
+			GrB_Matrix_nvals(&nvals, matrices[r]) == GrB_SUCCESS &&
+			nvals == relation->edge_count;
+	}
+
+	//--------------------------------------------------------------------------
+	// connect edges
+	//--------------------------------------------------------------------------
+
+	for(uint64_t r = 0; r < relation_count; r++) {
+		if(!snapshot->relations[r].covered) continue;
+
+		if(match) {
+			_LoadRelation(g, r, matrices[r]);
+		} else {
+			// stale snapshot, connect edges one by one
+			if(matrices[r] != NULL) GrB_Matrix_free(matrices + r);
+			SnapshotEdge *edges = snapshot->edges[r];
+			uint edge_count = array_len(edges);
+			for(uint i = 0; i < edge_count; i++) {
+				Graph_FormConnection(g, edges[i].src, edges[i].dest,
+						edges[i].id, r);
+			}
+		}
+
+		// registered edges are no longer required
+		array_free(snapshot->edges[r]);
+		snapshot->edges[r] = NULL;
+	}
+
+	if(match) {
+		RG_Matrix adj = Graph_GetAdjacencyMatrix(g, false);
+		info = GrB_wait(RG_MATRIX_M(adj), GrB_MATERIALIZE);
+		ASSERT(info == GrB_SUCCESS);
+		info = GrB_wait(RG_MATRIX_TM(adj), GrB_MATERIALIZE);
+		ASSERT(info == GrB_SUCCESS);
+	}
+
+	rm_free(matrices);
+	return match;
+}
+
+void MatrixSnapshot_Free
+(
+	MatrixSnapshot *snapshot
+) {
+	ASSERT(snapshot != NULL);
+
+	for(uint64_t r = 0; r < snapshot->header->relation_count; r++) {
+		if(snapshot->edges[r] != NULL) array_free(snapshot->edges[r]);
+	}
+	rm_free(snapshot->edges);
+
+	munmap((void *)snapshot->addr, snapshot->size);
+	rm_free(snapshot);
+}
+
@@ -0,0 +1,76 @@
+/*
+* Copyright 2018-2021 Redis Labs Ltd. and Contributors
+*
+* This file is available under the Redis Labs Source Available License Agreement
+*/
+
+#pragma once
+
+#include "../graph/graphcontext.h"
+
+// MatrixSnapshot is a file saved alongside the RDB, holding the graph's
+// relationship matrices in GraphBLAS serialized form
+// when the graph is decoded, the file is memory mapped and matrices are
+// deserialized straight from the mapping, rather than being populated
+// one edge at a time
+//
+// the snapshot is validated against the edges decoded from the RDB
+// if the two disagree, e.g. the snapshot is stale, edges are connected
+// in the regular way
+//
+// only relationship matrices which do not hold multi-edge entries
+// are included in the snapshot
+typedef struct MatrixSnapshot MatrixSnapshot;
+
+// save a snapshot of 'gc' relationship matrices
+// returns false if snapshot could not be saved
+bool MatrixSnapshot_Save
+(
+	GraphContext *gc
+);
+
+// open the snapshot of graph 'graph_name'
+// returns NULL if no snapshot exists or if it doesn't match the graph
+// being decoded
+MatrixSnapshot *MatrixSnapshot_Open
+(
+	const char *graph_name,     // graph name
+	uint64_t node_count,        // number of nodes being decoded
+	uint64_t edge_count,        // number of edges being decoded
+	uint64_t relation_count,    // number of relationship types
+	const uint64_t *multi_edge  // relationship types holding multi-edges
+);
+
+// returns true if relationship 'r' is covered by the snapshot
+// connections of covered relationships are made by MatrixSnapshot_Apply
+bool MatrixSnapshot_Covers
+(
+	const MatrixSnapshot *snapshot,
+	int r
+);
+
+// register a decoded edge of a covered relationship
+void MatrixSnapshot_AddEdge
+(
+	MatrixSnapshot *snapshot,
+	EdgeID id,
+	NodeID src,
+	NodeID dest,
+	int r
+);
+
+// connect all registered edges, either by loading the snapshot's matrices
+// or, if the snapshot doesn't match the registered edges, one by one
+// returns true if the snapshot's matrices were loaded
+bool MatrixSnapshot_Apply
+(
+	MatrixSnapshot *snapshot,
+	Graph *g
+);
+
+// unmap and free snapshot
+void MatrixSnapshot_Free
+(
+	MatrixSnapshot *snapshot
+);
+
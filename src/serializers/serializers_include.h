@@ -24,6 +24,8 @@
 #include "../datatypes/array.h"
 // Graph extentions.
 #include "graph_extensions.h"
+// Relationship matrices snapshot.
+#include "matrix_snapshot.h"
 // Module configuration
 #include "../configuration/config.h"
 
@@ -20,7 +20,7 @@
 sds _JsonEncoder_SIValue(SIValue v, sds s);
 
 static inline sds _JsonEncoder_String(SIValue v, sds s) {
-	return sdscatfmt(s, "\"%s\"", v.stringval);
+	return sdscatfmt(s, "\"%s\"", SI_STRINGVAL(v));
 }
 
 static sds _JsonEncoder_Properties(const GraphEntity *ge, sds s) {
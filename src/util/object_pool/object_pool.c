@@ -129,6 +129,11 @@ void ObjectPool_DeleteItem(ObjectPool *pool, void *item) {
 	pool->itemCount--;
 }
 
+uint ObjectPool_ItemSize(const ObjectPool *pool) {
+	ASSERT(pool != NULL);
+	return pool->itemSize - HEADER_SIZE;
+}
+
 void ObjectPool_Free(ObjectPool *pool) {
 	for(uint i = 0; i < pool->blockCount; i++) Block_Free(pool->blocks[i]);
 
@@ -40,6 +40,9 @@ void *ObjectPool_NewItem(ObjectPool *pool);
 // Removes item from pool.
 void ObjectPool_DeleteItem(ObjectPool *pool, void *item);
 
+// Returns the size of a single item in bytes, as specified on creation.
+uint ObjectPool_ItemSize(const ObjectPool *pool);
+
 // Free pool.
 void ObjectPool_Free(ObjectPool *pool);
 
@@ -0,0 +1,198 @@
+/*
+* Copyright 2018-2021 Redis Labs Ltd. and Contributors
+*
+* This file is available under the Redis Labs Source Available License Agreement
+*/
+
+#include "string_pool.h"
+#include "RG.h"
+#include "xxhash.h"
+#include "rmalloc.h"
+#include <string.h>
+#include <stddef.h>
+
+// retrieve interned string header from string
+#define INTERNED_STRING(s) \
+	((InternedString *)((char *)(s) - offsetof(InternedString, str)))
+
+static inline uint32_t _StringPool_Hash
+(
+	const char *s,
+	size_t len
+) {
+	return (uint32_t)XXH64(s, len, 0);
+}
+
+// returns the bucket in which 'entry' should reside
+static inline uint64_t _StringPool_Bucket
+(
+	const StringPool *pool,
+	uint32_t hash
+) {
+	return hash & (pool->cap - 1);
+}
+
+// rehash all strings into a table of 'cap' buckets
+static void _StringPool_Resize
+(
+	StringPool *pool,
+	uint64_t cap
+) {
+	uint64_t old_cap = pool->cap;
+	InternedString **old_buckets = pool->buckets;
+
+	pool->cap = cap;
+	pool->buckets = rm_calloc(cap, sizeof(InternedString *));
+
+	for(uint64_t i = 0; i < old_cap; i++) {
+		InternedString *entry = old_buckets[i];
+		if(entry == NULL) continue;
+
+		uint64_t idx = _StringPool_Bucket(pool, entry->hash);
+		while(pool->buckets[idx] != NULL) idx = (idx + 1) & (cap - 1);
+		pool->buckets[idx] = entry;
+	}
+
+	rm_free(old_buckets);
+}
+
+// remove the entry at position 'idx'
+// entries following 'idx' are shifted back such that lookups
+// will not stop at the vacated bucket
+static void _StringPool_RemoveAt
+(
+	StringPool *pool,
+	uint64_t idx
+) {
+	uint64_t mask = pool->cap - 1;
+	uint64_t hole = idx;
+	uint64_t next = (idx + 1) & mask;
+
+	while(pool->buckets[next] != NULL) {
+		uint64_t home = _StringPool_Bucket(pool, pool->buckets[next]->hash);
+		// move entry into the hole if its home bucket isn't
+		// located cyclically within (hole, next]
+		if(((next - home) & mask) >= ((next - hole) & mask)) {
+			pool->buckets[hole] = pool->buckets[next];
+			hole = next;
+		}
+		next = (next + 1) & mask;
+	}
+
+	pool->buckets[hole] = NULL;
+	pool->count--;
+}
+
+StringPool *StringPool_New(void) {
+	StringPool *pool = rm_malloc(sizeof(StringPool));
+
+	pool->cap      =  STRING_POOL_MIN_CAP;
+	pool->count    =  0;
+	pool->buckets  =  rm_calloc(pool->cap, sizeof(InternedString *));
+
+	return pool;
+}
+
+const char *StringPool_Intern
+(
+	StringPool *pool,
+	const char *s
+) {
+	ASSERT(s    != NULL);
+	ASSERT(pool != NULL);
+
+	size_t    len   =  strlen(s);
+	uint32_t  hash  =  _StringPool_Hash(s, len);
+	uint64_t  mask  =  pool->cap - 1;
+	uint64_t  idx   =  _StringPool_Bucket(pool, hash);
+
+	// search for string
+	InternedString *entry;
+	while((entry = pool->buckets[idx]) != NULL) {
+		if(entry->hash == hash && strcmp(entry->str, s) == 0) {
+			// a 64 bit count can't realistically wrap around
+			ASSERT(entry->ref_count < UINT64_MAX);
+			entry->ref_count++;
+			return entry->str;
+		}
+		idx = (idx + 1) & mask;
+	}
+
+	// string is missing, keep load factor below 3/4
+	if((pool->count + 1) * 4 > pool->cap * 3) {
+		_StringPool_Resize(pool, pool->cap * 2);
+		idx = _StringPool_Bucket(pool, hash);
+		while(pool->buckets[idx] != NULL) idx = (idx + 1) & (pool->cap - 1);
+	}
+
+	entry = rm_malloc(sizeof(InternedString) + len + 1);
+	entry->pool       =  pool;
+	entry->hash       =  hash;
+	entry->ref_count  =  1;
+	memcpy(entry->str, s, len + 1);
+
+	pool->buckets[idx] = entry;
+	pool->count++;
+
+	return entry->str;
+}
+
+void StringPool_Release
+(
+	const char *s
+) {
+	ASSERT(s != NULL);
+
+	InternedString *entry = INTERNED_STRING(s);
+	ASSERT(entry->ref_count > 0);
+
+	if(--entry->ref_count > 0) return;
+
+	// last reference, remove string from pool
+	StringPool *pool = entry->pool;
+	uint64_t mask = pool->cap - 1;
+	uint64_t idx = _StringPool_Bucket(pool, entry->hash);
+	while(pool->buckets[idx] != entry) {
+		ASSERT(pool->buckets[idx] != NULL);
+		idx = (idx + 1) & mask;
+	}
+
+	_StringPool_RemoveAt(pool, idx);
+	rm_free(entry);
+
+	// shrink table when it is mostly empty
+	if(pool->cap > STRING_POOL_MIN_CAP && pool->count * 8 < pool->cap) {
+		_StringPool_Resize(pool, pool->cap / 2);
+	}
+}
+
+uint64_t StringPool_RefCount
+(
+	const char *s
+) {
+	ASSERT(s != NULL);
+	return INTERNED_STRING(s)->ref_count;
+}
+
+uint64_t StringPool_Count
+(
+	const StringPool *pool
+) {
+	ASSERT(pool != NULL);
+	return pool->count;
+}
+
+void StringPool_Free
+(
+	StringPool *pool
+) {
+	ASSERT(pool != NULL);
+
+	for(uint64_t i = 0; i < pool->cap; i++) {
+		if(pool->buckets[i] != NULL) rm_free(pool->buckets[i]);
+	}
+
+	rm_free(pool->buckets);
+	rm_free(pool);
+}
+
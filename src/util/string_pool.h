@@ -0,0 +1,72 @@
+/*
+* Copyright 2018-2021 Redis Labs Ltd. and Contributors
+*
+* This file is available under the Redis Labs Source Available License Agreement
+*/
+
+#pragma once
+
+#include <stdint.h>
+#include <stdbool.h>
+
+// minimal number of buckets in a string pool, must be a power of 2
+#define STRING_POOL_MIN_CAP 64
+
+typedef struct StringPool StringPool;
+
+// an interned string is allocated together with its header
+// the string itself is what is handed out to the pool's users
+typedef struct {
+	StringPool *pool;        // pool owning the string
+	uint64_t ref_count;      // number of references to the string
+	uint32_t hash;           // string hash
+	char str[];              // NULL terminated string
+} InternedString;
+
+// StringPool maintains a single copy of each distinct string
+// interned strings are reference counted and removed from the pool
+// once their last reference is released
+// the pool is not thread-safe, as it is only modified by graph writers
+// while holding the graph's write lock
+struct StringPool {
+	InternedString **buckets;  // open addressing hash table
+	uint64_t cap;              // number of buckets, power of 2
+	uint64_t count;            // number of distinct strings
+};
+
+// create a new string pool
+StringPool *StringPool_New(void);
+
+// returns the pooled copy of 's', adding 's' to the pool if it is missing
+// the returned string's reference count is incremented
+const char *StringPool_Intern
+(
+	StringPool *pool,  // pool to intern 's' in
+	const char *s      // string to intern
+);
+
+// releases a reference to an interned string
+// the string is removed from its pool once it is no longer referenced
+void StringPool_Release
+(
+	const char *s  // string previously returned by StringPool_Intern
+);
+
+// returns the number of references to an interned string
+uint64_t StringPool_RefCount
+(
+	const char *s  // string previously returned by StringPool_Intern
+);
+
+// returns the number of distinct strings in the pool
+uint64_t StringPool_Count
+(
+	const StringPool *pool
+);
+
+// free pool along with all of its strings
+void StringPool_Free
+(
+	StringPool *pool
+);
+
@@ -139,28 +139,34 @@ void ThreadPools_Resume
 int ThreadPools_AddWorkReader
 (
 	void (*function_p)(void *),
-	void *arg_p
+	void *arg_p,
+	thpool_priority priority,
+	const void *tenant
 ) {
 	ASSERT(_readers_thpool != NULL);
 
 	// make sure there's enough room in thread pool queue
 	if(thpool_queue_full(_readers_thpool)) return THPOOL_QUEUE_FULL;
 
-	return thpool_add_work(_readers_thpool, function_p, arg_p);
+	return thpool_add_prioritized_work(_readers_thpool, function_p, arg_p, priority,
+			tenant);
 }
 
 // add task for writer thread
 int ThreadPools_AddWorkWriter
 (
 	void (*function_p)(void *),
-	void *arg_p
+	void *arg_p,
+	thpool_priority priority,
+	const void *tenant
 ) {
 	ASSERT(_writers_thpool != NULL);
 
 	// make sure there's enough room in thread pool queue
 	if(thpool_queue_full(_writers_thpool)) return THPOOL_QUEUE_FULL;
 
-	return thpool_add_work(_writers_thpool, function_p, arg_p);
+	return thpool_add_prioritized_work(_writers_thpool, function_p, arg_p, priority,
+			tenant);
 }
 
 void ThreadPools_SetMaxPendingWork(uint64_t val) {
@@ -58,17 +58,23 @@ void ThreadPools_Resume
 );
 
 // adds a read task
+// tasks are served by priority, tasks of the same priority issued by
+// different tenants (graphs) are served in a round robin fashion
 int ThreadPools_AddWorkReader
 (
 	void (*function_p)(void *),
-	void *arg_p
+	void *arg_p,
+	thpool_priority priority,  // task priority class
+	const void *tenant         // task owner, e.g. the queried graph
 );
 
 // add a write task
 int ThreadPools_AddWorkWriter
 (
 	void (*function_p)(void *),
-	void *arg_p
+	void *arg_p,
+	thpool_priority priority,  // task priority class
+	const void *tenant         // task owner, e.g. the queried graph
 );
 
 // sets the limit on max queued queries in each thread pool
@@ -36,6 +36,9 @@
 #define err(str)
 #endif
 
+/* Number of jobs that may be served ahead of a pending lower priority job */
+#define THPOOL_STARVATION_LIMIT 8
+
 static volatile int threads_keepalive;
 static volatile int threads_on_hold;
 
@@ -55,11 +58,20 @@ typedef struct job {
 	void *arg;                   /* function's argument       */
 } job;
 
+/* Tenant, pending jobs of a single tenant within a priority class */
+typedef struct tenant {
+	const void *id;              /* tenant identifier         */
+	job *front;                  /* tenant's first job        */
+	job *rear;                   /* tenant's last job         */
+	struct tenant *next;         /* next tenant to be served  */
+} tenant;
+
 /* Job queue */
 typedef struct jobqueue {
 	pthread_mutex_t rwmutex; 		/* used for queue r/w access */
-	job *front;              		/* pointer to front of queue */
-	job *rear;               		/* pointer to rear  of queue */
+	tenant *front[THPOOL_PRIORITY_COUNT];  /* next tenant to serve per class */
+	tenant *rear[THPOOL_PRIORITY_COUNT];   /* last tenant to serve per class */
+	uint skipped[THPOOL_PRIORITY_COUNT];   /* jobs served ahead of class     */
 	bsem *has_jobs;          		/* flag as binary semaphore  */
 	int len;                 		/* number of jobs in queue   */
 	uint64_t cap;                   /* capacity of the queue     */
@@ -92,7 +104,8 @@ static void thread_destroy(struct thread *thread_p);
 
 static int jobqueue_init(jobqueue *jobqueue_p);
 static void jobqueue_clear(jobqueue *jobqueue_p);
-static void jobqueue_push(jobqueue *jobqueue_p, struct job *newjob_p);
+static void jobqueue_push(jobqueue *jobqueue_p, struct job *newjob_p,
+		thpool_priority priority, const void *tenant_id);
 static struct job *jobqueue_pull(jobqueue *jobqueue_p);
 static void jobqueue_destroy(jobqueue *jobqueue_p);
 
@@ -167,8 +180,17 @@ struct thpool_ *thpool_init(int num_threads, const char *name) {
 
 /* Add work to the thread pool */
 int thpool_add_work(thpool_* thpool_p, void (*function_p)(void *), void *arg_p) {
+	return thpool_add_prioritized_work(thpool_p, function_p, arg_p,
+			THPOOL_PRIORITY_NORMAL, NULL);
+}
+
+/* Add prioritized work to the thread pool */
+int thpool_add_prioritized_work(thpool_* thpool_p, void (*function_p)(void *),
+		void *arg_p, thpool_priority priority, const void *tenant) {
 	job *newjob;
 
+	ASSERT(priority >= THPOOL_PRIORITY_HIGH && priority < THPOOL_PRIORITY_COUNT);
+
 	newjob = (struct job *)malloc(sizeof(struct job));
 	if(newjob == NULL) {
 		err("thpool_add_work(): Could not allocate memory for new job\n");
@@ -180,7 +202,7 @@ int thpool_add_work(thpool_* thpool_p, void (*function_p)(void *), void *arg_p)
 	newjob->arg = arg_p;
 
 	/* add job to queue */
-	jobqueue_push(&thpool_p->jobqueue, newjob);
+	jobqueue_push(&thpool_p->jobqueue, newjob, priority, tenant);
 
 	return 0;
 }
@@ -406,8 +428,12 @@ static void thread_destroy(thread *thread_p) {
 /* Initialize queue */
 static int jobqueue_init(jobqueue *jobqueue_p) {
 	jobqueue_p->len         =  0;
-	jobqueue_p->front       =  NULL;
-	jobqueue_p->rear        =  NULL;
+
+	for(int p = 0; p < THPOOL_PRIORITY_COUNT; p++) {
+		jobqueue_p->front[p]    =  NULL;
+		jobqueue_p->rear[p]     =  NULL;
+		jobqueue_p->skipped[p]  =  0;
+	}
 
 	jobqueue_p->has_jobs = (struct bsem *)malloc(sizeof(struct bsem));
 	if(jobqueue_p->has_jobs == NULL) {
@@ -429,26 +455,45 @@ static void jobqueue_clear(jobqueue *jobqueue_p) {
 		free(jobqueue_pull(jobqueue_p));
 	}
 
-	jobqueue_p->front = NULL;
-	jobqueue_p->rear = NULL;
+	for(int p = 0; p < THPOOL_PRIORITY_COUNT; p++) {
+		jobqueue_p->front[p]    =  NULL;
+		jobqueue_p->rear[p]     =  NULL;
+		jobqueue_p->skipped[p]  =  0;
+	}
 	bsem_reset(jobqueue_p->has_jobs);
 	jobqueue_p->len = 0;
 }
 
 /* Add (allocated) job to queue */
-static void jobqueue_push(jobqueue *jobqueue_p, struct job *newjob) {
+static void jobqueue_push(jobqueue *jobqueue_p, struct job *newjob,
+		thpool_priority priority, const void *tenant_id) {
 	newjob->prev = NULL;
 
 	pthread_mutex_lock(&jobqueue_p->rwmutex);
 
-	switch(jobqueue_p->len) {
-		case 0: /* no jobs in queue */
-			jobqueue_p->front = newjob;
-			jobqueue_p->rear = newjob;
-			break;
-		default: /* jobs in queue */
-			jobqueue_p->rear->prev = newjob;
-			jobqueue_p->rear = newjob;
+	/* locate tenant within priority class */
+	tenant *tenant_p = jobqueue_p->front[priority];
+	while(tenant_p != NULL && tenant_p->id != tenant_id) {
+		tenant_p = tenant_p->next;
+	}
+
+	if(tenant_p == NULL) {
+		/* tenant has no pending jobs, it is served last */
+		tenant_p = (struct tenant *)malloc(sizeof(struct tenant));
+		tenant_p->id = tenant_id;
+		tenant_p->front = newjob;
+		tenant_p->rear = newjob;
+		tenant_p->next = NULL;
+
+		if(jobqueue_p->rear[priority] == NULL) {
+			jobqueue_p->front[priority] = tenant_p;
+		} else {
+			jobqueue_p->rear[priority]->next = tenant_p;
+		}
+		jobqueue_p->rear[priority] = tenant_p;
+	} else {
+		tenant_p->rear->prev = newjob;
+		tenant_p->rear = newjob;
 	}
 
 	jobqueue_p->len++;
@@ -457,31 +502,76 @@ static void jobqueue_push(jobqueue *jobqueue_p, struct job *newjob) {
 	pthread_mutex_unlock(&jobqueue_p->rwmutex);
 }
 
-/* Get first job from queue(removes it from queue)
+/* Pick the priority class to serve next, -1 if queue is empty
+ * a class which was passed over too many times is served first
+ *
+ * Notice: Caller MUST hold a mutex
+ */
+static int jobqueue_next_priority(jobqueue *jobqueue_p) {
+	int next = -1;
+
+	for(int p = THPOOL_PRIORITY_COUNT - 1; p >= 0; p--) {
+		if(jobqueue_p->front[p] == NULL) continue;
+		if(jobqueue_p->skipped[p] >= THPOOL_STARVATION_LIMIT) {
+			next = p;
+			break;
+		}
+	}
+
+	if(next == -1) {
+		for(int p = 0; p < THPOOL_PRIORITY_COUNT; p++) {
+			if(jobqueue_p->front[p] != NULL) {
+				next = p;
+				break;
+			}
+		}
+	}
+
+	if(next == -1) return -1;
+
+	/* account for lower priority jobs served after this one */
+	jobqueue_p->skipped[next] = 0;
+	for(int p = next + 1; p < THPOOL_PRIORITY_COUNT; p++) {
+		if(jobqueue_p->front[p] != NULL) jobqueue_p->skipped[p]++;
+	}
+
+	return next;
+}
+
+/* Get next job from queue(removes it from queue)
  *
  * Notice: Caller MUST hold a mutex
  */
 static struct job *jobqueue_pull(jobqueue *jobqueue_p) {
 
 	pthread_mutex_lock(&jobqueue_p->rwmutex);
-	job *job_p = jobqueue_p->front;
 
-	switch(jobqueue_p->len) {
+	job *job_p = NULL;
+	int priority = jobqueue_next_priority(jobqueue_p);
 
-	case 0: /* if no jobs in queue */
-		break;
+	if(priority != -1) {
+		tenant *tenant_p = jobqueue_p->front[priority];
+		job_p = tenant_p->front;
+		tenant_p->front = job_p->prev;
 
-	case 1: /* if one job in queue */
-		jobqueue_p->front = NULL;
-		jobqueue_p->rear = NULL;
-		jobqueue_p->len = 0;
-		break;
+		if(tenant_p->front == NULL) {
+			/* tenant has no more pending jobs, remove it */
+			jobqueue_p->front[priority] = tenant_p->next;
+			if(jobqueue_p->front[priority] == NULL) {
+				jobqueue_p->rear[priority] = NULL;
+			}
+			free(tenant_p);
+		} else if(tenant_p->next != NULL) {
+			/* move tenant to the back of the line */
+			jobqueue_p->front[priority] = tenant_p->next;
+			jobqueue_p->rear[priority]->next = tenant_p;
+			jobqueue_p->rear[priority] = tenant_p;
+			tenant_p->next = NULL;
+		}
 
-	default: /* if >1 jobs in queue */
-		jobqueue_p->front = job_p->prev;
 		jobqueue_p->len--;
-		/* more than one job in queue -> post it */
-		bsem_post(jobqueue_p->has_jobs);
+		/* more jobs in queue -> post it */
+		if(jobqueue_p->len > 0) bsem_post(jobqueue_p->has_jobs);
 	}
 
 	pthread_mutex_unlock(&jobqueue_p->rwmutex);
@@ -19,6 +19,14 @@ extern "C" {
 
 typedef struct thpool_* threadpool;
 
+/* Job priority classes, higher priority jobs are served first */
+typedef enum {
+	THPOOL_PRIORITY_HIGH = 0,
+	THPOOL_PRIORITY_NORMAL,
+	THPOOL_PRIORITY_LOW,
+	THPOOL_PRIORITY_COUNT
+} thpool_priority;
+
 
 /**
  * @brief  Initialize threadpool
@@ -71,6 +79,27 @@ threadpool thpool_init(int num_threads, const char *name);
 int thpool_add_work(threadpool, void (*function_p)(void*), void* arg_p);
 
 
+/**
+ * @brief Add prioritized work to the job queue
+ *
+ * Jobs are served by priority class, within a class jobs of different
+ * tenants are served in a round robin fashion such that a burst of jobs
+ * from a single tenant won't delay the jobs of other tenants.
+ * Jobs of the same tenant are served in FIFO order.
+ * To avoid starvation, a pending lower priority job is served after
+ * THPOOL_STARVATION_LIMIT higher priority jobs were served ahead of it.
+ *
+ * @param  threadpool    threadpool to which the work will be added
+ * @param  function_p    pointer to function to add as work
+ * @param  arg_p         pointer to an argument
+ * @param  priority      job's priority class
+ * @param  tenant        job's owner, jobs with a NULL tenant share a queue
+ * @return 0 on successs -1 otherwise
+ */
+int thpool_add_prioritized_work(threadpool, void (*function_p)(void*),
+		void* arg_p, thpool_priority priority, const void *tenant);
+
+
 /**
  * @brief Wait for all queued jobs to finish
  *
@@ -21,12 +21,25 @@
 
 static inline void _SIString_ToString(SIValue str, char **buf, size_t *bufferLen,
 									  size_t *bytesWritten) {
-	size_t strLen = strlen(str.stringval);
+	const char *s = SI_STRINGVAL(str);
+	size_t strLen = strlen(s);
 	if(*bufferLen - *bytesWritten < strLen) {
 		*bufferLen += strLen;
 		*buf = rm_realloc(*buf, *bufferLen);
 	}
-	*bytesWritten += snprintf(*buf + *bytesWritten, *bufferLen, "%s", str.stringval);
+	*bytesWritten += snprintf(*buf + *bytesWritten, *bufferLen, "%s", s);
+}
+
+/* Store 's' within 'v' if it is short enough to be inlined,
+ * returns false if 's' is too long. */
+static inline bool _SI_InlineStringVal(const char *s, SIValue *v) {
+	size_t len = strnlen(s, SI_INLINE_STRING_LEN + 1);
+	if(len > SI_INLINE_STRING_LEN) return false;
+
+	memcpy(v->inlineval, s, len + 1);
+	v->type = T_STRING;
+	v->allocation = M_NONE;
+	return true;
 }
 
 SIValue SI_LongVal(int64_t i) {
@@ -93,23 +106,40 @@ SIValue SI_Map(u_int64_t initialCapacity) {
 }
 
 SIValue SI_DuplicateStringVal(const char *s) {
+	SIValue v;
+	if(_SI_InlineStringVal(s, &v)) return v;
 	return (SIValue) {
 		.stringval = rm_strdup(s), .type = T_STRING, .allocation = M_SELF
 	};
 }
 
 SIValue SI_ConstStringVal(const char *s) {
+	SIValue v;
+	if(_SI_InlineStringVal(s, &v)) return v;
 	return (SIValue) {
 		.stringval = (char*)s, .type = T_STRING, .allocation = M_CONST
 	};
 }
 
 SIValue SI_TransferStringVal(char *s) {
+	SIValue v;
+	if(_SI_InlineStringVal(s, &v)) {
+		rm_free(s);
+		return v;
+	}
 	return (SIValue) {
 		.stringval = s, .type = T_STRING, .allocation = M_SELF
 	};
 }
 
+SIValue SI_InternStringVal(StringPool *pool, const char *s) {
+	SIValue v;
+	if(_SI_InlineStringVal(s, &v)) return v;
+	return (SIValue) {
+		.stringval = (char *)StringPool_Intern(pool, s), .type = T_STRING, .allocation = M_INTERN
+	};
+}
+
 SIValue SI_Point(float latitude, float longitude) {
 	return (SIValue) {
 		.type = T_POINT, .allocation = M_NONE,
@@ -123,7 +153,7 @@ SIValue SI_Point(float latitude, float longitude) {
 SIValue SI_ShareValue(const SIValue v) {
 	SIValue dup = v;
 	// If the original value owns an allocation, mark that the duplicate shares it.
-	if(v.allocation == M_SELF) dup.allocation = M_VOLATILE;
+	if(v.allocation == M_SELF || v.allocation == M_INTERN) dup.allocation = M_VOLATILE;
 	return dup;
 }
 
@@ -135,7 +165,9 @@ SIValue SI_CloneValue(const SIValue v) {
 
 	if(v.type == T_STRING) {
 		// Allocate a new copy of the input's string value.
-		return SI_DuplicateStringVal(v.stringval);
+		// Pooled strings are copied as well, as the pool is only
+		// accessed by writers.
+		return SI_DuplicateStringVal(SI_STRINGVAL(v));
 	}
 
 	if(v.type == T_ARRAY) {
@@ -347,7 +379,7 @@ size_t SIValue_StringJoinLen(SIValue *strings, unsigned int string_count, const
 	for(int i = 0; i < string_count; i ++) {
 		/* String elements representing bytes size strings,
 		 * for all other SIValue types 32 bytes should be enough. */
-		elem_len = (strings[i].type == T_STRING) ? strlen(strings[i].stringval) + delimiter_len : 32;
+		elem_len = (strings[i].type == T_STRING) ? strlen(SI_STRINGVAL(strings[i])) + delimiter_len : 32;
 		length += elem_len;
 	}
 
@@ -515,7 +547,10 @@ int SIValue_Compare(const SIValue a, const SIValue b, int *disjointOrNull) {
 		case T_DOUBLE:
 			return SAFE_COMPARISON_RESULT(a.doubleval - b.doubleval);
 		case T_STRING:
-			return strcmp(a.stringval, b.stringval);
+			// Pooled strings are unique, identical pointers are equal strings.
+			if(a.allocation != M_NONE && b.allocation != M_NONE &&
+			   a.stringval == b.stringval) return 0;
+			return strcmp(SI_STRINGVAL(a), SI_STRINGVAL(b));
 		case T_NODE:
 		case T_EDGE:
 			return ENTITY_GET_ID((GraphEntity *)a.ptrval) - ENTITY_GET_ID((GraphEntity *)b.ptrval);
@@ -603,10 +638,12 @@ void SIValue_HashUpdate(SIValue v, XXH64_state_t *state) {
 			XXH64_update(state, &t, sizeof(t));
 			XXH64_update(state, &null, sizeof(null));
 			return;
-		case T_STRING:
+		case T_STRING: {
+			const char *s = SI_STRINGVAL(v);
 			XXH64_update(state, &t, sizeof(t));
-			XXH64_update(state, v.stringval, strlen(v.stringval));
+			XXH64_update(state, s, strlen(s));
 			return;
+		}
 		case T_INT64:
 			// change type to numeric
 			t = SI_NUMERIC;
@@ -670,6 +707,12 @@ XXH64_hash_t SIValue_HashCode(SIValue v) {
 }
 
 void SIValue_Free(SIValue v) {
+	// Pooled strings are released back to their pool.
+	if(v.allocation == M_INTERN) {
+		StringPool_Release(v.stringval);
+		return;
+	}
+
 	// The free routine only performs work if it owns a heap allocation.
 	if(v.allocation != M_SELF) return;
 
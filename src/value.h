@@ -12,6 +12,7 @@
 #include <stdbool.h>
 #include <sys/types.h>
 #include "xxhash.h"
+#include "util/string_pool.h"
 
 /* Type defines the supported types by the system. The types are powers
  * of 2 so they can be used in bitmasks of matching types.
@@ -44,7 +45,8 @@ typedef enum {
 	M_NONE = 0,       // SIValue is not heap-allocated
 	M_SELF = 0x1,     // SIValue is responsible for freeing its reference
 	M_VOLATILE = 0x2, // SIValue does not own its reference and may go out of scope
-	M_CONST = 0x4     // SIValue does not own its allocation, but its access is safe
+	M_CONST = 0x4,    // SIValue does not own its allocation, but its access is safe
+	M_INTERN = 0x8    // SIValue holds a reference to a pooled string
 } SIAllocation;
 
 #define SI_TYPE(value) (value).type
@@ -78,11 +80,22 @@ typedef enum {
 
 struct Pair;
 
+/* Strings of up to SI_INLINE_STRING_LEN characters are stored within
+ * the SIValue itself rather than on the heap.
+ * Inline strings are marked with the M_NONE allocation type. */
+#define SI_INLINE_STRING_LEN (sizeof(int64_t) - 1)
+
+/* Retrieve the string held by a T_STRING SIValue.
+ * For inline strings the returned pointer refers to the SIValue itself,
+ * and as such is only valid for as long as that SIValue is in scope. */
+#define SI_STRINGVAL(v) ((v).allocation == M_NONE ? (v).inlineval : (v).stringval)
+
 typedef struct SIValue {
 	union {
 		int64_t longval;
 		double doubleval;
 		char *stringval;
+		char inlineval[SI_INLINE_STRING_LEN + 1];
 		void *ptrval;
 		struct Pair *map;
 		struct SIValue *array;
@@ -119,6 +132,10 @@ SIValue SI_ConstStringVal(const char *s);
 // Don't duplicate input string, but assume ownership.
 SIValue SI_TransferStringVal(char *s);
 
+// Reference the pooled copy of the input string, interning it if missing.
+// Short strings are stored inline and are not pooled.
+SIValue SI_InternStringVal(StringPool *pool, const char *s);
+
 /* Functions for copying and guaranteeing memory safety for SIValues. */
 // SI_ShareValue creates an SIValue that shares all of the original's allocations.
 SIValue SI_ShareValue(const SIValue v);
@@ -4,10 +4,25 @@ import redis
 from RLTest import Env
 from redisgraph import Graph
 from base import FlowTestsBase
+from pathos.pools import ProcessPool as Pool
+from pathos.helpers import mp as pathos_multiprocess
 
 redis_con = None
 redis_graph = None
 
+GROUP_COMMIT_CLIENTS = 8  # number of concurrent writers
+GROUP_COMMIT_DB = 1       # writers use a none default database
+
+def group_commit_writer(v, barrier):
+    env = Env(decodeResponses=True)
+    kwargs = env.getConnection().connection_pool.connection_kwargs
+    conn = redis.Redis(host=kwargs['host'], port=kwargs['port'],
+                       db=GROUP_COMMIT_DB, decode_responses=True)
+    g = Graph("group_commit_concurrent", conn)
+
+    barrier.wait()
+    return g.query("CREATE (:G {v: %d})" % v).nodes_created
+
 class testConfig(FlowTestsBase):
     def __init__(self):
         self.env = Env(decodeResponses=True)
@@ -216,7 +231,8 @@ class testConfig(FlowTestsBase):
 
         # TIMEOUT, QUERY_MEM_CAPACITY, and DELTA_MAX_PENDING_CHANGES must be
         # non-negative values, 0 resets to default
-        for config in ["TIMEOUT", "QUERY_MEM_CAPACITY", "DELTA_MAX_PENDING_CHANGES"]:
+        for config in ["TIMEOUT", "QUERY_MEM_CAPACITY", "DELTA_MAX_PENDING_CHANGES",
+                       "GROUP_COMMIT_WINDOW"]:
             try:
                 redis_con.execute_command("GRAPH.CONFIG SET %s -1" % config)
                 assert(False)
@@ -246,4 +262,60 @@ class testConfig(FlowTestsBase):
         # Make sure config been updated.
         response = redis_con.execute_command("GRAPH.CONFIG GET " + config_name)
         expected_response = [config_name, config_value]
-        self.env.assertEqual(response, expected_response)
\ No newline at end of file
+        self.env.assertEqual(response, expected_response)
+
+    def test10_group_commit_window(self):
+        config_name = "GROUP_COMMIT_WINDOW"
+
+        # group commit is disabled by default
+        response = redis_con.execute_command("GRAPH.CONFIG GET " + config_name)
+        self.env.assertEqual(response, [config_name, 0])
+
+        response = redis_con.execute_command("GRAPH.CONFIG SET %s 5" % config_name)
+        self.env.assertEqual(response, "OK")
+
+        response = redis_con.execute_command("GRAPH.CONFIG GET " + config_name)
+        self.env.assertEqual(response, [config_name, 5])
+
+        # writes are still applied and replied to individually
+        g = Graph("group_commit", redis_con)
+        for i in range(10):
+            result = g.query("CREATE (:G {v: %d})" % i)
+            self.env.assertEqual(result.nodes_created, 1)
+
+        result = g.query("MATCH (n:G) RETURN count(n), sum(n.v)")
+        self.env.assertEqual(result.result_set[0], [10, 45])
+
+        # disable group commit
+        response = redis_con.execute_command("GRAPH.CONFIG SET %s 0" % config_name)
+        self.env.assertEqual(response, "OK")
+
+    def test11_group_commit_concurrent_writers(self):
+        # valgrind is not working correctly with multi processing
+        if self.env.envRunner.debugger is not None:
+            self.env.skip()
+
+        # a wide window makes sure all concurrent writes fall within it
+        redis_con.execute_command("GRAPH.CONFIG SET GROUP_COMMIT_WINDOW 500")
+
+        pool = Pool(nodes=GROUP_COMMIT_CLIENTS)
+        manager = pathos_multiprocess.Manager()
+        barrier = manager.Barrier(GROUP_COMMIT_CLIENTS)
+        values = list(range(GROUP_COMMIT_CLIENTS))
+        results = pool.map(group_commit_writer, values,
+                           [barrier] * GROUP_COMMIT_CLIENTS)
+
+        # every write is applied and replied to individually
+        self.env.assertEqual(results, [1] * GROUP_COMMIT_CLIENTS)
+
+        # writes were committed to the writers' database
+        kwargs = redis_con.connection_pool.connection_kwargs
+        conn = redis.Redis(host=kwargs['host'], port=kwargs['port'],
+                           db=GROUP_COMMIT_DB, decode_responses=True)
+        g = Graph("group_commit_concurrent", conn)
+        result = g.query("MATCH (n:G) RETURN count(n), sum(n.v)")
+        expected = [GROUP_COMMIT_CLIENTS, sum(values)]
+        self.env.assertEqual(result.result_set[0], expected)
+        self.env.assertEqual(redis_con.exists("group_commit_concurrent"), 0)
+
+        redis_con.execute_command("GRAPH.CONFIG SET GROUP_COMMIT_WINDOW 0")
@@ -108,3 +108,41 @@ class testExpandInto():
         self.env.assertIn("Expand Into", plan)
         self.env.assertEquals(4, result.result_set[0][0])
 
+
+    # test expand into multiple hops over batches of records
+    # with pending additions and deletions
+    def test05_multi_hop_batches(self):
+        redis_con = self.env.getConnection()
+        graph = Graph(GRAPH_ID, redis_con)
+        graph.delete()
+
+        # create graph
+        # (:A {v:x})-[:R]->()-[:R]->(:B {v:x})
+        query = "UNWIND range(0, 299) AS x CREATE (:A {v:x})-[:R]->()-[:R]->(:B {v:x})"
+        graph.query(query)
+
+        # each (a) is connected only to the (b) sharing its value
+        connected = "MATCH (a:A), (b:B) WHERE a.v = b.v WITH a, b MATCH (a)-[:R]->()-[:R]->(b) RETURN count(a)"
+        shifted = "MATCH (a:A), (b:B) WHERE b.v = a.v + 1 WITH a, b MATCH (a)-[:R]->()-[:R]->(b) RETURN count(a)"
+
+        plan = graph.execution_plan(connected)
+        self.env.assertIn("Expand Into", plan)
+        result = graph.query(connected)
+        self.env.assertEquals(300, result.result_set[0][0])
+        result = graph.query(shifted)
+        self.env.assertEquals(0, result.result_set[0][0])
+
+        # delete edges
+        query = "MATCH (a:A)-[e:R]->() WHERE a.v % 3 = 0 DELETE e"
+        result = graph.query(query)
+        self.env.assertEquals(100, result.relationships_deleted)
+
+        # introduce edges
+        query = "MATCH (a:A), (b:B) WHERE b.v = a.v + 1 AND a.v < 10 CREATE (a)-[:R]->()-[:R]->(b)"
+        result = graph.query(query)
+        self.env.assertEquals(20, result.relationships_created)
+
+        result = graph.query(connected)
+        self.env.assertEquals(200, result.result_set[0][0])
+        result = graph.query(shifted)
+        self.env.assertEquals(10, result.result_set[0][0])
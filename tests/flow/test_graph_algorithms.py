@@ -0,0 +1,126 @@
+import os
+import sys
+from RLTest import Env
+from redisgraph import Graph, Node, Edge
+
+sys.path.append(os.path.join(os.path.dirname(__file__), '..'))
+
+from base import FlowTestsBase
+
+GRAPH_ID = "graph_algorithms"
+redis_graph = None
+
+class testGraphAlgorithmsFlow(FlowTestsBase):
+    def __init__(self):
+        self.env = Env(decodeResponses=True)
+        global redis_graph
+        redis_con = self.env.getConnection()
+        redis_graph = Graph(GRAPH_ID, redis_con)
+        self.populate_graph()
+
+    def populate_graph(self):
+        # two triangles, (0, 1, 2) and (3, 4, 5), connected by 2->3
+        # an isolated node 6 and a node 7 connected only by a different type
+        q = """CREATE
+               (n0:L {v:0}), (n1:L {v:1}), (n2:L {v:2}), (n3:L {v:3}),
+               (n4:L {v:4}), (n5:L {v:5}), (n6:L {v:6}), (n7:X {v:7}),
+               (n0)-[:R]->(n1), (n1)-[:R]->(n2), (n2)-[:R]->(n0),
+               (n3)-[:R]->(n4), (n4)-[:R]->(n5), (n5)-[:R]->(n3),
+               (n2)-[:R]->(n3), (n7)-[:Y]->(n0)"""
+        redis_graph.query(q)
+
+    def test01_wcc(self):
+        q = """CALL algo.WCC('L', 'R') YIELD node, componentId
+               RETURN node.v, componentId ORDER BY node.v"""
+        resultset = redis_graph.query(q).result_set
+        ids = [row[1] for row in resultset]
+        self.env.assertEqual([row[0] for row in resultset], list(range(7)))
+
+        # both triangles form a single component, node 6 is on its own
+        self.env.assertEqual(len(set(ids[0:6])), 1)
+        self.env.assertNotEqual(ids[0], ids[6])
+
+        # without the bridging edge the triangles are disconnected
+        redis_graph.query("MATCH (:L {v:2})-[e:R]->(:L {v:3}) DELETE e")
+        resultset = redis_graph.query(q).result_set
+        ids = [row[1] for row in resultset]
+        self.env.assertEqual(len(set(ids[0:3])), 1)
+        self.env.assertEqual(len(set(ids[3:6])), 1)
+        self.env.assertNotEqual(ids[0], ids[3])
+        redis_graph.query("MATCH (a:L {v:2}), (b:L {v:3}) CREATE (a)-[:R]->(b)")
+
+        # considering every edge, node 7 joins the first triangle
+        q = """CALL algo.WCC(NULL, NULL) YIELD node, componentId
+               RETURN node.v, componentId ORDER BY node.v"""
+        resultset = redis_graph.query(q).result_set
+        self.env.assertEqual(len(resultset), 8)
+        self.env.assertEqual(resultset[7][1], resultset[0][1])
+
+    def test02_triangle_count(self):
+        q = """CALL algo.triangleCount('L', 'R') YIELD node, triangles
+               RETURN node.v, triangles ORDER BY node.v"""
+        resultset = redis_graph.query(q).result_set
+        expected = [[0, 1], [1, 1], [2, 1], [3, 1], [4, 1], [5, 1], [6, 0]]
+        self.env.assertEqual(resultset, expected)
+
+    def test03_kcore(self):
+        q = """CALL algo.kCore('L', 'R', 2) YIELD node, degree
+               RETURN node.v, degree ORDER BY node.v"""
+        resultset = redis_graph.query(q).result_set
+        expected = [[0, 2], [1, 2], [2, 3], [3, 3], [4, 2], [5, 2]]
+        self.env.assertEqual(resultset, expected)
+
+        # no node has 3 neighbors within a 3-core
+        q = "CALL algo.kCore('L', 'R', 3) YIELD node RETURN count(node)"
+        resultset = redis_graph.query(q).result_set
+        self.env.assertEqual(resultset[0][0], 0)
+
+        # invalid k
+        try:
+            redis_graph.query("CALL algo.kCore('L', 'R', -1)")
+            self.env.assertTrue(False)
+        except:
+            pass
+
+    def test04_label_propagation(self):
+        q = """CALL algo.labelPropagation('L', 'R') YIELD node, communityId
+               RETURN node.v, communityId ORDER BY node.v"""
+        resultset = redis_graph.query(q).result_set
+        ids = [row[1] for row in resultset]
+        self.env.assertEqual(len(ids), 7)
+
+        # each triangle forms its own community
+        self.env.assertEqual(len(set(ids[0:3])), 1)
+        self.env.assertEqual(len(set(ids[3:6])), 1)
+        self.env.assertNotEqual(ids[0], ids[3])
+        self.env.assertNotIn(ids[6], ids[0:6])
+
+    def test05_personalized_pagerank(self):
+        q = """MATCH (s:L {v:0})
+               CALL algo.personalizedPageRank(s, 'L', 'R') YIELD node, score
+               RETURN node.v, score ORDER BY score DESC"""
+        resultset = redis_graph.query(q).result_set
+
+        # node 6 is unreachable from the source
+        self.env.assertEqual(len(resultset), 6)
+        self.env.assertEqual(resultset[0][0], 0)
+        self.env.assertAlmostEqual(sum([row[1] for row in resultset]), 1, 0.0001)
+
+        # multiple sources
+        q = """MATCH (s:L) WHERE s.v IN [0, 6]
+               WITH collect(s) AS sources
+               CALL algo.personalizedPageRank(sources, 'L', 'R') YIELD node, score
+               RETURN node.v, score ORDER BY node.v"""
+        resultset = redis_graph.query(q).result_set
+        self.env.assertEqual(len(resultset), 7)
+        # walks reaching the isolated source restart from either source
+        # r6 = 0.5 * (0.15 + 0.85 * r6)
+        self.env.assertAlmostEqual(resultset[6][1], 0.075 / 0.575, 0.0001)
+        self.env.assertAlmostEqual(sum([row[1] for row in resultset]), 1, 0.0001)
+
+    def test06_unknown_label_or_relation(self):
+        for proc in ["algo.WCC", "algo.triangleCount", "algo.labelPropagation"]:
+            q = "CALL %s('Z', NULL) YIELD node RETURN count(node)" % proc
+            self.env.assertEqual(redis_graph.query(q).result_set[0][0], 0)
+            q = "CALL %s(NULL, 'Z') YIELD node RETURN count(node)" % proc
+            self.env.assertEqual(redis_graph.query(q).result_set[0][0], 0)
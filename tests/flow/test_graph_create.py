@@ -117,3 +117,49 @@ class testGraphCreationFlow(FlowTestsBase):
                 self.env.assertTrue(False)
             except redis.exceptions.ResponseError as e:
                 self.env.assertContains("Property values can only be of primitive types or arrays of primitive types", str(e))
+
+    # Create large batches of labeled nodes and edges
+    def test08_bulk_unwind_create(self):
+        redis_con = self.env.getConnection()
+        graph = Graph("bulk_create", redis_con)
+
+        query = """UNWIND range(0, 199) AS x CREATE (:Item {id: x})"""
+        result = graph.query(query)
+        self.env.assertEquals(result.nodes_created, 200)
+        self.env.assertEquals(result.labels_added, 1)
+
+        result = graph.query("MATCH (i:Item) RETURN count(i)")
+        self.env.assertEquals(result.result_set, [[200]])
+
+        # reuse IDs of deleted nodes
+        graph.query("MATCH (i:Item) WHERE i.id < 100 DELETE i")
+        query = """UNWIND range(0, 99) AS x CREATE (:Item:Other {id: x})"""
+        result = graph.query(query)
+        self.env.assertEquals(result.nodes_created, 100)
+
+        result = graph.query("MATCH (i:Item) RETURN count(i)")
+        self.env.assertEquals(result.result_set, [[200]])
+        result = graph.query("MATCH (i:Other) RETURN count(i), min(i.id), max(i.id)")
+        self.env.assertEquals(result.result_set, [[100, 0, 99]])
+
+        # connect consecutive items
+        query = """MATCH (a:Item), (b:Item) WHERE b.id = a.id + 1 CREATE (a)-[:NEXT]->(b)"""
+        result = graph.query(query)
+        self.env.assertEquals(result.relationships_created, 199)
+
+        result = graph.query("MATCH (:Item)-[:NEXT]->(:Item) RETURN count(1)")
+        self.env.assertEquals(result.result_set, [[199]])
+        result = graph.query("MATCH (:Item {id: 0})-[:NEXT*]->(b) RETURN count(b)")
+        self.env.assertEquals(result.result_set, [[199]])
+
+    def test09_edge_ids_follow_creation_order(self):
+        redis_con = self.env.getConnection()
+        graph = Graph("edge_creation_order", redis_con)
+
+        # edges of interleaved relationship types
+        query = """CREATE (a)-[:A {i: 0}]->(b), (a)-[:B {i: 1}]->(c), (a)-[:A {i: 2}]->(d)"""
+        result = graph.query(query)
+        self.env.assertEquals(result.relationships_created, 3)
+
+        result = graph.query("MATCH ()-[e]->() RETURN e.i, ID(e) ORDER BY e.i")
+        self.env.assertEquals(result.result_set, [[0, 0], [1, 1], [2, 2]])
@@ -575,3 +575,38 @@ class testGraphMergeFlow(FlowTestsBase):
         except redis.exceptions.ResponseError as e:
             # Expecting an error.
             self.env.assertIn("undefined property", str(e))
+
+    def test28_merge_batch(self):
+        redis_con = self.env.getConnection()
+        graph = Graph("batch_merge", redis_con)
+
+        # Create existing nodes, one of which shares its key with another.
+        query = """UNWIND range(0, 9) AS x CREATE (:User {id: x, v: 'existing'})"""
+        graph.query(query)
+        query = """CREATE (:User {id: 0, v: 'duplicate'})"""
+        graph.query(query)
+
+        # Merge a batch containing existing, new and repeated keys.
+        query = """UNWIND [0, 5.0, 10, 11, 10, 'a'] AS x
+                   MERGE (n:User {id: x})
+                   ON MATCH SET n.matched = true
+                   ON CREATE SET n.v = 'created'
+                   RETURN n.id, n.v ORDER BY n.v, toString(n.id)"""
+        result = graph.query(query)
+        self.env.assertEquals(result.nodes_created, 3)
+        expected_result = [[10, 'created'],
+                           [11, 'created'],
+                           ['a', 'created'],
+                           [0, 'duplicate'],
+                           [0, 'existing'],
+                           [5, 'existing']]
+        self.env.assertEquals(result.result_set, expected_result)
+
+        # Repeating the batch should not create any nodes.
+        query = """UNWIND [0, 5.0, 10, 11, 10, 'a'] AS x MERGE (n:User {id: x})"""
+        result = graph.query(query)
+        self.env.assertEquals(result.nodes_created, 0)
+
+        query = """MATCH (n:User) WHERE n.matched = true RETURN count(n)"""
+        result = graph.query(query)
+        self.env.assertEquals(result.result_set[0][0], 3)
@@ -1,3 +1,4 @@
+import os
 from RLTest import Env
 from redisgraph import Graph, Node, Edge
 from base import FlowTestsBase
@@ -36,3 +37,55 @@ class testHashJoin(FlowTestsBase):
 
         self.env.assertEquals(actual_result.result_set, expected_result)
 
+
+    def test_multi_key_hashjoin(self):
+        graph = Graph("multi_key_join", self.env.getConnection())
+        graph.query("UNWIND range(0, 99) AS x CREATE (:L {x: x % 10, y: x % 7, v: x})")
+        graph.query("UNWIND range(0, 49) AS x CREATE (:R {x: x % 10, y: x % 7, v: x})")
+
+        # both equality filters are resolved by a single join
+        q = "MATCH (a:L), (b:R) WHERE a.x = b.x AND b.y = a.y RETURN a.v, b.v ORDER BY a.v, b.v"
+        plan = graph.execution_plan(q)
+        self.env.assertEquals(plan.count("Value Hash Join"), 1)
+        self.env.assertNotIn("Filter", plan)
+
+        # compare against a join computed by the cartesian product
+        expected = graph.query("MATCH (a:L), (b:R) WITH a, b WHERE a.x + 0 = b.x + 0 AND b.y + 0 = a.y + 0 RETURN a.v, b.v ORDER BY a.v, b.v").result_set
+        actual = graph.query(q).result_set
+        self.env.assertGreater(len(expected), 0)
+        self.env.assertEquals(actual, expected)
+
+    def test_hashjoin_key_semantics(self):
+        graph = Graph("join_semantics", self.env.getConnection())
+        graph.query("CREATE (:A {k: 1, id: 0}), (:A {k: 2.0, id: 1}), (:A {id: 2}), (:A {k: 'x', id: 3}), (:A {k: [1, null], id: 4})")
+        graph.query("CREATE (:B {k: 1.0, id: 0}), (:B {k: 2, id: 1}), (:B {id: 2}), (:B {k: 'x', id: 3}), (:B {k: '1', id: 4}), (:B {k: [1, null], id: 5})")
+
+        q = "MATCH (a:A), (b:B) WHERE a.k = b.k RETURN a.id, b.id ORDER BY a.id, b.id"
+        plan = graph.execution_plan(q)
+        self.env.assertIn("Value Hash Join", plan)
+
+        # integers and floats of the same value are equal
+        # NULL keys, including lists holding NULL, never match
+        # values of different types never match
+        actual = graph.query(q).result_set
+        self.env.assertEquals(actual, [[0, 0], [1, 1], [3, 3]])
+
+    def test_hashjoin_build_side(self):
+        graph = Graph("join_build_side", self.env.getConnection())
+        graph.query("UNWIND range(0, 99) AS x CREATE (:L {x: x % 10, v: x})")
+        graph.query("UNWIND range(0, 19) AS x CREATE (:R {x: x % 10, v: x})")
+
+        # the join builds its hash table from its first child
+        def build_side(q):
+            ops = graph.execution_plan(q).split(os.linesep)
+            idx = [i for i, op in enumerate(ops) if "Value Hash Join" in op]
+            return ops[idx[0] + 1]
+
+        # the smaller stream is built
+        q = "MATCH (a:L), (b:R) WHERE a.x = b.x RETURN count(*)"
+        self.env.assertIn("(b:R)", build_side(q))
+
+        # a filter reduces the estimated size of the larger stream
+        q = "MATCH (a:L), (b:R) WHERE a.v = 5 AND a.x = b.x RETURN count(*)"
+        self.env.assertIn("Filter", build_side(q))
+        self.env.assertEquals(graph.query(q).result_set[0][0], 2)
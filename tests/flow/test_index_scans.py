@@ -570,3 +570,81 @@ class testIndexScanFlow():
         expected_result = [[990000000262240069, 990000000262240067]]
         self.env.assertEquals(result.result_set, expected_result)
 
+
+    def test20_index_topk(self):
+        con = self.env.getConnection()
+        # identical graphs, only the first is indexed
+        indexed = Graph('topk', con)
+        unindexed = Graph('topk_unindexed', con)
+        for g in [indexed, unindexed]:
+            g.query("UNWIND range(1, 200) AS x CREATE (:Event {ts: (x * 37) % 101, id: x})")
+        indexed.query("CREATE INDEX ON :Event(ts)")
+
+        queries = [
+            "MATCH (n:Event) RETURN n.ts ORDER BY n.ts DESC LIMIT 10",
+            "MATCH (n:Event) RETURN n.ts ORDER BY n.ts LIMIT 10",
+            "MATCH (n:Event) RETURN n.ts AS t ORDER BY t DESC SKIP 5 LIMIT 10",
+            "MATCH (n:Event) WHERE n.ts > 20 RETURN n.ts ORDER BY n.ts LIMIT 10",
+            "MATCH (n:Event) WHERE n.id < 50 RETURN n.ts ORDER BY n.ts DESC LIMIT 10",
+        ]
+
+        def update(q):
+            for g in [indexed, unindexed]:
+                g.query(q)
+
+        def validate():
+            for q in queries:
+                expected = unindexed.query(q).result_set
+                actual = indexed.query(q).result_set
+                self.env.assertEquals(actual, expected)
+
+        # all values are numeric, scans are restricted to a window
+        validate()
+        plan = indexed.execution_plan(queries[3])
+        self.env.assertIn("Node By Index Scan", plan)
+
+        def scanned(q, op):
+            profile = con.execute_command("GRAPH.PROFILE", "topk", q)
+            for line in profile:
+                if line.strip().startswith(op):
+                    return int(line.split("Records produced: ")[1].split(",")[0])
+            self.env.assertTrue(False)
+
+        # each value is held by at most two nodes
+        self.env.assertLess(scanned(queries[0], "Node By Label Scan"), 21)
+        self.env.assertLess(scanned(queries[1], "Node By Label Scan"), 21)
+        self.env.assertLess(scanned(queries[3], "Node By Index Scan"), 21)
+
+        # missing, string and boolean values are ranked apart from numerics
+        update("CREATE (:Event {id: 1000})")
+        validate()
+        update("MATCH (n:Event {id: 1000}) SET n.ts = 'late'")
+        validate()
+        update("MATCH (n:Event {id: 1000}) SET n.ts = true")
+        validate()
+        update("MATCH (n:Event {id: 1000}) SET n.ts = 1000.5")
+        validate()
+
+        # a node missing 'ts' was indexed, missing values rank first
+        # in descending order, scans are no longer restricted
+        self.env.assertEquals(scanned(queries[0], "Node By Label Scan"), 201)
+
+    def test21_index_topk_multiple_labels(self):
+        con = self.env.getConnection()
+        g = Graph('topk_multi_label', con)
+
+        # the highest ranked Event nodes aren't Important
+        g.query("UNWIND range(101, 200) AS x CREATE (:Event {ts: x})")
+        g.query("UNWIND range(1, 100) AS x CREATE (:Event:Important {ts: x})")
+        # make Important the larger label, such that Event is scanned
+        g.query("UNWIND range(1, 300) AS x CREATE (:Important {ts: x})")
+        g.query("CREATE INDEX ON :Event(ts)")
+
+        query = "MATCH (n:Event:Important) RETURN n.ts ORDER BY n.ts DESC LIMIT 10"
+        result = g.query(query)
+        expected = [[x] for x in range(100, 90, -1)]
+        self.env.assertEquals(result.result_set, expected)
+
+        query = "MATCH (n:Important:Event) RETURN n.ts ORDER BY n.ts DESC LIMIT 10"
+        result = g.query(query)
+        self.env.assertEquals(result.result_set, expected)
@@ -200,3 +200,34 @@ class testIndexUpdatesFlow(FlowTestsBase):
         # Validate that the previous value has been removed
         result = redis_graph.query("CALL db.idx.fulltext.queryNodes('label_a', 'Group C')")
         self.env.assertEquals(len(result.result_set), 0)
+
+    # Validate that index updates buffered by a query are visible to
+    # the query itself and are applied once per entity
+    def test08_buffered_index_updates(self):
+        g = Graph("buffered_index_updates", redis_graph.redis_con)
+        g.query("CREATE INDEX ON :L(v)")
+
+        # index scan following a creation within the same query
+        query = """CREATE (:L {v: 1}) WITH 1 AS x
+                   MATCH (n:L) WHERE n.v = 1 RETURN count(n)"""
+        result = g.query(query)
+        self.env.assertEquals(result.result_set[0][0], 1)
+
+        # multiple updates to the same entity
+        result = g.query("MATCH (n:L {v: 1}) SET n.v = 2 SET n.v = 3")
+        self.env.assertEquals(result.properties_set, 2)
+
+        for v, expected in [(1, 0), (2, 0), (3, 1)]:
+            query = "MATCH (n:L) WHERE n.v = %d RETURN count(n)" % v
+            plan = g.execution_plan(query)
+            self.env.assertIn("Node By Index Scan", plan)
+            result = g.query(query)
+            self.env.assertEquals(result.result_set[0][0], expected)
+
+        # deletion followed by a creation, reusing the deleted node's ID
+        g.query("MATCH (n:L {v: 3}) DELETE n WITH 1 AS x CREATE (:L {v: 4})")
+
+        for v, expected in [(3, 0), (4, 1)]:
+            query = "MATCH (n:L) WHERE n.v = %d RETURN count(n)" % v
+            result = g.query(query)
+            self.env.assertEquals(result.result_set[0][0], expected)
@@ -0,0 +1,102 @@
+import os
+import sys
+from RLTest import Env
+from redisgraph import Graph, Node, Edge
+
+GRAPH_ID = "intersect_traverse"
+
+redis_graph = None
+
+# tests the intersect-traverse operation
+# cyclic patterns such as triangles are closed by intersecting the
+# neighbours of all bound endpoints of the closing node, e.g.
+# MATCH (a)-[:F]->(b)-[:F]->(c), (a)-[:F]->(c)
+# resolves 'c' by intersecting the neighbours of both 'a' and 'b'
+
+class testIntersectTraverse():
+    def __init__(self):
+        self.env = Env(decodeResponses=True)
+        global redis_graph
+        redis_con = self.env.getConnection()
+        redis_graph = Graph(GRAPH_ID, redis_con)
+        self.populate_graph()
+
+    def populate_graph(self):
+        # 4-clique, (a:N)-[:F]->(b:N) for every a.v < b.v
+        redis_graph.query("UNWIND range(0, 3) AS x CREATE (:N {v:x})")
+        redis_graph.query("MATCH (a:N), (b:N) WHERE a.v < b.v CREATE (a)-[:F]->(b)")
+
+        # directed cycle, (:C {v:0})->(:C {v:1})->(:C {v:2})->(:C {v:0})
+        redis_graph.query("CREATE (a:C {v:0})-[:F]->(:C {v:1})-[:F]->(c:C {v:2}), (c)-[:F]->(a)")
+
+    def test01_directed_cycle(self):
+        query = "MATCH (a)-[:F]->(b)-[:F]->(c)-[:F]->(a) RETURN count(a)"
+        plan = redis_graph.execution_plan(query)
+        self.env.assertIn("Intersect Traverse", plan)
+        self.env.assertNotIn("Expand Into", plan)
+
+        # each rotation of the cycle is a match
+        result = redis_graph.query(query)
+        self.env.assertEquals(result.result_set[0][0], 3)
+
+    def test02_triangles(self):
+        query = "MATCH (a)-[:F]->(b)-[:F]->(c), (a)-[:F]->(c) RETURN a.v, b.v, c.v ORDER BY a.v, b.v, c.v"
+        plan = redis_graph.execution_plan(query)
+        self.env.assertIn("Intersect Traverse", plan)
+
+        result = redis_graph.query(query)
+        expected_result = [[0, 1, 2],
+                           [0, 1, 3],
+                           [0, 2, 3],
+                           [1, 2, 3]]
+        self.env.assertEquals(result.result_set, expected_result)
+
+        # same pattern, closing node reached via incoming edges
+        query = "MATCH (c)<-[:F]-(b)<-[:F]-(a), (c)<-[:F]-(a) RETURN a.v, b.v, c.v ORDER BY a.v, b.v, c.v"
+        result = redis_graph.query(query)
+        self.env.assertEquals(result.result_set, expected_result)
+
+    def test03_labeled_closing_node(self):
+        query = "MATCH (a)-[:F]->(b)-[:F]->(c:C), (c)-[:F]->(a) RETURN count(c)"
+        result = redis_graph.query(query)
+        self.env.assertEquals(result.result_set[0][0], 3)
+
+        query = "MATCH (a)-[:F]->(b)-[:F]->(c:N), (c)-[:F]->(a) RETURN count(c)"
+        result = redis_graph.query(query)
+        self.env.assertEquals(result.result_set[0][0], 0)
+
+        # missing label
+        query = "MATCH (a)-[:F]->(b)-[:F]->(c:Missing), (a)-[:F]->(c) RETURN count(c)"
+        result = redis_graph.query(query)
+        self.env.assertEquals(result.result_set[0][0], 0)
+
+    def test04_missing_relationship(self):
+        query = "MATCH (a)-[:F]->(b)-[:F]->(c), (a)-[:Missing]->(c) RETURN count(c)"
+        result = redis_graph.query(query)
+        self.env.assertEquals(result.result_set[0][0], 0)
+
+    def test05_clique(self):
+        query = """MATCH (a)-[:F]->(b)-[:F]->(c)-[:F]->(d), (a)-[:F]->(c), (a)-[:F]->(d), (b)-[:F]->(d)
+                   RETURN a.v, b.v, c.v, d.v"""
+        plan = redis_graph.execution_plan(query)
+        self.env.assertIn("Intersect Traverse", plan)
+
+        result = redis_graph.query(query)
+        expected_result = [[0, 1, 2, 3]]
+        self.env.assertEquals(result.result_set, expected_result)
+
+    def test06_pending_changes(self):
+        query = "MATCH (a)-[:F]->(b)-[:F]->(c), (a)-[:F]->(c) RETURN count(a)"
+
+        # extend clique to 5 nodes
+        redis_graph.query("CREATE (:N {v:4})")
+        redis_graph.query("MATCH (a:N), (b:N {v:4}) WHERE a.v < 4 CREATE (a)-[:F]->(b)")
+
+        # C(5, 3) triangles
+        result = redis_graph.query(query)
+        self.env.assertEquals(result.result_set[0][0], 10)
+
+        # remove edge (0)->(1), dropping triangles {0, 1, x}
+        redis_graph.query("MATCH (:N {v:0})-[e:F]->(:N {v:1}) DELETE e")
+        result = redis_graph.query(query)
+        self.env.assertEquals(result.result_set[0][0], 7)
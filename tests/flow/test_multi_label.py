@@ -111,7 +111,9 @@ class testMultiLabel():
             for query in queries:
                 query = query.format(ls=':'.join(permutation))
                 plan = graph.execution_plan(query)
-                self.env.assertContains("Node By Label Scan | (n:A)", plan)
+                # remaining labels are either checked by the scan
+                # or by the following traversal
+                self.env.assertContains("Node By Label Scan | (n:A", plan)
 
     # Validate behavior of index scans on multi-labeled nodes
     def test05_index_scan(self):
@@ -226,8 +228,40 @@ class testMultiLabel():
         # are extracted.
         query = """MERGE ()-[:R2]->(a:L1)-[:R1]->(a:L2) RETURN *"""
         plan = graph.execution_plan(query)
-        self.env.assertContains("Node By Label Scan | (a:L2)", plan)
+        self.env.assertContains("Node By Label Scan | (a:L2", plan)
         query_result = graph.query(query)
         self.env.assertEquals(query_result.nodes_created, 2)
         self.env.assertEquals(query_result.relationships_created, 2)
 
+    def test10_multi_label_scan_intersection(self):
+        graph = Graph('multi_label_scan', self.redis_con)
+
+        # 100 (:P), 10 (:P:Q), 1 (:P:Q:S) and 5 (:Q) nodes
+        graph.query("UNWIND range(1, 100) AS x CREATE (:P {v: x})")
+        graph.query("UNWIND range(1, 10) AS x CREATE (:P:Q {v: x})")
+        graph.query("CREATE (:P:Q:S {v: 0})")
+        graph.query("UNWIND range(1, 5) AS x CREATE (:Q {v: x})")
+
+        # scan the smallest label, intersecting it with the remaining labels
+        # without a following traversal
+        queries = [("MATCH (n:P:Q) RETURN count(n)", "(n:Q:P)", 11),
+                   ("MATCH (n:Q:P) RETURN count(n)", "(n:Q:P)", 11),
+                   ("MATCH (n:P:Q:S) RETURN count(n)", "(n:S:", 1),
+                   ("MATCH (n:P:Q) WHERE n.v > 5 RETURN count(n)", "(n:Q:P)", 5),
+                   ("UNWIND range(1, 2) AS i MATCH (n:P:Q) RETURN count(n)", "(n:Q:P)", 22)]
+
+        for q, scan, expected in queries:
+            plan = graph.execution_plan(q)
+            self.env.assertContains("Node By Label Scan | " + scan, plan)
+            self.env.assertNotIn("Conditional Traverse", plan)
+            result = graph.query(q)
+            self.env.assertEquals(result.result_set, [[expected]])
+
+        # non existing label
+        result = graph.query("MATCH (n:P:Missing) RETURN count(n)")
+        self.env.assertEquals(result.result_set, [[0]])
+
+        # intersection must account for pending deletions
+        graph.query("MATCH (n:P:Q {v: 1}) DELETE n")
+        result = graph.query("MATCH (n:P:Q) RETURN n.v ORDER BY n.v")
+        self.env.assertEquals(result.result_set, [[x] for x in range(0, 11) if x != 1])
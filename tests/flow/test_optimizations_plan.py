@@ -1,5 +1,6 @@
 from base import FlowTestsBase
 import os
+import redis
 import sys
 from RLTest import Env
 from redisgraph import Graph, Node, Edge
@@ -431,3 +432,116 @@ class testOptimizationsPlan(FlowTestsBase):
                     [0, 3],
                     [0, 3]]
         self.env.assertEqual(resultset, expected)
+
+    # Per node counting should be reduced to a single Degree Count operation.
+    def test28_reduce_degree_count(self):
+        names = sorted(people)
+
+        # outgoing multi-edges are counted individually
+        query = """MATCH (a:person)-[e:know]->(b) WITH a, count(e) AS c RETURN a.name, c ORDER BY a.name"""
+        executionPlan = graph.execution_plan(query)
+        self.env.assertIn("Degree Count", executionPlan)
+        self.env.assertNotIn("Conditional Traverse", executionPlan)
+        self.env.assertNotIn("Aggregate", executionPlan)
+        resultset = graph.query(query).result_set
+        expected = [[name, 6] for name in names]
+        self.env.assertEqual(resultset, expected)
+
+        # incoming edges of multiple relationship types are summed
+        query = """MATCH (a:person)<-[e:know|works_with]-(b) WITH a, count(e) AS c RETURN a.name, c ORDER BY a.name"""
+        executionPlan = graph.execution_plan(query)
+        self.env.assertIn("Degree Count", executionPlan)
+        resultset = graph.query(query).result_set
+        expected = [[name, 9] for name in names]
+        self.env.assertEqual(resultset, expected)
+
+        # counting destination nodes
+        query = """MATCH (a:person)-[:works_with]->(b) WITH a, count(b) AS c RETURN a.name, c ORDER BY a.name"""
+        executionPlan = graph.execution_plan(query)
+        self.env.assertIn("Degree Count", executionPlan)
+        resultset = graph.query(query).result_set
+        expected = [[name, 3] for name in names]
+        self.env.assertEqual(resultset, expected)
+
+        # filtered destination can't be reduced
+        query = """MATCH (a:person)-[:works_with]->(b) WHERE b.val > 0 WITH a, count(b) AS c RETURN a.name, c ORDER BY a.name"""
+        executionPlan = graph.execution_plan(query)
+        self.env.assertNotIn("Degree Count", executionPlan)
+        self.env.assertIn("Aggregate", executionPlan)
+
+        # summing a destination attribute, each person is connected to
+        # everyone else, 'val' values sum up to 6
+        vals = {name: idx for idx, name in enumerate(people)}
+        query = """MATCH (a:person)-[:works_with]->(b) WITH a, sum(b.val) AS s RETURN a.name, s ORDER BY a.name"""
+        executionPlan = graph.execution_plan(query)
+        self.env.assertIn("Degree Count", executionPlan)
+        self.env.assertNotIn("Aggregate", executionPlan)
+        resultset = graph.query(query).result_set
+        expected = [[name, 6.0 - vals[name]] for name in names]
+        self.env.assertEqual(resultset, expected)
+
+        # multi-edges lead to the same destination node, which is summed once
+        query = """MATCH (a:person)-[:know]->(b) WITH a, sum(b.val) AS s RETURN a.name, s ORDER BY a.name"""
+        executionPlan = graph.execution_plan(query)
+        self.env.assertIn("Degree Count", executionPlan)
+        resultset = graph.query(query).result_set
+        expected = [[name, 6.0 - vals[name]] for name in names]
+        self.env.assertEqual(resultset, expected)
+
+        # summing a constant
+        query = """MATCH (a:person)<-[:works_with]-(b) WITH a, sum(2.5) AS s RETURN a.name, s ORDER BY a.name"""
+        executionPlan = graph.execution_plan(query)
+        self.env.assertIn("Degree Count", executionPlan)
+        resultset = graph.query(query).result_set
+        expected = [[name, 7.5] for name in names]
+        self.env.assertEqual(resultset, expected)
+
+        # a missing attribute sums to 0
+        query = """MATCH (a:person)-[:works_with]->(b) WITH a, sum(b.missing) AS s RETURN a.name, s ORDER BY a.name"""
+        resultset = graph.query(query).result_set
+        expected = [[name, 0.0] for name in names]
+        self.env.assertEqual(resultset, expected)
+
+        # summing a none numeric attribute is an error
+        try:
+            query = """MATCH (a:person)-[:works_with]->(b) WITH a, sum(b.name) AS s RETURN a.name, s"""
+            graph.query(query)
+            self.env.assertTrue(False)
+        except redis.exceptions.ResponseError as e:
+            self.env.assertIn("Type mismatch", str(e))
+
+    # Counting the output of a traversal should not flatten it.
+    def test29_factorize_traversal_count(self):
+        names = sorted(people)
+
+        # each person reaches 3 co-workers, each with 3 co-workers of its own
+        query = """MATCH (a:person)-[:works_with]->(b) WHERE b.val >= 0 MATCH (b)-[:works_with]->(c) RETURN a.name, count(c) ORDER BY a.name"""
+        executionPlan = graph.execution_plan(query)
+        self.env.assertIn("Conditional Traverse (Factorized)", executionPlan)
+        resultset = graph.query(query).result_set
+        expected = [[name, 9] for name in names]
+        self.env.assertEqual(resultset, expected)
+
+        # multiple counts, multi-edges lead to the same destination node
+        query = """MATCH (a:person)-[:works_with]->(b) WHERE b.val >= 0 MATCH (b)-[:know]->(c) RETURN count(1), count(c)"""
+        executionPlan = graph.execution_plan(query)
+        self.env.assertIn("Conditional Traverse (Factorized)", executionPlan)
+        resultset = graph.query(query).result_set
+        expected = [[36, 36]]
+        self.env.assertEqual(resultset, expected)
+
+        # distinct count can't be factorized
+        query = """MATCH (a:person)-[:works_with]->(b) WHERE b.val >= 0 MATCH (b)-[:works_with]->(c) RETURN count(DISTINCT c)"""
+        executionPlan = graph.execution_plan(query)
+        self.env.assertNotIn("Factorized", executionPlan)
+        resultset = graph.query(query).result_set
+        expected = [[4]]
+        self.env.assertEqual(resultset, expected)
+
+        # grouping by the destination node can't be factorized
+        query = """MATCH (a:person)-[:works_with]->(b) WHERE b.val >= 0 MATCH (b)-[:works_with]->(c) RETURN c.name, count(1) ORDER BY c.name"""
+        executionPlan = graph.execution_plan(query)
+        self.env.assertNotIn("Factorized", executionPlan)
+        resultset = graph.query(query).result_set
+        expected = [[name, 9] for name in names]
+        self.env.assertEqual(resultset, expected)
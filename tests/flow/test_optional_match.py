@@ -275,3 +275,38 @@ class testOptionalFlow(FlowTestsBase):
         actual_result = redis_graph.query(query)
         expected_result = [['v1', 'v2']]
         self.env.assertEquals(actual_result.result_set, expected_result)
+
+    # Optional MATCH clause which doesn't refer to any bound variable is evaluated once.
+    def test22_uncorrelated_optional(self):
+        global redis_graph
+        query = """MATCH (a:L) OPTIONAL MATCH (b:L {v: 'v4'}) RETURN a.v, b.v ORDER BY a.v"""
+        actual_result = redis_graph.query(query)
+        expected_result = [['v1', 'v4'],
+                           ['v2', 'v4'],
+                           ['v3', 'v4'],
+                           ['v4', 'v4']]
+        self.env.assertEquals(actual_result.result_set, expected_result)
+
+        # the optional branch scans all 4 nodes once rather than once per 'a'
+        redis_con = self.env.getConnection()
+        profile = redis_con.execute_command("GRAPH.PROFILE", "optional_match", query)
+        profile = [x[0:x.index(',')].strip() for x in profile]
+        self.env.assertIn("Node By Label Scan | (b:L) | Records produced: 4", profile)
+
+        # optional branch without matches
+        query = """MATCH (a:L) OPTIONAL MATCH (b:L {v: 'v5'}) RETURN a.v, b.v ORDER BY a.v"""
+        actual_result = redis_graph.query(query)
+        expected_result = [['v1', None],
+                           ['v2', None],
+                           ['v3', None],
+                           ['v4', None]]
+        self.env.assertEquals(actual_result.result_set, expected_result)
+
+        # uncorrelated traversal
+        query = """MATCH (a:L) OPTIONAL MATCH (b:L)-[:E1]->(c) RETURN a.v, b.v, c.v ORDER BY a.v"""
+        actual_result = redis_graph.query(query)
+        expected_result = [['v1', 'v1', 'v2'],
+                           ['v2', 'v1', 'v2'],
+                           ['v3', 'v1', 'v2'],
+                           ['v4', 'v1', 'v2']]
+        self.env.assertEquals(actual_result.result_set, expected_result)
@@ -110,3 +110,55 @@ class testPagerankFlow(FlowTestsBase):
             self.env.assertAlmostEqual(resultset[0][1], 0.777813196182251, 0.0001)
             self.env.assertEqual(resultset[1][0], 1)
             self.env.assertAlmostEqual(resultset[1][1], 0.22218681871891, 0.0001)
+
+    def test_pagerank_top_k(self):
+        self.env.cmd('flushall')
+        # a chain of 10 nodes followed by a node pointing back at the chain head
+        q = """UNWIND range(0, 9) AS x CREATE (:L {v:x})"""
+        redis_graph.query(q)
+        q = """MATCH (a:L), (b:L) WHERE b.v = a.v + 1 CREATE (a)-[:R]->(b)"""
+        redis_graph.query(q)
+        q = """MATCH (a:L {v:9}), (b:L {v:0}) CREATE (a)-[:R]->(b), (:L {v:10})-[:R]->(b)"""
+        redis_graph.query(q)
+
+        q = """CALL algo.pageRank('L', 'R') YIELD node, score RETURN node.v, score"""
+        ranking = redis_graph.query(q).result_set
+
+        # results are ranked by score, sorting them is redundant
+        q = """CALL algo.pageRank('L', 'R') YIELD node, score
+               RETURN node.v, score ORDER BY score DESC LIMIT 3"""
+        plan = redis_graph.execution_plan(q)
+        self.env.assertNotIn("Sort", plan)
+        resultset = redis_graph.query(q).result_set
+        self.env.assertEqual(resultset, ranking[0:3])
+
+        # aliased order expression, skipped records
+        q = """CALL algo.pageRank('L', 'R') YIELD node, score AS s
+               WITH node.v AS v, s AS rank
+               RETURN v, rank ORDER BY rank DESC SKIP 2 LIMIT 3"""
+        plan = redis_graph.execution_plan(q)
+        self.env.assertNotIn("Sort", plan)
+        resultset = redis_graph.query(q).result_set
+        self.env.assertEqual(resultset, ranking[2:5])
+
+        # limit without order
+        q = """CALL algo.pageRank('L', 'R') YIELD node, score
+               RETURN node.v, score LIMIT 4"""
+        resultset = redis_graph.query(q).result_set
+        self.env.assertEqual(resultset, ranking[0:4])
+
+        # ascending order isn't the procedure's order
+        q = """CALL algo.pageRank('L', 'R') YIELD node, score
+               RETURN node.v, score ORDER BY score LIMIT 3"""
+        plan = redis_graph.execution_plan(q)
+        self.env.assertIn("Sort", plan)
+        resultset = redis_graph.query(q).result_set
+        self.env.assertEqual(resultset, ranking[::-1][0:3])
+
+        # filtered records, limit can't be applied to the procedure
+        q = """CALL algo.pageRank('L', 'R') YIELD node, score
+               WITH node, score WHERE node.v % 2 = 0
+               RETURN node.v, score ORDER BY score DESC LIMIT 2"""
+        resultset = redis_graph.query(q).result_set
+        expected = [row for row in ranking if row[0] % 2 == 0][0:2]
+        self.env.assertEqual(resultset, expected)
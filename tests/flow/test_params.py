@@ -1,6 +1,7 @@
 import os
 import sys
 import redis
+import struct
 from RLTest import Env
 from redisgraph import Graph, Node
 
@@ -12,6 +13,27 @@ from demo import QueryInfo
 GRAPH_ID = "G"
 redis_graph = None
 
+# encode a value in GRAPH.QUERY binary parameters format
+def encode_binary_value(v):
+    if v is None:
+        return struct.pack('<B', 0)
+    if isinstance(v, bool):
+        return struct.pack('<BB', 1, v)
+    if isinstance(v, float):
+        return struct.pack('<Bd', 2, v)
+    if isinstance(v, str):
+        return struct.pack('<B', 3) + v.encode() + b'\0'
+    if isinstance(v, int):
+        return struct.pack('<Bq', 4, v)
+    if isinstance(v, list):
+        return struct.pack('<Bq', 5, len(v)) + b''.join(encode_binary_value(x) for x in v)
+    if isinstance(v, dict):
+        return struct.pack('<Bq', 6, len(v)) + b''.join(k.encode() + b'\0' + encode_binary_value(x) for k, x in v.items())
+    raise TypeError(v)
+
+def encode_binary_params(params):
+    return struct.pack('<I', len(params)) + b''.join(k.encode() + b'\0' + encode_binary_value(v) for k, v in params.items())
+
 class testParams(FlowTestsBase):
     def __init__(self):
         self.env = Env(decodeResponses=True)
@@ -149,3 +171,44 @@ class testParams(FlowTestsBase):
         plan = redis_graph.execution_plan(query, params=params)
         self.env.assertIn('NodeByIdSeek', plan)
 
+
+    def test_binary_params(self):
+        redis_con = self.env.getConnection()
+        # pairs of parameter and its textual representation
+        params = [(1, "1"), (2.3, "2.3"), (-1, "-1"), (-2.3, "-2.3"),
+                  ("str", "'str'"), (True, "true"), (False, "false"),
+                  (None, "null"), ([0, 1, 2], "[0, 1, 2]"),
+                  ({'a': 1, 'b': [1.5, 'x', None], 'c': {'d': False}},
+                   "{a: 1, b: [1.5, 'x', null], c: {d: false}}")]
+        query = "RETURN $param"
+        for param, text in params:
+            # binary parameters are equivalent to textual parameters
+            textual = redis_con.execute_command("GRAPH.QUERY", GRAPH_ID,
+                    "CYPHER param=%s %s" % (text, query))
+            binary = redis_con.execute_command("GRAPH.QUERY", GRAPH_ID,
+                    query, "PARAMS", encode_binary_params({'param': param}))
+            self.env.assertEquals(binary[1], textual[1])
+
+        # bulk creation from a list of maps
+        rows = [{'v': i, 'name': 'n%d' % i} for i in range(1000)]
+        binary = encode_binary_params({'rows': rows})
+        redis_con.execute_command("GRAPH.QUERY", GRAPH_ID,
+                "UNWIND $rows AS row CREATE (:R {v: row.v, name: row.name})",
+                "PARAMS", binary)
+        result = redis_graph.query("MATCH (n:R) RETURN count(n), sum(n.v), max(n.name)")
+        self.env.assertEquals(result.result_set, [[1000, 499500, 'n999']])
+
+        # binary and textual parameters can be combined
+        res = redis_con.execute_command("GRAPH.QUERY", GRAPH_ID,
+                "CYPHER b=2 RETURN $a + $b", "PARAMS", encode_binary_params({'a': 1}))
+        self.env.assertEquals(res[1], [[3]])
+
+        # malformed binary parameters are reported back as an error
+        valid = encode_binary_params({'a': [1, 2]})
+        invalid = [b'', valid[:-1], valid + b'\0', struct.pack('<I', 1) + b'a\0' + struct.pack('<B', 9)]
+        for blob in invalid:
+            try:
+                redis_con.execute_command("GRAPH.QUERY", GRAPH_ID, "RETURN $a", "PARAMS", blob)
+                assert(False)
+            except redis.exceptions.ResponseError as e:
+                self.env.assertContains("malformed binary parameters", str(e))
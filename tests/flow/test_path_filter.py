@@ -306,3 +306,43 @@ class testPathFilter(FlowTestsBase):
         # The plan should be identical to the one constructed previously.
         self.env.assertEqual(plan_1, plan_2)
 
+
+    def test15_batched_path_filters(self):
+        # 100 users, each even user blocks its successor
+        redis_graph.query("UNWIND range(0, 99) AS x CREATE (:User {id:x})")
+        redis_graph.query("MATCH (a:User), (b:User) WHERE a.id % 2 = 0 AND b.id = (a.id + 1) % 100 CREATE (a)-[:BLOCKED]->(b)")
+
+        # Single traversal patterns are evaluated in batches, without a match branch.
+        query = "MATCH (n:User) WHERE (n)-[:BLOCKED]->(:User) RETURN count(n)"
+        plan = redis_graph.execution_plan(query)
+        self.env.assertIn("Semi Apply", plan)
+        self.env.assertNotIn("Argument", plan)
+        result_set = redis_graph.query(query)
+        self.env.assertEquals(result_set.result_set, [[50]])
+
+        query = "MATCH (n:User) WHERE NOT (n)-[:BLOCKED]->() RETURN count(n)"
+        result_set = redis_graph.query(query)
+        self.env.assertEquals(result_set.result_set, [[50]])
+
+        # Filters applied to the reached node.
+        query = "MATCH (n:User) WHERE (n)-[:BLOCKED]->({id: 11}) RETURN n.id"
+        result_set = redis_graph.query(query)
+        self.env.assertEquals(result_set.result_set, [[10]])
+
+        query = "MATCH (n:User) WHERE NOT (n)-[:BLOCKED]->({id: 11}) RETURN count(n)"
+        result_set = redis_graph.query(query)
+        self.env.assertEquals(result_set.result_set, [[99]])
+
+        # Filters referring to bound variables.
+        query = "MATCH (n:User) WHERE (n)-[:BLOCKED]->({id: n.id + 1}) RETURN count(n)"
+        result_set = redis_graph.query(query)
+        self.env.assertEquals(result_set.result_set, [[50]])
+
+        # Both pattern ends are bound.
+        query = "MATCH (a:User {id: 0}), (b:User) WHERE (a)-[:BLOCKED]->(b) RETURN b.id"
+        result_set = redis_graph.query(query)
+        self.env.assertEquals(result_set.result_set, [[1]])
+
+        query = "MATCH (a:User {id: 0}), (b:User) WHERE NOT (a)-[:BLOCKED]->(b) RETURN count(b)"
+        result_set = redis_graph.query(query)
+        self.env.assertEquals(result_set.result_set, [[99]])
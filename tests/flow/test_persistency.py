@@ -1,4 +1,5 @@
 import os
+import glob
 import sys
 import random
 from RLTest import Env
@@ -412,3 +413,138 @@ class testGraphPersistency():
         for q in queries:
             actual_result = g.query(q)
             self.env.assertEquals(actual_result.result_set[0], [1])
+
+    # Verify that string values shared by multiple entities
+    # are updated, deleted and restored independently.
+    def test08_persist_shared_strings(self):
+        graph_id = "shared_strings"
+        g = Graph(graph_id, redis_con)
+        q = "UNWIND range(0, 9) AS x CREATE (:L {v: x, status: 'active'})"
+        actual_result = g.query(q)
+        self.env.assertEquals(actual_result.nodes_created, 10)
+
+        # update and delete entities sharing the same string value
+        g.query("MATCH (a:L) WHERE a.v < 3 SET a.status = 'inactive'")
+        g.query("MATCH (a:L) WHERE a.v = 9 DELETE a")
+        g.query("MATCH (a:L) WHERE a.v = 8 SET a.status = NULL")
+
+        q = "MATCH (a:L) RETURN a.status, count(a) ORDER BY a.status"
+        expected_result = [['active', 5], ['inactive', 3], [None, 1]]
+        actual_result = g.query(q)
+        self.env.assertEquals(actual_result.result_set, expected_result)
+
+        # Save RDB & Load from RDB
+        self.env.dumpAndReload()
+
+        actual_result = g.query(q)
+        self.env.assertEquals(actual_result.result_set, expected_result)
+
+        # values loaded from RDB are shared as well
+        g.query("MATCH (a:L) WHERE a.v = 3 SET a.status = 'inactive'")
+        g.query("MATCH (a:L) WHERE a.status = 'inactive' DELETE a")
+
+        expected_result = [['active', 4], [None, 1]]
+        actual_result = g.query(q)
+        self.env.assertEquals(actual_result.result_set, expected_result)
+
+    def test09_matrix_snapshot(self):
+        graph_id = "matrix_snapshot"
+        g = Graph(graph_id, redis_con)
+        redis_con.execute_command("GRAPH.CONFIG SET MATRIX_SNAPSHOT yes")
+
+        g.query("UNWIND range(0, 99) AS x CREATE (:N {v: x})")
+        g.query("MATCH (a:N), (b:N) WHERE b.v = (a.v + 1) % 100 CREATE (a)-[:NEXT]->(b)")
+        g.query("MATCH (a:N), (b:N) WHERE b.v = (a.v * 7) % 100 CREATE (a)-[:MUL {w: a.v}]->(b)")
+        # multi-edge relationships are excluded from the snapshot
+        g.query("MATCH (a:N {v: 0}), (b:N {v: 1}) CREATE (a)-[:TWICE]->(b), (a)-[:TWICE]->(b)")
+
+        queries = [
+            "MATCH (a)-[:NEXT]->(b) RETURN a.v, b.v ORDER BY a.v",
+            "MATCH (a)<-[e:MUL]-(b) RETURN a.v, b.v, e.w ORDER BY a.v, b.v",
+            "MATCH (a)-[e]->(b) RETURN type(e), count(e) ORDER BY type(e)",
+            "MATCH (a {v: 0})-[*3]->(b) RETURN b.v ORDER BY b.v",
+        ]
+        expected = [g.query(q).result_set for q in queries]
+
+        logfilename = self.env.envRunner._getFileName("master", ".log")
+        logfile = open(f"{self.env.logDir}/{logfilename}")
+        logfile.read()
+
+        # save RDB and snapshot, load graph from both
+        self.env.dumpAndReload()
+        for q, e in zip(queries, expected):
+            self.env.assertEquals(g.query(q).result_set, e)
+
+        # snapshot is saved next to the RDB, named after the graph
+        workdir = redis_con.config_get("dir")["dir"]
+        snapshots = glob.glob(f"{workdir}/{graph_id}.*.rgsnap")
+        self.env.assertEquals(len(snapshots), 1)
+
+        # graph was loaded from the snapshot
+        log = logfile.read()
+        self.env.assertIn(f"Loaded matrix snapshot of graph {graph_id}", log)
+
+        # modify graph without updating the snapshot
+        # keeping the number of nodes and edges intact
+        redis_con.execute_command("GRAPH.CONFIG SET MATRIX_SNAPSHOT no")
+        g.query("MATCH (a:N {v: 5})-[e:NEXT]->() DELETE e")
+        g.query("MATCH (a:N {v: 5}), (b:N {v: 50}) CREATE (a)-[:NEXT]->(b)")
+        expected = [g.query(q).result_set for q in queries]
+        redis_con.execute_command("SAVE")
+
+        # stale snapshot is ignored
+        redis_con.execute_command("GRAPH.CONFIG SET MATRIX_SNAPSHOT yes")
+        redis_con.execute_command("DEBUG", "RELOAD", "NOSAVE")
+        for q, e in zip(queries, expected):
+            self.env.assertEquals(g.query(q).result_set, e)
+
+        log = logfile.read()
+        self.env.assertIn(f"Matrix snapshot of graph {graph_id} is stale, ignored", log)
+        self.env.assertNotIn(f"Loaded matrix snapshot of graph {graph_id}", log)
+
+        # graph names sanitized to the same file name have distinct snapshots
+        names = ["snapshot:a", "snapshot_a"]
+        for name in names:
+            Graph(name, redis_con).query("CREATE (:N)-[:R]->(:N)")
+        self.env.dumpAndReload()
+        snapshots = glob.glob(f"{workdir}/snapshot_a.*.rgsnap")
+        self.env.assertEquals(len(snapshots), 2)
+        log = logfile.read()
+        for name in names:
+            self.env.assertIn(f"Loaded matrix snapshot of graph {name}\n", log)
+            result = Graph(name, redis_con).query("MATCH ()-[e:R]->() RETURN count(e)")
+            self.env.assertEquals(result.result_set, [[1]])
+
+        redis_con.execute_command("GRAPH.CONFIG SET MATRIX_SNAPSHOT no")
+
+    def test10_modify_graph_loaded_from_snapshot(self):
+        graph_id = "matrix_snapshot_modify"
+        g = Graph(graph_id, redis_con)
+        redis_con.execute_command("GRAPH.CONFIG SET MATRIX_SNAPSHOT yes")
+
+        # ring of 10 nodes, edge 0 connects node 0 to node 1
+        g.query("UNWIND range(0, 9) AS x CREATE (:N {v: x})")
+        g.query("MATCH (a:N), (b:N) WHERE b.v = (a.v + 1) % 10 CREATE (a)-[:NEXT]->(b)")
+
+        logfilename = self.env.envRunner._getFileName("master", ".log")
+        logfile = open(f"{self.env.logDir}/{logfilename}")
+        logfile.read()
+
+        self.env.dumpAndReload()
+        log = logfile.read()
+        self.env.assertIn(f"Loaded matrix snapshot of graph {graph_id}\n", log)
+
+        # modify relationship matrices loaded from the snapshot
+        result = g.query("MATCH ()-[e:NEXT]->() WHERE ID(e) = 0 DELETE e")
+        self.env.assertEquals(result.relationships_deleted, 1)
+        result = g.query("MATCH (a:N {v: 0}), (b:N {v: 5}) CREATE (a)-[:NEXT]->(b)")
+        self.env.assertEquals(result.relationships_created, 1)
+
+        # traverse incoming edges through the transposed matrix
+        expected = [[a, (a - 1) % 10] for a in range(10) if a != 1]
+        expected.append([5, 0])
+        expected.sort()
+        result = g.query("MATCH (a:N)<-[:NEXT]-(b:N) RETURN a.v, b.v ORDER BY a.v, b.v")
+        self.env.assertEquals(result.result_set, expected)
+
+        redis_con.execute_command("GRAPH.CONFIG SET MATRIX_SNAPSHOT no")
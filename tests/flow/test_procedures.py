@@ -368,7 +368,12 @@ class testProcedures(FlowTestsBase):
         actual_resultset = redis_graph.query("CALL dbms.procedures() YIELD mode, name RETURN mode, name ORDER BY name").result_set
 
         expected_result = [["READ", "algo.BFS"],
+                           ["READ", "algo.WCC"],
+                           ["READ", "algo.kCore"],
+                           ["READ", "algo.labelPropagation"],
                            ["READ", "algo.pageRank"],
+                           ["READ", "algo.personalizedPageRank"],
+                           ["READ", "algo.triangleCount"],
                            ["WRITE", "db.idx.fulltext.createNodeIndex"],
                            ["WRITE", "db.idx.fulltext.drop"],
                            ["READ", "db.idx.fulltext.queryNodes"],
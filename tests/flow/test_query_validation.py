@@ -564,3 +564,18 @@ class testQueryValidationFlow(FlowTestsBase):
             except redis.exceptions.ResponseError as e:
                 pass
 
+
+    def test38_query_priority(self):
+        # valid priorities, case insensitive
+        for priority in ["HIGH", "normal", "Low"]:
+            res = redis_con.execute_command("GRAPH.QUERY", "G", "RETURN 1",
+                    "PRIORITY", priority)
+            self.env.assertEquals(res[1][0][0], 1)
+
+        # missing and unknown priorities are rejected
+        for args in [["PRIORITY"], ["PRIORITY", "urgent"]]:
+            try:
+                redis_con.execute_command("GRAPH.QUERY", "G", "RETURN 1", *args)
+                assert(False)
+            except redis.exceptions.ResponseError as e:
+                self.env.assertContains("Failed to parse query priority value", str(e))
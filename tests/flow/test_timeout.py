@@ -52,27 +52,44 @@ class testQueryTimeout(FlowTestsBase):
         except ResponseError as error:
             self.env.assertContains("Query timed out", str(error))
 
-    def test03_write_query_ignore_timeout(self):
+        # restore default timeout, write queries are subject to it as well
+        redis_con.execute_command("GRAPH.CONFIG SET timeout 0")
+
+    def test03_write_query_timeout(self):
         #----------------------------------------------------------------------
-        # verify that the timeout argument is ignored by write queries
+        # verify that write queries time out without modifying the graph
         #----------------------------------------------------------------------
+        query = "UNWIND range(0, 100000) AS x CREATE (:M)"
+        redis_graph.query(query)
+
+        # each query streams 10M records before committing its changes
+        # orders of magnitude longer than the timeout, regardless of
+        # machine speed
         write_queries = [
             # create query
-            "UNWIND range(0, 10000) AS x CREATE (a:M)",
+            "UNWIND range(0, 10000000) AS x WITH x WHERE x % 100 = 0 CREATE (:N)",
             # update query
-            "MATCH (a:M) SET a.v = 2",
+            "MATCH (a:M) UNWIND range(0, 100) AS x WITH a, x WHERE x = 100 SET a.v = 2",
             # delete query
-            "MATCH (a:M) DELETE a"
+            "MATCH (a:M) UNWIND range(0, 100) AS x WITH a, x WHERE x = 100 DELETE a"
         ]
 
-        # queries should complete successfully
         for q in write_queries:
             try:
-                result = redis_graph.query(q, timeout=1)
-                # the query should have taken longer than the timeout value
-                self.env.assertGreater(result.run_time_ms, 2)
-            except ResponseError:
+                # the query is expected to timeout
+                redis_graph.query(q, timeout=1)
                 assert(False)
+            except ResponseError as error:
+                self.env.assertContains("Query timed out", str(error))
+
+        # validate that timed out queries discarded their changes
+        result = redis_graph.query("MATCH (n:N) RETURN count(n)")
+        self.env.assertEquals(result.result_set[0][0], 0)
+        result = redis_graph.query("MATCH (a:M) RETURN count(a), count(a.v)")
+        self.env.assertEquals(result.result_set[0], [100001, 0])
+
+        # clear graph
+        redis_graph.query("MATCH (a:M) DELETE a")
 
         #----------------------------------------------------------------------
         # index creation should ignore timeouts
@@ -86,7 +86,7 @@ TEST_F(ArithmeticTest, ExpressionTest) {
 	query = "RETURN 'muchacho'";
 	arExp = _exp_from_query(query);
 	result = AR_EXP_Evaluate(arExp, NULL);
-	ASSERT_STREQ(result.stringval, "muchacho");
+	ASSERT_STREQ(SI_STRINGVAL(result), "muchacho");
 	AR_EXP_Free(arExp);
 
 	/* 1 */
@@ -127,7 +127,7 @@ TEST_F(ArithmeticTest, ExpressionTest) {
 	arExp = _exp_from_query(query);
 	ASSERT_EQ(arExp->type, AR_EXP_OPERAND);
 	result = AR_EXP_Evaluate(arExp, NULL);
-	ASSERT_TRUE(strcmp(result.stringval, "ab") == 0);
+	ASSERT_TRUE(strcmp(SI_STRINGVAL(result), "ab") == 0);
 	AR_EXP_Free(arExp);
 
 	/* 1 + 2 + 'a' + 2 + 1 */
@@ -135,7 +135,7 @@ TEST_F(ArithmeticTest, ExpressionTest) {
 	arExp = _exp_from_query(query);
 	ASSERT_EQ(arExp->type, AR_EXP_OPERAND);
 	result = AR_EXP_Evaluate(arExp, NULL);
-	ASSERT_TRUE(strcmp(result.stringval, "3a21") == 0);
+	ASSERT_TRUE(strcmp(SI_STRINGVAL(result), "3a21") == 0);
 	AR_EXP_Free(arExp);
 
 	/* 2 * 2 + 'a' + 3 * 3 */
@@ -143,7 +143,7 @@ TEST_F(ArithmeticTest, ExpressionTest) {
 	arExp = _exp_from_query(query);
 	ASSERT_EQ(arExp->type, AR_EXP_OPERAND);
 	result = AR_EXP_Evaluate(arExp, NULL);
-	ASSERT_TRUE(strcmp(result.stringval, "4a9") == 0);
+	ASSERT_TRUE(strcmp(SI_STRINGVAL(result), "4a9") == 0);
 	AR_EXP_Free(arExp);
 
 	query = "RETURN 9 % 5";
@@ -721,7 +721,7 @@ TEST_F(ArithmeticTest, ReverseTest) {
 	arExp = _exp_from_query(query);
 	result = AR_EXP_Evaluate(arExp, NULL);
 	expected = "ohcahcum";
-	ASSERT_STREQ(result.stringval, expected);
+	ASSERT_STREQ(SI_STRINGVAL(result), expected);
 	AR_EXP_Free(arExp);
 
 	/* REVERSE("") */
@@ -729,7 +729,7 @@ TEST_F(ArithmeticTest, ReverseTest) {
 	arExp = _exp_from_query(query);
 	result = AR_EXP_Evaluate(arExp, NULL);
 	expected = "";
-	ASSERT_STREQ(result.stringval, expected);
+	ASSERT_STREQ(SI_STRINGVAL(result), expected);
 	AR_EXP_Free(arExp);
 
 	/* REVERSE() */
@@ -751,7 +751,7 @@ TEST_F(ArithmeticTest, LeftTest) {
 	arExp = _exp_from_query(query);
 	result = AR_EXP_Evaluate(arExp, NULL);
 	expected = "much";
-	ASSERT_STREQ(result.stringval, expected);
+	ASSERT_STREQ(SI_STRINGVAL(result), expected);
 	AR_EXP_Free(arExp);
 
 	/* LEFT("muchacho", 100) */
@@ -759,7 +759,7 @@ TEST_F(ArithmeticTest, LeftTest) {
 	arExp = _exp_from_query(query);
 	result = AR_EXP_Evaluate(arExp, NULL);
 	expected = "muchacho";
-	ASSERT_STREQ(result.stringval, expected);
+	ASSERT_STREQ(SI_STRINGVAL(result), expected);
 	AR_EXP_Free(arExp);
 
 	/* LEFT(NULL, 100) */
@@ -781,7 +781,7 @@ TEST_F(ArithmeticTest, RightTest) {
 	arExp = _exp_from_query(query);
 	result = AR_EXP_Evaluate(arExp, NULL);
 	expected = "acho";
-	ASSERT_STREQ(result.stringval, expected);
+	ASSERT_STREQ(SI_STRINGVAL(result), expected);
 	AR_EXP_Free(arExp);
 
 	/* RIGHT("muchacho", 100) */
@@ -789,7 +789,7 @@ TEST_F(ArithmeticTest, RightTest) {
 	arExp = _exp_from_query(query);
 	result = AR_EXP_Evaluate(arExp, NULL);
 	expected = "muchacho";
-	ASSERT_STREQ(result.stringval, expected);
+	ASSERT_STREQ(SI_STRINGVAL(result), expected);
 	AR_EXP_Free(arExp);
 
 	/* RIGHT(NULL, 100) */
@@ -811,7 +811,7 @@ TEST_F(ArithmeticTest, LTrimTest) {
 	arExp = _exp_from_query(query);
 	result = AR_EXP_Evaluate(arExp, NULL);
 	expected = "muchacho";
-	ASSERT_STREQ(result.stringval, expected);
+	ASSERT_STREQ(SI_STRINGVAL(result), expected);
 	AR_EXP_Free(arExp);
 
 	/* lTrim("muchacho   ") */
@@ -819,7 +819,7 @@ TEST_F(ArithmeticTest, LTrimTest) {
 	arExp = _exp_from_query(query);
 	result = AR_EXP_Evaluate(arExp, NULL);
 	expected = "muchacho   ";
-	ASSERT_STREQ(result.stringval, expected);
+	ASSERT_STREQ(SI_STRINGVAL(result), expected);
 	AR_EXP_Free(arExp);
 
 	/* lTrim("   much   acho   ") */
@@ -827,7 +827,7 @@ TEST_F(ArithmeticTest, LTrimTest) {
 	arExp = _exp_from_query(query);
 	result = AR_EXP_Evaluate(arExp, NULL);
 	expected = "much   acho   ";
-	ASSERT_STREQ(result.stringval, expected);
+	ASSERT_STREQ(SI_STRINGVAL(result), expected);
 	AR_EXP_Free(arExp);
 
 	/* lTrim("muchacho") */
@@ -835,7 +835,7 @@ TEST_F(ArithmeticTest, LTrimTest) {
 	arExp = _exp_from_query(query);
 	result = AR_EXP_Evaluate(arExp, NULL);
 	expected = "muchacho";
-	ASSERT_STREQ(result.stringval, expected);
+	ASSERT_STREQ(SI_STRINGVAL(result), expected);
 	AR_EXP_Free(arExp);
 
 	/* lTrim() */
@@ -857,7 +857,7 @@ TEST_F(ArithmeticTest, RTrimTest) {
 	arExp = _exp_from_query(query);
 	result = AR_EXP_Evaluate(arExp, NULL);
 	expected = "   muchacho";
-	ASSERT_STREQ(result.stringval, expected);
+	ASSERT_STREQ(SI_STRINGVAL(result), expected);
 	AR_EXP_Free(arExp);
 
 	/* rTrim("muchacho   ") */
@@ -865,7 +865,7 @@ TEST_F(ArithmeticTest, RTrimTest) {
 	arExp = _exp_from_query(query);
 	result = AR_EXP_Evaluate(arExp, NULL);
 	expected = "muchacho";
-	ASSERT_STREQ(result.stringval, expected);
+	ASSERT_STREQ(SI_STRINGVAL(result), expected);
 	AR_EXP_Free(arExp);
 
 	/* rTrim("   much   acho   ") */
@@ -873,7 +873,7 @@ TEST_F(ArithmeticTest, RTrimTest) {
 	arExp = _exp_from_query(query);
 	result = AR_EXP_Evaluate(arExp, NULL);
 	expected = "   much   acho";
-	ASSERT_STREQ(result.stringval, expected);
+	ASSERT_STREQ(SI_STRINGVAL(result), expected);
 	AR_EXP_Free(arExp);
 
 	/* rTrim("muchacho") */
@@ -881,7 +881,7 @@ TEST_F(ArithmeticTest, RTrimTest) {
 	arExp = _exp_from_query(query);
 	result = AR_EXP_Evaluate(arExp, NULL);
 	expected = "muchacho";
-	ASSERT_STREQ(result.stringval, expected);
+	ASSERT_STREQ(SI_STRINGVAL(result), expected);
 	AR_EXP_Free(arExp);
 
 	/* rTrim() */
@@ -901,14 +901,14 @@ TEST_F(ArithmeticTest, RandomUUID) {
 	query = "RETURN randomUUID()";
 	arExp = _exp_from_query(query);
 	result = AR_EXP_Evaluate(arExp, NULL);
-	ASSERT_EQ(36, strlen(result.stringval));
-	ASSERT_EQ('-', result.stringval[8]);
-	ASSERT_EQ('-', result.stringval[13]);
-	ASSERT_EQ('4', result.stringval[14]);
-	ASSERT_EQ('-', result.stringval[18]);
-	v = result.stringval[19];
+	ASSERT_EQ(36, strlen(SI_STRINGVAL(result)));
+	ASSERT_EQ('-', SI_STRINGVAL(result)[8]);
+	ASSERT_EQ('-', SI_STRINGVAL(result)[13]);
+	ASSERT_EQ('4', SI_STRINGVAL(result)[14]);
+	ASSERT_EQ('-', SI_STRINGVAL(result)[18]);
+	v = SI_STRINGVAL(result)[19];
 	ASSERT_TRUE(v == '8' || v == '9' || v == 'a' || v == 'b');
-	ASSERT_EQ('-', result.stringval[23]);
+	ASSERT_EQ('-', SI_STRINGVAL(result)[23]);
 	AR_EXP_Free(arExp);
 }
 
@@ -923,7 +923,7 @@ TEST_F(ArithmeticTest, TrimTest) {
 	arExp = _exp_from_query(query);
 	result = AR_EXP_Evaluate(arExp, NULL);
 	expected = "muchacho";
-	ASSERT_STREQ(result.stringval, expected);
+	ASSERT_STREQ(SI_STRINGVAL(result), expected);
 	AR_EXP_Free(arExp);
 
 	/* trim("muchacho   ") */
@@ -931,7 +931,7 @@ TEST_F(ArithmeticTest, TrimTest) {
 	arExp = _exp_from_query(query);
 	result = AR_EXP_Evaluate(arExp, NULL);
 	expected = "muchacho";
-	ASSERT_STREQ(result.stringval, expected);
+	ASSERT_STREQ(SI_STRINGVAL(result), expected);
 	AR_EXP_Free(arExp);
 
 	/* trim("   much   acho   ") */
@@ -939,7 +939,7 @@ TEST_F(ArithmeticTest, TrimTest) {
 	arExp = _exp_from_query(query);
 	result = AR_EXP_Evaluate(arExp, NULL);
 	expected = "much   acho";
-	ASSERT_STREQ(result.stringval, expected);
+	ASSERT_STREQ(SI_STRINGVAL(result), expected);
 	AR_EXP_Free(arExp);
 
 	/* trim("muchacho") */
@@ -947,7 +947,7 @@ TEST_F(ArithmeticTest, TrimTest) {
 	arExp = _exp_from_query(query);
 	result = AR_EXP_Evaluate(arExp, NULL);
 	expected = "muchacho";
-	ASSERT_STREQ(result.stringval, expected);
+	ASSERT_STREQ(SI_STRINGVAL(result), expected);
 	AR_EXP_Free(arExp);
 
 	/* trim() */
@@ -969,7 +969,7 @@ TEST_F(ArithmeticTest, SubstringTest) {
 	arExp = _exp_from_query(query);
 	result = AR_EXP_Evaluate(arExp, NULL);
 	expected = "much";
-	ASSERT_STREQ(result.stringval, expected);
+	ASSERT_STREQ(SI_STRINGVAL(result), expected);
 	AR_EXP_Free(arExp);
 
 	/* SUBSTRING("muchacho", 3, 20) */
@@ -977,7 +977,7 @@ TEST_F(ArithmeticTest, SubstringTest) {
 	arExp = _exp_from_query(query);
 	result = AR_EXP_Evaluate(arExp, NULL);
 	expected = "hacho";
-	ASSERT_STREQ(result.stringval, expected);
+	ASSERT_STREQ(SI_STRINGVAL(result), expected);
 	AR_EXP_Free(arExp);
 
 	/* SUBSTRING(NULL, 3, 20) */
@@ -999,7 +999,7 @@ TEST_F(ArithmeticTest, ToLowerTest) {
 	arExp = _exp_from_query(query);
 	result = AR_EXP_Evaluate(arExp, NULL);
 	expected = "muchacho";
-	ASSERT_STREQ(result.stringval, expected);
+	ASSERT_STREQ(SI_STRINGVAL(result), expected);
 	AR_EXP_Free(arExp);
 
 	/* toLower("mUcHaChO") */
@@ -1007,7 +1007,7 @@ TEST_F(ArithmeticTest, ToLowerTest) {
 	arExp = _exp_from_query(query);
 	result = AR_EXP_Evaluate(arExp, NULL);
 	expected = "muchacho";
-	ASSERT_STREQ(result.stringval, expected);
+	ASSERT_STREQ(SI_STRINGVAL(result), expected);
 	AR_EXP_Free(arExp);
 
 	/* toLower("mUcHaChO") */
@@ -1029,7 +1029,7 @@ TEST_F(ArithmeticTest, ToUpperTest) {
 	arExp = _exp_from_query(query);
 	result = AR_EXP_Evaluate(arExp, NULL);
 	expected = "MUCHACHO";
-	ASSERT_STREQ(result.stringval, expected);
+	ASSERT_STREQ(SI_STRINGVAL(result), expected);
 	AR_EXP_Free(arExp);
 
 	/* toUpper("mUcHaChO") */
@@ -1037,7 +1037,7 @@ TEST_F(ArithmeticTest, ToUpperTest) {
 	arExp = _exp_from_query(query);
 	result = AR_EXP_Evaluate(arExp, NULL);
 	expected = "MUCHACHO";
-	ASSERT_STREQ(result.stringval, expected);
+	ASSERT_STREQ(SI_STRINGVAL(result), expected);
 	AR_EXP_Free(arExp);
 
 	/* toUpper("mUcHaChO") */
@@ -1059,7 +1059,7 @@ TEST_F(ArithmeticTest, ToStringTest) {
 	arExp = _exp_from_query(query);
 	result = AR_EXP_Evaluate(arExp, NULL);
 	expected = "muchacho";
-	ASSERT_STREQ(result.stringval, expected);
+	ASSERT_STREQ(SI_STRINGVAL(result), expected);
 	AR_EXP_Free(arExp);
 
 	/* toString("3.14") */
@@ -1067,7 +1067,7 @@ TEST_F(ArithmeticTest, ToStringTest) {
 	arExp = _exp_from_query(query);
 	result = AR_EXP_Evaluate(arExp, NULL);
 	expected = "3.140000";
-	ASSERT_STREQ(result.stringval, expected);
+	ASSERT_STREQ(SI_STRINGVAL(result), expected);
 	AR_EXP_Free(arExp);
 
 	/* toString() */
@@ -1230,7 +1230,7 @@ TEST_F(ArithmeticTest, AND) {
 		SIValue expected = truth_table[i + 2];
 
 		char *query;
-		asprintf(&query, "RETURN %s AND %s", a.stringval, b.stringval);
+		asprintf(&query, "RETURN %s AND %s", SI_STRINGVAL(a), SI_STRINGVAL(b));
 		AR_ExpNode *arExp = _exp_from_query(query);
 		SIValue result = AR_EXP_Evaluate(arExp, NULL);
 		AR_EXP_Free(arExp);
@@ -1261,7 +1261,7 @@ TEST_F(ArithmeticTest, OR) {
 		SIValue expected = truth_table[i + 2];
 
 		char *query;
-		asprintf(&query, "RETURN %s OR %s", a.stringval, b.stringval);
+		asprintf(&query, "RETURN %s OR %s", SI_STRINGVAL(a), SI_STRINGVAL(b));
 		AR_ExpNode *arExp = _exp_from_query(query);
 		SIValue result = AR_EXP_Evaluate(arExp, NULL);
 		AR_EXP_Free(arExp);
@@ -1292,7 +1292,7 @@ TEST_F(ArithmeticTest, XOR) {
 		SIValue expected = truth_table[i + 2];
 
 		char *query;
-		asprintf(&query, "RETURN %s XOR %s", a.stringval, b.stringval);
+		asprintf(&query, "RETURN %s XOR %s", SI_STRINGVAL(a), SI_STRINGVAL(b));
 		AR_ExpNode *arExp = _exp_from_query(query);
 		SIValue result = AR_EXP_Evaluate(arExp, NULL);
 		AR_EXP_Free(arExp);
@@ -1316,7 +1316,7 @@ TEST_F(ArithmeticTest, NOT) {
 		SIValue expected = truth_table[i + 1];
 
 		char *query;
-		asprintf(&query, "RETURN NOT %s", a.stringval);
+		asprintf(&query, "RETURN NOT %s", SI_STRINGVAL(a));
 		AR_ExpNode *arExp = _exp_from_query(query);
 		SIValue result = AR_EXP_Evaluate(arExp, NULL);
 		AR_EXP_Free(arExp);
@@ -1347,7 +1347,7 @@ TEST_F(ArithmeticTest, LT) {
 		SIValue expected = truth_table[i + 2];
 
 		char *query;
-		asprintf(&query, "RETURN %s < %s", a.stringval, b.stringval);
+		asprintf(&query, "RETURN %s < %s", SI_STRINGVAL(a), SI_STRINGVAL(b));
 		AR_ExpNode *arExp = _exp_from_query(query);
 		SIValue result = AR_EXP_Evaluate(arExp, NULL);
 		AR_EXP_Free(arExp);
@@ -1378,7 +1378,7 @@ TEST_F(ArithmeticTest, LE) {
 		SIValue expected = truth_table[i + 2];
 
 		char *query;
-		asprintf(&query, "RETURN %s <= %s", a.stringval, b.stringval);
+		asprintf(&query, "RETURN %s <= %s", SI_STRINGVAL(a), SI_STRINGVAL(b));
 		AR_ExpNode *arExp = _exp_from_query(query);
 		SIValue result = AR_EXP_Evaluate(arExp, NULL);
 		AR_EXP_Free(arExp);
@@ -1409,7 +1409,7 @@ TEST_F(ArithmeticTest, EQ) {
 		SIValue expected = truth_table[i + 2];
 
 		char *query;
-		asprintf(&query, "RETURN %s = %s", a.stringval, b.stringval);
+		asprintf(&query, "RETURN %s = %s", SI_STRINGVAL(a), SI_STRINGVAL(b));
 		AR_ExpNode *arExp = _exp_from_query(query);
 		SIValue result = AR_EXP_Evaluate(arExp, NULL);
 		AR_EXP_Free(arExp);
@@ -1440,7 +1440,7 @@ TEST_F(ArithmeticTest, NE) {
 		SIValue expected = truth_table[i + 2];
 
 		char *query;
-		asprintf(&query, "RETURN %s <> %s", a.stringval, b.stringval);
+		asprintf(&query, "RETURN %s <> %s", SI_STRINGVAL(a), SI_STRINGVAL(b));
 		AR_ExpNode *arExp = _exp_from_query(query);
 		SIValue result = AR_EXP_Evaluate(arExp, NULL);
 		AR_EXP_Free(arExp);
@@ -1475,7 +1475,7 @@ TEST_F(ArithmeticTest, ListTest) {
 	ASSERT_EQ(2.3, doubleVal.doubleval);
 
 	ASSERT_EQ(T_STRING, stringVal.type);
-	ASSERT_EQ(0, strcmp("4", stringVal.stringval));
+	ASSERT_EQ(0, strcmp("4", SI_STRINGVAL(stringVal)));
 
 	ASSERT_EQ(T_BOOL, trueVal.type);
 	ASSERT_EQ(true, trueVal.longval);
@@ -100,7 +100,7 @@ TEST_F(MapTest, map_add) {
 	SIValue *stored_keys = Map_Keys(map);
 	ASSERT_EQ(array_len(stored_keys), 3);
 	for(int i = 0; i < 3; i++) {
-		ASSERT_TRUE(strcmp(keys[i].stringval, stored_keys[i].stringval) == 0);
+		ASSERT_TRUE(strcmp(SI_STRINGVAL(keys[i]), SI_STRINGVAL(stored_keys[i])) == 0);
 	}
 
 	// clean up
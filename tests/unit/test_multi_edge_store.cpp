@@ -0,0 +1,166 @@
+/*
+* Copyright 2018-2021 Redis Labs Ltd. and Contributors
+*
+* This file is available under the Redis Labs Source Available License Agreement
+*/
+
+#include "gtest.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include "../../src/util/rmalloc.h"
+#include "../../src/graph/rg_matrix/multi_edge_store.h"
+
+#ifdef __cplusplus
+}
+#endif
+
+class MultiEdgeStoreTest: public ::testing::Test {
+  protected:
+	static void SetUpTestCase() {
+		// Use the malloc family for allocations
+		Alloc_Reset();
+	}
+};
+
+TEST_F(MultiEdgeStoreTest, NewList) {
+	uint32_t n;
+	MultiEdgeStore *store = MultiEdgeStore_New();
+
+	uint64_t a = MultiEdgeStore_NewList(store, 1, 2);
+	uint64_t b = MultiEdgeStore_NewList(store, 3, 4);
+	ASSERT_NE(a, b);
+	ASSERT_EQ(MultiEdgeStore_ListCount(store), 2);
+
+	const uint64_t *edges = MultiEdgeStore_GetEdges(store, a, &n);
+	ASSERT_EQ(n, 2);
+	ASSERT_EQ(edges[0], 1);
+	ASSERT_EQ(edges[1], 2);
+
+	edges = MultiEdgeStore_GetEdges(store, b, &n);
+	ASSERT_EQ(n, 2);
+	ASSERT_EQ(edges[0], 3);
+	ASSERT_EQ(edges[1], 4);
+
+	MultiEdgeStore_Free(&store);
+	ASSERT_TRUE(store == NULL);
+}
+
+TEST_F(MultiEdgeStoreTest, Append) {
+	uint32_t n;
+	int list_count = 100;
+	int edge_count = 100;
+	uint64_t *ids = (uint64_t *)malloc(sizeof(uint64_t) * list_count);
+	MultiEdgeStore *store = MultiEdgeStore_New();
+
+	for(int i = 0; i < list_count; i++) {
+		ids[i] = MultiEdgeStore_NewList(store, i * edge_count,
+				i * edge_count + 1);
+	}
+
+	// interleave appends, forcing lists to relocate
+	for(int j = 2; j < edge_count; j++) {
+		for(int i = 0; i < list_count; i++) {
+			MultiEdgeStore_Append(store, ids[i], i * edge_count + j);
+		}
+	}
+
+	// lists maintain their edges in order of insertion
+	for(int i = 0; i < list_count; i++) {
+		const uint64_t *edges = MultiEdgeStore_GetEdges(store, ids[i], &n);
+		ASSERT_EQ(n, edge_count);
+		for(int j = 0; j < edge_count; j++) {
+			ASSERT_EQ(edges[j], i * edge_count + j);
+		}
+	}
+
+	free(ids);
+	MultiEdgeStore_Free(&store);
+}
+
+TEST_F(MultiEdgeStoreTest, Remove) {
+	uint32_t n;
+	uint64_t remaining;
+	MultiEdgeStore *store = MultiEdgeStore_New();
+
+	uint64_t a = MultiEdgeStore_NewList(store, 1, 2);
+	MultiEdgeStore_Append(store, a, 3);
+
+	// list holds multiple edges after removal
+	ASSERT_FALSE(MultiEdgeStore_Remove(store, a, 1, &remaining));
+	const uint64_t *edges = MultiEdgeStore_GetEdges(store, a, &n);
+	ASSERT_EQ(n, 2);
+	ASSERT_TRUE((edges[0] == 2 && edges[1] == 3) ||
+				(edges[0] == 3 && edges[1] == 2));
+
+	// single edge remains, list is freed
+	ASSERT_TRUE(MultiEdgeStore_Remove(store, a, 3, &remaining));
+	ASSERT_EQ(remaining, 2);
+	ASSERT_EQ(MultiEdgeStore_ListCount(store), 0);
+
+	// freed list ID is reused
+	uint64_t b = MultiEdgeStore_NewList(store, 4, 5);
+	ASSERT_EQ(a, b);
+	ASSERT_EQ(MultiEdgeStore_ListCount(store), 1);
+
+	MultiEdgeStore_Free(&store);
+}
+
+TEST_F(MultiEdgeStoreTest, Compaction) {
+	uint32_t n;
+	int list_count = 1000;
+	uint64_t *ids = (uint64_t *)malloc(sizeof(uint64_t) * list_count);
+	MultiEdgeStore *store = MultiEdgeStore_New();
+
+	for(int i = 0; i < list_count; i++) {
+		ids[i] = MultiEdgeStore_NewList(store, i, i);
+		for(int j = 0; j < 6; j++) MultiEdgeStore_Append(store, ids[i], i);
+	}
+
+	// free most lists, leaving the pool mostly unused
+	for(int i = 0; i < list_count; i++) {
+		if(i % 10 != 0) MultiEdgeStore_FreeList(store, ids[i]);
+	}
+
+	ASSERT_EQ(MultiEdgeStore_ListCount(store), list_count / 10);
+	ASSERT_LE(store->garbage * 2, store->size);
+
+	// remaining lists are intact
+	for(int i = 0; i < list_count; i += 10) {
+		const uint64_t *edges = MultiEdgeStore_GetEdges(store, ids[i], &n);
+		ASSERT_EQ(n, 8);
+		for(uint32_t j = 0; j < n; j++) ASSERT_EQ(edges[j], i);
+	}
+
+	free(ids);
+	MultiEdgeStore_Free(&store);
+}
+
+TEST_F(MultiEdgeStoreTest, CompactionThreshold) {
+	uint32_t n;
+	MultiEdgeStore *store = MultiEdgeStore_New();
+
+	uint64_t a = MultiEdgeStore_NewList(store, 0, 0);
+	uint64_t b = MultiEdgeStore_NewList(store, 1, 1);
+
+	// growing 'a' relocates it past 'b', leaving a small amount of garbage
+	MultiEdgeStore_Append(store, a, 0);
+	ASSERT_EQ(store->garbage, 2);
+
+	// garbage below the threshold doesn't trigger a compaction
+	MultiEdgeStore_FreeList(store, b);
+	ASSERT_EQ(store->garbage, 4);
+	ASSERT_GE(store->garbage * 2, store->size);
+
+	// appends which don't relocate 'a' leave the pool as is
+	for(int i = 0; i < 100; i++) MultiEdgeStore_Append(store, a, 0);
+	ASSERT_EQ(store->garbage, 4);
+
+	const uint64_t *edges = MultiEdgeStore_GetEdges(store, a, &n);
+	ASSERT_EQ(n, 103);
+	for(uint32_t i = 0; i < n; i++) ASSERT_EQ(edges[i], 0);
+
+	MultiEdgeStore_Free(&store);
+}
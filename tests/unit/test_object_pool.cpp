@@ -38,6 +38,8 @@ TEST_F(ObjectPoolTest, New) {
 	// The size of items in the pool is greater to accommodate an internal header ID.
 	uint header_size = sizeof(uint64_t);
 	ASSERT_EQ(object_pool->itemSize, item_size + header_size);
+	// The reported item size excludes the header.
+	ASSERT_EQ(ObjectPool_ItemSize(object_pool), item_size);
 	ASSERT_GE(object_pool->blockCount, 1024 / POOL_BLOCK_CAP);
 
 	// Verify that blocks are properly chained together.
@@ -58,7 +58,7 @@ TEST_F(PagerankTest, Pagerank) {
 	GrB_Matrix_setElement_BOOL(A, true, 4, 5);
 	GrB_Matrix_setElement_BOOL(A, true, 1, 6);
 
-	Pagerank(&ranking, A, itermax, tol, &iters);
+	Pagerank(&ranking, A, 7, itermax, tol, &iters);
 
 	/*
 	Page:5, pagerank:0.392289
@@ -84,5 +84,16 @@ TEST_F(PagerankTest, Pagerank) {
 		ASSERT_NEAR(ranking[i].pagerank, expectations[i].pagerank, 0.000001);
 	}
 
+	// compute only the top ranked pages
+	rm_free(ranking);
+	Pagerank(&ranking, A, 3, itermax, tol, &iters);
+
+	for(int i = 0; i < 3; i++) {
+		ASSERT_NEAR(ranking[i].page, expectations[i].page, 0.000001);
+		ASSERT_NEAR(ranking[i].pagerank, expectations[i].pagerank, 0.000001);
+	}
+
+	rm_free(ranking);
+	GrB_free(&A);
 	GrB_finalize();
 }
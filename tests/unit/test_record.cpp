@@ -59,3 +59,46 @@ TEST_F(RecordTest, RecordToString) {
 	Record_Free(r);
 }
 
+
+TEST_F(RecordTest, RecordGraphEntities) {
+	rax *_rax = raxNew();
+	for(int i = 0; i < 3; i++) {
+		char buf[2] = {(char)i, '\0'};
+		raxInsert(_rax, (unsigned char *)buf, 2, NULL, NULL);
+	}
+
+	// entries should not be sized by the edge struct more than necessary
+	ASSERT_LE(sizeof(Edge), sizeof(Node) + 3 * sizeof(EntityID));
+
+	Record r = Record_New(_rax);
+	Record clone = Record_New(_rax);
+
+	Node src = GE_NEW_NODE();
+	Node dest = GE_NEW_NODE();
+	src.id = 1;
+	dest.id = 2;
+
+	Edge e = GE_NEW_LABELED_EDGE(3);
+	e.id = 4;
+	Edge_SetSrcNode(&e, &src);
+	Edge_SetDestNode(&e, &dest);
+
+	Record_AddNode(r, 0, src);
+	Record_AddNode(r, 1, dest);
+	Record_AddEdge(r, 2, e);
+
+	Record_Clone(r, clone);
+
+	ASSERT_EQ(Record_GetType(clone, 2), REC_TYPE_EDGE);
+	Edge *edge = Record_GetEdge(clone, 2);
+	ASSERT_EQ(ENTITY_GET_ID(edge), 4);
+	ASSERT_EQ(Edge_GetSrcNodeID(edge), 1);
+	ASSERT_EQ(Edge_GetDestNodeID(edge), 2);
+	ASSERT_EQ(Edge_GetRelationID(edge), 3);
+	ASSERT_EQ(ENTITY_GET_ID(Record_GetNode(clone, 0)), 1);
+	ASSERT_EQ(ENTITY_GET_ID(Record_GetNode(clone, 1)), 2);
+
+	Record_Free(clone);
+	Record_Free(r);
+	raxFree(_rax);
+}
@@ -774,6 +774,140 @@ TEST_F(RGMatrixTest, RGMatrix_set) {
 	ASSERT_TRUE(A == NULL);
 }
 
+// set multiple elements at once
+TEST_F(RGMatrixTest, RGMatrix_set_elements) {
+	GrB_Type    t                   =  GrB_BOOL;
+	RG_Matrix   A                   =  NULL;
+	GrB_Matrix  M                   =  NULL;
+	GrB_Matrix  DP                  =  NULL;
+	GrB_Matrix  DM                  =  NULL;
+	GrB_Info    info                =  GrB_SUCCESS;
+	GrB_Index   nvals               =  0;
+	GrB_Index   nrows               =  200;
+	GrB_Index   ncols               =  200;
+	GrB_Index   I[200];
+	bool        x;
+
+	for(GrB_Index k = 0; k < 200; k++) I[k] = k;
+
+	info = RG_Matrix_new(&A, t, nrows, ncols);
+	ASSERT_EQ(info, GrB_SUCCESS);
+
+	// get internal matrices
+	M   =  RG_MATRIX_M(A);
+	DP  =  RG_MATRIX_DELTA_PLUS(A);
+	DM  =  RG_MATRIX_DELTA_MINUS(A);
+
+	//--------------------------------------------------------------------------
+	// set elements of an empty matrix
+	//--------------------------------------------------------------------------
+
+	// set the first 100 diagonal elements
+	info = RG_Matrix_setElements_BOOL(A, I, I, 100);
+	ASSERT_EQ(info, GrB_SUCCESS);
+
+	RG_Matrix_nvals(&nvals, A);
+	ASSERT_EQ(nvals, 100);
+
+	// additions are pending in DP
+	M_EMPTY();
+	DM_EMPTY();
+	GrB_Matrix_nvals(&nvals, DP);
+	ASSERT_EQ(nvals, 100);
+
+	// force sync
+	// entries should migrate from 'delta-plus' to 'M'
+	RG_Matrix_wait(A, true);
+
+	//--------------------------------------------------------------------------
+	// set elements marked for deletion and existing elements
+	//--------------------------------------------------------------------------
+
+	info = RG_Matrix_removeElement_BOOL(A, 0, 0);
+	ASSERT_EQ(info, GrB_SUCCESS);
+	DM_NOT_EMPTY();
+
+	// set all diagonal elements
+	info = RG_Matrix_setElements_BOOL(A, I, I, 200);
+	ASSERT_EQ(info, GrB_SUCCESS);
+
+	//--------------------------------------------------------------------------
+	// validations
+	//--------------------------------------------------------------------------
+
+	RG_Matrix_nvals(&nvals, A);
+	ASSERT_EQ(nvals, 200);
+
+	// deleted entry is restored
+	DM_EMPTY();
+	info = RG_Matrix_extractElement_BOOL(&x, A, 0, 0);
+	ASSERT_EQ(info, GrB_SUCCESS);
+
+	// M holds the first 100 elements, DP holds the remaining
+	GrB_Matrix_nvals(&nvals, M);
+	ASSERT_EQ(nvals, 100);
+	GrB_Matrix_nvals(&nvals, DP);
+	ASSERT_EQ(nvals, 100);
+
+	//--------------------------------------------------------------------------
+	// clean up
+	//--------------------------------------------------------------------------
+
+	RG_Matrix_free(&A);
+	ASSERT_TRUE(A == NULL);
+}
+
+// every modification, including in place multi-edge edits, bumps version
+TEST_F(RGMatrixTest, RGMatrix_version_multi_edge) {
+	GrB_Type    t                   =  GrB_UINT64;
+	RG_Matrix   A                   =  NULL;
+	GrB_Info    info                =  GrB_SUCCESS;
+	GrB_Index   nrows               =  100;
+	GrB_Index   ncols               =  100;
+	GrB_Index   i                   =  0;
+	GrB_Index   j                   =  1;
+	uint64_t    version             =  0;
+
+	info = RG_Matrix_new(&A, t, nrows, ncols);
+	ASSERT_EQ(info, GrB_SUCCESS);
+
+	// create a multi-edge entry holding 3 edges
+	for(uint64_t e = 0; e < 3; e++) {
+		version = RG_Matrix_version(A);
+		info = RG_Matrix_setElement_UINT64(A, e, i, j);
+		ASSERT_EQ(info, GrB_SUCCESS);
+		ASSERT_GT(RG_Matrix_version(A), version);
+	}
+
+	// remove edges from multi-edge entry in 'delta-plus'
+	version = RG_Matrix_version(A);
+	info = RG_Matrix_removeEntry(A, i, j, 2);
+	ASSERT_EQ(info, GrB_SUCCESS);
+	ASSERT_GT(RG_Matrix_version(A), version);
+
+	// remove edges from multi-edge entry in 'M'
+	info = RG_Matrix_setElement_UINT64(A, 2, i, j);
+	ASSERT_EQ(info, GrB_SUCCESS);
+	RG_Matrix_wait(A, true);
+
+	version = RG_Matrix_version(A);
+	info = RG_Matrix_removeEntry(A, i, j, 2);
+	ASSERT_EQ(info, GrB_SUCCESS);
+	ASSERT_GT(RG_Matrix_version(A), version);
+
+	version = RG_Matrix_version(A);
+	info = RG_Matrix_clear(A);
+	ASSERT_EQ(info, GrB_SUCCESS);
+	ASSERT_GT(RG_Matrix_version(A), version);
+
+	//--------------------------------------------------------------------------
+	// clean up
+	//--------------------------------------------------------------------------
+
+	RG_Matrix_free(&A);
+	ASSERT_TRUE(A == NULL);
+}
+
 // flush simple addition
 TEST_F(RGMatrixTest, RGMatrix_flush) {
 	GrB_Type    t                   =  GrB_BOOL;
@@ -1295,6 +1429,111 @@ TEST_F(RGMatrixTest, RGMatrix_export_pending_changes) {
 	ASSERT_TRUE(A == NULL);
 }
 
+// flush pending changes by replacing M with an exported matrix
+TEST_F(RGMatrixTest, RGMatrix_replace) {
+	GrB_Type    t                   =  GrB_UINT64;
+	RG_Matrix   A                   =  NULL;
+	RG_Matrix   T                   =  NULL;
+	GrB_Matrix  M                   =  NULL;
+	GrB_Matrix  DP                  =  NULL;
+	GrB_Matrix  DM                  =  NULL;
+	GrB_Matrix  N                   =  NULL;  // exported matrix
+	GrB_Matrix  TN                  =  NULL;  // exported transposed matrix
+	GrB_Info    info                =  GrB_SUCCESS;
+	GrB_Index   nvals               =  0;
+	GrB_Index   nrows               =  100;
+	GrB_Index   ncols               =  100;
+	uint64_t    version             =  0;
+	uint64_t    x                   =  0;
+
+	info = RG_Matrix_new(&A, t, nrows, ncols);
+	ASSERT_EQ(info, GrB_SUCCESS);
+	T = RG_Matrix_getTranspose(A);
+
+	// set elements and flush them into M
+	info = RG_Matrix_setElement_UINT64(A, 1, 0, 0);
+	ASSERT_EQ(info, GrB_SUCCESS);
+	info = RG_Matrix_setElement_UINT64(A, 2, 1, 1);
+	ASSERT_EQ(info, GrB_SUCCESS);
+	RG_Matrix_wait(A, true);
+
+	//--------------------------------------------------------------------------
+	// set pending changes
+	//--------------------------------------------------------------------------
+
+	version = RG_Matrix_version(A);
+
+	info = RG_Matrix_removeElement_UINT64(A, 0, 0);
+	ASSERT_EQ(info, GrB_SUCCESS);
+	info = RG_Matrix_setElement_UINT64(A, 3, 2, 3);
+	ASSERT_EQ(info, GrB_SUCCESS);
+
+	// modifications advance version
+	ASSERT_GT(RG_Matrix_version(A), version);
+
+	// materialize without merging
+	info = RG_Matrix_materialize(A);
+	ASSERT_EQ(info, GrB_SUCCESS);
+	ASSERT_FALSE(RG_Matrix_isDirty(A));
+	ASSERT_FALSE(RG_Matrix_requiresFlush(A));
+
+	DP = RG_MATRIX_DELTA_PLUS(A);
+	DM = RG_MATRIX_DELTA_MINUS(A);
+	DP_NOT_EMPTY();
+	DM_NOT_EMPTY();
+
+	//--------------------------------------------------------------------------
+	// export and replace
+	//--------------------------------------------------------------------------
+
+	info = RG_Matrix_export(&N, A);
+	ASSERT_EQ(info, GrB_SUCCESS);
+	info = RG_Matrix_export(&TN, T);
+	ASSERT_EQ(info, GrB_SUCCESS);
+
+	info = RG_Matrix_replace(A, &N);
+	ASSERT_EQ(info, GrB_SUCCESS);
+	ASSERT_TRUE(N == NULL);
+	info = RG_Matrix_replace(T, &TN);
+	ASSERT_EQ(info, GrB_SUCCESS);
+	ASSERT_TRUE(TN == NULL);
+
+	//--------------------------------------------------------------------------
+	// validation
+	//--------------------------------------------------------------------------
+
+	M  = RG_MATRIX_M(A);
+	DP = RG_MATRIX_DELTA_PLUS(A);
+	DM = RG_MATRIX_DELTA_MINUS(A);
+	DP_EMPTY();
+	DM_EMPTY();
+
+	GrB_Matrix_nvals(&nvals, M);
+	ASSERT_EQ(nvals, 2);
+
+	info = GrB_Matrix_extractElement(&x, M, 1, 1);
+	ASSERT_EQ(info, GrB_SUCCESS);
+	ASSERT_EQ(x, 2);
+	info = GrB_Matrix_extractElement(&x, M, 2, 3);
+	ASSERT_EQ(info, GrB_SUCCESS);
+	ASSERT_EQ(x, 3);
+	info = GrB_Matrix_extractElement(&x, M, 0, 0);
+	ASSERT_EQ(info, GrB_NO_VALUE);
+
+	M  = RG_MATRIX_M(T);
+	DP = RG_MATRIX_DELTA_PLUS(T);
+	DM = RG_MATRIX_DELTA_MINUS(T);
+	DP_EMPTY();
+	DM_EMPTY();
+
+	GrB_Matrix_nvals(&nvals, M);
+	ASSERT_EQ(nvals, 2);
+
+	// clean up
+	RG_Matrix_free(&A);
+	ASSERT_TRUE(A == NULL);
+}
+
 TEST_F(RGMatrixTest, RGMatrix_copy) {
 	GrB_Type    t                   =  GrB_BOOL;
 	RG_Matrix   A                   =  NULL;
@@ -1457,6 +1696,130 @@ TEST_F(RGMatrixTest, RGMatrix_mxm) {
 	ASSERT_TRUE(C == NULL);
 }
 
+TEST_F(RGMatrixTest, RGMatrix_mxm_masked) {
+	GrB_Type    t                   =  GrB_BOOL;
+	RG_Matrix   A                   =  NULL;
+	RG_Matrix   B                   =  NULL;
+	RG_Matrix   C                   =  NULL;
+	RG_Matrix   D                   =  NULL;
+	GrB_Matrix  C_M                 =  NULL;
+	GrB_Matrix  D_M                 =  NULL;
+	GrB_Matrix  E                   =  NULL;
+	GrB_Matrix  Mask                =  NULL;
+	GrB_Info    info                =  GrB_SUCCESS;
+	GrB_Index   nrows               =  100;
+	GrB_Index   ncols               =  100;
+	bool        sync                =  false;
+
+	info = RG_Matrix_new(&A, t, nrows, ncols);
+	ASSERT_EQ(info, GrB_SUCCESS);
+
+	info = RG_Matrix_new(&B, t, nrows, ncols);
+	ASSERT_EQ(info, GrB_SUCCESS);
+
+	info = RG_Matrix_new(&C, t, nrows, ncols);
+	ASSERT_EQ(info, GrB_SUCCESS);
+
+	info = RG_Matrix_new(&D, t, nrows, ncols);
+	ASSERT_EQ(info, GrB_SUCCESS);
+
+	info = GrB_Matrix_new(&E, t, nrows, ncols);
+	ASSERT_EQ(info, GrB_SUCCESS);
+
+	info = GrB_Matrix_new(&Mask, t, nrows, ncols);
+	ASSERT_EQ(info, GrB_SUCCESS);
+
+	// set elements
+	info = RG_Matrix_setElement_BOOL(A, 0, 1);
+	ASSERT_EQ(info, GrB_SUCCESS);
+	info = RG_Matrix_setElement_BOOL(A, 2, 3);
+	ASSERT_EQ(info, GrB_SUCCESS);
+	info = RG_Matrix_setElement_BOOL(A, 4, 3);
+	ASSERT_EQ(info, GrB_SUCCESS);
+	info = RG_Matrix_setElement_BOOL(B, 1, 2);
+	ASSERT_EQ(info, GrB_SUCCESS);
+	info = RG_Matrix_setElement_BOOL(B, 3, 4);
+	ASSERT_EQ(info, GrB_SUCCESS);
+	info = RG_Matrix_setElement_BOOL(B, 3, 5);
+	ASSERT_EQ(info, GrB_SUCCESS);
+
+	//--------------------------------------------------------------------------
+	// flush matrix, sync
+	//--------------------------------------------------------------------------
+
+	// wait, force sync
+	sync = true;
+	RG_Matrix_wait(A, sync);
+	RG_Matrix_wait(B, sync);
+
+	//--------------------------------------------------------------------------
+	// set pending changes
+	//--------------------------------------------------------------------------
+
+	// remove element at position 1,2
+	info = RG_Matrix_removeElement_BOOL(B, 1, 2);
+	ASSERT_EQ(info, GrB_SUCCESS);
+
+	// set element at position 1,3
+	info = RG_Matrix_setElement_BOOL(B, 1, 3);
+	ASSERT_EQ(info, GrB_SUCCESS);
+
+	//--------------------------------------------------------------------------
+	// set mask
+	//--------------------------------------------------------------------------
+
+	// requested pairs, some of which aren't connected
+	info = GrB_Matrix_setElement_BOOL(Mask, true, 0, 2);
+	ASSERT_EQ(info, GrB_SUCCESS);
+	info = GrB_Matrix_setElement_BOOL(Mask, true, 0, 3);
+	ASSERT_EQ(info, GrB_SUCCESS);
+	info = GrB_Matrix_setElement_BOOL(Mask, true, 2, 4);
+	ASSERT_EQ(info, GrB_SUCCESS);
+	info = GrB_Matrix_setElement_BOOL(Mask, true, 4, 6);
+	ASSERT_EQ(info, GrB_SUCCESS);
+	GrB_Matrix_wait(Mask, GrB_MATERIALIZE);
+
+	//--------------------------------------------------------------------------
+	// mxm matrix
+	//--------------------------------------------------------------------------
+
+	info = RG_mxm(C, GxB_ANY_PAIR_BOOL, A, B);
+	ASSERT_EQ(info, GrB_SUCCESS);
+
+	info = RG_mxm_masked(D, Mask, GxB_ANY_PAIR_BOOL, A, B);
+	ASSERT_EQ(info, GrB_SUCCESS);
+
+	//--------------------------------------------------------------------------
+	// validation
+	//--------------------------------------------------------------------------
+
+	C_M  = RG_MATRIX_M(C);
+	D_M  = RG_MATRIX_M(D);
+
+	// masked multiplication equals the masked result of the multiplication
+	info = GrB_Matrix_apply(E, Mask, NULL, GrB_IDENTITY_BOOL, C_M, GrB_DESC_RS);
+	ASSERT_EQ(info, GrB_SUCCESS);
+
+	ASSERT_GrB_Matrices_EQ(E, D_M);
+
+	// only (0,3) and (2,4) are connected
+	GrB_Index nvals;
+	GrB_Matrix_nvals(&nvals, D_M);
+	ASSERT_EQ(nvals, 2);
+
+	// clean up
+	RG_Matrix_free(&A);
+	ASSERT_TRUE(A == NULL);
+	RG_Matrix_free(&B);
+	ASSERT_TRUE(B == NULL);
+	RG_Matrix_free(&C);
+	ASSERT_TRUE(C == NULL);
+	RG_Matrix_free(&D);
+	ASSERT_TRUE(D == NULL);
+	GrB_free(&E);
+	GrB_free(&Mask);
+}
+
 TEST_F(RGMatrixTest, RGMatrix_resize) {
 	RG_Matrix  A        =  NULL;
 	RG_Matrix  T        =  NULL;
@@ -0,0 +1,158 @@
+/*
+* Copyright 2018-2021 Redis Labs Ltd. and Contributors
+*
+* This file is available under the Redis Labs Source Available License Agreement
+*/
+
+#include "gtest.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stdio.h>
+#include <string.h>
+#include "../../src/value.h"
+#include "../../src/util/rmalloc.h"
+#include "../../src/util/string_pool.h"
+
+#ifdef __cplusplus
+}
+#endif
+
+class StringPoolTest: public ::testing::Test {
+  protected:
+	static void SetUpTestCase() {
+		// Use the malloc family for allocations
+		Alloc_Reset();
+	}
+};
+
+TEST_F(StringPoolTest, Intern) {
+	StringPool *pool = StringPool_New();
+
+	char buf[16];
+	strcpy(buf, "active");
+
+	const char *a = StringPool_Intern(pool, "active");
+	const char *b = StringPool_Intern(pool, buf);
+	const char *c = StringPool_Intern(pool, "inactive");
+
+	// identical strings share a single copy
+	ASSERT_EQ(a, b);
+	ASSERT_NE(a, c);
+	ASSERT_STREQ(a, "active");
+	ASSERT_STREQ(c, "inactive");
+
+	ASSERT_EQ(StringPool_Count(pool), 2);
+	ASSERT_EQ(StringPool_RefCount(a), 2);
+	ASSERT_EQ(StringPool_RefCount(c), 1);
+
+	StringPool_Free(pool);
+}
+
+TEST_F(StringPoolTest, Release) {
+	StringPool *pool = StringPool_New();
+
+	const char *a = StringPool_Intern(pool, "active");
+	StringPool_Intern(pool, "active");
+	StringPool_Intern(pool, "inactive");
+
+	// string remains pooled while referenced
+	StringPool_Release(a);
+	ASSERT_EQ(StringPool_Count(pool), 2);
+	ASSERT_EQ(StringPool_RefCount(a), 1);
+
+	// last reference removes string from pool
+	StringPool_Release(a);
+	ASSERT_EQ(StringPool_Count(pool), 1);
+
+	// re-interning a released string
+	a = StringPool_Intern(pool, "active");
+	ASSERT_EQ(StringPool_Count(pool), 2);
+	ASSERT_EQ(StringPool_RefCount(a), 1);
+
+	StringPool_Free(pool);
+}
+
+TEST_F(StringPoolTest, ManyStrings) {
+	StringPool *pool = StringPool_New();
+
+	char buf[32];
+	int n = 10000;
+	const char **strings = (const char **)malloc(sizeof(char *) * n);
+
+	// force pool to grow
+	for(int i = 0; i < n; i++) {
+		sprintf(buf, "str_%d", i);
+		strings[i] = StringPool_Intern(pool, buf);
+	}
+	ASSERT_EQ(StringPool_Count(pool), n);
+
+	// strings are still located after resizing
+	for(int i = 0; i < n; i++) {
+		sprintf(buf, "str_%d", i);
+		ASSERT_EQ(StringPool_Intern(pool, buf), strings[i]);
+		StringPool_Release(strings[i]);
+	}
+	ASSERT_EQ(StringPool_Count(pool), n);
+
+	// release every other string, forcing pool to shrink
+	for(int i = 0; i < n; i += 2) StringPool_Release(strings[i]);
+	ASSERT_EQ(StringPool_Count(pool), n / 2);
+
+	for(int i = 1; i < n; i += 2) {
+		sprintf(buf, "str_%d", i);
+		ASSERT_EQ(StringPool_Intern(pool, buf), strings[i]);
+		StringPool_Release(strings[i]);
+		StringPool_Release(strings[i]);
+	}
+	ASSERT_EQ(StringPool_Count(pool), 0);
+
+	free(strings);
+	StringPool_Free(pool);
+}
+
+TEST_F(StringPoolTest, InternedValue) {
+	StringPool *pool = StringPool_New();
+
+	SIValue a = SI_InternStringVal(pool, "active_user");
+	SIValue b = SI_InternStringVal(pool, "active_user");
+	SIValue c = SI_ConstStringVal("active_user");
+
+	ASSERT_EQ(a.allocation, M_INTERN);
+	ASSERT_EQ(a.stringval, b.stringval);
+	ASSERT_EQ(SIValue_Compare(a, b, NULL), 0);
+	ASSERT_EQ(SIValue_Compare(a, c, NULL), 0);
+
+	// clones own their own copy of the string
+	SIValue clone = SI_CloneValue(a);
+	ASSERT_EQ(clone.allocation, M_SELF);
+	ASSERT_NE(clone.stringval, a.stringval);
+	ASSERT_EQ(StringPool_RefCount(a.stringval), 2);
+	SIValue_Free(clone);
+
+	// shared values do not hold a reference
+	SIValue shared = SI_ShareValue(a);
+	ASSERT_EQ(shared.allocation, M_VOLATILE);
+
+	SIValue_Free(a);
+	ASSERT_EQ(StringPool_Count(pool), 1);
+	SIValue_Free(b);
+	ASSERT_EQ(StringPool_Count(pool), 0);
+
+	StringPool_Free(pool);
+}
+
+TEST_F(StringPoolTest, InlineValue) {
+	StringPool *pool = StringPool_New();
+
+	// short strings are stored inline rather than pooled
+	SIValue a = SI_InternStringVal(pool, "USA");
+	ASSERT_EQ(a.allocation, M_NONE);
+	ASSERT_STREQ(SI_STRINGVAL(a), "USA");
+	ASSERT_EQ(StringPool_Count(pool), 0);
+
+	SIValue_Free(a);
+	StringPool_Free(pool);
+}
@@ -34,8 +34,27 @@ class ThreadPoolsTest: public ::testing::Test {
 		int *threadID = (int*)arg;
 		*threadID = ThreadPools_GetThreadID();	
 	}
+
+	// blocks until 'arg' is set
+	static void wait_for_release(void *arg) {
+		volatile bool *release = (volatile bool*)arg;
+		while(!*release) {}
+	}
+
+	// records job execution order
+	static void record_job(void *arg) {
+		int job = (int)(intptr_t)arg;
+		int i = __atomic_fetch_add(&executed_count, 1, __ATOMIC_SEQ_CST);
+		executed[i] = job;
+	}
+
+	static int executed[16];
+	static int executed_count;
 };
 
+int ThreadPoolsTest::executed[16];
+int ThreadPoolsTest::executed_count = 0;
+
 TEST_F(ThreadPoolsTest, ThreadPools_ThreadID) {
 	// verify thread count equals to the number of reader and writer threads
 	ASSERT_EQ (READER_COUNT + WRITER_COUNT, ThreadPools_ThreadCount());
@@ -50,7 +69,7 @@ TEST_F(ThreadPoolsTest, ThreadPools_ThreadID) {
 		int offset = i + 1;
 		ASSERT_EQ(0,
 				ThreadPools_AddWorkReader(get_thread_friendly_id,
-					thread_ids + offset));
+					thread_ids + offset, THPOOL_PRIORITY_NORMAL, NULL));
 	}
 
 	// get writer threads friendly ids
@@ -58,7 +77,7 @@ TEST_F(ThreadPoolsTest, ThreadPools_ThreadID) {
 		int offset = i + READER_COUNT + 1;
 		ASSERT_EQ(0,
 				ThreadPools_AddWorkWriter(get_thread_friendly_id,
-					thread_ids + offset));
+					thread_ids + offset, THPOOL_PRIORITY_NORMAL, NULL));
 	}
 
 	// wait for all threads
@@ -83,3 +102,37 @@ TEST_F(ThreadPoolsTest, ThreadPools_ThreadID) {
 	}
 }
 
+
+TEST_F(ThreadPoolsTest, ThreadPool_Scheduling) {
+	int tenant_a;
+	int tenant_b;
+	volatile bool release = false;
+	threadpool pool = thpool_init(1, "scheduling");
+
+	// occupy the single thread while jobs are queued
+	thpool_add_work(pool, wait_for_release, (void*)&release);
+
+	// burst of tenant A jobs followed by tenant B jobs
+	thpool_add_prioritized_work(pool, record_job, (void*)1,
+			THPOOL_PRIORITY_NORMAL, &tenant_a);
+	thpool_add_prioritized_work(pool, record_job, (void*)2,
+			THPOOL_PRIORITY_NORMAL, &tenant_a);
+	thpool_add_prioritized_work(pool, record_job, (void*)3,
+			THPOOL_PRIORITY_NORMAL, &tenant_a);
+	thpool_add_prioritized_work(pool, record_job, (void*)4,
+			THPOOL_PRIORITY_NORMAL, &tenant_b);
+	thpool_add_prioritized_work(pool, record_job, (void*)5,
+			THPOOL_PRIORITY_LOW, &tenant_b);
+	thpool_add_prioritized_work(pool, record_job, (void*)6,
+			THPOOL_PRIORITY_HIGH, &tenant_b);
+
+	release = true;
+	thpool_wait(pool);
+
+	// high priority first, then tenants alternate, low priority last
+	int expected[6] = {6, 1, 4, 2, 3, 5};
+	ASSERT_EQ(executed_count, 6);
+	for(int i = 0; i < 6; i++) ASSERT_EQ(executed[i], expected[i]);
+
+	thpool_destroy(pool);
+}
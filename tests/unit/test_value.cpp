@@ -63,14 +63,58 @@ TEST_F(ValueTest, TestStrings) {
 	char const *str = "Test!";
 	v = SIValue_FromString(str);
 	ASSERT_TRUE(v.type == T_STRING);
-	ASSERT_STREQ(v.stringval, "Test!");
+	ASSERT_STREQ(SI_STRINGVAL(v), "Test!");
 	SIValue_Free(v);
 
 	/* Out of double range */
 	str = "1.0001e10001";
 	v = SIValue_FromString(str);
 	ASSERT_TRUE(v.type == T_STRING);
-	ASSERT_STREQ(v.stringval, "1.0001e10001");
+	ASSERT_STREQ(SI_STRINGVAL(v), "1.0001e10001");
+	SIValue_Free(v);
+}
+
+TEST_F(ValueTest, TestInlineStrings) {
+	// short strings are stored within the SIValue
+	char buf[16];
+	strcpy(buf, "USA");
+	SIValue v = SI_ConstStringVal(buf);
+	ASSERT_EQ(v.allocation, M_NONE);
+	ASSERT_STREQ(SI_STRINGVAL(v), "USA");
+
+	// value doesn't depend on the original buffer
+	buf[0] = 'X';
+	ASSERT_STREQ(SI_STRINGVAL(v), "USA");
+
+	// copies are self contained, no allocation is required
+	SIValue clone = SI_CloneValue(v);
+	ASSERT_EQ(clone.allocation, M_NONE);
+	ASSERT_STREQ(SI_STRINGVAL(clone), "USA");
+	ASSERT_NE(SI_STRINGVAL(clone), SI_STRINGVAL(v));
+
+	SIValue persisted = SI_ShareValue(v);
+	SIValue_Persist(&persisted);
+	ASSERT_EQ(persisted.allocation, M_NONE);
+	ASSERT_EQ(SIValue_Compare(v, persisted, NULL), 0);
+
+	// longest inline string
+	v = SI_DuplicateStringVal("1234567");
+	ASSERT_EQ(v.allocation, M_NONE);
+	ASSERT_STREQ(SI_STRINGVAL(v), "1234567");
+
+	// longer strings are heap allocated
+	SIValue long_str = SI_DuplicateStringVal("12345678");
+	ASSERT_EQ(long_str.allocation, M_SELF);
+	ASSERT_STREQ(SI_STRINGVAL(long_str), "12345678");
+	ASSERT_LT(SIValue_Compare(v, long_str, NULL), 0);
+	SIValue_Free(long_str);
+
+	// transferred short strings are inlined and released
+	char *s = (char *)rm_malloc(4);
+	strcpy(s, "abc");
+	v = SI_TransferStringVal(s);
+	ASSERT_EQ(v.allocation, M_NONE);
+	ASSERT_STREQ(SI_STRINGVAL(v), "abc");
 	SIValue_Free(v);
 }
 